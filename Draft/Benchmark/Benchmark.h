@@ -0,0 +1,243 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+// Shared micro-benchmark harness for the programs in Draft/.
+// Include it from a suite file, fill a struct BenchCase per routine and call benchMeasure().
+// Reports ns/op, p50/p99 latency, hardware counters (when perf events are available) and JSON.
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<time.h>
+#ifdef __linux__
+#include<unistd.h>
+#include<sys/ioctl.h>
+#include<sys/syscall.h>
+#include<linux/perf_event.h>
+#endif
+
+#define BENCH_COUNTERS 4
+static const char *benchCounterNames[BENCH_COUNTERS]={"cache_references","cache_misses","branch_misses","instructions"};
+
+struct BenchConfig{
+    size_t minN,maxN;       // smallest and largest input size (elements)
+    unsigned factor;        // geometric step between sizes
+    size_t ops;             // measured operations per case
+    unsigned batch;         // operations per latency sample
+    unsigned seed;          // PRNG seed for inputs and queries
+    int threads;            // worker threads for parallel routines, 0 = every online CPU
+    const char *json;       // JSON output path, "-" for stdout, NULL for none
+    const char *filter;     // only run cases whose name contains this
+};
+struct BenchCase{
+    const char *name;       // routine name shown in the report
+    size_t n;               // input size (elements)
+    size_t ops;             // operations to measure, 0 means cfg->ops
+    unsigned batch;         // operations per sample, 0 means cfg->batch
+    // Runs operations [begin,end) and returns a checksum so the work cannot be optimised away
+    long long (*run)(void *ctx, size_t begin, size_t end);
+    // Optional untimed preparation before each sample (e.g. re-copying unsorted input)
+    void (*setup)(void *ctx, size_t begin, size_t end);
+    void *ctx;
+    size_t items;           // elements processed per operation (e.g. n for a sort), 0 means 1
+};
+struct BenchResult{
+    const char *name; size_t n,ops;
+    double nsPerOp,nsPerItem,p50,p99,minNs,maxNs;
+    long long counters[BENCH_COUNTERS]; // -1 when the counter is unavailable
+    long long checksum;
+};
+struct BenchReport{FILE *json; int count;};
+
+// Monotonic clock in nanoseconds
+static inline double benchNowNs(void){
+    struct timespec ts; clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (double)ts.tv_sec*1e9+(double)ts.tv_nsec;
+}
+// xorshift64* generator, good enough for shuffles and query streams
+static inline unsigned long long benchRand(unsigned long long *s){
+    unsigned long long x=*s;
+    x^=x>>12; x^=x<<25; x^=x>>27; *s=x;
+    return x*0x2545F4914F6CDD1DULL;
+}
+static inline unsigned long long benchSeed(unsigned seed){
+    return 0x9E3779B97F4A7C15ULL*(seed+1); // never zero
+}
+// Keeps results alive across the timed region
+static volatile unsigned long long benchSink;
+
+static inline void benchDefaults(struct BenchConfig *cfg){
+    cfg->minN=1<<10; cfg->maxN=1<<24; cfg->factor=4;
+    cfg->ops=1<<20; cfg->batch=8; cfg->seed=1; cfg->threads=0;
+    cfg->json=NULL; cfg->filter=NULL;
+}
+static inline void benchUsage(const char *prog){
+    fprintf(stderr,"Usage: %s [--min N] [--max N] [--factor F] [--ops N] [--batch N] [--seed S] [--threads T] [--filter NAME] [--json FILE|-]\n",prog);
+}
+// Parses the common flags over values already set by benchDefaults() (suites may adjust those first).
+// Returns the index of the first unknown flag, or argc when everything was understood.
+static inline int benchParseArgs(struct BenchConfig *cfg, int argc, char **argv){
+    int i;
+    for(i=1;i<argc;i++){
+        const char *a=argv[i];
+        if(i+1>=argc) break; // every flag takes a value
+        if(!strcmp(a,"--min")) cfg->minN=strtoull(argv[++i],NULL,0);
+        else if(!strcmp(a,"--max")) cfg->maxN=strtoull(argv[++i],NULL,0);
+        else if(!strcmp(a,"--factor")) cfg->factor=(unsigned)strtoul(argv[++i],NULL,0);
+        else if(!strcmp(a,"--ops")) cfg->ops=strtoull(argv[++i],NULL,0);
+        else if(!strcmp(a,"--batch")) cfg->batch=(unsigned)strtoul(argv[++i],NULL,0);
+        else if(!strcmp(a,"--seed")) cfg->seed=(unsigned)strtoul(argv[++i],NULL,0);
+        else if(!strcmp(a,"--threads")) cfg->threads=atoi(argv[++i]);
+        else if(!strcmp(a,"--filter")) cfg->filter=argv[++i];
+        else if(!strcmp(a,"--json")) cfg->json=argv[++i];
+        else break;
+    }
+    if(cfg->factor<2) cfg->factor=2;
+    if(cfg->batch==0) cfg->batch=1;
+    if(cfg->minN==0) cfg->minN=1;
+    if(cfg->maxN<cfg->minN) cfg->maxN=cfg->minN;
+    return i;
+}
+// Next size in the sweep; returns 0 once past cfg->maxN
+static inline size_t benchNextSize(const struct BenchConfig *cfg, size_t n){
+    if(n==0) return cfg->minN;
+    if(n>=cfg->maxN) return 0;
+    n*=cfg->factor;
+    return n>cfg->maxN ? cfg->maxN : n;
+}
+static inline int benchSelected(const struct BenchConfig *cfg, const char *name){
+    return cfg->filter==NULL || strstr(name,cfg->filter)!=NULL;
+}
+
+// Hardware counters through perf_event_open(2); every call is a no-op when unavailable
+struct BenchCounters{int fd[BENCH_COUNTERS];};
+#ifdef __linux__
+static inline int benchPerfOpen(unsigned type, unsigned long long config){
+    struct perf_event_attr attr;
+    memset(&attr,0,sizeof(attr));
+    attr.size=sizeof(attr); attr.type=type; attr.config=config;
+    attr.disabled=1; attr.exclude_kernel=1; attr.exclude_hv=1;
+    return (int)syscall(__NR_perf_event_open,&attr,0,-1,-1,0);
+}
+#endif
+static inline void benchCountersOpen(struct BenchCounters *c){
+    for(int i=0;i<BENCH_COUNTERS;i++) c->fd[i]=-1;
+#ifdef __linux__
+    static const unsigned long long cfg[BENCH_COUNTERS]={
+        PERF_COUNT_HW_CACHE_REFERENCES,PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,PERF_COUNT_HW_INSTRUCTIONS};
+    for(int i=0;i<BENCH_COUNTERS;i++) c->fd[i]=benchPerfOpen(PERF_TYPE_HARDWARE,cfg[i]);
+    for(int i=0;i<BENCH_COUNTERS;i++) if(c->fd[i]>=0) ioctl(c->fd[i],PERF_EVENT_IOC_RESET,0);
+#endif
+}
+static inline void benchCountersEnable(struct BenchCounters *c, int on){
+#ifdef __linux__
+    for(int i=0;i<BENCH_COUNTERS;i++)
+        if(c->fd[i]>=0) ioctl(c->fd[i],on ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE,0);
+#else
+    (void)c; (void)on;
+#endif
+}
+static inline void benchCountersClose(struct BenchCounters *c, long long out[BENCH_COUNTERS]){
+    for(int i=0;i<BENCH_COUNTERS;i++){
+        out[i]=-1;
+#ifdef __linux__
+        if(c->fd[i]<0) continue;
+        long long v;
+        if(read(c->fd[i],&v,sizeof(v))==(ssize_t)sizeof(v)) out[i]=v;
+        close(c->fd[i]);
+#endif
+    }
+}
+
+static inline int benchCompareDouble(const void *x, const void *y){
+    double a=*(const double*)x, b=*(const double*)y;
+    return (a>b)-(a<b);
+}
+// p in [0,1] over an already sorted sample array
+static inline double benchPercentile(const double *sorted, size_t n, double p){
+    if(n==0) return 0;
+    size_t i=(size_t)(p*(double)(n-1)+0.5);
+    return sorted[i<n ? i : n-1];
+}
+
+// Runs one case: one warm-up pass, then samples of `batch` operations timed individually
+static inline struct BenchResult benchMeasure(const struct BenchConfig *cfg, const struct BenchCase *bc){
+    struct BenchResult r;
+    memset(&r,0,sizeof(r));
+    r.name=bc->name; r.n=bc->n;
+    size_t ops=bc->ops ? bc->ops : cfg->ops;
+    unsigned batch=bc->batch ? bc->batch : cfg->batch;
+    if(ops<batch) ops=batch;
+    size_t samples=ops/batch; ops=samples*batch; r.ops=ops;
+    double *lat=(double*)malloc(samples*sizeof(double));
+
+    // Warm caches, page tables and branch predictors on a slice of the workload
+    // (a single sample for heavy operations such as whole-array sorts)
+    size_t warm=ops<4096 ? ops : 4096;
+    if(bc->items>1) warm=batch;
+    if(bc->setup) bc->setup(bc->ctx,0,warm);
+    benchSink+=(unsigned long long)bc->run(bc->ctx,0,warm);
+
+    struct BenchCounters pc; benchCountersOpen(&pc);
+    // unsigned, so that hash checksums may wrap around
+    unsigned long long sum=0; double total=0;
+    for(size_t s=0;s<samples;s++){
+        size_t b=s*batch, e=b+batch;
+        if(bc->setup) bc->setup(bc->ctx,b,e);
+        benchCountersEnable(&pc,1);
+        double t0=benchNowNs();
+        sum+=(unsigned long long)bc->run(bc->ctx,b,e);
+        double t1=benchNowNs();
+        benchCountersEnable(&pc,0);
+        lat[s]=(t1-t0)/batch; total+=t1-t0;
+    }
+    benchCountersClose(&pc,r.counters);
+    benchSink+=sum; r.checksum=(long long)sum;
+
+    qsort(lat,samples,sizeof(double),benchCompareDouble);
+    r.nsPerOp=total/(double)ops;
+    r.nsPerItem=r.nsPerOp/(double)(bc->items>1 ? bc->items : 1);
+    r.p50=benchPercentile(lat,samples,0.50);
+    r.p99=benchPercentile(lat,samples,0.99);
+    r.minNs=lat[0]; r.maxNs=lat[samples-1];
+    free(lat);
+    return r;
+}
+
+// Human-readable table on stdout (stderr when JSON goes to stdout), JSON array to cfg->json
+static inline void benchReportBegin(struct BenchReport *rep, const struct BenchConfig *cfg, const char *suite){
+    rep->count=0; rep->json=NULL;
+    if(cfg->json!=NULL){
+        rep->json=strcmp(cfg->json,"-") ? fopen(cfg->json,"w") : stdout;
+        if(rep->json==NULL) perror(cfg->json);
+    }
+    if(rep->json)
+        fprintf(rep->json,"{\"suite\":\"%s\",\"batch\":%u,\"seed\":%u,\"threads\":%d,\"results\":[",suite,cfg->batch,cfg->seed,cfg->threads);
+    FILE *out=rep->json==stdout ? stderr : stdout;
+    fprintf(out,"%-28s %12s %12s %10s %12s %12s %14s %14s\n","routine","n","ns/op","ns/item","p50","p99","cache-miss/op","branch-miss/op");
+}
+static inline void benchReportResult(struct BenchReport *rep, const struct BenchResult *r){
+    FILE *out=rep->json==stdout ? stderr : stdout;
+    fprintf(out,"%-28s %12zu %12.2f %10.3f %12.2f %12.2f",r->name,r->n,r->nsPerOp,r->nsPerItem,r->p50,r->p99);
+    for(int i=1;i<=2;i++){
+        if(r->counters[i]<0) fprintf(out," %14s","n/a");
+        else fprintf(out," %14.3f",(double)r->counters[i]/(double)r->ops);
+    }
+    fprintf(out,"\n"); fflush(out);
+    if(rep->json==NULL) return;
+    fprintf(rep->json,"%s\n{\"name\":\"%s\",\"n\":%zu,\"ops\":%zu,\"ns_per_op\":%.3f,\"ns_per_item\":%.3f,\"p50_ns\":%.3f,\"p99_ns\":%.3f,\"min_ns\":%.3f,\"max_ns\":%.3f",
+        rep->count ? "," : "",r->name,r->n,r->ops,r->nsPerOp,r->nsPerItem,r->p50,r->p99,r->minNs,r->maxNs);
+    for(int i=0;i<BENCH_COUNTERS;i++){
+        if(r->counters[i]<0) fprintf(rep->json,",\"%s\":null",benchCounterNames[i]);
+        else fprintf(rep->json,",\"%s\":%lld",benchCounterNames[i],r->counters[i]);
+    }
+    fprintf(rep->json,",\"checksum\":%lld}",r->checksum);
+    rep->count++;
+}
+static inline void benchReportEnd(struct BenchReport *rep){
+    if(rep->json==NULL) return;
+    fprintf(rep->json,"\n]}\n");
+    if(rep->json!=stdout) fclose(rep->json);
+    else fflush(stdout);
+    rep->json=NULL;
+}
+#endif
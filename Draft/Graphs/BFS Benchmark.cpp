@@ -0,0 +1,180 @@
+// Benchmark for Breadth First Search.c against bfs() of
+// daily/day_003/breadth_first_search_bfs_for_graph_traversal.md, which pops a std::queue over a vector
+// of vectors and keeps the visited set in a std::set. Built as C++ only for that reference.
+// Build: g++ -O2 -pthread -o bfs_bench "BFS Benchmark.cpp"
+// Run:   ./bfs_bench --min 65536 --max 16777216 --threads 16 --json bfs.json
+// Graphs over n vertices, BFS from a random vertex with edges (ns/item = per stored edge; 1000/ns is MTEPS):
+//   random    undirected, average degree 16
+//   rmat      undirected R-MAT (a=0.57, b=c=0.19, the Graph500 parameters), average degree 16:
+//             skewed degrees, a few huge hubs, many isolated vertices
+//   grid      sqrt(n) x sqrt(n), 4 neighbours: high diameter, where bottom-up never pays
+//   directed  directed random, average out-degree 8; bottom-up reads csrTranspose()
+// Routines:
+//   reference     the daily bfs(), up to BFS_REF_MAX vertices
+//   topdown       bfsRun() forced top-down, one thread
+//   bottomup      bfsRun() forced bottom-up, one thread
+//   hybrid/t<k>   direction-optimizing bfsRun() on a pool of k workers, k = 1, 2, 4, ... --threads
+// The checksum is the number of vertices reached and must match the first row. Every bfsRun() row
+// must also reproduce the levels of the topdown row and give each vertex a parent one level up.
+#include<iostream>
+#include<vector>
+#include<queue>
+#include<set>
+#include"Breadth First Search.c"
+#include"../Benchmark/Benchmark.h"
+
+#define BFS_REF_MAX (1<<20)
+#define BFS_MAX_POOLS 16
+
+// The daily version, with the print of each vertex replaced by a count of them
+int referenceBfs(int startNode, const std::vector<std::vector<int>>& adj) {
+    std::queue<int> q;
+    std::set<int> visited;
+    int count = 0;
+
+    q.push(startNode);
+    visited.insert(startNode);
+
+    while (!q.empty()) {
+        int u = q.front();
+        q.pop();
+        count++;
+
+        for (int v : adj[u]) {
+            if (visited.find(v) == visited.end()) {
+                visited.insert(v);
+                q.push(v);
+            }
+        }
+    }
+    return count;
+}
+
+// R-MAT: each edge picks one quadrant of the adjacency matrix per bit of the vertex ids, then
+// the ids are permuted so that the hubs are not all at the start
+static struct CSRGraph *rmatGraph(int n, int degree, unsigned long long seed){
+    int scale=0;
+    while((1<<scale)<n) scale++;
+    size_t m=(size_t)n*degree/2;
+    int *src=(int*)malloc(m*sizeof(int)), *dst=(int*)malloc(m*sizeof(int)), *perm=(int*)malloc(n*sizeof(int));
+    struct CSRGraph *g=NULL;
+    if(src!=NULL && dst!=NULL && perm!=NULL){
+        for(int v=0;v<n;v++) perm[v]=v;
+        for(int v=n-1;v>0;v--){ int j=(int)(csrRand(&seed)%(unsigned)(v+1)), t=perm[v]; perm[v]=perm[j]; perm[j]=t; }
+        for(size_t k=0;k<m;k++){
+            unsigned u=0, v=0;
+            for(int b=0;b<scale;b++){
+                unsigned r=(unsigned)(csrRand(&seed)%100);   // a: [0,57) b: [57,76) c: [76,95) d: [95,100)
+                u=u<<1|(r>=76); v=v<<1|((r>=57 && r<76) || r>=95);
+            }
+            src[k]=perm[u%(unsigned)n]; dst[k]=perm[v%(unsigned)n];
+        }
+        g=newCSRGraph(n,m,src,dst,NULL,CSR_UNDIRECTED);
+    }
+    else printf("Out of Memory!");
+    free(src); free(dst); free(perm);
+    return g;
+}
+
+struct BFSCtx{
+    const struct CSRGraph *g; const std::vector<std::vector<int> > *adj;
+    struct BFS *b; int source;
+};
+static long long runReference(void *vctx, size_t begin, size_t end){
+    struct BFSCtx *c=(struct BFSCtx*)vctx; (void)begin; (void)end;
+    return referenceBfs(c->source,*c->adj);
+}
+static long long runBFS(void *vctx, size_t begin, size_t end){
+    struct BFSCtx *c=(struct BFSCtx*)vctx; (void)begin; (void)end;
+    if(bfsRun(c->b,&c->source,1)!=0) return -1;
+    long long reached=0;
+    for(int v=0;v<c->g->n;v++) reached+=c->b->dist[v]>=0;
+    return reached;
+}
+// Same levels as the topdown row, and every parent an in-neighbour one level up
+static int checkBFS(const struct BFS *b, const int *levels){
+    const struct CSRGraph *g=b->g;
+    for(int v=0;v<g->n;v++){
+        if(b->dist[v]!=levels[v]) return 0;
+        int p=b->parent[v];
+        if(b->dist[v]<=0){ if(p!=-1) return 0; continue; }
+        if(p<0 || b->dist[p]!=b->dist[v]-1) return 0;
+        int edge=0;
+        for(size_t e=g->off[p];e<g->off[p+1] && !edge;e++) edge=g->to[e]==v;
+        if(!edge) return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    cfg.minN=1<<16; cfg.maxN=1<<22;
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    // one pool per point of the scaling curve
+    struct Pool *full=newPool(cfg.threads), *pools[BFS_MAX_POOLS]; int sizes[BFS_MAX_POOLS], npools=0;
+    if(full==NULL){ printf("Out of Memory!"); return 1; }
+    for(int t=1;t<poolThreads(full) && npools<BFS_MAX_POOLS-1;t*=2){ sizes[npools]=t; pools[npools++]=newPool(t); }
+    sizes[npools]=poolThreads(full); pools[npools++]=full;
+    const char *graphs[]={"random","rmat","grid","directed"};
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"bfs");
+    int failed=0;
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        for(int gi=0;gi<4;gi++){
+            int side=1;
+            while((size_t)(side+1)*(side+1)<=n) side++;
+            struct CSRGraph *g=gi==0 ? csrRandomGraph((int)n,16,1,CSR_UNDIRECTED,cfg.seed) :
+                               gi==1 ? rmatGraph((int)n,16,cfg.seed) :
+                               gi==2 ? csrGridGraph(side,1,cfg.seed) : csrRandomGraph((int)n,8,1,CSR_DIRECTED,cfg.seed);
+            struct CSRGraph *gt=gi==3 && g ? csrTranspose(g) : NULL;
+            int *levels=g ? (int*)malloc(g->n*sizeof(int)) : NULL;
+            if(g==NULL || (gi==3 && gt==NULL) || levels==NULL){ printf("Out of Memory!"); return 1; }
+            std::vector<std::vector<int> > adj;
+            if(g->n<=BFS_REF_MAX){
+                adj.resize(g->n);
+                for(int v=0;v<g->n;v++) adj[v].assign(g->to+g->off[v],g->to+g->off[v+1]);
+            }
+            struct BFSCtx ctx={g,&adj,NULL,0};
+            unsigned long long s=benchSeed(cfg.seed);
+            // a source with edges; a graph without any (a 1-vertex grid) starts from vertex 0
+            if(g->m>0) do ctx.source=(int)(benchRand(&s)%(unsigned)g->n); while(g->off[ctx.source+1]==g->off[ctx.source]);
+            size_t reps=g->m ? cfg.ops*16/g->m : 100;
+            if(reps<3) reps=3;
+            if(reps>100) reps=100;
+            int rows=3+npools, refDone=0; long long ref=0;
+            for(int r=0;r<rows;r++){
+                char name[64];
+                const char *routine[]={"reference","topdown","bottomup"};
+                if(r<3) snprintf(name,sizeof(name),"%s/%s",graphs[gi],routine[r]);
+                else snprintf(name,sizeof(name),"%s/hybrid/t%d",graphs[gi],sizes[r-3]);
+                if(r==0 && g->n>BFS_REF_MAX) continue;
+                // the first row and topdown, whose levels the others must match, always run
+                if(!benchSelected(&cfg,name) && refDone && r!=1) continue;
+                if(r>0){
+                    if((ctx.b=newBFS(g,gt,r>=3 ? pools[r-3] : NULL))==NULL){ printf("Out of Memory!"); return 1; }
+                    ctx.b->mode=r==1 ? BFS_TOP_DOWN : r==2 ? BFS_BOTTOM_UP : BFS_HYBRID;
+                }
+                struct BenchCase bc={name,(size_t)g->n,reps,1,r==0 ? runReference : runBFS,NULL,&ctx,g->m};
+                struct BenchResult res=benchMeasure(&cfg,&bc);
+                if(benchSelected(&cfg,name)) benchReportResult(&rep,&res);
+                long long one=res.checksum/(long long)res.ops;
+                if(!refDone){ refDone=1; ref=one; }
+                else if(one!=ref){
+                    fprintf(stderr,"%s: wrong result for n=%zu\n",name,n); failed=1;
+                }
+                if(r==1) memcpy(levels,ctx.b->dist,g->n*sizeof(int));
+                else if(r>1 && !checkBFS(ctx.b,levels)){
+                    fprintf(stderr,"%s: wrong levels or parents for n=%zu\n",name,n); failed=1;
+                }
+                if(r>=3 && benchSelected(&cfg,name))
+                    fprintf(stderr,"%s: %d levels, %d bottom-up\n",name,ctx.b->levels,ctx.b->bottomUp);
+                freeBFS(ctx.b); ctx.b=NULL;
+            }
+            free(levels); freeCSRGraph(gt); freeCSRGraph(g);
+        }
+    }
+    benchReportEnd(&rep);
+    for(int i=0;i<npools;i++) freePool(pools[i]);
+    return failed;
+}
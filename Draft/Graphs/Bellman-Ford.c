@@ -0,0 +1,135 @@
+#ifndef BELLMAN_FORD_C
+#define BELLMAN_FORD_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<limits.h>
+#include"CSR Graph.h"
+// Single-source shortest paths on a CSR graph whose weights may be negative.
+//   bellmanFord()  passes over the vertices in order, relaxing the edges of those whose distance
+//                  changed since their last scan, and stops after the first pass that changes nothing
+//   spfa()         the same relaxations driven by a FIFO queue of changed vertices (Shortest Path
+//                  Faster Algorithm), so a vertex is scanned only when something new reaches it
+// Both return 0, 1 when a negative cycle is reachable from the source (dist is then meaningless
+// and *cycle, when not NULL, is set to a vertex on one, following parent), or -1 for a bad source
+// or no memory. dist[v] is BF_INF for unreachable v; parent (may be NULL) gives a shortest path tree.
+//
+// Negative cycles: the textbook test waits for a change in pass n, or for a path of n edges, which
+// takes about n trips around the cycle, each pushing new distances through the graph. But a cycle
+// of parent links is itself proof of a negative cycle, and it closes on the first trip. Both
+// functions look for one after every n relaxations, O(1) amortized per relaxation, and keep the
+// textbook bound as a backstop.
+#define BF_INF LLONG_MAX
+
+// A vertex on a cycle of parent links, or -1. Walks start at each vertex in turn and stop at a
+// vertex already seen; meeting the current walk closes a cycle. seen has room for n ints.
+static int bfParentCycle(const int *parent, int n, int *seen){
+    memset(seen,0,n*sizeof(int));                  // seen[v]: 1 + the walk that reached v
+    for(int s=0;s<n;s++){
+        int v=s;
+        while(v>=0 && seen[v]==0){ seen[v]=s+1; v=parent[v]; }
+        if(v>=0 && seen[v]==s+1) return v;
+    }
+    return -1;
+}
+
+struct BFState{int *par, *seen, *len, *ring; char *flag; int relaxed;};
+static void bfFree(struct BFState *s, int *parent){
+    if(s->par!=parent) free(s->par);
+    free(s->seen); free(s->len); free(s->ring); free(s->flag);
+}
+static int bfInit(struct BFState *s, int n, int *parent, int queue){
+    memset(s,0,sizeof(*s));
+    s->par=parent ? parent : (int*)malloc(n*sizeof(int));
+    s->seen=(int*)malloc(n*sizeof(int));
+    s->flag=(char*)calloc(n,1);
+    if(queue){ s->len=(int*)malloc(n*sizeof(int)); s->ring=(int*)malloc(n*sizeof(int)); }
+    if(s->par==NULL || s->seen==NULL || s->flag==NULL || (queue && (s->len==NULL || s->ring==NULL))){
+        printf("Out of Memory!"); bfFree(s,parent); return 0;
+    }
+    return 1;
+}
+// Called after each relaxation: 1 when the parent links now hold a cycle, its vertex in *cycle
+static inline int bfCheck(struct BFState *s, int n, int *cycle){
+    if(++s->relaxed<n) return 0;
+    s->relaxed=0;
+    int c=bfParentCycle(s->par,n,s->seen);
+    if(c<0) return 0;
+    if(cycle) *cycle=c;
+    return 1;
+}
+
+static int bellmanFord(const struct CSRGraph *g, int source, long long *dist, int *parent, int *cycle){
+    int n=g->n;
+    struct BFState s;
+    if(source<0 || source>=n) return -1;
+    if(!bfInit(&s,n,parent,0)) return -1;
+    char *changed=s.flag;                       // dist[v] dropped since v's edges were last relaxed
+    for(int v=0;v<n;v++){ dist[v]=BF_INF; s.par[v]=-1; }
+    dist[source]=0; changed[source]=1;
+    int result=0;
+    if(cycle) *cycle=-1;
+    // Without a negative cycle every shortest path has at most n-1 edges, so n-1 passes suffice and
+    // a change in pass n proves a cycle. Relaxing in place lets one pass carry a distance far.
+    for(int pass=0;result==0;pass++){
+        int any=0;
+        for(int u=0;u<n && result==0;u++){
+            if(!changed[u]) continue;
+            changed[u]=0;
+            long long d=dist[u];
+            for(size_t e=g->off[u];e<g->off[u+1];e++){
+                int v=g->to[e];
+                if(d+g->w[e]<dist[v]){
+                    dist[v]=d+g->w[e]; s.par[v]=u;
+                    changed[v]=1; any=1;
+                    if(bfCheck(&s,n,cycle)){ result=1; break; }
+                }
+            }
+        }
+        if(!any || result) break;
+        if(pass>=n-1){
+            if(cycle) *cycle=bfParentCycle(s.par,n,s.seen);
+            result=1;
+        }
+    }
+    bfFree(&s,parent);
+    return result;
+}
+
+// len[v] counts the edges of v's current path; a path of n edges repeats a vertex. Each vertex is
+// in the ring at most once, so n slots suffice.
+static int spfa(const struct CSRGraph *g, int source, long long *dist, int *parent, int *cycle){
+    int n=g->n;
+    struct BFState s;
+    if(source<0 || source>=n) return -1;
+    if(!bfInit(&s,n,parent,1)) return -1;
+    char *queued=s.flag; int *len=s.len, *ring=s.ring;
+    int result=0, head=0, count=1;
+    for(int v=0;v<n;v++){ dist[v]=BF_INF; s.par[v]=-1; }
+    dist[source]=0; len[source]=0;
+    ring[0]=source; queued[source]=1;
+    if(cycle) *cycle=-1;
+    while(count>0 && result==0){
+        int u=ring[head]; if(++head==n) head=0;
+        count--; queued[u]=0;
+        long long d=dist[u];
+        for(size_t e=g->off[u];e<g->off[u+1];e++){
+            int v=g->to[e];
+            if(d+g->w[e]<dist[v]){
+                dist[v]=d+g->w[e]; s.par[v]=u; len[v]=len[u]+1;
+                if(bfCheck(&s,n,cycle)){ result=1; break; }
+                if(len[v]>=n){
+                    if(cycle) *cycle=bfParentCycle(s.par,n,s.seen);
+                    result=1; break;
+                }
+                if(!queued[v]){
+                    int tail=head+count; if(tail>=n) tail-=n;
+                    ring[tail]=v; queued[v]=1; count++;
+                }
+            }
+        }
+    }
+    bfFree(&s,parent);
+    return result;
+}
+#endif
@@ -0,0 +1,232 @@
+#ifndef BREADTH_FIRST_SEARCH_C
+#define BREADTH_FIRST_SEARCH_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include"CSR Graph.h"
+#include"../Parallel/Work-Stealing Pool.h"
+// Direction-optimizing parallel BFS on a CSR graph (Beamer, Asanovic and Patterson), level by level:
+//   top-down   every frontier vertex scans its out-edges for unvisited vertices. The frontier is
+//              an array; each worker appends what it discovers to its own list, and the lists
+//              are concatenated into the next frontier. Claiming a vertex is one atomic OR on the
+//              visited bitmap, tried only after a plain read finds it unvisited.
+//   bottom-up  every unvisited vertex scans its in-edges for a parent in the frontier and stops at
+//              the first one. The frontier and the visited set are bitmaps, and each worker owns
+//              whole 64-vertex words of them, so this step has no atomics at all.
+// On low-diameter graphs a few middle levels hold most of the vertices. Top-down then checks
+// nearly every edge, while bottom-up stops early for most vertices. BFS_HYBRID switches to bottom-up
+// when a growing frontier has more out-edges than the unexplored vertices have / alpha, and back when a
+// shrinking frontier falls below n / beta vertices. Requiring growth keeps a high-diameter graph,
+// whose unexplored edges run out near the end, from flipping back and forth.
+//
+//   struct BFS *b=newBFS(g,NULL,pool);        // directed graphs also need csrTranspose(g)
+//   bfsRun(b,sources,ns);                     // b->dist[v] (-1 unreached), b->parent[v]
+//   freeBFS(b);
+#define BFS_ALPHA 15
+#define BFS_BETA 18
+#define BFS_GRAIN 1024          // frontier vertices per task top-down
+#define BFS_WORDS 16            // bitmap words (64 vertices each) per task bottom-up
+
+enum BFSDirection{BFS_HYBRID, BFS_TOP_DOWN, BFS_BOTTOM_UP};
+
+struct BFSWorker{
+    int *a; size_t n, cap, at;              // vertices discovered top-down; at: offset in the next frontier
+    long long found, degree;                // vertices discovered this level, their out-edges
+    char pad[POOL_LINE];                    // workers write their own entry only
+};
+struct BFS{
+    const struct CSRGraph *g, *gt;          // out-edges, in-edges (gt==g when undirected)
+    struct Pool *pool; int threads;
+    int *dist;                              // level, -1 when unreached
+    int *parent;                            // vertex it was discovered from, -1 for sources and unreached
+    unsigned long long *visited, *front, *next; size_t words;
+    int *queue; size_t nq;                  // the frontier as an array, while top-down
+    struct BFSWorker *workers;
+    int level;                              // being expanded
+    enum BFSDirection mode; int alpha, beta;
+    int levels, bottomUp;                   // levels of the last run, and how many ran bottom-up
+    int failed;                             // a worker ran out of memory
+};
+
+static void freeBFS(struct BFS *b){
+    if(b==NULL) return;
+    if(b->workers) for(int t=0;t<b->threads;t++) free(b->workers[t].a);
+    free(b->workers); free(b->dist); free(b->parent);
+    free(b->visited); free(b->front); free(b->next); free(b->queue); free(b);
+}
+// gt holds the in-edges (csrTranspose(g)); NULL when g is undirected. pool may be NULL (one thread)
+static struct BFS *newBFS(const struct CSRGraph *g, const struct CSRGraph *gt, struct Pool *pool){
+    struct BFS *b=(struct BFS*)calloc(1,sizeof(struct BFS));
+    size_t n=g->n ? g->n : 1;
+    if(b==NULL) goto fail;
+    b->g=g; b->gt=gt ? gt : g; b->pool=pool; b->threads=poolThreads(pool);
+    b->mode=BFS_HYBRID; b->alpha=BFS_ALPHA; b->beta=BFS_BETA;
+    b->words=(n+63)/64;
+    b->dist=(int*)malloc(n*sizeof(int)); b->parent=(int*)malloc(n*sizeof(int)); b->queue=(int*)malloc(n*sizeof(int));
+    b->visited=(unsigned long long*)malloc(b->words*sizeof(unsigned long long));
+    b->front=(unsigned long long*)malloc(b->words*sizeof(unsigned long long));
+    b->next=(unsigned long long*)malloc(b->words*sizeof(unsigned long long));
+    b->workers=(struct BFSWorker*)calloc(b->threads,sizeof(struct BFSWorker));
+    if(b->dist==NULL || b->parent==NULL || b->queue==NULL || b->visited==NULL || b->front==NULL ||
+       b->next==NULL || b->workers==NULL) goto fail;
+    return b;
+fail:
+    printf("Out of Memory!");
+    freeBFS(b);
+    return NULL;
+}
+
+static inline int bfsPush(struct BFSWorker *me, int v){
+    if(me->n==me->cap){
+        size_t cap=me->cap ? 2*me->cap : 256;
+        int *a=(int*)realloc(me->a,cap*sizeof(int));
+        if(a==NULL) return 0;
+        me->a=a; me->cap=cap;
+    }
+    me->a[me->n++]=v;
+    return 1;
+}
+static inline struct BFSWorker *bfsSelf(struct BFS *b){
+    return &b->workers[poolIndex(b->pool)];
+}
+static inline long long bfsDegree(const struct CSRGraph *g, int v){
+    return (long long)(g->off[v+1]-g->off[v]);
+}
+static void bfsTopDownBody(void *arg, size_t begin, size_t end){
+    struct BFS *b=(struct BFS*)arg;
+    struct BFSWorker *me=bfsSelf(b);
+    const struct CSRGraph *g=b->g;
+    for(size_t i=begin;i<end;i++){
+        int u=b->queue[i];
+        for(size_t e=g->off[u];e<g->off[u+1];e++){
+            int v=g->to[e];
+            unsigned long long bit=1ULL<<(v&63), *word=&b->visited[v>>6];
+            if(__atomic_load_n(word,__ATOMIC_RELAXED)&bit) continue;
+            if(__atomic_fetch_or(word,bit,__ATOMIC_RELAXED)&bit) continue;   // another worker won
+            b->dist[v]=b->level+1; b->parent[v]=u;
+            me->found++; me->degree+=bfsDegree(g,v);
+            if(!bfsPush(me,v)) __atomic_store_n(&b->failed,1,__ATOMIC_RELAXED);
+        }
+    }
+}
+// [begin,end) are bitmap words, so each word of visited and next has one writer
+static void bfsBottomUpBody(void *arg, size_t begin, size_t end){
+    struct BFS *b=(struct BFS*)arg;
+    struct BFSWorker *me=bfsSelf(b);
+    const struct CSRGraph *gt=b->gt;
+    for(size_t w=begin;w<end;w++){
+        unsigned long long todo=~b->visited[w], add=0;
+        while(todo){
+            int bit=__builtin_ctzll(todo), v=(int)(w*64)+bit;
+            todo&=todo-1;
+            for(size_t e=gt->off[v];e<gt->off[v+1];e++){
+                int u=gt->to[e];
+                if(b->front[u>>6]>>(u&63)&1){
+                    b->dist[v]=b->level+1; b->parent[v]=u; add|=1ULL<<bit;
+                    me->found++; me->degree+=bfsDegree(b->g,v);
+                    break;
+                }
+            }
+        }
+        b->visited[w]|=add; b->next[w]=add;
+    }
+}
+static void bfsToBitmapBody(void *arg, size_t begin, size_t end){
+    struct BFS *b=(struct BFS*)arg;
+    for(size_t i=begin;i<end;i++){
+        int v=b->queue[i];
+        __atomic_fetch_or(&b->front[v>>6],1ULL<<(v&63),__ATOMIC_RELAXED);
+    }
+}
+static void bfsToQueueBody(void *arg, size_t begin, size_t end){
+    struct BFS *b=(struct BFS*)arg;
+    struct BFSWorker *me=bfsSelf(b);
+    for(size_t w=begin;w<end;w++)
+        for(unsigned long long bits=b->front[w];bits;bits&=bits-1)
+            if(!bfsPush(me,(int)(w*64)+__builtin_ctzll(bits))) __atomic_store_n(&b->failed,1,__ATOMIC_RELAXED);
+}
+static void bfsCopyBody(void *arg, size_t begin, size_t end){
+    struct BFS *b=(struct BFS*)arg;
+    for(size_t t=begin;t<end;t++)
+        if(b->workers[t].n) memcpy(b->queue+b->workers[t].at,b->workers[t].a,b->workers[t].n*sizeof(int));
+}
+// Concatenates the workers' lists into the frontier array
+static void bfsGather(struct BFS *b){
+    size_t at=0;
+    for(int t=0;t<b->threads;t++){ b->workers[t].at=at; at+=b->workers[t].n; }
+    poolParallelFor(b->pool,0,(size_t)b->threads,1,bfsCopyBody,b);
+    for(int t=0;t<b->threads;t++) b->workers[t].n=0;
+    b->nq=at;
+}
+static void bfsResetBody(void *arg, size_t begin, size_t end){
+    struct BFS *b=(struct BFS*)arg;
+    for(size_t v=begin;v<end;v++){ b->dist[v]=-1; b->parent[v]=-1; }
+}
+// Runs on the pool: each poolParallelFor inside it forks onto the workers already running
+static void bfsRoot(void *arg){
+    struct BFS *b=(struct BFS*)arg;
+    size_t n=(size_t)b->g->n;
+    long long nf=(long long)b->nq, prev=0, mf=0, mu=(long long)b->g->m;
+    for(size_t i=0;i<b->nq;i++) mf+=bfsDegree(b->g,b->queue[i]);
+    mu-=mf;
+    int topDown=1;
+    for(b->level=0;nf>0 && !b->failed;b->level++){
+        if(b->mode==BFS_HYBRID ? topDown && mf>mu/b->alpha && nf>prev : b->mode==BFS_BOTTOM_UP && topDown){
+            memset(b->front,0,b->words*sizeof(unsigned long long));
+            poolParallelFor(b->pool,0,b->nq,BFS_GRAIN,bfsToBitmapBody,b);
+            topDown=0;
+        }
+        else if(b->mode==BFS_HYBRID && !topDown && nf<(long long)n/b->beta && nf<prev){
+            poolParallelFor(b->pool,0,b->words,BFS_WORDS,bfsToQueueBody,b);
+            bfsGather(b);
+            topDown=1;
+        }
+        for(int t=0;t<b->threads;t++){ b->workers[t].found=0; b->workers[t].degree=0; }
+        if(topDown){
+            poolParallelFor(b->pool,0,b->nq,BFS_GRAIN,bfsTopDownBody,b);
+            bfsGather(b);
+        }
+        else{
+            poolParallelFor(b->pool,0,b->words,BFS_WORDS,bfsBottomUpBody,b);
+            unsigned long long *t=b->front; b->front=b->next; b->next=t;
+            b->bottomUp++;
+        }
+        prev=nf; nf=0; mf=0;
+        for(int t=0;t<b->threads;t++){ nf+=b->workers[t].found; mf+=b->workers[t].degree; }
+        mu-=mf;
+        b->levels++;
+    }
+}
+// Levels and parents from the ns sources, all at level 0, into b->dist and b->parent; 0, or -1
+// for a bad source or no memory
+static int bfsRun(struct BFS *b, const int *sources, int ns){
+    int n=b->g->n;
+    for(int i=0;i<ns;i++) if(sources[i]<0 || sources[i]>=n) return -1;
+    b->failed=0; b->levels=0; b->bottomUp=0; b->nq=0;
+    for(int t=0;t<b->threads;t++) b->workers[t].n=0;
+    poolParallelFor(b->pool,0,(size_t)n,65536,bfsResetBody,b);
+    memset(b->visited,0,b->words*sizeof(unsigned long long));
+    // the ids past n in the last word count as visited, so bottom-up never looks at them
+    if(n%64) b->visited[b->words-1]=~0ULL<<(n%64);
+    for(int i=0;i<ns;i++){
+        int s=sources[i];
+        if(b->visited[s>>6]>>(s&63)&1) continue;             // listed twice
+        b->visited[s>>6]|=1ULL<<(s&63);
+        b->dist[s]=0; b->queue[b->nq++]=s;
+    }
+    poolRun(b->pool,bfsRoot,b);
+    return b->failed ? -1 : 0;
+}
+// One-shot version into the caller's arrays (parent may be NULL); 0, or -1 for a bad source or no memory
+static inline int bfs(const struct CSRGraph *g, const struct CSRGraph *gt, int source, int *dist, int *parent, struct Pool *pool){
+    struct BFS *b=newBFS(g,gt,pool);
+    if(b==NULL) return -1;
+    int r=bfsRun(b,&source,1);
+    if(r==0){
+        memcpy(dist,b->dist,g->n*sizeof(int));
+        if(parent) memcpy(parent,b->parent,g->n*sizeof(int));
+    }
+    freeBFS(b);
+    return r;
+}
+#endif
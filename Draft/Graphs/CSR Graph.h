@@ -0,0 +1,144 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+// Compressed sparse row graph shared by the graph programs in Draft/Graphs.
+// The edges leaving v are to[off[v]..off[v+1]) with weights w[] at the same positions: one array
+// of offsets and two of edges, instead of a vector (and an allocation) per vertex. Scanning the
+// neighbours of a vertex reads contiguous memory, and the whole graph is three mallocs.
+//
+//   struct CSRGraph *g=newCSRGraph(n,m,src,dst,w,CSR_UNDIRECTED);   // w may be NULL: all weights 1
+//   for(size_t e=g->off[v];e<g->off[v+1];e++) visit(g->to[e],g->w[e]);
+//   freeCSRGraph(g);
+// csrRandomGraph() and csrGridGraph() make the synthetic graphs of the benchmarks.
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+
+#define CSR_DIRECTED 0
+#define CSR_UNDIRECTED 1        // every edge is stored in both directions
+
+struct CSRGraph{
+    int n;                      // vertices 0..n-1
+    size_t m;                   // stored (directed) edges
+    size_t *off;                // n+1 offsets into to and w
+    int *to, *w;
+    int minW, maxW;             // weight range, 0 and 0 without edges
+};
+
+static inline void freeCSRGraph(struct CSRGraph *g){
+    if(g==NULL) return;
+    free(g->off); free(g->to); free(g->w); free(g);
+}
+// Builds the graph of the m edges src[i]->dst[i] of weight w[i] with a counting sort by source,
+// so the edges of a vertex keep their input order. NULL when out of memory or a vertex is out of range.
+static inline struct CSRGraph *newCSRGraph(int n, size_t m, const int *src, const int *dst, const int *w, int flags){
+    size_t stored=flags&CSR_UNDIRECTED ? 2*m : m;
+    struct CSRGraph *g=(struct CSRGraph*)calloc(1,sizeof(struct CSRGraph));
+    if(g==NULL) goto fail;
+    g->n=n; g->m=stored;
+    g->off=(size_t*)calloc((size_t)n+1,sizeof(size_t));
+    g->to=(int*)malloc((stored ? stored : 1)*sizeof(int));
+    g->w=(int*)malloc((stored ? stored : 1)*sizeof(int));
+    if(g->off==NULL || g->to==NULL || g->w==NULL) goto fail;
+    for(size_t i=0;i<m;i++){
+        if(src[i]<0 || src[i]>=n || dst[i]<0 || dst[i]>=n){ freeCSRGraph(g); return NULL; }
+        g->off[src[i]+1]++;
+        if(flags&CSR_UNDIRECTED) g->off[dst[i]+1]++;
+    }
+    for(int v=0;v<n;v++) g->off[v+1]+=g->off[v];
+    // off[v] is the next free slot of v while filling, then shifted back by one vertex
+    for(size_t i=0;i<m;i++){
+        int wi=w ? w[i] : 1;
+        size_t a=g->off[src[i]]++;
+        g->to[a]=dst[i]; g->w[a]=wi;
+        if(flags&CSR_UNDIRECTED){
+            size_t b=g->off[dst[i]]++;
+            g->to[b]=src[i]; g->w[b]=wi;
+        }
+    }
+    memmove(g->off+1,g->off,(size_t)n*sizeof(size_t));
+    g->off[0]=0;
+    for(size_t e=0;e<stored;e++){
+        if(e==0 || g->w[e]<g->minW) g->minW=g->w[e];
+        if(e==0 || g->w[e]>g->maxW) g->maxW=g->w[e];
+    }
+    return g;
+fail:
+    printf("Out of Memory!");
+    freeCSRGraph(g);
+    return NULL;
+}
+
+// The reverse graph, edge v->u for every u->v with the same weight: the in-edges of each vertex.
+// Undirected graphs are their own transpose. NULL when out of memory
+static inline struct CSRGraph *csrTranspose(const struct CSRGraph *g){
+    struct CSRGraph *t=(struct CSRGraph*)calloc(1,sizeof(struct CSRGraph));
+    if(t==NULL) goto fail;
+    t->n=g->n; t->m=g->m; t->minW=g->minW; t->maxW=g->maxW;
+    t->off=(size_t*)calloc((size_t)g->n+1,sizeof(size_t));
+    t->to=(int*)malloc((g->m ? g->m : 1)*sizeof(int));
+    t->w=(int*)malloc((g->m ? g->m : 1)*sizeof(int));
+    if(t->off==NULL || t->to==NULL || t->w==NULL) goto fail;
+    for(size_t e=0;e<g->m;e++) t->off[g->to[e]+1]++;
+    for(int v=0;v<g->n;v++) t->off[v+1]+=t->off[v];
+    // same counting sort as newCSRGraph(): sources come out in increasing order
+    for(int u=0;u<g->n;u++)
+        for(size_t e=g->off[u];e<g->off[u+1];e++){
+            size_t a=t->off[g->to[e]]++;
+            t->to[a]=u; t->w[a]=g->w[e];
+        }
+    memmove(t->off+1,t->off,(size_t)g->n*sizeof(size_t));
+    t->off[0]=0;
+    return t;
+fail:
+    printf("Out of Memory!");
+    freeCSRGraph(t);
+    return NULL;
+}
+
+// splitmix64, so a graph depends only on its seed
+static inline unsigned long long csrRand(unsigned long long *s){
+    unsigned long long z=(*s+=0x9e3779b97f4a7c15ULL);
+    z=(z^(z>>30))*0xbf58476d1ce4e5b9ULL;
+    z=(z^(z>>27))*0x94d049bb133111ebULL;
+    return z^(z>>31);
+}
+// n vertices, each joined to a random earlier one (so the graph is connected when undirected),
+// plus random edges up to n*degree/2 in all; weights uniform in [1,maxW]. NULL, without the
+// out-of-memory message, when n or maxW is below 1 or degree is negative.
+static inline struct CSRGraph *csrRandomGraph(int n, int degree, int maxW, int flags, unsigned long long seed){
+    if(n<1 || maxW<1 || degree<0) return NULL;
+    size_t m=(size_t)n*(size_t)degree/2, k=0;
+    if(m<(size_t)n) m=n;
+    int *src=(int*)malloc(m*sizeof(int)), *dst=(int*)malloc(m*sizeof(int)), *w=(int*)malloc(m*sizeof(int));
+    struct CSRGraph *g=NULL;
+    if(src!=NULL && dst!=NULL && w!=NULL){
+        for(int v=1;v<n;v++,k++){ src[k]=(int)(csrRand(&seed)%(unsigned)v); dst[k]=v; }
+        for(;k<m;k++){ src[k]=(int)(csrRand(&seed)%(unsigned)n); dst[k]=(int)(csrRand(&seed)%(unsigned)n); }
+        for(k=0;k<m;k++) w[k]=1+(int)(csrRand(&seed)%(unsigned)maxW);
+        g=newCSRGraph(n,m,src,dst,w,flags);
+    }
+    else printf("Out of Memory!");
+    free(src); free(dst); free(w);
+    return g;
+}
+// side x side grid, 4 neighbours per vertex, undirected: a stand-in for a road network, with a
+// diameter of 2*side instead of the O(log n) of a random graph. NULL when side or maxW is below 1.
+static inline struct CSRGraph *csrGridGraph(int side, int maxW, unsigned long long seed){
+    if(side<1 || maxW<1) return NULL;
+    size_t m=2*(size_t)side*(size_t)side, k=0;
+    int *src=(int*)malloc(m*sizeof(int)), *dst=(int*)malloc(m*sizeof(int)), *w=(int*)malloc(m*sizeof(int));
+    struct CSRGraph *g=NULL;
+    if(src!=NULL && dst!=NULL && w!=NULL){
+        for(int r=0;r<side;r++)
+            for(int c=0;c<side;c++){
+                int v=r*side+c;
+                if(c+1<side){ src[k]=v; dst[k]=v+1; w[k++]=1+(int)(csrRand(&seed)%(unsigned)maxW); }
+                if(r+1<side){ src[k]=v; dst[k]=v+side; w[k++]=1+(int)(csrRand(&seed)%(unsigned)maxW); }
+            }
+        g=newCSRGraph(side*side,k,src,dst,w,CSR_UNDIRECTED);
+    }
+    else printf("Out of Memory!");
+    free(src); free(dst); free(w);
+    return g;
+}
+#endif
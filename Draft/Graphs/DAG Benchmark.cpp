@@ -0,0 +1,274 @@
+// Benchmark for Topological Sort.c against topologicalSortKahn() of daily/day_002/topological_sort.md,
+// which counts in-degrees over a vector of vectors and pops a std::queue. Built as C++ only for that reference.
+// Build: g++ -O2 -pthread -o dag_bench "DAG Benchmark.cpp"
+// Run:   ./dag_bench --min 1048576 --max 16777216 --threads 16 --json dag.json
+// DAGs over n nodes, ids shuffled (ns/item = per node):
+//   random   each node waits for 4 random earlier nodes: about 100 levels, thousands of nodes wide
+//   layered  layers of DAG_WIDTH nodes, each waiting for 4 random nodes of the layer before
+//   deep     each node waits for 2 of the 16 nodes before it: n/8 or so levels a few nodes wide
+// Each node is a job of cost 1..32 units of DAG_UNIT dependent multiply-adds.
+// Routines:
+//   sort/reference        the daily topologicalSortKahn()
+//   sort/levels/t<k>      topoLevels() on a pool of k workers, k = 1, 2, 4, ... --threads
+//   exec/reference        the jobs one after the other in the order of the daily topologicalSortKahn()
+//   exec/levels/t<k>      topoExecuteLevels(): each level a parallel loop, barrier between levels
+//   exec/dataflow/t<k>    topoExecute(): each job as soon as its last predecessor is done
+// sort rows check that every edge goes forward in their order and report the number of nodes
+// ordered; exec rows check that every job ran after its predecessors and report the sum of the job
+// results. Both must match the first row of their group. Untimed, each DAG also reports its
+// critical path (checked edge by edge against the costs) and, with one edge closing it into a
+// cycle, the cycle both the reference (empty order) and topoLevels() must detect. topoExecute()
+// on the cyclic DAG must return 1 with a cycle, block as many nodes as topoLevels() and run
+// every other job exactly once.
+#include<iostream>
+#include<vector>
+#include<queue>
+#include<map>
+#include"Topological Sort.c"
+#include"../Benchmark/Benchmark.h"
+
+#define DAG_MAX_POOLS 16
+#define DAG_WIDTH 4096
+#define DAG_UNIT 4
+#define DAG_EXEC_GRAIN 16       // jobs per task of topoExecuteLevels()
+
+// The daily version
+std::vector<int> topologicalSortKahn(int numNodes, const std::vector<std::vector<int>>& adj)
+{
+    std::vector<int> inDegree(numNodes, 0);
+    for (int u = 0; u < numNodes; ++u)
+    {
+        for (int v : adj[u])
+        {
+            inDegree[v]++;
+        }
+    }
+
+    std::queue<int> q;
+    for (int i = 0; i < numNodes; ++i)
+    {
+        if (inDegree[i] == 0)
+        {
+            q.push(i);
+        }
+    }
+
+    std::vector<int> result;
+    while (!q.empty())
+    {
+        int u = q.front();
+        q.pop();
+        result.push_back(u);
+
+        for (int v : adj[u])
+        {
+            inDegree[v]--;
+            if (inDegree[v] == 0)
+            {
+                q.push(v);
+            }
+        }
+    }
+
+    if ((int)result.size() != numNodes)
+    {
+        // Graph contains a cycle, topological sort not possible
+        return {};
+    }
+    return result;
+}
+
+// Edges in position order, then ids shuffled so that position says nothing about id
+static int dagEdges(int kind, int n, unsigned long long seed, std::vector<int> &src, std::vector<int> &dst){
+    std::vector<int> perm(n);
+    for(int v=0;v<n;v++) perm[v]=v;
+    for(int v=n-1;v>0;v--){ int j=(int)(csrRand(&seed)%(unsigned)(v+1)); std::swap(perm[v],perm[j]); }
+    src.clear(); dst.clear();
+    for(int v=1;v<n;v++){
+        int k=kind==2 ? 2 : 4;
+        for(int i=0;i<k;i++){
+            int u;
+            if(kind==0) u=(int)(csrRand(&seed)%(unsigned)v);
+            else if(kind==1){
+                int layer=v/DAG_WIDTH;
+                if(layer==0) break;
+                u=(layer-1)*DAG_WIDTH+(int)(csrRand(&seed)%DAG_WIDTH);
+            }
+            else u=v-1-(int)(csrRand(&seed)%(unsigned)(v<16 ? v : 16));
+            src.push_back(perm[u]); dst.push_back(perm[v]);
+        }
+    }
+    return (int)src.size();
+}
+
+struct DAGCtx{
+    const struct CSRGraph *g; const std::vector<std::vector<int> > *adj;
+    struct TopoSort *t; const int *cost;
+    long long *out; int *seq; long clock;
+    std::vector<int> order;
+};
+static void dagJob(void *arg, int v){
+    struct DAGCtx *c=(struct DAGCtx*)arg;
+    unsigned long long x=(unsigned long long)v+1;
+    for(int i=0;i<c->cost[v]*DAG_UNIT;i++) x=x*6364136223846793005ULL+1442695040888963407ULL;
+    c->out[v]=(long long)(x>>20);
+    c->seq[v]=(int)__atomic_fetch_add(&c->clock,1,__ATOMIC_RELAXED);
+}
+static long long dagSum(const struct DAGCtx *c){
+    long long s=0;
+    for(int v=0;v<c->g->n;v++) s+=c->out[v];
+    return s;
+}
+static long long runSortReference(void *vctx, size_t begin, size_t end){
+    struct DAGCtx *c=(struct DAGCtx*)vctx; (void)begin; (void)end;
+    c->order=topologicalSortKahn(c->g->n,*c->adj);
+    for(size_t i=0;i<c->order.size();i++) c->seq[c->order[i]]=(int)i;
+    return (long long)c->order.size();
+}
+static long long runSortLevels(void *vctx, size_t begin, size_t end){
+    struct DAGCtx *c=(struct DAGCtx*)vctx; (void)begin; (void)end;
+    if(topoLevels(c->t,NULL)!=0) return -1;
+    int ordered=c->t->levelOff[c->t->levels];
+    for(int i=0;i<ordered;i++) c->seq[c->t->order[i]]=i;
+    return ordered;
+}
+static long long runExecReference(void *vctx, size_t begin, size_t end){
+    struct DAGCtx *c=(struct DAGCtx*)vctx; (void)begin; (void)end;
+    std::vector<int> order=topologicalSortKahn(c->g->n,*c->adj);
+    c->clock=0;
+    for(size_t i=0;i<order.size();i++) dagJob(c,order[i]);
+    return dagSum(c);
+}
+static long long runExecLevels(void *vctx, size_t begin, size_t end){
+    struct DAGCtx *c=(struct DAGCtx*)vctx; (void)begin; (void)end;
+    c->clock=0;
+    if(topoLevels(c->t,NULL)!=0) return -1;
+    topoExecuteLevels(c->t,dagJob,c,DAG_EXEC_GRAIN);
+    return dagSum(c);
+}
+static long long runExecDataflow(void *vctx, size_t begin, size_t end){
+    struct DAGCtx *c=(struct DAGCtx*)vctx; (void)begin; (void)end;
+    c->clock=0;
+    if(topoExecute(c->t,dagJob,c)!=0) return -1;
+    return dagSum(c);
+}
+static void setupExec(void *vctx, size_t begin, size_t end){
+    struct DAGCtx *c=(struct DAGCtx*)vctx; (void)begin; (void)end;
+    memset(c->seq,-1,c->g->n*sizeof(int));
+}
+// Every node numbered, and every edge from a smaller number to a larger one
+static int checkOrder(const struct CSRGraph *g, const int *seq){
+    for(int u=0;u<g->n;u++){
+        if(seq[u]<0) return 0;
+        for(size_t e=g->off[u];e<g->off[u+1];e++) if(seq[g->to[e]]<=seq[u]) return 0;
+    }
+    return 1;
+}
+// Job of the cyclic run: counts the jobs run, and how often each node ran
+struct DAGCount{long ran; int *times;};
+static void dagCountJob(void *arg, int v){
+    struct DAGCount *c=(struct DAGCount*)arg;
+    __atomic_fetch_add(&c->ran,1,__ATOMIC_RELAXED);
+    __atomic_fetch_add(&c->times[v],1,__ATOMIC_RELAXED);
+}
+static int hasEdge(const struct CSRGraph *g, int u, int v){
+    for(size_t e=g->off[u];e<g->off[u+1];e++) if(g->to[e]==v) return 1;
+    return 0;
+}
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    cfg.minN=1<<20; cfg.maxN=1<<22;
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    // one pool per point of the scaling curve
+    struct Pool *full=newPool(cfg.threads), *pools[DAG_MAX_POOLS]; int sizes[DAG_MAX_POOLS], npools=0;
+    if(full==NULL){ printf("Out of Memory!"); return 1; }
+    for(int t=1;t<poolThreads(full) && npools<DAG_MAX_POOLS-1;t*=2){ sizes[npools]=t; pools[npools++]=newPool(t); }
+    sizes[npools]=poolThreads(full); pools[npools++]=full;
+    const char *graphs[]={"random","layered","deep"};
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"dag");
+    int failed=0;
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        for(int gi=0;gi<3;gi++){
+            std::vector<int> src, dst;
+            int m=dagEdges(gi,(int)n,benchSeed(cfg.seed),src,dst);
+            struct CSRGraph *g=newCSRGraph((int)n,m,src.data(),dst.data(),NULL,CSR_DIRECTED);
+            int *cost=(int*)malloc(n*sizeof(int)), *seq=(int*)malloc(n*sizeof(int)), *path=(int*)malloc(n*sizeof(int));
+            long long *out=(long long*)malloc(n*sizeof(long long));
+            struct TopoSort *t=g ? newTopoSort(g,NULL) : NULL;
+            if(g==NULL || cost==NULL || seq==NULL || path==NULL || out==NULL || t==NULL){ printf("Out of Memory!"); return 1; }
+            unsigned long long s=benchSeed(cfg.seed+1);
+            long long work=0;
+            for(size_t v=0;v<n;v++){ cost[v]=1+(int)(benchRand(&s)%32); work+=cost[v]; }
+            std::vector<std::vector<int> > adj(n);
+            for(int v=0;v<g->n;v++) adj[v].assign(g->to+g->off[v],g->to+g->off[v+1]);
+            struct DAGCtx ctx;
+            ctx.g=g; ctx.adj=&adj; ctx.t=NULL; ctx.cost=cost; ctx.out=out; ctx.seq=seq; ctx.clock=0;
+
+            // untimed: critical path, then the same DAG closed into a cycle
+            if(topoLevels(t,cost)!=0){ fprintf(stderr,"%s: cycle reported in a DAG\n",graphs[gi]); failed=1; }
+            else{
+                int k=topoCriticalPath(t,path); long long sum=0; int ok=k>0;
+                for(int i=0;i<k;i++){ sum+=cost[path[i]]; if(i>0 && !hasEdge(g,path[i-1],path[i])) ok=0; }
+                if(!ok || sum!=t->span){ fprintf(stderr,"%s: wrong critical path for n=%zu\n",graphs[gi],n); failed=1; }
+                else if(benchSelected(&cfg,graphs[gi]))
+                    fprintf(stderr,"%s: n=%zu, %d levels, critical path of %d nodes and %lld units, work/span %.0f\n",
+                            graphs[gi],n,t->levels,k,t->span,(double)work/(double)t->span);
+                src.push_back(path[k-1]); dst.push_back(path[0]);
+                struct CSRGraph *cyclic=newCSRGraph((int)n,m+1,src.data(),dst.data(),NULL,CSR_DIRECTED);
+                struct TopoSort *ct=cyclic ? newTopoSort(cyclic,NULL) : NULL;
+                if(ct==NULL){ printf("Out of Memory!"); return 1; }
+                std::vector<std::vector<int> > cadj=adj;
+                cadj[path[k-1]].push_back(path[0]);
+                int found=topoLevels(ct,NULL)==1 && ct->ncycle>0 && topologicalSortKahn((int)n,cadj).empty();
+                for(int i=0;found && i<ct->ncycle;i++) found=hasEdge(cyclic,ct->cycle[i],ct->cycle[(i+1)%ct->ncycle]);
+                if(!found){ fprintf(stderr,"%s: cycle not found for n=%zu\n",graphs[gi],n); failed=1; }
+                else if(benchSelected(&cfg,graphs[gi]))
+                    fprintf(stderr,"%s: closing edge makes a cycle of %d nodes, %d nodes blocked\n",graphs[gi],ct->ncycle,ct->blocked);
+                // the blocked nodes are the cycle and everything after it: the same for topoExecute()
+                struct TopoSort *et=newTopoSort(cyclic,full);
+                struct DAGCount count={0,seq};
+                if(et==NULL){ printf("Out of Memory!"); return 1; }
+                memset(seq,0,n*sizeof(int));
+                int ran=topoExecute(et,dagCountJob,&count)==1 && et->ncycle>0 && et->blocked==ct->blocked && count.ran==(long)n-et->blocked;
+                for(int i=0;ran && i<et->ncycle;i++) ran=hasEdge(cyclic,et->cycle[i],et->cycle[(i+1)%et->ncycle]);
+                for(size_t v=0;ran && v<n;v++) ran=seq[v]<=1;
+                if(!ran){ fprintf(stderr,"%s: topoExecute() ran the wrong jobs of a cyclic DAG for n=%zu\n",graphs[gi],n); failed=1; }
+                freeTopoSort(et); freeTopoSort(ct); freeCSRGraph(cyclic);
+            }
+
+            // rows: sort/reference, sort/levels/t*, exec/reference, exec/levels/t*, exec/dataflow/t*
+            int rows=2+3*npools, refDone=0; long long ref=0;
+            for(int r=0;r<rows;r++){
+                char name[64]; int pi=-1;
+                long long (*run)(void*,size_t,size_t);
+                if(r==0){ snprintf(name,sizeof(name),"%s/sort/reference",graphs[gi]); run=runSortReference; }
+                else if(r<=npools){ pi=r-1; snprintf(name,sizeof(name),"%s/sort/levels/t%d",graphs[gi],sizes[pi]); run=runSortLevels; }
+                else if(r==npools+1){ snprintf(name,sizeof(name),"%s/exec/reference",graphs[gi]); run=runExecReference; refDone=0; }
+                else if(r<=2*npools+1){ pi=r-npools-2; snprintf(name,sizeof(name),"%s/exec/levels/t%d",graphs[gi],sizes[pi]); run=runExecLevels; }
+                else{ pi=r-2*npools-2; snprintf(name,sizeof(name),"%s/exec/dataflow/t%d",graphs[gi],sizes[pi]); run=runExecDataflow; }
+                // the first row of each group always runs
+                if(!benchSelected(&cfg,name) && refDone) continue;
+                if(pi>=0 && (ctx.t=newTopoSort(g,pools[pi]))==NULL){ printf("Out of Memory!"); return 1; }
+                struct BenchCase bc={name,n,3,1,run,setupExec,&ctx,n};
+                struct BenchResult res=benchMeasure(&cfg,&bc);
+                if(benchSelected(&cfg,name)) benchReportResult(&rep,&res);
+                long long one=res.checksum/(long long)res.ops;
+                if(!refDone){ refDone=1; ref=one; }
+                else if(one!=ref){
+                    fprintf(stderr,"%s: wrong result for n=%zu\n",name,n); failed=1;
+                }
+                if(!checkOrder(g,seq)){
+                    fprintf(stderr,"%s: order violates an edge for n=%zu\n",name,n); failed=1;
+                }
+                freeTopoSort(ctx.t); ctx.t=NULL;
+            }
+            freeTopoSort(t); freeCSRGraph(g); free(cost); free(seq); free(path); free(out);
+        }
+    }
+    benchReportEnd(&rep);
+    for(int i=0;i<npools;i++) freePool(pools[i]);
+    return failed;
+}
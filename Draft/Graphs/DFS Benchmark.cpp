@@ -0,0 +1,255 @@
+// Benchmark for Depth First Search.c and Strongly Connected Components.c against dfsRecursive() of
+// daily/day_003/depth_first_search_dfs_for_graph_traversal.md (recursion, visited in a std::set) and
+// findSCCs()/tarjanSCC() of daily/day_003/tarjan_s_algorithm_for_strongly_connected_components_scc.md
+// (recursion over global arrays). Built as C++ only for those references.
+// Build: g++ -O2 -pthread -o dfs_bench "DFS Benchmark.cpp"
+// Run:   ./dfs_bench --min 65536 --max 16777216 --threads 16 --json dfs.json
+// Directed graphs over n vertices (ns/item = per edge):
+//   random  out-degree 4: one giant component of 97% of the vertices, the rest mostly alone
+//   sparse  out-degree 1.5: a giant component of a third of the vertices, the rest mostly alone
+//   deep    the path 0->1->...->n-1 with an edge back to the start of every block of 1000: n/1000
+//           components, and a DFS from 0 that is n vertices deep
+// Routines:
+//   dfs/reference       the daily dfsRecursive() from vertex 0, up to DFS_REF_MAX vertices
+//   dfs/iterative       dfsFrom(0)
+//   scc/reference       the daily tarjanSCC(), up to DFS_REF_MAX vertices
+//   scc/tarjan          sccTarjan()
+//   scc/parallel/t<k>   sccParallel() on a pool of k workers, k = 1, 2, 4, ... --threads
+// The checksum is the number of vertices reached or of components and must match the first row
+// of its group. Every SCC row must also find the components of scc/tarjan, and the condensation of
+// those must be a DAG. The references recurse once per vertex on the path, so everything runs on a
+// thread with a DFS_STACK stack.
+#include<iostream>
+#include<vector>
+#include<algorithm>
+#include<stack>
+#include<set>
+#include<pthread.h>
+#include"Depth First Search.c"
+#include"Strongly Connected Components.c"
+#include"../Benchmark/Benchmark.h"
+
+#define DFS_REF_MAX (1<<20)
+#define DFS_MAX_POOLS 16
+#define DFS_STACK ((size_t)1<<30)
+
+// The daily versions. The prints are replaced by counts, and MAXN is raised from 100005 to fit
+// DFS_REF_MAX vertices.
+int dfsCount;
+void dfsRecursive(int u, const std::vector<std::vector<int>>& adj, std::set<int>& visited) {
+    visited.insert(u);
+    dfsCount++;
+
+    for (int v : adj[u]) {
+        if (visited.find(v) == visited.end()) {
+            dfsRecursive(v, adj, visited);
+        }
+    }
+}
+
+const int MAXN = DFS_REF_MAX + 5;
+std::vector<int> adj[MAXN];
+int disc[MAXN]; // Discovery time
+int low[MAXN];  // Lowest discovery time reachable from node or its subtree
+bool onStack[MAXN];
+std::stack<int> s;
+int timer = 0;
+
+void findSCCs(int u, int& sccCount) {
+    disc[u] = low[u] = ++timer;
+    s.push(u);
+    onStack[u] = true;
+
+    for (int v : adj[u]) {
+        if (disc[v] == 0) { // If v is not visited
+            findSCCs(v, sccCount);
+            low[u] = std::min(low[u], low[v]);
+        } else if (onStack[v]) { // If v is visited and on stack, it's a back-edge to an ancestor in current DFS tree
+            low[u] = std::min(low[u], disc[v]);
+        }
+    }
+
+    // If u is the root of an SCC
+    if (low[u] == disc[u]) {
+        sccCount++;
+        while (true) {
+            int node = s.top();
+            s.pop();
+            onStack[node] = false;
+            if (u == node) break;
+        }
+    }
+}
+
+int tarjanSCC(int numNodes) {
+    // Initialize arrays
+    for (int i = 0; i <= numNodes; ++i) {
+        disc[i] = 0;
+        low[i] = 0;
+        onStack[i] = false;
+    }
+    timer = 0;
+    int sccCount = 0;
+
+    for (int i = 1; i <= numNodes; ++i) { // Iterate through all nodes (1-indexed)
+        if (disc[i] == 0) { // If node i not visited, start DFS from it
+            findSCCs(i, sccCount);
+        }
+    }
+    return sccCount;
+}
+
+static struct CSRGraph *deepGraph(int n){
+    size_t m=(size_t)n+n/1000, k=0;
+    int *src=(int*)malloc(m*sizeof(int)), *dst=(int*)malloc(m*sizeof(int));
+    struct CSRGraph *g=NULL;
+    if(src!=NULL && dst!=NULL){
+        for(int v=0;v+1<n;v++){ src[k]=v; dst[k++]=v+1; }
+        for(int v=999;v<n;v+=1000){ src[k]=v; dst[k++]=v-999; }
+        g=newCSRGraph(n,k,src,dst,NULL,CSR_DIRECTED);
+    }
+    else printf("Out of Memory!");
+    free(src); free(dst);
+    return g;
+}
+
+struct DFSCtx{
+    const struct CSRGraph *g, *gt; const std::vector<std::vector<int> > *adj;
+    struct DFS *d; struct Pool *pool; int *comp;
+};
+static long long runDfsReference(void *vctx, size_t begin, size_t end){
+    struct DFSCtx *c=(struct DFSCtx*)vctx; (void)begin; (void)end;
+    std::set<int> visited;
+    dfsCount=0;
+    dfsRecursive(0,*c->adj,visited);
+    return dfsCount;
+}
+static long long runDfs(void *vctx, size_t begin, size_t end){
+    struct DFSCtx *c=(struct DFSCtx*)vctx; (void)begin; (void)end;
+    dfsReset(c->d);
+    return dfsFrom(c->d,0);
+}
+static long long runSccReference(void *vctx, size_t begin, size_t end){
+    struct DFSCtx *c=(struct DFSCtx*)vctx; (void)begin; (void)end;
+    return tarjanSCC(c->g->n);
+}
+static long long runTarjan(void *vctx, size_t begin, size_t end){
+    struct DFSCtx *c=(struct DFSCtx*)vctx; (void)begin; (void)end;
+    return sccTarjan(c->g,c->comp);
+}
+static long long runParallel(void *vctx, size_t begin, size_t end){
+    struct DFSCtx *c=(struct DFSCtx*)vctx; (void)begin; (void)end;
+    return sccParallel(c->g,c->gt,c->comp,c->pool);
+}
+// Same partition as ref: component ids may differ, but must map one to one
+static int sameComponents(const int *a, const int *ref, int n, int count){
+    std::vector<int> to(count,-1), from(count,-1);
+    for(int v=0;v<n;v++){
+        if(a[v]<0 || a[v]>=count) return 0;
+        if(to[ref[v]]<0 && from[a[v]]<0){ to[ref[v]]=a[v]; from[a[v]]=ref[v]; }
+        else if(to[ref[v]]!=a[v] || from[a[v]]!=ref[v]) return 0;
+    }
+    return 1;
+}
+// Tarjan numbers components in reverse topological order, so every edge of the condensation
+// goes to a smaller id, and none repeats
+static int checkCondensation(const struct CSRGraph *dag){
+    std::vector<int> seen(dag->n,-1);
+    for(int c=0;c<dag->n;c++)
+        for(size_t e=dag->off[c];e<dag->off[c+1];e++){
+            if(dag->to[e]>=c || seen[dag->to[e]]==c) return 0;
+            seen[dag->to[e]]=c;
+        }
+    return 1;
+}
+
+static struct BenchConfig cfg;
+static void *benchMain(void *arg){
+    int *failed=(int*)arg;
+    // one pool per point of the scaling curve
+    struct Pool *full=newPool(cfg.threads), *pools[DFS_MAX_POOLS]; int sizes[DFS_MAX_POOLS], npools=0;
+    if(full==NULL){ printf("Out of Memory!"); *failed=1; return NULL; }
+    for(int t=1;t<poolThreads(full) && npools<DFS_MAX_POOLS-1;t*=2){ sizes[npools]=t; pools[npools++]=newPool(t); }
+    sizes[npools]=poolThreads(full); pools[npools++]=full;
+    const char *graphs[]={"random","sparse","deep"};
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"dfs");
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        for(int gi=0;gi<3;gi++){
+            struct CSRGraph *g=gi==0 ? csrRandomGraph((int)n,8,1,CSR_DIRECTED,cfg.seed) :
+                               gi==1 ? csrRandomGraph((int)n,3,1,CSR_DIRECTED,cfg.seed) : deepGraph((int)n);
+            struct CSRGraph *gt=g ? csrTranspose(g) : NULL;
+            int *tarjan=g ? (int*)malloc(g->n*sizeof(int)) : NULL, *comp=g ? (int*)malloc(g->n*sizeof(int)) : NULL;
+            struct DFS *d=g ? newDFS(g) : NULL;
+            if(g==NULL || gt==NULL || tarjan==NULL || comp==NULL || d==NULL){ printf("Out of Memory!"); *failed=1; return NULL; }
+            std::vector<std::vector<int> > vadj;
+            int withRef=g->n<=DFS_REF_MAX;
+            if(withRef){
+                vadj.resize(g->n);
+                for(int v=0;v<g->n;v++){
+                    vadj[v].assign(g->to+g->off[v],g->to+g->off[v+1]);
+                    adj[v+1].clear();
+                    for(size_t e=g->off[v];e<g->off[v+1];e++) adj[v+1].push_back(g->to[e]+1);
+                }
+            }
+            struct DFSCtx ctx={g,gt,&vadj,d,NULL,comp};
+            size_t reps=g->m ? cfg.ops*4/g->m : 100;
+            if(reps<3) reps=3;
+            if(reps>100) reps=100;
+            // rows 0-1 dfs, 2-3 scc references, then the scaling rows
+            int rows=4+npools, refDone=0, tarjanDone=0; long long ref=0;
+            for(int r=0;r<rows;r++){
+                char name[64];
+                const char *routine[]={"dfs/reference","dfs/iterative","scc/reference","scc/tarjan"};
+                if(r<4) snprintf(name,sizeof(name),"%s/%s",graphs[gi],routine[r]);
+                else snprintf(name,sizeof(name),"%s/scc/parallel/t%d",graphs[gi],sizes[r-4]);
+                if(r==2) refDone=0;
+                if((r==0 || r==2) && !withRef) continue;
+                // the first row of each group and scc/tarjan, whose components the others must match, always run
+                if(!benchSelected(&cfg,name) && refDone && r!=3) continue;
+                ctx.pool=r>=4 ? pools[r-4] : NULL;
+                long long (*run)(void*,size_t,size_t)=r==0 ? runDfsReference : r==1 ? runDfs :
+                                                     r==2 ? runSccReference : r==3 ? runTarjan : runParallel;
+                struct BenchCase bc={name,(size_t)g->n,reps,1,run,NULL,&ctx,g->m};
+                struct BenchResult res=benchMeasure(&cfg,&bc);
+                if(benchSelected(&cfg,name)) benchReportResult(&rep,&res);
+                long long one=res.checksum/(long long)res.ops;
+                if(!refDone){ refDone=1; ref=one; }
+                else if(one!=ref){
+                    fprintf(stderr,"%s: wrong result for n=%zu\n",name,n); *failed=1;
+                }
+                if(r==3){
+                    memcpy(tarjan,comp,g->n*sizeof(int)); tarjanDone=1;
+                    struct CSRGraph *dag=sccCondense(g,comp,(int)one);
+                    if(dag==NULL || !checkCondensation(dag)){
+                        fprintf(stderr,"%s: condensation is not a DAG for n=%zu\n",name,n); *failed=1;
+                    }
+                    else if(benchSelected(&cfg,name))
+                        fprintf(stderr,"%s: %lld components, %zu condensation edges\n",name,one,dag->m);
+                    freeCSRGraph(dag);
+                }
+                else if(r>3 && tarjanDone && !sameComponents(comp,tarjan,g->n,(int)one)){
+                    fprintf(stderr,"%s: wrong components for n=%zu\n",name,n); *failed=1;
+                }
+            }
+            freeDFS(d); free(tarjan); free(comp); freeCSRGraph(gt); freeCSRGraph(g);
+        }
+    }
+    benchReportEnd(&rep);
+    for(int i=0;i<npools;i++) freePool(pools[i]);
+    return NULL;
+}
+
+int main(int argc, char **argv){
+    benchDefaults(&cfg);
+    cfg.minN=1<<16; cfg.maxN=1<<22;
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    pthread_attr_t attr; pthread_t th; int failed=0;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr,DFS_STACK);
+    if(pthread_create(&th,&attr,benchMain,&failed)!=0){ printf("Out of Memory!"); return 1; }
+    pthread_join(th,NULL);
+    pthread_attr_destroy(&attr);
+    return failed;
+}
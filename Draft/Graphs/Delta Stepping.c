@@ -0,0 +1,226 @@
+#ifndef DELTA_STEPPING_C
+#define DELTA_STEPPING_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<limits.h>
+#include"CSR Graph.h"
+#include"../Parallel/Work-Stealing Pool.h"
+// Parallel single-source shortest paths for non-negative weights (Meyer and Sanders' delta-stepping).
+// Tentative distances are sorted into buckets of width delta: bucket i holds the vertices with
+// distance in [i*delta,(i+1)*delta). Buckets are settled in order, but all vertices of a bucket are
+// relaxed at once, in parallel, instead of one at a time as in Dijkstra.
+// - Light edges (weight < delta) can put a vertex back into the current bucket, so the bucket is
+//   relaxed in phases until it stays empty. Heavy edges can only reach later buckets, so they are
+//   relaxed once, from every vertex the bucket settled.
+// - Every adjacency list is partitioned light-first once, when the engine is built, so a phase
+//   reads exactly the edges it needs.
+// - Distances drop with a CAS loop. Each worker appends what it improved to its own bins, with no
+//   shared queue; between phases the bins of the current bucket are gathered into one frontier.
+//   A vertex may be binned more than once, and entries whose distance has since fallen into an
+//   earlier bucket are skipped.
+// - While bucket i is settled every new distance lies below (i+1)*delta+maxW, so only buckets i to
+//   i+1+(maxW-1)/delta can be filed into. The bins are a cyclic window of that many buckets,
+//   indexed by bucket mod nbins, and take no more room however far the distances reach.
+// delta trades work for parallelism: delta=1 is Dijkstra with ties relaxed together, delta=maxW
+// relaxes whole wavefronts Bellman-Ford style. 0 picks maxW*n/m, about maxW/degree. delta is
+// raised when the window would need more than DS_MAX_BINS buckets.
+//
+//   struct DeltaStepping *ds=newDeltaStepping(g,0,pool);
+//   deltaSteppingRun(ds,source);             // ds->dist[v], DS_INF when unreachable
+//   freeDeltaStepping(ds);
+#define DS_INF LLONG_MAX
+#define DS_GRAIN 256            // frontier vertices per task
+#define DS_MAX_BINS 65536       // buckets in the window of bins
+
+struct DSVec{int *a; size_t n,cap;};
+struct DSWorker{
+    struct DSVec *bins;                     // bins[i % nbins]: vertices this worker moved into bucket i
+    struct DSVec settled;                   // vertices this worker settled in the current bucket
+    char pad[POOL_LINE];                    // workers write their own entry only
+};
+struct DeltaStepping{
+    const struct CSRGraph *g; struct Pool *pool; int threads;
+    long long delta;
+    int *to, *w; size_t *light;             // edges of v: light in [off[v],light[v]), heavy up to off[v+1]
+    long long *dist;
+    long long *stamp;                       // bucket in which v last joined its worker's settled list
+    struct DSWorker *workers; size_t nbins;
+    struct DSVec frontier;
+    long long bucket;                       // being settled
+    long long phases;                       // parallel steps of the last run
+    int failed;                             // a worker ran out of memory
+};
+
+static inline int dsPush(struct DSVec *v, int x){
+    if(v->n==v->cap){
+        size_t cap=v->cap ? 2*v->cap : 64;
+        int *a=(int*)realloc(v->a,cap*sizeof(int));
+        if(a==NULL) return 0;
+        v->a=a; v->cap=cap;
+    }
+    v->a[v->n++]=x;
+    return 1;
+}
+static inline struct DSWorker *dsSelf(struct DeltaStepping *ds){
+    return &ds->workers[poolIndex(ds->pool)];
+}
+// v's distance dropped to d: file it under its bucket in this worker's bins
+static inline void dsBin(struct DeltaStepping *ds, struct DSWorker *me, int v, long long d){
+    if(!dsPush(&me->bins[(size_t)(d/ds->delta)%ds->nbins],v)) __atomic_store_n(&ds->failed,1,__ATOMIC_RELAXED);
+}
+// dist[v]=min(dist[v],d) atomically; 1 when it dropped
+static inline int dsRelax(long long *p, long long d){
+    long long old=__atomic_load_n(p,__ATOMIC_RELAXED);
+    while(d<old)
+        if(__atomic_compare_exchange_n(p,&old,d,1,__ATOMIC_RELAXED,__ATOMIC_RELAXED)) return 1;
+    return 0;
+}
+
+static void freeDeltaStepping(struct DeltaStepping *ds){
+    if(ds==NULL) return;
+    if(ds->workers)
+        for(int t=0;t<ds->threads;t++){
+            if(ds->workers[t].bins)
+                for(size_t b=0;b<ds->nbins;b++) free(ds->workers[t].bins[b].a);
+            free(ds->workers[t].bins); free(ds->workers[t].settled.a);
+        }
+    free(ds->workers); free(ds->to); free(ds->w); free(ds->light);
+    free(ds->dist); free(ds->stamp); free(ds->frontier.a); free(ds);
+}
+// NULL for negative weights or no memory; pool may be NULL (one thread)
+static struct DeltaStepping *newDeltaStepping(const struct CSRGraph *g, long long delta, struct Pool *pool){
+    if(g->minW<0) return NULL;
+    struct DeltaStepping *ds=(struct DeltaStepping*)calloc(1,sizeof(struct DeltaStepping));
+    size_t m=g->m ? g->m : 1, n=g->n ? g->n : 1;
+    long long reach=g->maxW>0 ? g->maxW-1 : 0;     // room for buckets i..i+1+reach/delta
+    if(delta<=0) delta=g->m ? (long long)g->maxW*g->n/(long long)g->m : 1;
+    if(delta<=0) delta=1;
+    if(reach/delta+2>DS_MAX_BINS) delta=reach/(DS_MAX_BINS-2)+1;
+    if(ds==NULL) goto fail;
+    ds->g=g; ds->pool=pool; ds->threads=poolThreads(pool);
+    ds->delta=delta; ds->nbins=(size_t)(reach/delta+2);
+    ds->to=(int*)malloc(m*sizeof(int)); ds->w=(int*)malloc(m*sizeof(int));
+    ds->light=(size_t*)malloc(n*sizeof(size_t));
+    ds->dist=(long long*)malloc(n*sizeof(long long)); ds->stamp=(long long*)malloc(n*sizeof(long long));
+    ds->workers=(struct DSWorker*)calloc(ds->threads,sizeof(struct DSWorker));
+    if(ds->to==NULL || ds->w==NULL || ds->light==NULL || ds->dist==NULL || ds->stamp==NULL || ds->workers==NULL) goto fail;
+    for(int t=0;t<ds->threads;t++)
+        if((ds->workers[t].bins=(struct DSVec*)calloc(ds->nbins,sizeof(struct DSVec)))==NULL) goto fail;
+    for(int v=0;v<g->n;v++){
+        size_t lo=g->off[v], hi=g->off[v+1];
+        for(size_t e=g->off[v];e<g->off[v+1];e++){
+            size_t k=g->w[e]<ds->delta ? lo++ : --hi;
+            ds->to[k]=g->to[e]; ds->w[k]=g->w[e];
+        }
+        ds->light[v]=lo;
+    }
+    return ds;
+fail:
+    printf("Out of Memory!");
+    freeDeltaStepping(ds);
+    return NULL;
+}
+
+// Moves bucket b of every worker into the frontier; its size
+static size_t dsGather(struct DeltaStepping *ds, long long b){
+    ds->frontier.n=0;
+    for(int t=0;t<ds->threads;t++){
+        struct DSVec *src=&ds->workers[t].bins[(size_t)b%ds->nbins];
+        if(src->n==0) continue;
+        if(ds->frontier.n+src->n>ds->frontier.cap){
+            size_t cap=2*(ds->frontier.n+src->n);
+            int *a=(int*)realloc(ds->frontier.a,cap*sizeof(int));
+            if(a==NULL){ ds->failed=1; return 0; }
+            ds->frontier.a=a; ds->frontier.cap=cap;
+        }
+        memcpy(ds->frontier.a+ds->frontier.n,src->a,src->n*sizeof(int));
+        ds->frontier.n+=src->n; src->n=0;
+    }
+    return ds->frontier.n;
+}
+static void dsLightBody(void *arg, size_t begin, size_t end){
+    struct DeltaStepping *ds=(struct DeltaStepping*)arg;
+    struct DSWorker *me=dsSelf(ds);
+    long long lo=ds->bucket*ds->delta;
+    for(size_t i=begin;i<end;i++){
+        int v=ds->frontier.a[i];
+        long long d=__atomic_load_n(&ds->dist[v],__ATOMIC_RELAXED);
+        if(d<lo) continue;                                  // settled in an earlier bucket
+        if(__atomic_exchange_n(&ds->stamp[v],ds->bucket,__ATOMIC_RELAXED)!=ds->bucket &&
+           !dsPush(&me->settled,v)) __atomic_store_n(&ds->failed,1,__ATOMIC_RELAXED);
+        for(size_t e=ds->g->off[v];e<ds->light[v];e++)
+            if(dsRelax(&ds->dist[ds->to[e]],d+ds->w[e])) dsBin(ds,me,ds->to[e],d+ds->w[e]);
+    }
+}
+static void dsHeavyBody(void *arg, size_t begin, size_t end){
+    struct DeltaStepping *ds=(struct DeltaStepping*)arg;
+    struct DSWorker *me=dsSelf(ds);
+    for(size_t i=begin;i<end;i++){
+        int v=ds->frontier.a[i];
+        long long d=ds->dist[v];
+        for(size_t e=ds->light[v];e<ds->g->off[v+1];e++)
+            if(dsRelax(&ds->dist[ds->to[e]],d+ds->w[e])) dsBin(ds,me,ds->to[e],d+ds->w[e]);
+    }
+}
+static void dsResetBody(void *arg, size_t begin, size_t end){
+    struct DeltaStepping *ds=(struct DeltaStepping*)arg;
+    for(size_t v=begin;v<end;v++){ ds->dist[v]=DS_INF; ds->stamp[v]=-1; }
+}
+// Runs on the pool: each poolParallelFor inside it forks onto the workers already running
+static void dsRoot(void *arg){
+    struct DeltaStepping *ds=(struct DeltaStepping*)arg;
+    for(;;){
+        // light phases until the bucket stays empty
+        while(dsGather(ds,ds->bucket)>0 && !ds->failed){
+            poolParallelFor(ds->pool,0,ds->frontier.n,DS_GRAIN,dsLightBody,ds);
+            ds->phases++;
+        }
+        // heavy edges of everything the bucket settled, gathered like the bins
+        ds->frontier.n=0;
+        for(int t=0;t<ds->threads && !ds->failed;t++){
+            struct DSVec *s=&ds->workers[t].settled;
+            for(size_t i=0;i<s->n;i++)
+                if(!dsPush(&ds->frontier,s->a[i])){ ds->failed=1; break; }
+            s->n=0;
+        }
+        if(ds->failed) return;
+        if(ds->frontier.n>0){
+            poolParallelFor(ds->pool,0,ds->frontier.n,DS_GRAIN,dsHeavyBody,ds);
+            ds->phases++;
+        }
+        // next non-empty bucket of any worker, within the window after this one
+        long long next=LLONG_MAX;
+        for(int t=0;t<ds->threads;t++){
+            struct DSVec *bins=ds->workers[t].bins;
+            for(long long b=ds->bucket+1;b<ds->bucket+(long long)ds->nbins && b<next;b++)
+                if(bins[(size_t)b%ds->nbins].n>0){ next=b; break; }
+        }
+        if(next==LLONG_MAX || ds->failed) return;
+        ds->bucket=next;
+    }
+}
+// Distances from source into ds->dist; 0, or -1 for a bad source or no memory
+static int deltaSteppingRun(struct DeltaStepping *ds, int source){
+    if(source<0 || source>=ds->g->n) return -1;
+    ds->failed=0; ds->phases=0; ds->bucket=0;
+    for(int t=0;t<ds->threads;t++){
+        for(size_t b=0;b<ds->nbins;b++) ds->workers[t].bins[b].n=0;
+        ds->workers[t].settled.n=0;
+    }
+    poolParallelFor(ds->pool,0,(size_t)ds->g->n,65536,dsResetBody,ds);
+    ds->dist[source]=0;
+    dsBin(ds,&ds->workers[0],source,0);
+    if(!ds->failed) poolRun(ds->pool,dsRoot,ds);
+    return ds->failed ? -1 : 0;
+}
+// One-shot version into the caller's array; 0, or -1 for negative weights, a bad source or no memory
+static inline int deltaStepping(const struct CSRGraph *g, int source, long long delta, long long *dist, struct Pool *pool){
+    struct DeltaStepping *ds=newDeltaStepping(g,delta,pool);
+    if(ds==NULL) return -1;
+    int r=deltaSteppingRun(ds,source);
+    if(r==0) memcpy(dist,ds->dist,g->n*sizeof(long long));
+    freeDeltaStepping(ds);
+    return r;
+}
+#endif
@@ -0,0 +1,90 @@
+#ifndef DEPTH_FIRST_SEARCH_C
+#define DEPTH_FIRST_SEARCH_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include"CSR Graph.h"
+// Depth-first search on a CSR graph with an explicit stack, so a path of a million vertices
+// needs a million stack entries on the heap instead of a million call frames. Each entry is a
+// vertex and the position of the next of its edges to scan, so the visiting order is that of
+// the recursive version: edges in adjacency order, each vertex entered once.
+// Visited is a bitmap (one bit per vertex) instead of a std::set, and the traversal is recorded
+// in flat arrays the other graph programs build on:
+//   pre[0..npre)    vertices in the order they were entered
+//   post[0..npost)  vertices in the order they were finished; reversed, a topological order of a DAG
+//   parent[v]       the tree edge into v, -1 for roots (valid for visited v only)
+//
+//   struct DFS *d=newDFS(g);
+//   dfsFrom(d,s);          // tree from s over vertices not yet visited; may be called again
+//   dfsAll(d);             // or: forget everything, then a forest over all vertices
+//   freeDFS(d);
+
+struct DFS{
+    const struct CSRGraph *g;
+    unsigned long long *visited;
+    int *parent;
+    int *pre, *post; int npre, npost;
+    int *stack; size_t *next;       // explicit stack: vertex, and the next of its edges to scan
+    int maxDepth;                   // deepest stack since the last reset
+};
+
+static void freeDFS(struct DFS *d){
+    if(d==NULL) return;
+    free(d->visited); free(d->parent); free(d->pre); free(d->post); free(d->stack); free(d->next); free(d);
+}
+// Forgets every visit in O(n/64)
+static inline void dfsReset(struct DFS *d){
+    memset(d->visited,0,((size_t)d->g->n+63)/64*sizeof(unsigned long long));
+    d->npre=d->npost=0; d->maxDepth=0;
+}
+static struct DFS *newDFS(const struct CSRGraph *g){
+    struct DFS *d=(struct DFS*)calloc(1,sizeof(struct DFS));
+    size_t n=g->n ? g->n : 1;
+    if(d==NULL) goto fail;
+    d->g=g;
+    d->visited=(unsigned long long*)malloc((n+63)/64*sizeof(unsigned long long));
+    d->parent=(int*)malloc(n*sizeof(int)); d->pre=(int*)malloc(n*sizeof(int)); d->post=(int*)malloc(n*sizeof(int));
+    d->stack=(int*)malloc(n*sizeof(int)); d->next=(size_t*)malloc(n*sizeof(size_t));
+    if(d->visited==NULL || d->parent==NULL || d->pre==NULL || d->post==NULL || d->stack==NULL || d->next==NULL) goto fail;
+    dfsReset(d);
+    return d;
+fail:
+    printf("Out of Memory!");
+    freeDFS(d);
+    return NULL;
+}
+static inline int dfsVisited(const struct DFS *d, int v){
+    return (int)(d->visited[v>>6]>>(v&63)&1);
+}
+// Visits every vertex reachable from s that is not visited yet; the number of vertices entered.
+// A stack entry per vertex on the current path: at most n, so it cannot overflow.
+static int dfsFrom(struct DFS *d, int s){
+    const struct CSRGraph *g=d->g;
+    if(s<0 || s>=g->n || dfsVisited(d,s)) return 0;
+    int start=d->npre, top=1;
+    d->visited[s>>6]|=1ULL<<(s&63); d->parent[s]=-1; d->pre[d->npre++]=s;
+    d->stack[0]=s; d->next[0]=g->off[s];
+    if(d->maxDepth<1) d->maxDepth=1;
+    while(top>0){
+        int u=d->stack[top-1];
+        size_t e=d->next[top-1], end=g->off[u+1];
+        while(e<end && dfsVisited(d,g->to[e])) e++;
+        if(e<end){
+            int v=g->to[e];
+            d->next[top-1]=e+1;
+            d->visited[v>>6]|=1ULL<<(v&63); d->parent[v]=u; d->pre[d->npre++]=v;
+            d->stack[top]=v; d->next[top]=g->off[v]; top++;
+            if(top>d->maxDepth) d->maxDepth=top;
+        }
+        else{ d->post[d->npost++]=u; top--; }
+    }
+    return d->npre-start;
+}
+// Forest over the whole graph, roots tried in vertex order; the number of trees
+static inline int dfsAll(struct DFS *d){
+    int trees=0;
+    dfsReset(d);
+    for(int v=0;v<d->g->n;v++) if(dfsFrom(d,v)>0) trees++;
+    return trees;
+}
+#endif
@@ -0,0 +1,224 @@
+// Benchmark for Dijkstra.c against dijkstra() of daily/day_001/dijkstra_s_algorithm.md, which keeps
+// the graph in a vector of vectors, the distances in a std::map and the frontier in a
+// std::priority_queue with duplicates. Built as C++ only for that reference.
+// Build: g++ -O2 -pthread -o dijkstra_bench "Dijkstra Benchmark.cpp"
+// Run:   ./dijkstra_bench --min 1024 --max 4194304 --threads 8 --json dijkstra.json
+// Graphs over n vertices with weights in [1,1000] (small enough for Dial's buckets):
+//   random  undirected, average degree 8
+//   grid    sqrt(n) x sqrt(n), 4 neighbours, like a road network
+// Routines:
+//   sssp/<graph>/reference        the daily dijkstra(), up to DIJKSTRA_REF_MAX vertices
+//   sssp/<graph>/binary|heap4|dial|radix   dijkstra() of Dijkstra.c from vertex 0
+//     (ns/item = per vertex; checksum = sum of the distances)
+//   p2p/<graph>/full     DIJKSTRA_P2P point-to-point queries, each a full radix run from the source
+//   p2p/<graph>/early    the same queries stopping at the target, reusing one DijkstraWork
+//   p2p/<graph>/batch    dijkstraBatch() of the queries on --threads workers
+//     (ns/item = per query; checksum = sum of the target distances)
+// Every row must match the first row of its group that ran. Untimed, checkMultiSource() runs
+// every queue from DIJKSTRA_SOURCES sources at once against the minimum of single-source runs, and
+// checkPaths() follows dijkstraPath() of the p2p queries edge by edge.
+#include<vector>
+#include<queue>
+#include<map>
+#include<limits>
+#include"Dijkstra.c"
+#include"../Benchmark/Benchmark.h"
+
+#define DIJKSTRA_REF_MAX (1<<20)
+#define DIJKSTRA_P2P 16
+#define DIJKSTRA_SOURCES 4
+
+// The daily version, unchanged
+const long long INF = std::numeric_limits<long long>::max();
+typedef std::pair<long long, int> pii;
+std::map<int, long long> referenceDijkstra(int startNode, int numNodes, const std::vector<std::vector<std::pair<int, int>>>& adj) {
+    std::map<int, long long> dist;
+    for (int i = 0; i < numNodes; ++i) {
+        dist[i] = INF;
+    }
+    dist[startNode] = 0;
+
+    std::priority_queue<pii, std::vector<pii>, std::greater<pii>> pq;
+    pq.push({0, startNode});
+
+    while (!pq.empty()) {
+        long long d = pq.top().first;
+        int u = pq.top().second;
+        pq.pop();
+
+        if (d > dist[u]) {
+            continue;
+        }
+
+        for (const auto& edge : adj[u]) {
+            int v = edge.first;
+            int weight = edge.second;
+
+            if (dist[u] + weight < dist[v]) {
+                dist[v] = dist[u] + weight;
+                pq.push({dist[v], v});
+            }
+        }
+    }
+    return dist;
+}
+
+struct DijkstraCtx{
+    const struct CSRGraph *g; const std::vector<std::vector<std::pair<int,int> > > *adj;
+    long long *dist; struct DijkstraWork *work; struct Pool *pool;
+    int src[DIJKSTRA_P2P], dst[DIJKSTRA_P2P]; long long out[DIJKSTRA_P2P];
+};
+static long long sumDist(const long long *dist, int n){
+    long long sum=0;
+    for(int v=0;v<n;v++) if(dist[v]!=DIJKSTRA_INF) sum+=dist[v];
+    return sum;
+}
+static long long runReference(void *vctx, size_t begin, size_t end){
+    struct DijkstraCtx *c=(struct DijkstraCtx*)vctx; (void)begin; (void)end;
+    std::map<int,long long> dist=referenceDijkstra(0,c->g->n,*c->adj);
+    long long sum=0;
+    for(const auto &d : dist) if(d.second!=INF) sum+=d.second;
+    return sum;
+}
+#define DIJKSTRA_SSSP(fn, q) \
+static long long fn(void *vctx, size_t begin, size_t end){ \
+    struct DijkstraCtx *c=(struct DijkstraCtx*)vctx; (void)begin; (void)end; \
+    if(dijkstra(c->g,0,q,c->dist,NULL)!=0) return -1; \
+    return sumDist(c->dist,c->g->n); \
+}
+DIJKSTRA_SSSP(runBinary,DIJKSTRA_BINARY)
+DIJKSTRA_SSSP(runHeap4,DIJKSTRA_HEAP4)
+DIJKSTRA_SSSP(runDial,DIJKSTRA_DIAL)
+DIJKSTRA_SSSP(runRadix,DIJKSTRA_RADIX)
+static long long runFull(void *vctx, size_t begin, size_t end){
+    struct DijkstraCtx *c=(struct DijkstraCtx*)vctx; long long sum=0; (void)begin; (void)end;
+    for(int i=0;i<DIJKSTRA_P2P;i++){
+        if(dijkstra(c->g,c->src[i],DIJKSTRA_RADIX,c->dist,NULL)!=0) return -1;
+        sum+=c->dist[c->dst[i]];
+    }
+    return sum;
+}
+static long long runEarly(void *vctx, size_t begin, size_t end){
+    struct DijkstraCtx *c=(struct DijkstraCtx*)vctx; long long sum=0; (void)begin; (void)end;
+    for(int i=0;i<DIJKSTRA_P2P;i++){
+        if(dijkstraRun(c->work,&c->src[i],1,c->dst[i],DIJKSTRA_RADIX)!=0) return -1;
+        sum+=c->work->dist[c->dst[i]];
+    }
+    return sum;
+}
+static long long runBatch(void *vctx, size_t begin, size_t end){
+    struct DijkstraCtx *c=(struct DijkstraCtx*)vctx; long long sum=0; (void)begin; (void)end;
+    if(dijkstraBatch(c->g,c->src,c->dst,DIJKSTRA_P2P,DIJKSTRA_RADIX,c->out,c->pool)!=0) return -1;
+    for(int i=0;i<DIJKSTRA_P2P;i++) sum+=c->out[i];
+    return sum;
+}
+
+// Every queue from DIJKSTRA_SOURCES sources (one repeated) at once must give, for each vertex, the
+// smallest of its single-source distances, and only the sources may lack a parent
+static int checkMultiSource(const struct CSRGraph *g, struct DijkstraWork *w, long long *best, const int *src){
+    int n=g->n, sources[DIJKSTRA_SOURCES+1];
+    for(int v=0;v<n;v++) best[v]=DIJKSTRA_INF;
+    for(int i=0;i<DIJKSTRA_SOURCES;i++){
+        sources[i]=src[i];
+        if(dijkstraRun(w,&src[i],1,-1,DIJKSTRA_RADIX)!=0) return 0;
+        for(int v=0;v<n;v++) if(w->dist[v]<best[v]) best[v]=w->dist[v];
+    }
+    sources[DIJKSTRA_SOURCES]=src[0];
+    for(int q=DIJKSTRA_BINARY;q<=DIJKSTRA_RADIX;q++){
+        if(dijkstraRun(w,sources,DIJKSTRA_SOURCES+1,-1,(enum DijkstraQueue)q)!=0) return 0;
+        for(int v=0;v<n;v++){
+            if(w->dist[v]!=best[v]) return 0;
+            if(w->parent[v]<0 && best[v]!=DIJKSTRA_INF && best[v]!=0) return 0;
+        }
+    }
+    return 1;
+}
+// After a run to dst, dijkstraPath() must start at src, end at dst, and step along edges whose
+// weights add up to each vertex's distance; a short buffer gets the length and is left alone
+static int checkPaths(const struct CSRGraph *g, struct DijkstraWork *w, const int *src, const int *dst){
+    std::vector<int> path(g->n);
+    for(int i=0;i<DIJKSTRA_P2P;i++){
+        if(dijkstraRun(w,&src[i],1,dst[i],DIJKSTRA_HEAP4)!=0) return 0;
+        int len=dijkstraPath(w,dst[i],path.data(),g->n);
+        if(w->dist[dst[i]]==DIJKSTRA_INF){ if(len!=0) return 0; continue; }
+        if(len<1 || path[0]!=src[i] || path[len-1]!=dst[i] || w->dist[src[i]]!=0) return 0;
+        for(int k=0;k+1<len;k++){
+            int u=path[k], v=path[k+1], found=0;
+            for(size_t e=g->off[u];e<g->off[u+1] && !found;e++) found=g->to[e]==v && w->dist[u]+g->w[e]==w->dist[v];
+            if(!found) return 0;
+        }
+        int first=-1;
+        if(len>1 && (dijkstraPath(w,dst[i],&first,1)!=len || first!=-1)) return 0;
+    }
+    return 1;
+}
+
+struct DijkstraRoutine{const char *group, *name; long long (*run)(void *ctx, size_t begin, size_t end);};
+static const struct DijkstraRoutine routines[]={
+    {"sssp","reference",runReference},{"sssp","binary",runBinary},{"sssp","heap4",runHeap4},
+    {"sssp","dial",runDial},{"sssp","radix",runRadix},
+    {"p2p","full",runFull},{"p2p","early",runEarly},{"p2p","batch",runBatch},
+};
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    cfg.maxN=1<<22;
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    struct Pool *pool=newPool(cfg.threads);
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"dijkstra");
+    int failed=0;
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        for(int grid=0;grid<2;grid++){
+            int side=1;
+            while((size_t)(side+1)*(side+1)<=n) side++;
+            struct CSRGraph *g=grid ? csrGridGraph(side,1000,cfg.seed) : csrRandomGraph((int)n,8,1000,CSR_UNDIRECTED,cfg.seed);
+            struct DijkstraCtx *ctx=new DijkstraCtx();
+            std::vector<std::vector<std::pair<int,int> > > adj;
+            if(pool==NULL || g==NULL || (ctx->dist=(long long*)malloc(g->n*sizeof(long long)))==NULL ||
+               (ctx->work=newDijkstraWork(g))==NULL){
+                printf("Out of Memory!"); return 1;
+            }
+            if(g->n<=DIJKSTRA_REF_MAX){
+                adj.resize(g->n);
+                for(int v=0;v<g->n;v++)
+                    for(size_t e=g->off[v];e<g->off[v+1];e++) adj[v].push_back(std::make_pair(g->to[e],g->w[e]));
+            }
+            ctx->g=g; ctx->adj=&adj; ctx->pool=pool;
+            unsigned long long s=benchSeed(cfg.seed);
+            for(int i=0;i<DIJKSTRA_P2P;i++){
+                ctx->src[i]=(int)(benchRand(&s)%(unsigned)g->n); ctx->dst[i]=(int)(benchRand(&s)%(unsigned)g->n);
+            }
+            if(!checkMultiSource(g,ctx->work,ctx->dist,ctx->src) || !checkPaths(g,ctx->work,ctx->src,ctx->dst)){
+                fprintf(stderr,"%s: wrong multi-source distances or paths for n=%zu\n",grid ? "grid" : "random",n); failed=1;
+            }
+            size_t reps=cfg.ops*4/n;
+            if(reps<3) reps=3;
+            if(reps>200) reps=200;
+            const char *group=NULL; long long ref=0;
+            for(size_t r=0;r<sizeof(routines)/sizeof(routines[0]);r++){
+                char name[64];
+                int p2p=strcmp(routines[r].group,"p2p")==0;
+                snprintf(name,sizeof(name),"%s/%s/%s",routines[r].group,grid ? "grid" : "random",routines[r].name);
+                if(r==0 && g->n>DIJKSTRA_REF_MAX) continue;
+                int first=group==NULL || strcmp(group,routines[r].group)!=0;
+                if(!benchSelected(&cfg,name) && !first) continue;   // the reference always runs
+                size_t items=p2p ? DIJKSTRA_P2P : (size_t)g->n;
+                struct BenchCase bc={name,(size_t)g->n,p2p && reps>=48 ? reps/16 : p2p ? 3 : reps,1,routines[r].run,NULL,ctx,items};
+                struct BenchResult res=benchMeasure(&cfg,&bc);
+                if(benchSelected(&cfg,name)) benchReportResult(&rep,&res);
+                long long one=res.checksum/(long long)res.ops;
+                if(first){ group=routines[r].group; ref=one; }
+                else if(one!=ref){
+                    fprintf(stderr,"%s: wrong result for n=%zu\n",name,n); failed=1;
+                }
+            }
+            free(ctx->dist); freeDijkstraWork(ctx->work); delete ctx;
+            freeCSRGraph(g);
+        }
+    }
+    benchReportEnd(&rep);
+    freePool(pool);
+    return failed;
+}
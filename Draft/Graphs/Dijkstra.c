@@ -0,0 +1,298 @@
+#ifndef DIJKSTRA_C
+#define DIJKSTRA_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<limits.h>
+#include"CSR Graph.h"
+#include"../Queues/Priority Queue.c"
+#include"../Parallel/Work-Stealing Pool.h"
+// Dijkstra's algorithm on a CSR graph with non-negative int weights, with the distances in a flat
+// array and one of four monotone priority queues:
+//   DIJKSTRA_BINARY, DIJKSTRA_HEAP4  indexed heap of Priority Queue.c (D=2, D=4) with decrease-key
+//   DIJKSTRA_DIAL    Dial's buckets: a ring of maxW+1 doubly linked lists, one per distance mod
+//                    maxW+1, moving a vertex between lists in O(1); for small weights only
+//   DIJKSTRA_RADIX   radix heap: 65 buckets by the highest bit in which a key differs from the last
+//                    key popped; each entry moves to a lower bucket at most 64 times
+// Dijkstra pops keys in increasing order, which is all Dial's buckets and the radix heap need.
+//
+// A struct DijkstraWork holds the arrays of one thread and is reused across queries. A run only
+// resets the vertices the previous run reached, so a short query on a huge graph costs what it
+// visits, not O(n).
+//   struct DijkstraWork *w=newDijkstraWork(g);
+//   dijkstraRun(w,sources,ns,target,DIJKSTRA_RADIX);   // target -1: every vertex
+//   w->dist[v], w->parent[v]
+//   freeDijkstraWork(w);
+// With a target the run stops as soon as the target is settled; the other distances are then
+// only upper bounds. Several sources all start at distance 0 (nearest of many depots).
+#define DIJKSTRA_INF LLONG_MAX
+#define DIJKSTRA_DIAL_MAX 65536     // largest edge weight Dial's buckets accept
+#define DIJKSTRA_RADIX_BUCKETS 65
+
+enum DijkstraQueue{DIJKSTRA_BINARY, DIJKSTRA_HEAP4, DIJKSTRA_DIAL, DIJKSTRA_RADIX};
+
+DEFINE_INDEXED_HEAP(IndexedHeap2,long long,2)
+
+struct RadixEntry{unsigned long long key; int v;};
+struct DijkstraWork{
+    const struct CSRGraph *g;
+    long long *dist;                // DIJKSTRA_INF when unreached
+    int *parent;                    // predecessor on a shortest path, -1 for sources and unreached
+    int *touched; int ntouched;     // vertices the last run reached
+    int dirty;                      // the last run stopped early and left its queue non-empty
+    struct IndexedHeap2 *heap2; struct IndexedHeap4 *heap4;
+    int *head, *next, *prev; int buckets;           // Dial: next[v]==-2 when v is not queued
+    struct RadixEntry *radix[DIJKSTRA_RADIX_BUCKETS];
+    size_t radixN[DIJKSTRA_RADIX_BUCKETS], radixCap[DIJKSTRA_RADIX_BUCKETS];
+};
+
+static void freeDijkstraWork(struct DijkstraWork *w){
+    if(w==NULL) return;
+    free(w->dist); free(w->parent); free(w->touched);
+    freeIndexedHeap2(w->heap2); freeIndexedHeap4(w->heap4);
+    free(w->head); free(w->next); free(w->prev);
+    for(int i=0;i<DIJKSTRA_RADIX_BUCKETS;i++) free(w->radix[i]);
+    free(w);
+}
+// The queues are created by the first run that uses them
+static struct DijkstraWork *newDijkstraWork(const struct CSRGraph *g){
+    struct DijkstraWork *w=(struct DijkstraWork*)calloc(1,sizeof(struct DijkstraWork));
+    int n=g->n ? g->n : 1;
+    if(w!=NULL){
+        w->g=g;
+        w->dist=(long long*)malloc(n*sizeof(long long));
+        w->parent=(int*)malloc(n*sizeof(int));
+        w->touched=(int*)malloc(n*sizeof(int));
+    }
+    if(w==NULL || w->dist==NULL || w->parent==NULL || w->touched==NULL){
+        printf("Out of Memory!"); freeDijkstraWork(w); return NULL;
+    }
+    for(int v=0;v<g->n;v++){ w->dist[v]=DIJKSTRA_INF; w->parent[v]=-1; }
+    return w;
+}
+
+// Forgets the previous run: only the vertices it reached, and its queue if it stopped early.
+// Every vertex still queued was reached, so clearing pos[] and next[] for them empties the queues.
+static void dijkstraReset(struct DijkstraWork *w){
+    for(int i=0;i<w->ntouched;i++){
+        int v=w->touched[i];
+        w->dist[v]=DIJKSTRA_INF; w->parent[v]=-1;
+        if(!w->dirty) continue;
+        if(w->heap2) w->heap2->pos[v]=-1;
+        if(w->heap4) w->heap4->pos[v]=-1;
+        if(w->next) w->next[v]=-2;
+    }
+    w->ntouched=0;
+    if(!w->dirty) return;
+    if(w->heap2) w->heap2->n=0;
+    if(w->heap4) w->heap4->n=0;
+    if(w->head) memset(w->head,-1,w->buckets*sizeof(int));
+    memset(w->radixN,0,sizeof(w->radixN));
+    w->dirty=0;
+}
+
+#define DIJKSTRA_HEAP_RUN(fn, H, field) \
+static int fn(struct DijkstraWork *w, int target){ \
+    const struct CSRGraph *g=w->g; \
+    if(w->field==NULL && (w->field=new##H(g->n))==NULL) return -1; \
+    struct H *q=w->field; \
+    for(int i=0;i<w->ntouched;i++) H##Push(q,w->touched[i],0); \
+    int u; long long d; \
+    while(H##Pop(q,&u,&d)){ \
+        if(u==target){ w->dirty=q->n>0; return 0; } \
+        for(size_t e=g->off[u];e<g->off[u+1];e++){ \
+            int v=g->to[e]; long long nd=d+g->w[e]; \
+            if(nd<w->dist[v]){ \
+                if(w->dist[v]==DIJKSTRA_INF) w->touched[w->ntouched++]=v; \
+                w->dist[v]=nd; w->parent[v]=u; \
+                H##Update(q,v,nd); \
+            } \
+        } \
+    } \
+    return 0; \
+}
+DIJKSTRA_HEAP_RUN(dijkstraBinary,IndexedHeap2,heap2)
+DIJKSTRA_HEAP_RUN(dijkstraHeap4,IndexedHeap4,heap4)
+
+// Dial: every queued distance lies in [cur,cur+maxW], so distance mod maxW+1 names its list
+static inline void dialLink(struct DijkstraWork *w, int v, long long d){
+    int b=(int)(d%w->buckets);
+    w->prev[v]=-1; w->next[v]=w->head[b];
+    if(w->head[b]>=0) w->prev[w->head[b]]=v;
+    w->head[b]=v;
+}
+static inline void dialUnlink(struct DijkstraWork *w, int v, long long d){
+    if(w->prev[v]>=0) w->next[w->prev[v]]=w->next[v];
+    else w->head[d%w->buckets]=w->next[v];
+    if(w->next[v]>=0) w->prev[w->next[v]]=w->prev[v];
+    w->next[v]=-2;
+}
+static int dijkstraDial(struct DijkstraWork *w, int target){
+    const struct CSRGraph *g=w->g;
+    if(g->maxW>DIJKSTRA_DIAL_MAX) return -1;
+    if(w->head==NULL || w->buckets!=g->maxW+1){
+        free(w->head); free(w->next); free(w->prev);
+        w->buckets=g->maxW+1;
+        w->head=(int*)malloc(w->buckets*sizeof(int));
+        w->next=(int*)malloc((g->n ? g->n : 1)*sizeof(int));
+        w->prev=(int*)malloc((g->n ? g->n : 1)*sizeof(int));
+        if(w->head==NULL || w->next==NULL || w->prev==NULL){
+            free(w->head); free(w->next); free(w->prev);
+            w->head=w->next=w->prev=NULL;
+            printf("Out of Memory!"); return -1;
+        }
+        memset(w->head,-1,w->buckets*sizeof(int));
+        for(int v=0;v<g->n;v++) w->next[v]=-2;
+    }
+    int queued=0;
+    for(int i=0;i<w->ntouched;i++){ dialLink(w,w->touched[i],0); queued++; }
+    long long cur=0; int b=0;
+    while(queued>0){
+        while(w->head[b]<0){ cur++; if(++b==w->buckets) b=0; }
+        int u=w->head[b];
+        dialUnlink(w,u,cur); queued--;
+        if(u==target){ w->dirty=queued>0; return 0; }
+        for(size_t e=g->off[u];e<g->off[u+1];e++){
+            int v=g->to[e]; long long nd=cur+g->w[e];
+            if(nd<w->dist[v]){
+                if(w->dist[v]==DIJKSTRA_INF){ w->touched[w->ntouched++]=v; queued++; }
+                else if(w->next[v]!=-2) dialUnlink(w,v,w->dist[v]);
+                else queued++;
+                w->dist[v]=nd; w->parent[v]=u;
+                dialLink(w,v,nd);
+            }
+        }
+    }
+    return 0;
+}
+
+// Radix heap: bucket 0 holds keys equal to last, bucket i keys whose highest bit differing from
+// last is bit i-1. Entries are lazy: a vertex is pushed again when its distance drops, and an
+// entry whose key is no longer the vertex's distance is skipped when popped.
+static inline int radixBucket(unsigned long long key, unsigned long long last){
+    return key==last ? 0 : 64-__builtin_clzll(key^last);
+}
+static inline int radixPush(struct DijkstraWork *w, int b, unsigned long long key, int v){
+    if(w->radixN[b]==w->radixCap[b]){
+        size_t cap=w->radixCap[b] ? 2*w->radixCap[b] : 64;
+        struct RadixEntry *a=(struct RadixEntry*)realloc(w->radix[b],cap*sizeof(struct RadixEntry));
+        if(a==NULL){ printf("Out of Memory!"); return 0; }
+        w->radix[b]=a; w->radixCap[b]=cap;
+    }
+    w->radix[b][w->radixN[b]].key=key; w->radix[b][w->radixN[b]++].v=v;
+    return 1;
+}
+static int dijkstraRadix(struct DijkstraWork *w, int target){
+    const struct CSRGraph *g=w->g;
+    unsigned long long last=0; size_t size=0;
+    for(int i=0;i<w->ntouched;i++){
+        if(!radixPush(w,0,0,w->touched[i])) return -1;
+        size++;
+    }
+    while(size>0){
+        if(w->radixN[0]==0){
+            // refill bucket 0 from the first non-empty bucket: its minimum becomes last, and every
+            // entry there now differs from last in a lower bit
+            int i=1;
+            while(w->radixN[i]==0) i++;
+            struct RadixEntry *a=w->radix[i]; size_t n=w->radixN[i];
+            unsigned long long min=a[0].key;
+            for(size_t k=1;k<n;k++) if(a[k].key<min) min=a[k].key;
+            last=min; w->radixN[i]=0;
+            for(size_t k=0;k<n;k++)
+                if(!radixPush(w,radixBucket(a[k].key,last),a[k].key,a[k].v)) return -1;
+        }
+        struct RadixEntry x=w->radix[0][--w->radixN[0]]; size--;
+        int u=x.v;
+        if((long long)x.key!=w->dist[u]) continue;     // stale
+        if(u==target){ w->dirty=size>0; return 0; }
+        for(size_t e=g->off[u];e<g->off[u+1];e++){
+            int v=g->to[e]; long long nd=(long long)x.key+g->w[e];
+            if(nd<w->dist[v]){
+                if(w->dist[v]==DIJKSTRA_INF) w->touched[w->ntouched++]=v;
+                w->dist[v]=nd; w->parent[v]=u;
+                if(!radixPush(w,radixBucket((unsigned long long)nd,last),(unsigned long long)nd,v)) return -1;
+                size++;
+            }
+        }
+    }
+    return 0;
+}
+
+// Shortest distances from the ns sources (all at distance 0) into w->dist and w->parent.
+// With target>=0 it stops once target is settled. 0, or -1 for negative weights, weights above
+// DIJKSTRA_DIAL_MAX with DIJKSTRA_DIAL, a vertex out of range or no memory.
+static int dijkstraRun(struct DijkstraWork *w, const int *sources, int ns, int target, enum DijkstraQueue q){
+    const struct CSRGraph *g=w->g;
+    if(g->minW<0 || target>=g->n) return -1;
+    dijkstraReset(w);
+    for(int i=0;i<ns;i++){
+        int s=sources[i];
+        if(s<0 || s>=g->n) return -1;
+        if(w->dist[s]==0) continue;
+        w->dist[s]=0; w->touched[w->ntouched++]=s;
+    }
+    switch(q){
+    case DIJKSTRA_BINARY: return dijkstraBinary(w,target);
+    case DIJKSTRA_HEAP4: return dijkstraHeap4(w,target);
+    case DIJKSTRA_DIAL: return dijkstraDial(w,target);
+    case DIJKSTRA_RADIX: return dijkstraRadix(w,target);
+    }
+    return -1;
+}
+// The vertices of the shortest path to target, source first, into path (room for max);
+// returns its length, 0 when target was not reached, or the full length when max is too small
+static inline int dijkstraPath(const struct DijkstraWork *w, int target, int *path, int max){
+    if(target<0 || target>=w->g->n || w->dist[target]==DIJKSTRA_INF) return 0;
+    int len=0;
+    for(int v=target;v>=0;v=w->parent[v]) len++;
+    if(len>max) return len;
+    int i=len;
+    for(int v=target;v>=0;v=w->parent[v]) path[--i]=v;
+    return len;
+}
+// Single source into caller arrays (parent may be NULL); 0 or -1 as dijkstraRun()
+static int dijkstra(const struct CSRGraph *g, int source, enum DijkstraQueue q, long long *dist, int *parent){
+    struct DijkstraWork *w=newDijkstraWork(g);
+    if(w==NULL) return -1;
+    int r=dijkstraRun(w,&source,1,-1,q);
+    if(r==0){
+        memcpy(dist,w->dist,g->n*sizeof(long long));
+        if(parent) memcpy(parent,w->parent,g->n*sizeof(int));
+    }
+    freeDijkstraWork(w);
+    return r;
+}
+
+// Batch of point-to-point queries src[i]->dst[i] spread over the workers of pool (NULL: this
+// thread), each worker with its own DijkstraWork and early exit. out[i] is the distance,
+// DIJKSTRA_INF when unreachable. 0, or -1 when any query fails.
+struct DijkstraBatch{
+    const struct CSRGraph *g; const int *src, *dst; long long *out; enum DijkstraQueue q;
+    struct DijkstraWork **works; int failed;
+    struct Pool *pool;
+};
+static void dijkstraBatchBody(void *arg, size_t begin, size_t end){
+    struct DijkstraBatch *b=(struct DijkstraBatch*)arg;
+    int self=poolIndex(b->pool);
+    if(b->works[self]==NULL && (b->works[self]=newDijkstraWork(b->g))==NULL){
+        __atomic_store_n(&b->failed,1,__ATOMIC_RELAXED); return;
+    }
+    struct DijkstraWork *w=b->works[self];
+    for(size_t i=begin;i<end;i++){
+        if(dijkstraRun(w,&b->src[i],1,b->dst[i],b->q)!=0){ __atomic_store_n(&b->failed,1,__ATOMIC_RELAXED); return; }
+        b->out[i]=w->dist[b->dst[i]];
+    }
+}
+static inline int dijkstraBatch(const struct CSRGraph *g, const int *src, const int *dst, int nq,
+                         enum DijkstraQueue q, long long *out, struct Pool *pool){
+    int threads=poolThreads(pool);
+    struct DijkstraWork **works=(struct DijkstraWork**)calloc(threads,sizeof(struct DijkstraWork*));
+    if(works==NULL){ printf("Out of Memory!"); return -1; }
+    struct DijkstraBatch b={g,src,dst,out,q,works,0,pool};
+    poolParallelFor(pool,0,(size_t)nq,1,dijkstraBatchBody,&b);
+    for(int t=0;t<threads;t++) freeDijkstraWork(works[t]);
+    free(works);
+    return b.failed ? -1 : 0;
+}
+#endif
@@ -0,0 +1,237 @@
+// Benchmark for Floyd-Warshall.c against floydWarshall() of daily/day_002/floyd_warshall_algorithm.md,
+// the textbook k,i,j loop over a std::vector<std::vector<int>>. Built as C++ only for that reference.
+// Build: g++ -O2 -pthread -o fw_bench "Floyd-Warshall Benchmark.cpp"
+// Run:   ./fw_bench --min 256 --max 8192 --threads 16 --json fw.json
+// Directed random graphs with average out-degree 8 and weights in [1,1000].
+// ns/item = per relaxation (n^3 per run); the checksum is the sum of the finite distances.
+//   reference       the daily floydWarshall(), up to FW_REF_MAX vertices
+//   flat            the same loop over one contiguous matrix, without the INF tests
+//   blocked/scalar  floydWarshallKernels() with the scalar tile kernels, one thread
+//   blocked/simd    floydWarshallRun(), the best kernels (AVX2 when available), one thread
+//   blocked/pred    the same keeping the predecessor matrix
+//   blocked/t<k>    floydWarshallRun() on a pool of k workers, k = 2, 4, ... --threads
+// Every row must match the first one that ran. The input matrix is copied back before every run, untimed.
+// Untimed, before the runs: graphs of 1, 63, 65, 100, 200 and 333 vertices, which leave partial
+// tiles, with negative weights and the random self-loops of csrRandomGraph(). The scalar, best
+// and pooled runs must match the daily floydWarshall() on every pair, and every fwPath() must
+// run from u to v over edges that add up to the distance. A negative self-loop must be reported
+// as a negative cycle.
+#include<vector>
+#include<algorithm>
+#include"Floyd-Warshall.c"
+#include"../Benchmark/Benchmark.h"
+
+#define FW_REF_MAX 2048
+#define FW_MAX_POOLS 16
+#define FW_CHECK_RUNS 3
+
+// The daily version, unchanged
+const int INF = 1e9; // Represents infinity
+
+void floydWarshall(int numNodes, std::vector<std::vector<int>>& dist)
+{
+    // Initialize dist matrix: direct edge weights or INF if no direct edge, 0 for self loops
+    // Input 'dist' is assumed to be the adjacency matrix, where dist[i][j] is weight or INF.
+    // Ensure dist[i][i] is 0.
+
+    for (int k = 0; k < numNodes; ++k)
+    {
+        for (int i = 0; i < numNodes; ++i)
+        {
+            for (int j = 0; j < numNodes; ++j)
+            {
+                if (dist[i][k] != INF && dist[k][j] != INF)
+                {
+                    dist[i][j] = std::min(dist[i][j], dist[i][k] + dist[k][j]);
+                }
+            }
+        }
+    }
+}
+
+struct FWCtx{
+    int n;
+    std::vector<std::vector<int> > input, ref;      // daily layout
+    struct FloydWarshall *init, *fw;                // init: the edges, copied into fw before each run
+    int *flat;
+    struct Pool *pool;
+};
+static void setupReference(void *vctx, size_t begin, size_t end){
+    struct FWCtx *c=(struct FWCtx*)vctx; (void)begin; (void)end;
+    c->ref=c->input;
+}
+static void setupBlocked(void *vctx, size_t begin, size_t end){
+    struct FWCtx *c=(struct FWCtx*)vctx; (void)begin; (void)end;
+    size_t cells=c->fw->stride*c->fw->stride;
+    memcpy(c->fw->dist,c->init->dist,cells*sizeof(int));
+    if(c->fw->pred) memcpy(c->fw->pred,c->init->pred,cells*sizeof(int));
+}
+static void setupFlat(void *vctx, size_t begin, size_t end){
+    struct FWCtx *c=(struct FWCtx*)vctx; (void)begin; (void)end;
+    for(int u=0;u<c->n;u++) memcpy(c->flat+(size_t)u*c->n,c->init->dist+u*c->init->stride,c->n*sizeof(int));
+}
+static long long runReference(void *vctx, size_t begin, size_t end){
+    struct FWCtx *c=(struct FWCtx*)vctx; (void)begin; (void)end;
+    floydWarshall(c->n,c->ref);
+    long long sum=0;
+    for(int u=0;u<c->n;u++) for(int v=0;v<c->n;v++) if(c->ref[u][v]!=INF) sum+=c->ref[u][v];
+    return sum;
+}
+static long long runFlat(void *vctx, size_t begin, size_t end){
+    struct FWCtx *c=(struct FWCtx*)vctx; (void)begin; (void)end;
+    int n=c->n, *d=c->flat;
+    for(int k=0;k<n;k++)
+        for(int i=0;i<n;i++){
+            int a=d[(size_t)i*n+k];
+            int *__restrict di=d+(size_t)i*n;
+            const int *__restrict dk=d+(size_t)k*n;
+            if(i!=k) for(int j=0;j<n;j++){ int t=a+dk[j]; di[j]=t<di[j] ? t : di[j]; }
+        }
+    long long sum=0;
+    for(size_t x=0;x<(size_t)n*n;x++) if(d[x]<FW_INF/2) sum+=d[x];
+    return sum;
+}
+static long long sumBlocked(const struct FloydWarshall *fw){
+    long long sum=0;
+    for(int u=0;u<fw->n;u++) for(int v=0;v<fw->n;v++) if(fwDist(fw,u,v)!=FW_INF) sum+=fwDist(fw,u,v);
+    return sum;
+}
+static long long runScalar(void *vctx, size_t begin, size_t end){
+    struct FWCtx *c=(struct FWCtx*)vctx; (void)begin; (void)end;
+    if(floydWarshallKernels(c->fw,NULL,&fwScalarKernels)!=0) return -1;
+    return sumBlocked(c->fw);
+}
+static long long runBlocked(void *vctx, size_t begin, size_t end){
+    struct FWCtx *c=(struct FWCtx*)vctx; (void)begin; (void)end;
+    if(floydWarshallRun(c->fw,c->pool)!=0) return -1;
+    return sumBlocked(c->fw);
+}
+
+// Negative weights without negative cycles: w+p[u]-p[v] for random potentials p changes the
+// weight of a u-v path by p[u]-p[v] only, so every cycle keeps its positive weight. 0 when
+// every check passes
+static int checkNegative(struct Pool *pool, unsigned seed){
+    static const int sizes[]={1,63,65,100,200,333};
+    int bad=0;
+    for(size_t c=0;c<sizeof(sizes)/sizeof(sizes[0]) && !bad;c++){
+        int n=sizes[c];
+        unsigned long long s=benchSeed(seed+(unsigned)c);
+        struct CSRGraph *g=csrRandomGraph(n,8,1000,CSR_DIRECTED,s);
+        struct FloydWarshall *init=NULL, *fw[FW_CHECK_RUNS]={NULL,NULL,NULL};
+        if(g==NULL){ printf("Out of Memory!"); return 1; }
+        std::vector<int> p(n), path(n);
+        for(int v=0;v<n;v++) p[v]=(int)(benchRand(&s)%1000);
+        for(int u=0;u<n;u++)
+            for(size_t e=g->off[u];e<g->off[u+1];e++) g->w[e]+=p[u]-p[g->to[e]];
+        if((init=floydWarshallCSR(g,0))==NULL){ freeCSRGraph(g); return 1; }
+        // init holds the lightest edge of every pair, which is also what the paths are made of
+        std::vector<std::vector<int> > ref(n,std::vector<int>(n,INF));
+        for(int u=0;u<n;u++)
+            for(int v=0;v<n;v++) if(fwDist(init,u,v)!=FW_INF) ref[u][v]=fwDist(init,u,v);
+        floydWarshall(n,ref);
+        for(int r=0;r<FW_CHECK_RUNS && !bad;r++){
+            // scalar and pooled runs keep predecessors, so both kernel sets run with and without them
+            const char *routine[]={"blocked/scalar","blocked/simd","blocked/pool"};
+            if((fw[r]=floydWarshallCSR(g,r!=1))==NULL){ bad=1; break; }
+            int cycle=r==0 ? floydWarshallKernels(fw[r],NULL,&fwScalarKernels) : floydWarshallRun(fw[r],r==2 ? pool : NULL);
+            if(cycle){
+                fprintf(stderr,"%s: negative cycle reported for n=%d with negative weights\n",routine[r],n); bad=1;
+            }
+            for(int u=0;u<n && !bad;u++)
+                for(int v=0;v<n && !bad;v++){
+                    int d=fwDist(fw[r],u,v);
+                    if(d!=(ref[u][v]==INF ? FW_INF : ref[u][v])){
+                        fprintf(stderr,"%s: wrong distance %d->%d for n=%d with negative weights\n",routine[r],u,v,n); bad=1;
+                    }
+                    if(r==1 || bad) continue;
+                    int k=fwPath(fw[r],u,v,path.data());
+                    long long sum=0;
+                    for(int i=1;i<k;i++) sum+=fwDist(init,path[i-1],path[i]);
+                    if(d==FW_INF ? k!=0 : k<1 || path[0]!=u || path[k-1]!=v || sum!=d){
+                        fprintf(stderr,"%s: wrong path %d->%d for n=%d with negative weights\n",routine[r],u,v,n); bad=1;
+                    }
+                }
+        }
+        for(int r=0;r<FW_CHECK_RUNS;r++) freeFloydWarshall(fw[r]);
+        freeFloydWarshall(init); freeCSRGraph(g);
+    }
+    if(bad) return 1;
+    // a path 0->1->...->69 and a self-loop of -1 on vertex 40 (and a harmless one of 5 on 10)
+    int src[71], dst[71], w[71];
+    for(int v=0;v<69;v++){ src[v]=v; dst[v]=v+1; w[v]=1; }
+    src[69]=dst[69]=40; w[69]=-1;
+    src[70]=dst[70]=10; w[70]=5;
+    struct CSRGraph *g=newCSRGraph(70,71,src,dst,w,CSR_DIRECTED);
+    struct FloydWarshall *fw=g ? floydWarshallCSR(g,1) : NULL;
+    if(fw==NULL){ freeCSRGraph(g); return 1; }
+    if(floydWarshallRun(fw,pool)!=1 || fwDist(fw,40,40)>=0){
+        fprintf(stderr,"blocked: negative self-loop not reported as a negative cycle\n"); bad=1;
+    }
+    freeFloydWarshall(fw); freeCSRGraph(g);
+    return bad;
+}
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    cfg.minN=256; cfg.maxN=4096; cfg.factor=2;
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    // one pool per point of the scaling curve past one thread
+    struct Pool *full=newPool(cfg.threads), *pools[FW_MAX_POOLS]; int sizes[FW_MAX_POOLS], npools=0;
+    if(full==NULL){ printf("Out of Memory!"); return 1; }
+    for(int t=2;t<poolThreads(full) && npools<FW_MAX_POOLS-1;t*=2){ sizes[npools]=t; pools[npools++]=newPool(t); }
+    if(poolThreads(full)>1){ sizes[npools]=poolThreads(full); pools[npools++]=full; }
+    fprintf(stderr,"Floyd-Warshall kernels: %s\n",fwKernels()->isa);
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"floyd-warshall");
+    int failed=checkNegative(full,cfg.seed);
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        struct CSRGraph *g=csrRandomGraph((int)n,16,1000,CSR_DIRECTED,cfg.seed);
+        struct FWCtx *ctx=new FWCtx();
+        ctx->n=(int)n;
+        if(g==NULL || (ctx->init=floydWarshallCSR(g,1))==NULL || (ctx->flat=(int*)malloc(n*n*sizeof(int)))==NULL){
+            printf("Out of Memory!"); return 1;
+        }
+        if(n<=FW_REF_MAX){
+            ctx->input.assign(n,std::vector<int>(n,INF));
+            for(int u=0;u<(int)n;u++){
+                ctx->input[u][u]=0;
+                for(int v=0;v<(int)n;v++) if(u!=v && fwDist(ctx->init,u,v)!=FW_INF) ctx->input[u][v]=fwDist(ctx->init,u,v);
+            }
+        }
+        size_t reps=(size_t)(4e9/((double)n*n*n));
+        if(reps<1) reps=1;
+        if(reps>20) reps=20;
+        int rows=5+npools, refDone=0; long long ref=0;
+        for(int r=0;r<rows;r++){
+            char name[64];
+            const char *routine[]={"reference","flat","blocked/scalar","blocked/simd","blocked/pred"};
+            if(r<5) snprintf(name,sizeof(name),"%s",routine[r]);
+            else snprintf(name,sizeof(name),"blocked/t%d",sizes[r-5]);
+            if(r==0 && n>FW_REF_MAX) continue;
+            if(!benchSelected(&cfg,name) && refDone) continue;   // the first row always runs
+            if(r>=2 && (ctx->fw=newFloydWarshall((int)n,r==4))==NULL){
+                printf("Out of Memory!"); return 1;
+            }
+            ctx->pool=r>=5 ? pools[r-5] : NULL;
+            long long (*run)(void*,size_t,size_t)=r==0 ? runReference : r==1 ? runFlat : r==2 ? runScalar : runBlocked;
+            void (*setup)(void*,size_t,size_t)=r==0 ? setupReference : r==1 ? setupFlat : setupBlocked;
+            struct BenchCase bc={name,n,reps,1,run,setup,ctx,n*n*n};
+            struct BenchResult res=benchMeasure(&cfg,&bc);
+            if(benchSelected(&cfg,name)) benchReportResult(&rep,&res);
+            long long one=res.checksum/(long long)res.ops;
+            if(!refDone){ refDone=1; ref=one; }
+            else if(one!=ref){
+                fprintf(stderr,"%s: wrong result for n=%zu\n",name,n); failed=1;
+            }
+            if(r>=2){ freeFloydWarshall(ctx->fw); ctx->fw=NULL; }
+        }
+        ctx->input.clear(); ctx->ref.clear();
+        freeFloydWarshall(ctx->init); free(ctx->flat); delete ctx;
+        freeCSRGraph(g);
+    }
+    benchReportEnd(&rep);
+    if(npools==0) freePool(full);
+    for(int i=0;i<npools;i++) freePool(pools[i]);
+    return failed;
+}
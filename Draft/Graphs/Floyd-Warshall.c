@@ -0,0 +1,262 @@
+#ifndef FLOYD_WARSHALL_C
+#define FLOYD_WARSHALL_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<limits.h>
+#include"CSR Graph.h"
+#include"../Parallel/Work-Stealing Pool.h"
+// All-pairs shortest paths with a blocked (tiled) Floyd-Warshall over one contiguous matrix.
+// The matrix is cut into FW_BLOCK x FW_BLOCK tiles, and round K makes the vertices of tile K
+// available as intermediates in three phases:
+//   1. the diagonal tile (K,K), with itself
+//   2. the row panel (K,J) and the column panel (I,K), each tile with the diagonal one, in parallel
+//   3. every other tile (I,J) from (I,K) and (K,J), which phase 2 finished, in parallel
+// A tile is 16KB, so each phase works on at most three tiles that fit in L1/L2, instead of
+// streaming the whole matrix once per vertex as the textbook k,i,j loop does.
+// Phase 3 does almost all the work and reads nothing it writes, so its min-plus kernel keeps a
+// row of the output tile in vector registers over the whole k loop. Each kernel has an AVX2
+// copy and a scalar copy, and the best one is picked at runtime.
+//
+// Distances are ints with FW_INF for no path; FW_INF+FW_INF does not overflow, so the kernels
+// need no test for it. Weights may be negative as long as no path comes within FW_INF/2 of
+// overflow, so FW_INF plus a negative sum stays recognisable as no path.
+//
+//   struct FloydWarshall *fw=newFloydWarshall(n,1);  // 1: keep a predecessor matrix for fwPath()
+//   fwAddEdge(fw,u,v,w); ...                          // or floydWarshallCSR(g,1)
+//   floydWarshallRun(fw,pool);                        // pool may be NULL
+//   fwDist(fw,u,v); fwPath(fw,u,v,path);
+//   freeFloydWarshall(fw);
+#define FW_INF (INT_MAX/2)
+#define FW_BLOCK 64                 // tile side; rows are padded to a multiple of it
+
+struct FloydWarshall{
+    int n, nb;                      // vertices, tiles per side
+    size_t stride;                  // ints per row, nb*FW_BLOCK
+    int *dist;                      // dist[u*stride+v]
+    int *pred;                      // pred[u*stride+v]: vertex before v on a shortest u-v path, -1 for none; may be NULL
+};
+
+static void freeFloydWarshall(struct FloydWarshall *fw){
+    if(fw==NULL) return;
+    free(fw->dist); free(fw->pred); free(fw);
+}
+// n vertices and no edges: 0 on the diagonal, FW_INF elsewhere. NULL when out of memory
+static struct FloydWarshall *newFloydWarshall(int n, int withPred){
+    struct FloydWarshall *fw=(struct FloydWarshall*)calloc(1,sizeof(struct FloydWarshall));
+    size_t cells=0;
+    if(fw==NULL || n<0) goto fail;
+    fw->n=n; fw->nb=(n+FW_BLOCK-1)/FW_BLOCK; if(fw->nb==0) fw->nb=1;
+    fw->stride=(size_t)fw->nb*FW_BLOCK;
+    cells=fw->stride*fw->stride;
+    if(posix_memalign((void**)&fw->dist,POOL_LINE,cells*sizeof(int))!=0){ fw->dist=NULL; goto fail; }
+    if(withPred && posix_memalign((void**)&fw->pred,POOL_LINE,cells*sizeof(int))!=0){ fw->pred=NULL; goto fail; }
+    // the padding rows and columns stay FW_INF, even on the diagonal, so they never shorten a path
+    for(size_t c=0;c<cells;c++) fw->dist[c]=FW_INF;
+    for(int v=0;v<n;v++) fw->dist[v*fw->stride+v]=0;
+    if(fw->pred) for(size_t c=0;c<cells;c++) fw->pred[c]=-1;
+    return fw;
+fail:
+    printf("Out of Memory!");
+    freeFloydWarshall(fw);
+    return NULL;
+}
+// Edge u->v of weight w; parallel edges keep the lightest
+static inline void fwAddEdge(struct FloydWarshall *fw, int u, int v, int w){
+    size_t c=u*fw->stride+v;
+    if(w<fw->dist[c]){
+        fw->dist[c]=w;
+        if(fw->pred) fw->pred[c]=u;
+    }
+}
+// The edges of g; a self-loop only counts when negative, as dist[u][u]=min(0,w), so that
+// floydWarshallRun() reports it as a negative cycle
+static inline struct FloydWarshall *floydWarshallCSR(const struct CSRGraph *g, int withPred){
+    struct FloydWarshall *fw=newFloydWarshall(g->n,withPred);
+    if(fw==NULL) return NULL;
+    for(int u=0;u<g->n;u++)
+        for(size_t e=g->off[u];e<g->off[u+1];e++) fwAddEdge(fw,u,g->to[e],g->w[e]);
+    return fw;
+}
+static inline int fwDist(const struct FloydWarshall *fw, int u, int v){
+    return fw->dist[u*fw->stride+v];
+}
+// Writes the shortest u-v path into path (room for n vertices) and returns its vertex count,
+// 0 when v is unreachable or there is no predecessor matrix
+static inline int fwPath(const struct FloydWarshall *fw, int u, int v, int *path){
+    if(fw->pred==NULL || fwDist(fw,u,v)==FW_INF) return 0;
+    int k=0;
+    for(int x=v;;x=fw->pred[u*fw->stride+x]){
+        if(x<0 || k==fw->n) return 0;                 // broken by a negative cycle
+        path[k++]=x;
+        if(x==u) break;
+    }
+    for(int i=0,j=k-1;i<j;i++,j--){ int t=path[i]; path[i]=path[j]; path[j]=t; }
+    return k;
+}
+
+// Tile kernels on rows of stride s. C(i,j)=min(C(i,j),A(i,k)+B(k,j)); when C improves, PC takes
+// the predecessor PB(k,j) (PC is NULL without a predecessor matrix).
+//   update   k outer, in place: C may be A or B, as in phases 1 and 2
+//   minPlus  C is neither A nor B, as in phase 3: any order works, so i outer
+struct FWKernels{
+    const char *isa;
+    void (*update)(int *C, const int *A, const int *B, int *PC, const int *PB, size_t s);
+    void (*minPlus)(int *C, const int *A, const int *B, int *PC, const int *PB, size_t s);
+};
+// One row: c=min(c,a+b), branch-free so the compiler vectorises it
+static inline void fwRowScalar(int *__restrict c, const int *__restrict b, int a, int *__restrict pc, const int *__restrict pb){
+    if(pc==NULL)
+        for(int j=0;j<FW_BLOCK;j++){ int t=a+b[j]; c[j]=t<c[j] ? t : c[j]; }
+    else
+        for(int j=0;j<FW_BLOCK;j++){ int t=a+b[j], lt=t<c[j]; pc[j]=lt ? pb[j] : pc[j]; c[j]=lt ? t : c[j]; }
+}
+static void fwUpdateScalar(int *C, const int *A, const int *B, int *PC, const int *PB, size_t s){
+    for(int k=0;k<FW_BLOCK;k++)
+        for(int i=0;i<FW_BLOCK;i++){
+            // row k of a tile that is also B would be relaxed with itself: min(d,d(k,k)+d) changes
+            // nothing unless d(k,k)<0, and then the cycle is already on the diagonal
+            if(C==B && i==k) continue;
+            fwRowScalar(C+i*s,B+k*s,A[i*s+k],PC ? PC+i*s : NULL,PC ? PB+k*s : NULL);
+        }
+}
+static void fwMinPlusScalar(int *C, const int *A, const int *B, int *PC, const int *PB, size_t s){
+    for(int i=0;i<FW_BLOCK;i++)
+        for(int k=0;k<FW_BLOCK;k++)
+            fwRowScalar(C+i*s,B+k*s,A[i*s+k],PC ? PC+i*s : NULL,PC ? PB+k*s : NULL);
+}
+#if defined(__x86_64__) || defined(__i386__)
+#include<immintrin.h>
+// The matrix is 64-byte aligned and rows are a multiple of 256 bytes, so every load is aligned
+__attribute__((target("avx2")))
+static void fwUpdateAvx2(int *C, const int *A, const int *B, int *PC, const int *PB, size_t s){
+    for(int k=0;k<FW_BLOCK;k++)
+        for(int i=0;i<FW_BLOCK;i++){
+            __m256i a=_mm256_set1_epi32(A[i*s+k]);
+            for(int j=0;j<FW_BLOCK;j+=8){
+                __m256i *c=(__m256i*)(C+i*s+j);
+                __m256i t=_mm256_add_epi32(a,_mm256_load_si256((const __m256i*)(B+k*s+j)));
+                if(PC){
+                    __m256i lt=_mm256_cmpgt_epi32(*c,t), *p=(__m256i*)(PC+i*s+j);
+                    *p=_mm256_blendv_epi8(*p,_mm256_load_si256((const __m256i*)(PB+k*s+j)),lt);
+                }
+                *c=_mm256_min_epi32(*c,t);
+            }
+        }
+}
+// Two half rows of C (2x32 ints, eight registers) stay in registers for the whole k loop, so
+// each row of B loaded serves both: per k, two broadcasts, four loads, eight adds and eight mins
+__attribute__((target("avx2")))
+static void fwMinPlusAvx2(int *C, const int *A, const int *B, int *PC, const int *PB, size_t s){
+    for(int i=0;i<FW_BLOCK;i+=2)
+        for(int h=0;h<FW_BLOCK;h+=32){
+            __m256i *c=(__m256i*)(C+i*s+h), *d=(__m256i*)(C+(i+1)*s+h);
+            const int *ai=A+i*s, *aj=A+(i+1)*s;
+            if(PC==NULL){
+                __m256i c0=c[0], c1=c[1], c2=c[2], c3=c[3], d0=d[0], d1=d[1], d2=d[2], d3=d[3];
+                for(int k=0;k<FW_BLOCK;k++){
+                    __m256i a=_mm256_set1_epi32(ai[k]), e=_mm256_set1_epi32(aj[k]);
+                    const __m256i *b=(const __m256i*)(B+k*s+h);
+                    __m256i b0=b[0], b1=b[1], b2=b[2], b3=b[3];
+                    c0=_mm256_min_epi32(c0,_mm256_add_epi32(a,b0)); d0=_mm256_min_epi32(d0,_mm256_add_epi32(e,b0));
+                    c1=_mm256_min_epi32(c1,_mm256_add_epi32(a,b1)); d1=_mm256_min_epi32(d1,_mm256_add_epi32(e,b1));
+                    c2=_mm256_min_epi32(c2,_mm256_add_epi32(a,b2)); d2=_mm256_min_epi32(d2,_mm256_add_epi32(e,b2));
+                    c3=_mm256_min_epi32(c3,_mm256_add_epi32(a,b3)); d3=_mm256_min_epi32(d3,_mm256_add_epi32(e,b3));
+                }
+                c[0]=c0; c[1]=c1; c[2]=c2; c[3]=c3; d[0]=d0; d[1]=d1; d[2]=d2; d[3]=d3;
+            }
+            else{
+                // a predecessor register per distance register: one row at a time
+                for(int r=0;r<2;r++){
+                    __m256i *cr=r ? d : c, *p=(__m256i*)(PC+(i+r)*s+h);
+                    const int *ar=r ? aj : ai;
+                    __m256i c0=cr[0], c1=cr[1], c2=cr[2], c3=cr[3], p0=p[0], p1=p[1], p2=p[2], p3=p[3];
+#define FW_PRED_STEP(cx,px,x) do{ \
+    __m256i t_=_mm256_add_epi32(a,b[x]), lt_=_mm256_cmpgt_epi32(cx,t_); \
+    cx=_mm256_min_epi32(cx,t_); px=_mm256_blendv_epi8(px,q[x],lt_); \
+}while(0)
+                    for(int k=0;k<FW_BLOCK;k++){
+                        __m256i a=_mm256_set1_epi32(ar[k]);
+                        const __m256i *b=(const __m256i*)(B+k*s+h), *q=(const __m256i*)(PB+k*s+h);
+                        FW_PRED_STEP(c0,p0,0); FW_PRED_STEP(c1,p1,1); FW_PRED_STEP(c2,p2,2); FW_PRED_STEP(c3,p3,3);
+                    }
+#undef FW_PRED_STEP
+                    cr[0]=c0; cr[1]=c1; cr[2]=c2; cr[3]=c3; p[0]=p0; p[1]=p1; p[2]=p2; p[3]=p3;
+                }
+            }
+        }
+}
+#endif
+static const struct FWKernels fwScalarKernels={"scalar",fwUpdateScalar,fwMinPlusScalar};
+// Picks the widest kernel the CPU supports; resolved once, on first use
+static const struct FWKernels *fwKernels(void){
+    static const struct FWKernels *chosen=NULL;
+    if(chosen!=NULL) return chosen;
+#if defined(__x86_64__) || defined(__i386__)
+    static const struct FWKernels avx2={"avx2",fwUpdateAvx2,fwMinPlusAvx2};
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) return chosen=&avx2;
+#endif
+    return chosen=&fwScalarKernels;
+}
+
+struct FWRound{struct FloydWarshall *fw; struct Pool *pool; const struct FWKernels *kern; int K;};
+static inline size_t fwTile(const struct FloydWarshall *fw, int I, int J){
+    return (size_t)I*FW_BLOCK*fw->stride+(size_t)J*FW_BLOCK;
+}
+// One call per tile: (K,t) for t<nb, then (t-nb,K)
+static void fwPanelBody(void *arg, size_t begin, size_t end){
+    struct FWRound *r=(struct FWRound*)arg;
+    struct FloydWarshall *fw=r->fw;
+    int *d=fw->dist, *p=fw->pred; size_t kk=fwTile(fw,r->K,r->K);
+    for(size_t t=begin;t<end;t++){
+        int row=t<(size_t)fw->nb, J=row ? (int)t : (int)t-fw->nb;
+        if(J==r->K) continue;
+        size_t c=row ? fwTile(fw,r->K,J) : fwTile(fw,J,r->K);
+        // row panel: A is the diagonal tile; column panel: B is
+        r->kern->update(d+c,d+(row ? kk : c),d+(row ? c : kk),p ? p+c : NULL,p ? p+(row ? c : kk) : NULL,fw->stride);
+    }
+}
+static void fwRestBody(void *arg, size_t begin, size_t end){
+    struct FWRound *r=(struct FWRound*)arg;
+    struct FloydWarshall *fw=r->fw;
+    int *d=fw->dist, *p=fw->pred;
+    for(size_t t=begin;t<end;t++){
+        int I=(int)(t/fw->nb), J=(int)(t%fw->nb);
+        if(I==r->K || J==r->K) continue;
+        size_t c=fwTile(fw,I,J), a=fwTile(fw,I,r->K), b=fwTile(fw,r->K,J);
+        r->kern->minPlus(d+c,d+a,d+b,p ? p+c : NULL,p ? p+b : NULL,fw->stride);
+    }
+}
+// Runs on the pool: each poolParallelFor inside it forks onto the workers already running
+static void fwRoot(void *arg){
+    struct FWRound *r=(struct FWRound*)arg;
+    struct FloydWarshall *fw=r->fw;
+    size_t nb=(size_t)fw->nb;
+    for(r->K=0;r->K<fw->nb;r->K++){
+        size_t kk=fwTile(fw,r->K,r->K);
+        r->kern->update(fw->dist+kk,fw->dist+kk,fw->dist+kk,fw->pred ? fw->pred+kk : NULL,fw->pred ? fw->pred+kk : NULL,fw->stride);
+        poolParallelFor(r->pool,0,2*nb,1,fwPanelBody,r);
+        poolParallelFor(r->pool,0,nb*nb,1,fwRestBody,r);
+    }
+}
+// floydWarshallRun() with the given kernels, e.g. fwScalarKernels to measure what SIMD adds
+static int floydWarshallKernels(struct FloydWarshall *fw, struct Pool *pool, const struct FWKernels *kern){
+    struct FWRound r={fw,pool,kern,0};
+    poolRun(pool,fwRoot,&r);
+    int cycle=0;
+    for(int u=0;u<fw->n;u++){
+        int *d=fw->dist+u*fw->stride;
+        for(int v=0;v<fw->n;v++)
+            if(d[v]>FW_INF/2){ d[v]=FW_INF; if(fw->pred) fw->pred[u*fw->stride+v]=-1; }
+        if(d[u]<0) cycle=1;
+    }
+    return cycle;
+}
+// Shortest distances between all pairs, in place; 0, or 1 when there is a negative cycle (some
+// dist[v][v]<0; the other distances are then meaningless). Paths that only went through
+// unreachable vertices are reset to FW_INF at the end.
+static inline int floydWarshallRun(struct FloydWarshall *fw, struct Pool *pool){
+    return floydWarshallKernels(fw,pool,fwKernels());
+}
+#endif
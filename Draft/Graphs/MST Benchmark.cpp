@@ -0,0 +1,313 @@
+// Benchmark for Minimum Spanning Tree.c against kruskal() of daily/day_001/kruskal_s_algorithm_for_minimum_spanning_tree.md,
+// which sorts every edge and joins them through a recursive union-find, and prim() of
+// daily/day_001/prim_s_algorithm_for_minimum_spanning_tree.md, which keeps a lazy std::priority_queue.
+// Built as C++ only for those references.
+// Build: g++ -O2 -pthread -o mst_bench "MST Benchmark.cpp"
+// Run:   ./mst_bench --min 1048576 --max 16777216 --threads 16 --json mst.json
+// Connected graphs of about n edges with weights 1..2^20 (ns/item = per edge):
+//   sparse   n/4 nodes (at least 2), each joined to a random earlier node, the rest random pairs: degree 8
+//   dense    the complete graph on about sqrt(2n) nodes
+// Routines:
+//   reference/kruskal     the daily kruskal() on a fresh copy of the edges
+//   reference/prim        the daily prim() from node 0 over adjacency lists built beforehand
+//   filter-kruskal        mstFilterKruskal() on a fresh copy of the edges
+//   boruvka/t<k>          mstBoruvka() on a pool of k workers, k = 1, 2, 4, ... --threads
+// Every row reports the number of tree edges, which must match the first row; untimed, each tree
+// is checked to have no cycle and the weight of the daily kruskal() tree.
+// Untimed, before the runs: disconnected graphs, with edges inside 7 groups of nodes and the last
+// tenth of the nodes isolated, weights in -2^19..2^19 and self-loops (some of weight INT_MIN).
+// mstFilterKruskal() and mstBoruvka() on every pool must find a forest of n - components edges
+// without a cycle, of the weight they report and of the daily kruskal() forest's weight.
+#include<iostream>
+#include<vector>
+#include<queue>
+#include<limits>
+#include<algorithm>
+#include<numeric>
+#include<climits>
+#include"Minimum Spanning Tree.c"
+#include"CSR Graph.h"
+#include"../Benchmark/Benchmark.h"
+
+#define MST_MAX_POOLS 16
+#define MST_MAX_WEIGHT (1<<20)
+
+// The daily versions
+// DSU structure
+struct DSU {
+    std::vector<int> parent;
+    DSU(int n) {
+        parent.resize(n);
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    int find(int i) {
+        if (parent[i] == i)
+            return i;
+        return parent[i] = find(parent[i]);
+    }
+
+    void unite(int i, int j) {
+        int root_i = find(i);
+        int root_j = find(j);
+        if (root_i != root_j) {
+            parent[root_i] = root_j;
+        }
+    }
+};
+
+struct Edge {
+    int u, v, weight;
+    bool operator<(const Edge& other) const {
+        return weight < other.weight;
+    }
+};
+
+std::vector<Edge> kruskal(int numNodes, std::vector<Edge>& edges) {
+    std::sort(edges.begin(), edges.end());
+
+    DSU dsu(numNodes);
+    std::vector<Edge> mst_edges;
+    long long total_weight = 0;
+
+    for (const auto& edge : edges) {
+        if (dsu.find(edge.u) != dsu.find(edge.v)) {
+            dsu.unite(edge.u, edge.v);
+            mst_edges.push_back(edge);
+            total_weight += edge.weight;
+            // Optional: if (mst_edges.size() == numNodes - 1) break;
+        }
+    }
+    return mst_edges;
+}
+
+const long long INF = std::numeric_limits<long long>::max();
+
+// Pair of (weight, vertex)
+typedef std::pair<long long, int> pii;
+
+std::vector<std::pair<int, int>> prim(int startNode, int numNodes, const std::vector<std::vector<std::pair<int, int>>>& adj) {
+    std::vector<long long> min_weight(numNodes, INF);
+    std::vector<int> parent(numNodes, -1);
+    std::vector<bool> in_mst(numNodes, false);
+
+    std::priority_queue<pii, std::vector<pii>, std::greater<pii>> pq;
+
+    min_weight[startNode] = 0;
+    pq.push({0, startNode});
+
+    std::vector<std::pair<int, int>> mst_edges;
+
+    while (!pq.empty()) {
+        int u = pq.top().second;
+        pq.pop();
+
+        if (in_mst[u]) {
+            continue;
+        }
+        in_mst[u] = true;
+
+        if (parent[u] != -1) {
+            mst_edges.push_back({parent[u], u});
+        }
+
+        for (const auto& edge : adj[u]) {
+            int v = edge.first;
+            int weight = edge.second;
+
+            if (!in_mst[v] && weight < min_weight[v]) {
+                min_weight[v] = weight;
+                parent[v] = u;
+                pq.push({min_weight[v], v});
+            }
+        }
+    }
+    return mst_edges;
+}
+
+// Connected: a random tree first, then random pairs (sparse) or every pair (dense)
+static int mstGraph(int kind, size_t n, unsigned long long seed, std::vector<MSTEdge> &edges){
+    edges.clear();
+    int nodes;
+    if(kind==0){
+        nodes=n<8 ? 2 : (int)(n/4);          // random pairs need two nodes to differ
+        for(int v=1;v<nodes;v++) edges.push_back({(int)(csrRand(&seed)%(unsigned)v),v,0});
+        while(edges.size()<n){
+            int u=(int)(csrRand(&seed)%(unsigned)nodes), v=(int)(csrRand(&seed)%(unsigned)nodes);
+            if(u!=v) edges.push_back({u,v,0});
+        }
+    }
+    else{
+        nodes=2;
+        while((size_t)(nodes+1)*nodes/2<=n) nodes++;
+        for(int u=0;u<nodes;u++) for(int v=u+1;v<nodes;v++) edges.push_back({u,v,0});
+    }
+    for(size_t i=0;i<edges.size();i++) edges[i].w=1+(int)(csrRand(&seed)%MST_MAX_WEIGHT);
+    return nodes;
+}
+
+struct MSTCtx{
+    int nodes; const std::vector<MSTEdge> *edges;
+    const std::vector<std::vector<std::pair<int,int> > > *adj;
+    std::vector<Edge> refEdges; std::vector<MSTEdge> work;
+    std::vector<MSTEdge> tree; int count;
+    std::vector<std::pair<int,int> > primTree; int isPrim;
+    struct Pool *pool;
+};
+static void setupCopy(void *vctx, size_t begin, size_t end){
+    struct MSTCtx *c=(struct MSTCtx*)vctx; (void)begin; (void)end;
+    const std::vector<MSTEdge> &e=*c->edges;
+    c->refEdges.resize(e.size()); c->work=e;
+    for(size_t i=0;i<e.size();i++){ c->refEdges[i].u=e[i].u; c->refEdges[i].v=e[i].v; c->refEdges[i].weight=e[i].w; }
+}
+static long long runKruskal(void *vctx, size_t begin, size_t end){
+    struct MSTCtx *c=(struct MSTCtx*)vctx; (void)begin; (void)end;
+    std::vector<Edge> t=kruskal(c->nodes,c->refEdges);
+    c->tree.resize(t.size());
+    for(size_t i=0;i<t.size();i++){ c->tree[i].u=t[i].u; c->tree[i].v=t[i].v; c->tree[i].w=t[i].weight; }
+    return c->count=(int)t.size();
+}
+static long long runPrim(void *vctx, size_t begin, size_t end){
+    struct MSTCtx *c=(struct MSTCtx*)vctx; (void)begin; (void)end;
+    c->primTree=prim(0,c->nodes,*c->adj);
+    return c->count=(int)c->primTree.size();
+}
+static long long runFilterKruskal(void *vctx, size_t begin, size_t end){
+    struct MSTCtx *c=(struct MSTCtx*)vctx; (void)begin; (void)end;
+    long long w;
+    return c->count=mstFilterKruskal(c->nodes,c->work.data(),c->work.size(),c->tree.data(),&w);
+}
+static long long runBoruvka(void *vctx, size_t begin, size_t end){
+    struct MSTCtx *c=(struct MSTCtx*)vctx; (void)begin; (void)end;
+    long long w;
+    return c->count=mstBoruvka(c->nodes,c->edges->data(),c->edges->size(),c->tree.data(),&w,c->pool);
+}
+// The tree's weight, or -1 when its edges close a cycle; prim() edges take their lightest parallel weight
+static long long treeWeight(struct MSTCtx *c){
+    struct UnionFind *uf=newUnionFind(c->nodes);
+    long long w=0;
+    if(uf==NULL) return -1;
+    for(int i=0;i<c->count;i++){
+        int u, v, wt;
+        if(c->isPrim){
+            u=c->primTree[i].first; v=c->primTree[i].second; wt=INT_MAX;
+            for(size_t j=0;j<(*c->adj)[v].size();j++)
+                if((*c->adj)[v][j].first==u && (*c->adj)[v][j].second<wt) wt=(*c->adj)[v][j].second;
+        }
+        else{ u=c->tree[i].u; v=c->tree[i].v; wt=c->tree[i].w; }
+        if(!ufUnion(uf,u,v)){ w=-1; break; }
+        w+=wt;
+    }
+    freeUnionFind(uf);
+    return w;
+}
+
+// Sums the weight of k forest edges into *w; 0 when they close a cycle or UnionFind runs out of memory
+static int forestWeight(int n, const struct MSTEdge *e, int k, long long *w){
+    struct UnionFind *uf=newUnionFind(n);
+    int ok=uf!=NULL;
+    *w=0;
+    for(int i=0;ok && i<k;i++){ ok=ufUnion(uf,e[i].u,e[i].v); *w+=e[i].w; }
+    freeUnionFind(uf);
+    return ok;
+}
+// 0 when every routine finds the daily kruskal() forest's size and weight on every graph
+static int checkForest(struct Pool **pools, int npools, unsigned seed){
+    static const int shape[][2]={{1,4},{10,40},{1000,4000},{30000,240000},{2000,200000}};
+    int bad=0;
+    for(size_t s=0;s<sizeof(shape)/sizeof(shape[0]) && !bad;s++){
+        int nodes=shape[s][0], grouped=nodes-nodes/10;
+        unsigned long long r=benchSeed(seed+(unsigned)s);
+        std::vector<MSTEdge> edges((size_t)shape[s][1]), work, out(nodes);
+        for(size_t i=0;i<edges.size();i++){
+            // group g holds the nodes g, g+7, g+14, ... below grouped
+            int u=(int)(benchRand(&r)%(unsigned)grouped), g=u%7;
+            int v=(int)(benchRand(&r)%(unsigned)((grouped-g+6)/7))*7+g;
+            int w=(int)(benchRand(&r)%MST_MAX_WEIGHT)-MST_MAX_WEIGHT/2;
+            if(i%16==0){ v=u; if(i%32==0) w=INT_MIN; }
+            edges[i].u=u; edges[i].v=v; edges[i].w=w;
+        }
+        std::vector<Edge> refEdges(edges.size());
+        for(size_t i=0;i<edges.size();i++){ refEdges[i].u=edges[i].u; refEdges[i].v=edges[i].v; refEdges[i].weight=edges[i].w; }
+        std::vector<Edge> ref=kruskal(nodes,refEdges);
+        long long refWeight=0;
+        for(size_t i=0;i<ref.size();i++) refWeight+=ref[i].weight;
+        struct UnionFind *uf=newUnionFind(nodes);
+        if(uf==NULL) return 1;
+        int joined=0;
+        for(size_t i=0;i<edges.size();i++) joined+=ufUnion(uf,edges[i].u,edges[i].v);
+        freeUnionFind(uf);
+        if((int)ref.size()!=joined){ fprintf(stderr,"reference/kruskal: wrong forest for %d nodes\n",nodes); return 1; }
+        // filter-kruskal, then boruvka without a pool and on every pool
+        for(int k=-2;k<npools && !bad;k++){
+            long long w, sum;
+            int count;
+            if(k==-2){ work=edges; count=mstFilterKruskal(nodes,work.data(),work.size(),out.data(),&w); }
+            else count=mstBoruvka(nodes,edges.data(),edges.size(),out.data(),&w,k<0 ? NULL : pools[k]);
+            if(count!=joined || !forestWeight(nodes,out.data(),count,&sum) || sum!=w || w!=refWeight){
+                if(k==-2) fprintf(stderr,"filter-kruskal: wrong forest for %d nodes\n",nodes);
+                else fprintf(stderr,"boruvka/t%d: wrong forest for %d nodes\n",k<0 ? 1 : poolThreads(pools[k]),nodes);
+                bad=1;
+            }
+        }
+    }
+    return bad;
+}
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    cfg.minN=1<<20; cfg.maxN=1<<22;
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    // one pool per point of the scaling curve
+    struct Pool *full=newPool(cfg.threads), *pools[MST_MAX_POOLS]; int sizes[MST_MAX_POOLS], npools=0;
+    if(full==NULL){ printf("Out of Memory!"); return 1; }
+    for(int t=1;t<poolThreads(full) && npools<MST_MAX_POOLS-1;t*=2){ sizes[npools]=t; pools[npools++]=newPool(t); }
+    sizes[npools]=poolThreads(full); pools[npools++]=full;
+    const char *graphs[]={"sparse","dense"};
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"mst");
+    int failed=checkForest(pools,npools,cfg.seed);
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        for(int gi=0;gi<2;gi++){
+            std::vector<MSTEdge> edges;
+            struct MSTCtx ctx;
+            ctx.nodes=mstGraph(gi,n,benchSeed(cfg.seed),edges);
+            std::vector<std::vector<std::pair<int,int> > > adj(ctx.nodes);
+            for(size_t i=0;i<edges.size();i++){
+                adj[edges[i].u].push_back({edges[i].v,edges[i].w});
+                adj[edges[i].v].push_back({edges[i].u,edges[i].w});
+            }
+            ctx.edges=&edges; ctx.adj=&adj; ctx.tree.resize(ctx.nodes); ctx.count=0; ctx.isPrim=0; ctx.pool=NULL;
+
+            // rows: reference/kruskal, reference/prim, filter-kruskal, boruvka/t*
+            int rows=3+npools, refDone=0; long long ref=0, refWeight=0;
+            for(int r=0;r<rows;r++){
+                char name[64]; int pi=-1;
+                long long (*run)(void*,size_t,size_t);
+                void (*setup)(void*,size_t,size_t)=NULL;
+                if(r==0){ snprintf(name,sizeof(name),"%s/reference/kruskal",graphs[gi]); run=runKruskal; setup=setupCopy; }
+                else if(r==1){ snprintf(name,sizeof(name),"%s/reference/prim",graphs[gi]); run=runPrim; }
+                else if(r==2){ snprintf(name,sizeof(name),"%s/filter-kruskal",graphs[gi]); run=runFilterKruskal; setup=setupCopy; }
+                else{ pi=r-3; snprintf(name,sizeof(name),"%s/boruvka/t%d",graphs[gi],sizes[pi]); run=runBoruvka; }
+                // the first row always runs
+                if(!benchSelected(&cfg,name) && refDone) continue;
+                ctx.pool=pi>=0 ? pools[pi] : NULL; ctx.isPrim=r==1;
+                struct BenchCase bc={name,edges.size(),3,1,run,setup,&ctx,edges.size()};
+                struct BenchResult res=benchMeasure(&cfg,&bc);
+                if(benchSelected(&cfg,name)) benchReportResult(&rep,&res);
+                long long one=res.checksum/(long long)res.ops, w=treeWeight(&ctx);
+                if(!refDone){ refDone=1; ref=one; refWeight=w; }
+                else if(one!=ref || w!=refWeight){
+                    fprintf(stderr,"%s: wrong result for n=%zu\n",name,n); failed=1;
+                }
+                if(w<0){ fprintf(stderr,"%s: tree with a cycle for n=%zu\n",name,n); failed=1; }
+            }
+            if(benchSelected(&cfg,graphs[gi]))
+                fprintf(stderr,"%s: %d nodes, %zu edges, tree of %lld edges weighing %lld\n",graphs[gi],ctx.nodes,edges.size(),ref,refWeight);
+        }
+    }
+    benchReportEnd(&rep);
+    for(int i=0;i<npools;i++) freePool(pools[i]);
+    return failed;
+}
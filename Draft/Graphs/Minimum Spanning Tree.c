@@ -0,0 +1,272 @@
+#ifndef MINIMUM_SPANNING_TREE_C
+#define MINIMUM_SPANNING_TREE_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<limits.h>
+#include"Union-Find.h"
+#include"../Parallel/Work-Stealing Pool.h"
+// Minimum spanning forest of an undirected edge list over nodes 0..n-1, two ways:
+//   mstFilterKruskal()  Kruskal without sorting every edge (Osipov, Sanders and Singler). The edges
+//                       are split quicksort style around a pivot weight; the light part is solved
+//                       first, after which every heavy edge whose ends the union-find already
+//                       connects is dropped before the heavy part is split in turn. On graphs with
+//                       many more edges than nodes most heavy edges go without ever being sorted.
+//                       Small parts are insertion sorted, and it stops at n-1 tree edges. One thread.
+//   mstBoruvka()        Boruvka's rounds on the workers of a Pool: every component picks its
+//                       lightest edge to another component, all picked edges join the tree at once,
+//                       and the edges now inside a component are dropped. Each round at least halves
+//                       the components. Picks are one atomic min per edge end on (weight, edge),
+//                       joins go through the lock-free ufUnionConcurrent(). Ties between equal
+//                       weights break on the edge position, so the picks never close a cycle.
+//                       With over 2x as many edges as nodes the rounds first run on the light
+//                       edges only (Filter-Kruskal's pivot, at most half of them), then on the heavy
+//                       ones still between components, of which few survive the light rounds.
+// Both write the tree edges to out (room for n-1), its weight to *weight, and return the number of
+// tree edges (n - components), or -1 when out of memory. Edges u==v are ignored.
+//
+//   struct MSTEdge *out=(struct MSTEdge*)malloc(n*sizeof(struct MSTEdge)); long long w;
+//   int k=mstFilterKruskal(n,edges,m,out,&w);      // reorders edges[]
+//   int k=mstBoruvka(n,edges,m,out,&w,pool);       // edges[] untouched, pool may be NULL, m < 2^32
+#define MST_SMALL 32            // parts of Filter-Kruskal insertion sorted
+#define MST_SAMPLE 255          // edges sampled for a Filter-Kruskal pivot, 15 on small parts
+#define MST_GRAIN 4096          // edges or nodes per task of mstBoruvka()
+
+struct MSTEdge{int u,v,w;};
+
+// Filter-Kruskal
+struct MSTKruskal{
+    struct UnionFind *uf;
+    struct MSTEdge *out; int count, need;
+    long long weight;
+    unsigned long long seed;
+};
+static inline void mstTake(struct MSTKruskal *k, const struct MSTEdge *e){
+    if(ufUnion(k->uf,e->u,e->v)){ k->out[k->count++]=*e; k->weight+=e->w; }
+}
+// Drops the edges inside one component, keeping the order of the rest; their number. Ahead of
+// more edges than nodes every node is pointed at its root, so each end costs one lookup.
+static size_t mstFilter(struct MSTKruskal *k, struct MSTEdge *e, size_t m){
+    int *parent=k->uf->parent;
+    size_t kept=0;
+    if(m>(size_t)k->uf->n){
+        for(int v=0;v<k->uf->n;v++) parent[v]=ufFind(k->uf,v);
+        for(size_t i=0;i<m;i++)
+            if(parent[e[i].u]!=parent[e[i].v]) e[kept++]=e[i];
+        return kept;
+    }
+    for(size_t i=0;i<m;i++)
+        if(ufFind(k->uf,e[i].u)!=ufFind(k->uf,e[i].v)) e[kept++]=e[i];
+    return kept;
+}
+static void mstInsertionSort(struct MSTEdge *e, size_t m){
+    for(size_t i=1;i<m;i++){
+        struct MSTEdge x=e[i]; size_t j=i;
+        while(j>0 && e[j-1].w>x.w){ e[j]=e[j-1]; j--; }
+        e[j]=x;
+    }
+}
+// A sampled weight with about 8x as many edges below it as tree edges are still missing (at most
+// half of the edges): a dense graph keeps its tree within the few lightest edges, which then are all
+// that gets split further while one filter pass drops nearly all of the rest
+static inline int mstPivot(const struct MSTEdge *e, size_t m, int need, unsigned long long *seed){
+    struct MSTEdge sample[MST_SAMPLE];
+    int size=m>(size_t)MST_SAMPLE*MST_SAMPLE ? MST_SAMPLE : 15;
+    for(int i=0;i<size;i++){
+        *seed=*seed*6364136223846793005ULL+1442695040888963407ULL;
+        sample[i]=e[(*seed>>33)%m];
+    }
+    mstInsertionSort(sample,size);
+    // one rank up: the lightest of the sample can fall far below the target
+    double light=8.0*need/(double)m;
+    return sample[(int)((light<0.5 ? light : 0.5)*size)+1].w;
+}
+static void mstFilterKruskalPart(struct MSTKruskal *k, struct MSTEdge *e, size_t m){
+    // the heavy side loops instead of recursing, so the depth is that of the light sides
+    while(m>0 && k->count<k->need){
+        if(m<=MST_SMALL){
+            mstInsertionSort(e,m);
+            for(size_t i=0;i<m && k->count<k->need;i++) mstTake(k,&e[i]);
+            return;
+        }
+        // [0,lt) lighter than the pivot, [lt,gt) equal, [gt,m) heavier
+        int p=mstPivot(e,m,k->need-k->count,&k->seed);
+        size_t lt=0, i=0, gt=m;
+        while(i<gt){
+            if(e[i].w<p){ struct MSTEdge t=e[i]; e[i]=e[lt]; e[lt]=t; lt++; i++; }
+            else if(e[i].w>p){ gt--; struct MSTEdge t=e[i]; e[i]=e[gt]; e[gt]=t; }
+            else i++;
+        }
+        mstFilterKruskalPart(k,e,lt);
+        for(i=lt;i<gt && k->count<k->need;i++) mstTake(k,&e[i]);
+        if(k->count>=k->need) return;
+        e+=gt; m=mstFilter(k,e,m-gt);
+    }
+}
+static int mstFilterKruskal(int n, struct MSTEdge *e, size_t m, struct MSTEdge *out, long long *weight){
+    struct MSTKruskal k;
+    *weight=0;
+    if(n<=0) return 0;
+    if((k.uf=newUnionFind(n))==NULL) return -1;
+    k.out=out; k.count=0; k.need=n-1; k.weight=0; k.seed=0x9E3779B97F4A7C15ULL^m;
+    mstFilterKruskalPart(&k,e,m);
+    freeUnionFind(k.uf);
+    *weight=k.weight;
+    return k.count;
+}
+
+// Boruvka
+struct MSTWorker{
+    struct MSTEdge *a; size_t n,cap;        // tree edges this worker added
+    char pad[POOL_LINE];                    // workers write their own entry only
+};
+struct MSTBoruvka{
+    struct Pool *pool; int threads, n;
+    struct UnionFind *uf;
+    unsigned long long *best;               // per component root: lightest (weight, edge) out of it
+    const struct MSTEdge *in;
+    struct MSTEdge *e, *next; size_t m;     // edges between components, and the buffer of the next round
+    size_t *kept;                           // edges each block of MST_GRAIN kept, then where they go
+    const struct MSTEdge *src;              // of mstSelect()
+    struct MSTEdge *scratch, *dst; int lo, hi;
+    struct MSTWorker *workers;
+    int linked, failed;
+};
+#define MST_NONE (~0ULL)
+
+static inline unsigned long long mstKey(int w, size_t i){
+    // flipping the sign bit orders negative weights first
+    return (unsigned long long)((unsigned)w^0x80000000u)<<32 | (unsigned long long)i;
+}
+static inline void mstMinKey(struct MSTBoruvka *b, int c, unsigned long long key){
+    if(b->threads==1){ if(key<b->best[c]) b->best[c]=key; return; }
+    unsigned long long old=__atomic_load_n(&b->best[c],__ATOMIC_RELAXED);
+    while(key<old && !__atomic_compare_exchange_n(&b->best[c],&old,key,1,__ATOMIC_RELAXED,__ATOMIC_RELAXED));
+}
+static void mstResetBody(void *arg, size_t begin, size_t end){
+    struct MSTBoruvka *b=(struct MSTBoruvka*)arg;
+    for(size_t v=begin;v<end;v++) b->best[v]=MST_NONE;
+}
+// Every parent is a root here (see mstFlattenBody), so one read finds an edge's components
+static void mstPickBody(void *arg, size_t begin, size_t end){
+    struct MSTBoruvka *b=(struct MSTBoruvka*)arg;
+    const int *parent=b->uf->parent;
+    for(size_t i=begin;i<end;i++){
+        int cu=parent[b->e[i].u], cv=parent[b->e[i].v];
+        if(cu==cv) continue;
+        unsigned long long key=mstKey(b->e[i].w,i);
+        mstMinKey(b,cu,key); mstMinKey(b,cv,key);
+    }
+}
+// An edge picked by the components at both its ends joins them once
+static void mstLinkBody(void *arg, size_t begin, size_t end){
+    struct MSTBoruvka *b=(struct MSTBoruvka*)arg;
+    struct MSTWorker *me=&b->workers[poolIndex(b->pool)];
+    int linked=0;
+    for(size_t c=begin;c<end;c++){
+        if(b->best[c]==MST_NONE) continue;
+        const struct MSTEdge *e=&b->e[(unsigned)b->best[c]];
+        if(b->threads>1 ? !ufUnionConcurrent(b->uf,e->u,e->v) : !ufUnion(b->uf,e->u,e->v)) continue;
+        if(me->n==me->cap){
+            size_t cap=me->cap ? 2*me->cap : 256;
+            struct MSTEdge *a=(struct MSTEdge*)realloc(me->a,cap*sizeof(struct MSTEdge));
+            if(a==NULL){ __atomic_store_n(&b->failed,1,__ATOMIC_RELAXED); return; }
+            me->a=a; me->cap=cap;
+        }
+        me->a[me->n++]=*e; linked=1;
+    }
+    if(linked) __atomic_store_n(&b->linked,1,__ATOMIC_RELAXED);
+}
+static void mstFlattenBody(void *arg, size_t begin, size_t end){
+    struct MSTBoruvka *b=(struct MSTBoruvka*)arg;
+    int *parent=b->uf->parent;
+    for(size_t v=begin;v<end;v++){
+        if(b->threads==1){ parent[v]=ufFind(b->uf,(int)v); continue; }
+        __atomic_store_n(&parent[v],ufFindConcurrent(b->uf,(int)v),__ATOMIC_RELAXED);
+    }
+}
+static void mstKeepBody(void *arg, size_t begin, size_t end){
+    struct MSTBoruvka *b=(struct MSTBoruvka*)arg;
+    const int *parent=b->uf->parent;
+    for(size_t k=begin;k<end;k++){
+        size_t from=k*MST_GRAIN, to=from+MST_GRAIN<b->m ? from+MST_GRAIN : b->m, at=from;
+        for(size_t i=from;i<to;i++){
+            struct MSTEdge e=b->src[i];
+            if(e.w>=b->lo && e.w<=b->hi && parent[e.u]!=parent[e.v]) b->scratch[at++]=e;
+        }
+        b->kept[k]=at-from;
+    }
+}
+static void mstGatherBody(void *arg, size_t begin, size_t end){
+    struct MSTBoruvka *b=(struct MSTBoruvka*)arg;
+    for(size_t k=begin;k<end;k++)
+        memcpy(b->dst+b->kept[k],b->scratch+k*MST_GRAIN,(b->kept[k+1]-b->kept[k])*sizeof(struct MSTEdge));
+}
+// The edges of src[0..b->m) weighing lo..hi between two components, in order, to dst; their
+// number. Each block of MST_GRAIN keeps its edges at its own front in scratch (src itself when
+// writable), then prefix sums over the blocks place them.
+static size_t mstSelect(struct MSTBoruvka *b, const struct MSTEdge *src, struct MSTEdge *scratch, struct MSTEdge *dst, int lo, int hi){
+    size_t blocks=(b->m+MST_GRAIN-1)/MST_GRAIN, at=0;
+    b->src=src; b->scratch=scratch; b->dst=dst; b->lo=lo; b->hi=hi;
+    poolParallelFor(b->pool,0,blocks,1,mstKeepBody,b);
+    for(size_t k=0;k<blocks;k++){ size_t c=b->kept[k]; b->kept[k]=at; at+=c; }
+    b->kept[blocks]=at;
+    poolParallelFor(b->pool,0,blocks,1,mstGatherBody,b);
+    return at;
+}
+// Rounds over b->e until no edge is left between components; parents stay flat
+static void mstRounds(struct MSTBoruvka *b){
+    size_t n=(size_t)b->n;
+    while(b->m>0 && !b->failed){
+        poolParallelFor(b->pool,0,n,MST_GRAIN,mstResetBody,b);
+        poolParallelFor(b->pool,0,b->m,MST_GRAIN,mstPickBody,b);
+        b->linked=0;
+        poolParallelFor(b->pool,0,n,MST_GRAIN,mstLinkBody,b);
+        if(!b->linked) break;
+        poolParallelFor(b->pool,0,n,MST_GRAIN,mstFlattenBody,b);
+        // drop the edges the round put inside a component
+        b->m=mstSelect(b,b->e,b->e,b->next,INT_MIN,INT_MAX);
+        struct MSTEdge *t=b->e; b->e=b->next; b->next=t;
+    }
+}
+static void mstBoruvkaRoot(void *arg){
+    struct MSTBoruvka *b=(struct MSTBoruvka*)arg;
+    size_t m=b->m;
+    int pivot=INT_MAX;
+    unsigned long long seed=0x9E3779B97F4A7C15ULL^m;
+    if(m>2*(size_t)b->n) pivot=mstPivot(b->in,m,b->n-1,&seed);
+    b->m=mstSelect(b,b->in,b->next,b->e,INT_MIN,pivot);
+    mstRounds(b);
+    if(pivot<INT_MAX && !b->failed){
+        b->m=m;
+        b->m=mstSelect(b,b->in,b->next,b->e,pivot+1,INT_MAX);
+        mstRounds(b);
+    }
+}
+static int mstBoruvka(int n, const struct MSTEdge *e, size_t m, struct MSTEdge *out, long long *weight, struct Pool *pool){
+    struct MSTBoruvka b;
+    memset(&b,0,sizeof(b));
+    *weight=0;
+    if(n<=0) return 0;
+    b.pool=pool; b.threads=poolThreads(pool); b.n=n; b.in=e; b.m=m;
+    size_t cap=m ? m : 1;
+    b.uf=newUnionFind(n);
+    b.best=(unsigned long long*)malloc((size_t)n*sizeof(unsigned long long));
+    b.e=(struct MSTEdge*)malloc(cap*sizeof(struct MSTEdge));
+    b.next=(struct MSTEdge*)malloc(cap*sizeof(struct MSTEdge));
+    b.kept=(size_t*)malloc((cap/MST_GRAIN+2)*sizeof(size_t));
+    b.workers=(struct MSTWorker*)calloc(b.threads,sizeof(struct MSTWorker));
+    int count=-1;
+    if(b.uf==NULL || b.best==NULL || b.e==NULL || b.next==NULL || b.kept==NULL || b.workers==NULL) goto done;
+    poolRun(pool,mstBoruvkaRoot,&b);
+    if(b.failed) goto done;
+    count=0;
+    for(int i=0;i<b.threads;i++)
+        for(size_t j=0;j<b.workers[i].n;j++){ out[count++]=b.workers[i].a[j]; *weight+=b.workers[i].a[j].w; }
+done:
+    if(count<0 && b.uf) printf("Out of Memory!");      // newUnionFind() said so already
+    if(b.workers) for(int i=0;i<b.threads;i++) free(b.workers[i].a);
+    freeUnionFind(b.uf); free(b.best); free(b.e); free(b.next); free(b.kept); free(b.workers);
+    return count;
+}
+#endif
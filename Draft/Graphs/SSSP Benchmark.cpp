@@ -0,0 +1,197 @@
+// Benchmark for Bellman-Ford.c and Delta Stepping.c against bellmanFord() of
+// daily/day_001/bellman_ford_algorithm.md, which makes |V|-1 full passes over a std::vector<Edge>.
+// Built as C++ only for that reference.
+// Build: g++ -O2 -pthread -o sssp_bench "SSSP Benchmark.cpp"
+// Run:   ./sssp_bench --min 1024 --max 4194304 --threads 16 --json sssp.json
+// Groups (ns/item = per vertex; the checksum is the sum of the distances):
+//   nonneg/random, nonneg/grid   weights in [1,1000]; random is undirected with average degree 8
+//     reference     the daily bellmanFord(), up to SSSP_REF_MAX vertices
+//     bellmanFord   passes with early exit, spfa   FIFO frontier queue
+//     dijkstra      Dijkstra.c with the radix heap, the sequential yardstick
+//     delta/t<k>    deltaSteppingRun() on a pool of k workers, k = 1, 2, 4, ... --threads:
+//                   the scaling curve (the engine and its edge partition are built untimed)
+//   negative/random  directed, weights w+p[u]-p[v] for random potentials p: many negative edges
+//                    but no negative cycle; reference, bellmanFord, spfa
+//   cycle/random     the same plus a planted negative cycle; the checksum is 1 when detected
+// Every row must match the first row of its group that ran.
+#include<vector>
+#include<limits>
+#include"Bellman-Ford.c"
+#include"Delta Stepping.c"
+#include"Dijkstra.c"
+#include"../Benchmark/Benchmark.h"
+
+#define SSSP_REF_MAX 8192
+#define SSSP_MAX_POOLS 16
+
+// The daily version, unchanged
+const long long INF = std::numeric_limits<long long>::max();
+struct Edge {
+    int u, v, weight;
+};
+std::vector<long long> referenceBellmanFord(int startNode, int numNodes, const std::vector<Edge>& edges) {
+    std::vector<long long> dist(numNodes, INF);
+    dist[startNode] = 0;
+
+    // Relax all edges V-1 times
+    for (int i = 0; i < numNodes - 1; ++i) {
+        for (const auto& edge : edges) {
+            int u = edge.u;
+            int v = edge.v;
+            int weight = edge.weight;
+
+            if (dist[u] != INF && dist[u] + weight < dist[v]) {
+                dist[v] = dist[u] + weight;
+            }
+        }
+    }
+
+    // Check for negative cycles
+    for (const auto& edge : edges) {
+        int u = edge.u;
+        int v = edge.v;
+        int weight = edge.weight;
+
+        if (dist[u] != INF && dist[u] + weight < dist[v]) {
+            std::vector<long long> result;
+            result.push_back(-1); // Indicator for negative cycle
+            return result;
+        }
+    }
+    return dist;
+}
+
+struct SsspCtx{
+    const struct CSRGraph *g; std::vector<Edge> edges; int cycle;   // cycle: checksums are detection flags
+    long long *dist; struct DeltaStepping *ds;
+};
+static long long sumDist(const long long *dist, int n){
+    long long sum=0;
+    for(int v=0;v<n;v++) if(dist[v]!=BF_INF) sum+=dist[v];
+    return sum;
+}
+// Whether the daily version found a negative cycle. Its marker is {-1}, which is no distance
+// vector even at n=1: without a negative cycle the start keeps distance 0
+static int referenceCycle(const std::vector<long long> &dist){
+    return dist.size()==1 && dist[0]==-1;
+}
+static long long runReference(void *vctx, size_t begin, size_t end){
+    struct SsspCtx *c=(struct SsspCtx*)vctx; (void)begin; (void)end;
+    std::vector<long long> dist=referenceBellmanFord(0,c->g->n,c->edges);
+    if(c->cycle) return referenceCycle(dist);
+    return sumDist(dist.data(),c->g->n);
+}
+#define SSSP_NEGATIVE(fn, algo) \
+static long long fn(void *vctx, size_t begin, size_t end){ \
+    struct SsspCtx *c=(struct SsspCtx*)vctx; (void)begin; (void)end; \
+    int r=algo(c->g,0,c->dist,NULL,NULL); \
+    if(c->cycle) return r==1; \
+    return r==0 ? sumDist(c->dist,c->g->n) : -1; \
+}
+SSSP_NEGATIVE(runBellmanFord,bellmanFord)
+SSSP_NEGATIVE(runSpfa,spfa)
+static long long runDijkstra(void *vctx, size_t begin, size_t end){
+    struct SsspCtx *c=(struct SsspCtx*)vctx; (void)begin; (void)end;
+    if(dijkstra(c->g,0,DIJKSTRA_RADIX,c->dist,NULL)!=0) return -1;
+    return sumDist(c->dist,c->g->n);
+}
+static long long runDelta(void *vctx, size_t begin, size_t end){
+    struct SsspCtx *c=(struct SsspCtx*)vctx; (void)begin; (void)end;
+    if(deltaSteppingRun(c->ds,0)!=0) return -1;
+    return sumDist(c->ds->dist,c->g->n);
+}
+
+struct SsspGroup{const char *name; int negative, cycle;};
+static const struct SsspGroup groups[]={
+    {"nonneg/random",0,0},{"nonneg/grid",0,0},{"negative/random",1,0},{"cycle/random",1,1},
+};
+
+// Directed random graph reweighted by random potentials; with cycle, three more edges 0->a->b->0
+// of total weight -1 close a negative cycle
+static struct CSRGraph *negativeGraph(int n, int cycle, unsigned long long seed){
+    struct CSRGraph *base=csrRandomGraph(n,8,1000,CSR_DIRECTED,seed);
+    if(base==NULL) return NULL;
+    size_t m=base->m, k=0;
+    int *src=(int*)malloc((m+3)*sizeof(int)), *dst=(int*)malloc((m+3)*sizeof(int)), *w=(int*)malloc((m+3)*sizeof(int));
+    int *p=(int*)malloc(n*sizeof(int));
+    struct CSRGraph *g=NULL;
+    if(src!=NULL && dst!=NULL && w!=NULL && p!=NULL){
+        for(int v=0;v<n;v++) p[v]=(int)(csrRand(&seed)%2000);
+        for(int u=0;u<n;u++)
+            for(size_t e=base->off[u];e<base->off[u+1];e++,k++){ src[k]=u; dst[k]=base->to[e]; w[k]=base->w[e]+p[u]-p[base->to[e]]; }
+        if(cycle){
+            int a=n/3, b=2*n/3;
+            src[k]=0; dst[k]=a; w[k++]=-3;
+            src[k]=a; dst[k]=b; w[k++]=1;
+            src[k]=b; dst[k]=0; w[k++]=1;
+        }
+        g=newCSRGraph(n,k,src,dst,w,CSR_DIRECTED);
+    }
+    free(src); free(dst); free(w); free(p);
+    freeCSRGraph(base);
+    return g;
+}
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    cfg.maxN=1<<22;
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    // one pool per point of the scaling curve
+    struct Pool *full=newPool(cfg.threads), *pools[SSSP_MAX_POOLS]; int sizes[SSSP_MAX_POOLS], npools=0;
+    if(full==NULL){ printf("Out of Memory!"); return 1; }
+    for(int t=1;t<poolThreads(full) && npools<SSSP_MAX_POOLS-1;t*=2){ sizes[npools]=t; pools[npools++]=newPool(t); }
+    sizes[npools]=poolThreads(full); pools[npools++]=full;
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"sssp");
+    int failed=0;
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        for(size_t gi=0;gi<sizeof(groups)/sizeof(groups[0]);gi++){
+            const struct SsspGroup *gr=&groups[gi];
+            int side=1;
+            while((size_t)(side+1)*(side+1)<=n) side++;
+            struct CSRGraph *g=gr->negative ? negativeGraph((int)n,gr->cycle,cfg.seed) :
+                               gi==1 ? csrGridGraph(side,1000,cfg.seed) : csrRandomGraph((int)n,8,1000,CSR_UNDIRECTED,cfg.seed);
+            struct SsspCtx *ctx=new SsspCtx();
+            if(g==NULL || (ctx->dist=(long long*)malloc(g->n*sizeof(long long)))==NULL){
+                printf("Out of Memory!"); return 1;
+            }
+            ctx->g=g; ctx->cycle=gr->cycle;
+            if(g->n<=SSSP_REF_MAX)
+                for(int u=0;u<g->n;u++)
+                    for(size_t e=g->off[u];e<g->off[u+1];e++) ctx->edges.push_back(Edge{u,g->to[e],g->w[e]});
+            size_t reps=cfg.ops*4/n;
+            if(reps<3) reps=3;
+            if(reps>200) reps=200;
+            // reference, bellmanFord, spfa, then for non-negative weights dijkstra and the curve
+            int rows=gr->negative ? 3 : 4+npools;
+            int refDone=0; long long ref=0;
+            for(int r=0;r<rows;r++){
+                char name[64]; long long (*run)(void*,size_t,size_t);
+                const char *routine[]={"reference","bellmanFord","spfa","dijkstra"};
+                if(r<4){ snprintf(name,sizeof(name),"%s/%s",gr->name,routine[r]); }
+                else snprintf(name,sizeof(name),"%s/delta/t%d",gr->name,sizes[r-4]);
+                run=r==0 ? runReference : r==1 ? runBellmanFord : r==2 ? runSpfa : r==3 ? runDijkstra : runDelta;
+                if(r==0 && g->n>SSSP_REF_MAX) continue;
+                if(!benchSelected(&cfg,name) && refDone) continue;   // the reference always runs
+                if(r>=4 && (ctx->ds=newDeltaStepping(g,0,pools[r-4]))==NULL){
+                    printf("Out of Memory!"); return 1;
+                }
+                struct BenchCase bc={name,(size_t)g->n,reps,1,run,NULL,ctx,(size_t)g->n};
+                struct BenchResult res=benchMeasure(&cfg,&bc);
+                if(benchSelected(&cfg,name)) benchReportResult(&rep,&res);
+                long long one=res.checksum/(long long)res.ops;
+                if(!refDone){ refDone=1; ref=one; }
+                else if(one!=ref){
+                    fprintf(stderr,"%s: wrong result for n=%zu\n",name,n); failed=1;
+                }
+                if(r>=4){ freeDeltaStepping(ctx->ds); ctx->ds=NULL; }
+            }
+            free(ctx->dist); delete ctx;
+            freeCSRGraph(g);
+        }
+    }
+    benchReportEnd(&rep);
+    for(int i=0;i<npools;i++) freePool(pools[i]);
+    return failed;
+}
@@ -0,0 +1,332 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_C
+#define STRONGLY_CONNECTED_COMPONENTS_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<limits.h>
+#include"CSR Graph.h"
+#include"../Parallel/Work-Stealing Pool.h"
+// Strongly connected components of a directed CSR graph: comp[v] is the component of v, in 0..count-1.
+//   sccTarjan()    Tarjan's algorithm with an explicit call stack and flat arrays, so deep graphs
+//                  cannot overflow the machine stack. Components are numbered in reverse
+//                  topological order: every edge between two components goes to a smaller id.
+//   sccParallel()  on the workers of a Pool, in the style of Hong, Rodia and Olukotun:
+//                    1. trim: a vertex without remaining in-edges or out-edges is a component alone
+//                    2. forward-backward: the vertices both reachable from and reaching a pivot of
+//                       high degree form its component, usually the giant one, found by two
+//                       parallel frontier expansions
+//                    3. coloring for the rest: every vertex takes the largest id that reaches it
+//                       (parallel label propagation), then each vertex whose own id won collects
+//                       the vertices of its color that reach it backwards. Colors are disjoint, so
+//                       the backward searches need no synchronisation. Repeat on what is left.
+//                  Needs the in-edges (csrTranspose()); component ids are in no particular order.
+// sccCondense() builds the condensation: one vertex per component and one edge per pair of
+// components joined by some edge, which is a DAG.
+//
+//   int *comp=malloc(n*sizeof(int));
+//   int count=sccTarjan(g,comp);             // or sccParallel(g,gt,comp,pool)
+//   struct CSRGraph *dag=sccCondense(g,comp,count);
+#define SCC_GRAIN 1024          // vertices per task
+#define SCC_TRIM_PASSES 3
+
+// Returns the number of components, or -1 when out of memory
+static int sccTarjan(const struct CSRGraph *g, int *comp){
+    int n=g->n, count=0, counter=0, sp=0;
+    size_t nn=n ? n : 1;
+    int *idx=(int*)calloc(nn,sizeof(int));          // discovery index, 0 unvisited, INT_MAX done
+    int *low=(int*)malloc(nn*sizeof(int));
+    int *stack=(int*)malloc(nn*sizeof(int));        // Tarjan's stack of open vertices
+    int *call=(int*)malloc(nn*sizeof(int));         // the call stack of the recursive version...
+    size_t *next=(size_t*)malloc(nn*sizeof(size_t)); // ...with the next edge each frame scans
+    if(idx==NULL || low==NULL || stack==NULL || call==NULL || next==NULL){
+        printf("Out of Memory!");
+        free(idx); free(low); free(stack); free(call); free(next);
+        return -1;
+    }
+    for(int r=0;r<n;r++){
+        if(idx[r]) continue;
+        int top=1;
+        idx[r]=low[r]=++counter; stack[sp++]=r;
+        call[0]=r; next[0]=g->off[r];
+        while(top>0){
+            int u=call[top-1];
+            size_t e=next[top-1];
+            if(e<g->off[u+1]){
+                int v=g->to[e];
+                next[top-1]=e+1;
+                if(idx[v]==0){                      // recurse into v
+                    idx[v]=low[v]=++counter; stack[sp++]=v;
+                    call[top]=v; next[top]=g->off[v]; top++;
+                }
+                else if(idx[v]<low[u]) low[u]=idx[v];   // only vertices on Tarjan's stack can pass
+            }
+            else{                                   // u returns
+                top--;
+                if(low[u]==idx[u]){
+                    int w;
+                    do{ w=stack[--sp]; comp[w]=count; idx[w]=INT_MAX; }while(w!=u);
+                    count++;
+                }
+                if(top>0 && low[u]<low[call[top-1]]) low[call[top-1]]=low[u];
+            }
+        }
+    }
+    free(idx); free(low); free(stack); free(call); free(next);
+    return count;
+}
+
+struct SCCVec{int *a; size_t n,cap;};
+struct SCCWorker{
+    struct SCCVec list;                     // vertices this worker found in the current step
+    struct SCCVec stack;                    // its backward search
+    long long found;
+    char pad[POOL_LINE];                    // workers write their own entry only
+};
+struct SCCParallel{
+    const struct CSRGraph *g, *gt; struct Pool *pool; int threads;
+    int *comp, count;                       // comp -1 while the vertex remains
+    int *color;
+    unsigned char *mark;                    // SCC_FORWARD, SCC_BACKWARD from the pivot
+    struct SCCVec work;                     // frontier, worklist or roots of the current step
+    struct SCCWorker *workers;
+    unsigned char bit;                      // mark set by the current expansion
+    int failed;
+};
+#define SCC_FORWARD 1
+#define SCC_BACKWARD 2
+
+static inline int sccPush(struct SCCVec *v, int x){
+    if(v->n==v->cap){
+        size_t cap=v->cap ? 2*v->cap : 256;
+        int *a=(int*)realloc(v->a,cap*sizeof(int));
+        if(a==NULL) return 0;
+        v->a=a; v->cap=cap;
+    }
+    v->a[v->n++]=x;
+    return 1;
+}
+static inline struct SCCWorker *sccSelf(struct SCCParallel *s){
+    return &s->workers[poolIndex(s->pool)];
+}
+static inline void sccAppend(struct SCCParallel *s, struct SCCWorker *me, int v){
+    if(!sccPush(&me->list,v)) __atomic_store_n(&s->failed,1,__ATOMIC_RELAXED);
+}
+// Concatenates the workers' lists into s->work
+static void sccGather(struct SCCParallel *s){
+    s->work.n=0;
+    for(int t=0;t<s->threads && !s->failed;t++){
+        struct SCCVec *l=&s->workers[t].list;
+        for(size_t i=0;i<l->n;i++)
+            if(!sccPush(&s->work,l->a[i])){ s->failed=1; break; }
+        l->n=0;
+    }
+}
+static inline int sccRemains(const struct SCCParallel *s, int v){
+    return __atomic_load_n(&s->comp[v],__ATOMIC_RELAXED)<0;
+}
+// A remaining vertex with no remaining in-neighbour or out-neighbour is a component alone. Two
+// neighbours trimmed at once are both right: each is a component alone either way.
+static inline int sccHasRemaining(const struct SCCParallel *s, const struct CSRGraph *g, int v){
+    for(size_t e=g->off[v];e<g->off[v+1];e++)
+        if(g->to[e]!=v && sccRemains(s,g->to[e])) return 1;
+    return 0;
+}
+static void sccTrimBody(void *arg, size_t begin, size_t end){
+    struct SCCParallel *s=(struct SCCParallel*)arg;
+    struct SCCWorker *me=sccSelf(s);
+    for(size_t v=begin;v<end;v++){
+        if(!sccRemains(s,(int)v)) continue;
+        if(sccHasRemaining(s,s->g,(int)v) && sccHasRemaining(s,s->gt,(int)v)) continue;
+        __atomic_store_n(&s->comp[v],__atomic_fetch_add(&s->count,1,__ATOMIC_RELAXED),__ATOMIC_RELAXED);
+        me->found++;
+    }
+}
+static void sccTrim(struct SCCParallel *s){
+    for(int pass=0;pass<SCC_TRIM_PASSES;pass++){
+        long long found=0;
+        for(int t=0;t<s->threads;t++) s->workers[t].found=0;
+        poolParallelFor(s->pool,0,(size_t)s->g->n,SCC_GRAIN,sccTrimBody,s);
+        for(int t=0;t<s->threads;t++) found+=s->workers[t].found;
+        if(found==0) break;
+    }
+}
+// One level of a reachability search over the remaining vertices, along g (forward) or gt (backward)
+static void sccReachBody(void *arg, size_t begin, size_t end){
+    struct SCCParallel *s=(struct SCCParallel*)arg;
+    struct SCCWorker *me=sccSelf(s);
+    const struct CSRGraph *g=s->bit==SCC_FORWARD ? s->g : s->gt;
+    for(size_t i=begin;i<end;i++){
+        int u=s->work.a[i];
+        for(size_t e=g->off[u];e<g->off[u+1];e++){
+            int v=g->to[e];
+            if(!sccRemains(s,v) || __atomic_load_n(&s->mark[v],__ATOMIC_RELAXED)&s->bit) continue;
+            if(__atomic_fetch_or(&s->mark[v],s->bit,__ATOMIC_RELAXED)&s->bit) continue;
+            sccAppend(s,me,v);
+        }
+    }
+}
+static void sccReach(struct SCCParallel *s, int pivot, unsigned char bit){
+    s->bit=bit; s->mark[pivot]|=bit;
+    s->work.n=0;
+    if(!sccPush(&s->work,pivot)){ s->failed=1; return; }
+    while(s->work.n>0 && !s->failed){
+        poolParallelFor(s->pool,0,s->work.n,SCC_GRAIN,sccReachBody,s);
+        sccGather(s);
+    }
+}
+static void sccColorInitBody(void *arg, size_t begin, size_t end){
+    struct SCCParallel *s=(struct SCCParallel*)arg;
+    struct SCCWorker *me=sccSelf(s);
+    for(size_t v=begin;v<end;v++)
+        if(sccRemains(s,(int)v)){ s->color[v]=(int)v; sccAppend(s,me,(int)v); }
+}
+// Pushes each worklist vertex's color along its out-edges with an atomic max; whatever it
+// raised goes on the next worklist
+static void sccColorBody(void *arg, size_t begin, size_t end){
+    struct SCCParallel *s=(struct SCCParallel*)arg;
+    struct SCCWorker *me=sccSelf(s);
+    const struct CSRGraph *g=s->g;
+    for(size_t i=begin;i<end;i++){
+        int u=s->work.a[i], c=__atomic_load_n(&s->color[u],__ATOMIC_RELAXED);
+        for(size_t e=g->off[u];e<g->off[u+1];e++){
+            int v=g->to[e];
+            if(!sccRemains(s,v)) continue;
+            int old=__atomic_load_n(&s->color[v],__ATOMIC_RELAXED);
+            while(old<c)
+                if(__atomic_compare_exchange_n(&s->color[v],&old,c,1,__ATOMIC_RELAXED,__ATOMIC_RELAXED)){
+                    sccAppend(s,me,v); break;
+                }
+        }
+    }
+}
+static void sccRootsBody(void *arg, size_t begin, size_t end){
+    struct SCCParallel *s=(struct SCCParallel*)arg;
+    struct SCCWorker *me=sccSelf(s);
+    for(size_t v=begin;v<end;v++)
+        if(sccRemains(s,(int)v) && s->color[v]==(int)v) sccAppend(s,me,(int)v);
+}
+// Each root r collects the vertices of color r that reach it: its component. A vertex has one
+// color, so no two roots touch the same vertex.
+static void sccBackwardBody(void *arg, size_t begin, size_t end){
+    struct SCCParallel *s=(struct SCCParallel*)arg;
+    struct SCCWorker *me=sccSelf(s);
+    const struct CSRGraph *gt=s->gt;
+    for(size_t i=begin;i<end;i++){
+        int r=s->work.a[i], id=__atomic_fetch_add(&s->count,1,__ATOMIC_RELAXED);
+        me->stack.n=0;
+        s->comp[r]=id;
+        if(!sccPush(&me->stack,r)){ __atomic_store_n(&s->failed,1,__ATOMIC_RELAXED); return; }
+        while(me->stack.n>0){
+            int u=me->stack.a[--me->stack.n];
+            for(size_t e=gt->off[u];e<gt->off[u+1];e++){
+                int v=gt->to[e];
+                if(s->color[v]!=r || s->comp[v]>=0) continue;
+                s->comp[v]=id;
+                if(!sccPush(&me->stack,v)){ __atomic_store_n(&s->failed,1,__ATOMIC_RELAXED); return; }
+            }
+        }
+    }
+}
+// Runs on the pool: each poolParallelFor inside it forks onto the workers already running
+static void sccRoot(void *arg){
+    struct SCCParallel *s=(struct SCCParallel*)arg;
+    const struct CSRGraph *g=s->g, *gt=s->gt;
+    int n=g->n;
+    sccTrim(s);
+    // forward-backward from the remaining vertex with the largest in-degree x out-degree
+    int pivot=-1; long long best=-1;
+    for(int v=0;v<n;v++){
+        if(!sccRemains(s,v)) continue;
+        long long d=(long long)(g->off[v+1]-g->off[v])*(long long)(gt->off[v+1]-gt->off[v]);
+        if(d>best){ best=d; pivot=v; }
+    }
+    if(pivot>=0){
+        sccReach(s,pivot,SCC_FORWARD);
+        sccReach(s,pivot,SCC_BACKWARD);
+        if(s->failed) return;
+        int id=s->count++;
+        for(int v=0;v<n;v++) if(s->mark[v]==(SCC_FORWARD|SCC_BACKWARD)) s->comp[v]=id;
+        sccTrim(s);
+    }
+    // coloring rounds until nothing remains
+    for(;;){
+        poolParallelFor(s->pool,0,(size_t)n,SCC_GRAIN,sccColorInitBody,s);
+        sccGather(s);
+        if(s->work.n==0 || s->failed) return;
+        while(s->work.n>0 && !s->failed){
+            poolParallelFor(s->pool,0,s->work.n,SCC_GRAIN,sccColorBody,s);
+            sccGather(s);
+        }
+        poolParallelFor(s->pool,0,(size_t)n,SCC_GRAIN,sccRootsBody,s);
+        sccGather(s);
+        if(s->failed) return;
+        poolParallelFor(s->pool,0,s->work.n,1,sccBackwardBody,s);
+        if(s->failed) return;
+        sccTrim(s);
+    }
+}
+// gt holds the in-edges of g (csrTranspose(g)); pool may be NULL (one thread).
+// Returns the number of components, or -1 when out of memory
+static int sccParallel(const struct CSRGraph *g, const struct CSRGraph *gt, int *comp, struct Pool *pool){
+    size_t n=g->n ? g->n : 1;
+    struct SCCParallel s;
+    memset(&s,0,sizeof(s));
+    s.g=g; s.gt=gt; s.pool=pool; s.threads=poolThreads(pool); s.comp=comp;
+    s.color=(int*)malloc(n*sizeof(int));
+    s.mark=(unsigned char*)calloc(n,1);
+    s.workers=(struct SCCWorker*)calloc(s.threads,sizeof(struct SCCWorker));
+    if(s.color==NULL || s.mark==NULL || s.workers==NULL) s.failed=1;
+    else{
+        for(int v=0;v<g->n;v++) comp[v]=-1;
+        poolRun(pool,sccRoot,&s);
+    }
+    if(s.failed) printf("Out of Memory!");
+    if(s.workers) for(int t=0;t<s.threads;t++){ free(s.workers[t].list.a); free(s.workers[t].stack.a); }
+    free(s.workers); free(s.color); free(s.mark); free(s.work.a);
+    return s.failed ? -1 : s.count;
+}
+
+// The condensation DAG: vertex c per component, and an edge c->d for each pair of components
+// joined by at least one edge, carrying the lightest such weight. NULL when out of memory
+static struct CSRGraph *sccCondense(const struct CSRGraph *g, const int *comp, int count){
+    size_t m=0, k=0;
+    for(int u=0;u<g->n;u++)
+        for(size_t e=g->off[u];e<g->off[u+1];e++) m+=comp[u]!=comp[g->to[e]];
+    int *src=(int*)malloc((m ? m : 1)*sizeof(int)), *dst=(int*)malloc((m ? m : 1)*sizeof(int));
+    int *w=(int*)malloc((m ? m : 1)*sizeof(int)), *last=(int*)malloc((count ? count : 1)*sizeof(int));
+    struct CSRGraph *dag=NULL;
+    if(src==NULL || dst==NULL || w==NULL || last==NULL){
+        printf("Out of Memory!");
+        goto done;
+    }
+    for(int u=0;u<g->n;u++)
+        for(size_t e=g->off[u];e<g->off[u+1];e++)
+            if(comp[u]!=comp[g->to[e]]){ src[k]=comp[u]; dst[k]=comp[g->to[e]]; w[k++]=g->w[e]; }
+    dag=newCSRGraph(count,m,src,dst,w,CSR_DIRECTED);
+    if(dag==NULL) goto done;
+    // merge parallel edges in place: last[d] is where c's edge to d went, while scanning c
+    for(int c=0;c<count;c++) last[c]=-1;
+    k=0;
+    for(int c=0;c<count;c++){
+        size_t begin=dag->off[c], start=k;
+        for(size_t e=begin;e<dag->off[c+1];e++){
+            int d=dag->to[e];
+            if(last[d]>=0 && (size_t)last[d]>=start){
+                if(dag->w[e]<dag->w[last[d]]) dag->w[last[d]]=dag->w[e];
+                continue;
+            }
+            last[d]=(int)k; dag->to[k]=d; dag->w[k++]=dag->w[e];
+        }
+        dag->off[c]=start;
+    }
+    dag->off[count]=k; dag->m=k;
+    dag->minW=dag->maxW=0;
+    for(size_t e=0;e<k;e++){
+        if(e==0 || dag->w[e]<dag->minW) dag->minW=dag->w[e];
+        if(e==0 || dag->w[e]>dag->maxW) dag->maxW=dag->w[e];
+    }
+done:
+    free(src); free(dst); free(w); free(last);
+    return dag;
+}
+#endif
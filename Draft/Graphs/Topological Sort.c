@@ -0,0 +1,330 @@
+#ifndef TOPOLOGICAL_SORT_C
+#define TOPOLOGICAL_SORT_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include"CSR Graph.h"
+#include"../Parallel/Work-Stealing Pool.h"
+// Kahn's algorithm on a CSR graph, on the workers of a Pool, for the graphs of jobs where an edge
+// u->v means v needs u finished first.
+//   topoLevels()   orders the nodes in wavefronts: level 0 is every node without in-edges, level
+//                  l+1 every node whose last in-edge comes from level l. All nodes of a level can
+//                  run at once. Each level is one parallel loop over the previous one that counts
+//                  down the in-degrees of its successors with atomics; a node whose count reaches
+//                  zero joins the next level. With node costs it also finishes the critical path:
+//                  finish[v] = cost[v] + the largest finish among the nodes v waits for.
+//   topoExecute()  runs fn(arg,v) for every node as soon as its last predecessor has finished,
+//                  without waiting for the rest of its level. Finishing a node counts down its
+//                  successors onto the worker's own list of ready nodes, which it works through
+//                  depth first; a few of them at a time are spawned as tasks for idle workers.
+//   topoExecuteLevels()  the level-scheduled alternative after topoLevels(): one parallel loop
+//                  per level, with a barrier between levels.
+// Both stop at a cycle: the nodes of one cycle go to t->cycle[0..ncycle) in edge order and
+// t->blocked counts every node that could not run (those on cycles and after them).
+//
+//   struct TopoSort *t=newTopoSort(g,pool);  // pool may be NULL (one thread)
+//   if(topoLevels(t,cost)==0) ...t->order[t->levelOff[l]..t->levelOff[l+1]) is level l,
+//                                 t->span the critical path, topoCriticalPath(t,path) its nodes
+//   topoExecute(t,fn,arg);                   // or topoExecuteLevels(t,fn,arg,0) after topoLevels()
+//   freeTopoSort(t);
+#define TOPO_GRAIN 1024         // frontier nodes per task
+#define TOPO_AHEAD 8            // frontier nodes prefetched ahead
+#define TOPO_SPAWN 4            // ready nodes topoExecute() keeps on offer per worker
+
+struct TopoVec{int *a; size_t n,cap;};
+struct TopoWorker{
+    struct TopoVec list;                    // nodes this worker made ready in the current level
+    struct TopoVec ready;                   // ready nodes its topoExecute() tasks have not run yet
+    long long ran;
+    char pad[POOL_LINE];                    // workers write their own entry only
+};
+struct TopoTask{struct PoolTask task; struct TopoSort *t; int v;};
+struct TopoSort{
+    const struct CSRGraph *g; struct Pool *pool; int threads;
+    int *indeg;                             // in-degrees still to count down
+    int *order, *levelOff, levels;          // level l is order[levelOff[l]..levelOff[l+1])
+    int *level;
+    const int *cost;                        // of the last topoLevels(), NULL is 1 per node
+    long long *finish, span;                // earliest finish of each node (with costs), and of all of them
+    int *pred;                              // scratch of the critical path and cycle searches
+    int *cycle, ncycle, blocked;
+    struct TopoWorker *workers;
+    struct TopoTask *tasks;                 // topoExecute(), allocated on first use
+    void (*fn)(void *arg, int v); void *arg; size_t grain;
+    long pending;
+    int failed;
+};
+
+static void freeTopoSort(struct TopoSort *t){
+    if(t==NULL) return;
+    if(t->workers) for(int i=0;i<t->threads;i++){ free(t->workers[i].list.a); free(t->workers[i].ready.a); }
+    free(t->indeg); free(t->order); free(t->levelOff); free(t->level); free(t->finish);
+    free(t->pred); free(t->cycle); free(t->workers); free(t->tasks); free(t);
+}
+static struct TopoSort *newTopoSort(const struct CSRGraph *g, struct Pool *pool){
+    struct TopoSort *t=(struct TopoSort*)calloc(1,sizeof(struct TopoSort));
+    size_t n=g->n ? g->n : 1;
+    if(t==NULL) goto fail;
+    t->g=g; t->pool=pool; t->threads=poolThreads(pool);
+    t->indeg=(int*)malloc(n*sizeof(int)); t->order=(int*)malloc(n*sizeof(int));
+    t->levelOff=(int*)malloc((n+1)*sizeof(int)); t->level=(int*)malloc(n*sizeof(int));
+    t->finish=(long long*)malloc(n*sizeof(long long));
+    t->pred=(int*)malloc(n*sizeof(int)); t->cycle=(int*)malloc(n*sizeof(int));
+    t->workers=(struct TopoWorker*)calloc(t->threads,sizeof(struct TopoWorker));
+    if(t->indeg==NULL || t->order==NULL || t->levelOff==NULL || t->level==NULL || t->finish==NULL ||
+       t->pred==NULL || t->cycle==NULL || t->workers==NULL) goto fail;
+    return t;
+fail:
+    printf("Out of Memory!");
+    freeTopoSort(t);
+    return NULL;
+}
+
+static inline int topoPush(struct TopoVec *v, int x){
+    if(v->n==v->cap){
+        size_t cap=v->cap ? 2*v->cap : 256;
+        int *a=(int*)realloc(v->a,cap*sizeof(int));
+        if(a==NULL) return 0;
+        v->a=a; v->cap=cap;
+    }
+    v->a[v->n++]=x;
+    return 1;
+}
+static inline struct TopoWorker *topoSelf(struct TopoSort *t){
+    return &t->workers[poolIndex(t->pool)];
+}
+// Counts down one in-edge of v; plain arithmetic when nothing runs beside us
+static inline int topoRelease(struct TopoSort *t, int v){
+    return t->threads>1 ? __atomic_sub_fetch(&t->indeg[v],1,__ATOMIC_ACQ_REL) : --t->indeg[v];
+}
+static inline void topoMaxFinish(struct TopoSort *t, int v, long long f){
+    if(t->threads==1){ if(f>t->finish[v]) t->finish[v]=f; return; }
+    long long old=__atomic_load_n(&t->finish[v],__ATOMIC_RELAXED);
+    while(old<f && !__atomic_compare_exchange_n(&t->finish[v],&old,f,1,__ATOMIC_RELAXED,__ATOMIC_RELAXED));
+}
+
+static void topoDegreeBody(void *arg, size_t begin, size_t end){
+    struct TopoSort *t=(struct TopoSort*)arg;
+    const struct CSRGraph *g=t->g;
+    for(size_t u=begin;u<end;u++)
+        for(size_t e=g->off[u];e<g->off[u+1];e++){
+            if(t->threads>1) __atomic_add_fetch(&t->indeg[g->to[e]],1,__ATOMIC_RELAXED);
+            else t->indeg[g->to[e]]++;
+        }
+}
+static void topoSourcesBody(void *arg, size_t begin, size_t end){
+    struct TopoSort *t=(struct TopoSort*)arg;
+    struct TopoWorker *me=topoSelf(t);
+    for(size_t v=begin;v<end;v++)
+        if(t->indeg[v]==0 && !topoPush(&me->list,(int)v)) __atomic_store_n(&t->failed,1,__ATOMIC_RELAXED);
+}
+// Appends the workers' lists to the order; the number of nodes added
+static size_t topoGather(struct TopoSort *t, size_t at){
+    size_t start=at;
+    for(int i=0;i<t->threads;i++){
+        struct TopoVec *l=&t->workers[i].list;
+        if(l->n) memcpy(t->order+at,l->a,l->n*sizeof(int));
+        at+=l->n; l->n=0;
+    }
+    return at-start;
+}
+// In-degrees, then the nodes without in-edges in the workers' lists
+static void topoStart(struct TopoSort *t){
+    const struct CSRGraph *g=t->g;
+    memset(t->indeg,0,(size_t)g->n*sizeof(int));
+    poolParallelFor(t->pool,0,(size_t)g->n,TOPO_GRAIN,topoDegreeBody,t);
+    poolParallelFor(t->pool,0,(size_t)g->n,TOPO_GRAIN,topoSourcesBody,t);
+}
+
+// One level: the frontier order[levelOff[l]..levelOff[l+1]) releases its successors
+static void topoLevelBody(void *arg, size_t begin, size_t end){
+    struct TopoSort *t=(struct TopoSort*)arg;
+    struct TopoWorker *me=topoSelf(t);
+    const struct CSRGraph *g=t->g;
+    int l=t->levels;
+    for(size_t i=begin;i<end;i++){
+        int u=t->order[i];
+        long long f=0;
+        // the frontier is known ahead: fetch the offsets, then the edges, of the nodes coming up
+        if(i+2*TOPO_AHEAD<end) __builtin_prefetch(&g->off[t->order[i+2*TOPO_AHEAD]]);
+        if(i+TOPO_AHEAD<end){
+            int a=t->order[i+TOPO_AHEAD];
+            __builtin_prefetch(&g->to[g->off[a]]); __builtin_prefetch(&t->level[a],1);
+        }
+        t->level[u]=l;
+        if(t->cost){ f=t->finish[u]+t->cost[u]; t->finish[u]=f; }
+        for(size_t e=g->off[u];e<g->off[u+1];e++){
+            int v=g->to[e];
+            if(t->cost) topoMaxFinish(t,v,f);
+            if(topoRelease(t,v)==0 && !topoPush(&me->list,v)) __atomic_store_n(&t->failed,1,__ATOMIC_RELAXED);
+        }
+    }
+}
+static void topoLevelsRoot(void *arg){
+    struct TopoSort *t=(struct TopoSort*)arg;
+    size_t done=0, added;
+    topoStart(t);
+    if(t->failed) return;
+    added=topoGather(t,0);
+    t->levels=0; t->levelOff[0]=0;
+    while(added>0){
+        t->levelOff[t->levels+1]=(int)(done+added);
+        poolParallelFor(t->pool,done,done+added,TOPO_GRAIN,topoLevelBody,t);
+        if(t->failed) return;
+        done+=added; t->levels++;
+        added=topoGather(t,done);
+    }
+}
+
+// The nodes with in-degree left (left[v]>0) each have a predecessor among them, so walking
+// predecessors from one of them must come back to a node already seen: a cycle
+static void topoFindCycle(struct TopoSort *t, const int *left){
+    const struct CSRGraph *g=t->g;
+    int n=g->n, v=-1;
+    t->ncycle=0; t->blocked=0;
+    for(int u=0;u<n;u++){
+        t->pred[u]=-1;
+        if(left[u]>0){ t->blocked++; if(v<0) v=u; }
+    }
+    if(v<0) return;
+    for(int u=0;u<n;u++)
+        if(left[u]>0)
+            for(size_t e=g->off[u];e<g->off[u+1];e++) if(left[g->to[e]]>0) t->pred[g->to[e]]=u;
+    // level[] marks the walk: -2 once seen
+    for(int u=0;u<n;u++) if(left[u]>0) t->level[u]=-1;
+    while(t->level[v]!=-2){ t->level[v]=-2; v=t->pred[v]; }
+    // v is on the cycle; collect it backwards, then reverse into edge order
+    int u=v;
+    do{ t->cycle[t->ncycle++]=u; u=t->pred[u]; }while(u!=v);
+    for(int i=0,j=t->ncycle-1;i<j;i++,j--){ int x=t->cycle[i]; t->cycle[i]=t->cycle[j]; t->cycle[j]=x; }
+}
+
+// Orders the nodes into levels and, with cost (NULL: 1 per node), computes finish[] and span.
+// Returns 0, 1 when the graph has a cycle (t->cycle, t->blocked), or -1 when out of memory
+static int topoLevels(struct TopoSort *t, const int *cost){
+    const struct CSRGraph *g=t->g;
+    t->cost=cost; t->failed=0; t->levels=0; t->ncycle=0; t->blocked=0; t->span=0;
+    if(cost) memset(t->finish,0,(size_t)g->n*sizeof(long long));
+    poolRun(t->pool,topoLevelsRoot,t);
+    if(t->failed){ printf("Out of Memory!"); return -1; }
+    int ordered=t->levelOff[t->levels];
+    if(cost==NULL) t->span=t->levels;
+    else for(int i=0;i<ordered;i++) if(t->finish[t->order[i]]>t->span) t->span=t->finish[t->order[i]];
+    if(ordered==g->n) return 0;
+    topoFindCycle(t,t->indeg);
+    return 1;
+}
+// Without costs a node finishes with its level
+static inline long long topoFinish(const struct TopoSort *t, int v){
+    return t->cost ? t->finish[v] : t->level[v]+1;
+}
+static inline long long topoStartTime(const struct TopoSort *t, int v){
+    return t->cost ? t->finish[v]-t->cost[v] : t->level[v];
+}
+// After topoLevels() returned 0: the nodes of a longest path by cost, in order, into path[];
+// returns how many. Their costs add up to t->span
+static int topoCriticalPath(struct TopoSort *t, int *path){
+    const struct CSRGraph *g=t->g;
+    int n=g->n, end=-1, k=0;
+    if(n==0 || t->levelOff[t->levels]!=n) return 0;
+    for(int v=0;v<n;v++){
+        t->pred[v]=-1;
+        if(end<0 || topoFinish(t,v)>topoFinish(t,end)) end=v;
+    }
+    // a predecessor that finishes exactly when v can start holds v up
+    for(int u=0;u<n;u++)
+        for(size_t e=g->off[u];e<g->off[u+1];e++){
+            int v=g->to[e];
+            if(t->pred[v]<0 && topoFinish(t,u)==topoStartTime(t,v)) t->pred[v]=u;
+        }
+    for(int v=end;v>=0;v=topoStartTime(t,v)>0 ? t->pred[v] : -1) path[k++]=v;
+    for(int i=0,j=k-1;i<j;i++,j--){ int x=path[i]; path[i]=path[j]; path[j]=x; }
+    return k;
+}
+
+// Runs node v, then whatever it made ready, depth first from the worker's own ready list. Only
+// while fewer than TOPO_SPAWN tasks wait in its deque does it hand ready nodes to the pool for
+// idle workers to steal: a task per node would cost more than a small job
+static void topoRun(struct TopoSort *t, int v, size_t base){
+    struct TopoWorker *me=topoSelf(t);
+    const struct CSRGraph *g=t->g;
+    size_t head=base;
+    for(;;){
+        if(head<me->ready.n) __builtin_prefetch(&g->off[me->ready.a[head]]);
+        t->fn(t->arg,v);
+        me->ran++;
+        for(size_t e=g->off[v];e<g->off[v+1];e++)
+            if(topoRelease(t,g->to[e])==0 && !topoPush(&me->ready,g->to[e])){
+                __atomic_store_n(&t->failed,1,__ATOMIC_RELAXED); return;
+            }
+        if(head==me->ready.n){ me->ready.n=base; return; }
+        v=me->ready.a[head++];
+        while(t->threads>1 && head<me->ready.n && poolQueued(t->pool)<TOPO_SPAWN){
+            int w=me->ready.a[head++];
+            poolSpawn(t->pool,&t->tasks[w].task,&t->pending);
+        }
+        if(head==me->ready.n) head=me->ready.n=base;
+    }
+}
+static void topoNodeTask(void *arg){
+    struct TopoTask *k=(struct TopoTask*)arg;
+    topoRun(k->t,k->v,topoSelf(k->t)->ready.n);
+}
+static void topoExecuteRoot(void *arg){
+    struct TopoSort *t=(struct TopoSort*)arg;
+    struct TopoWorker *me=topoSelf(t);
+    // a run that stopped on a failed push left nodes on these
+    for(int i=0;i<t->threads;i++) t->workers[i].list.n=t->workers[i].ready.n=0;
+    topoStart(t);
+    if(t->failed) return;
+    // the sources start on the ready list of this worker, as if one node had made them ready
+    for(int i=0;i<t->threads && !t->failed;i++){
+        struct TopoVec *l=&t->workers[i].list;
+        for(size_t j=0;j<l->n;j++)
+            if(!topoPush(&me->ready,l->a[j])){ t->failed=1; break; }
+        l->n=0;
+    }
+    if(me->ready.n>0 && !t->failed){
+        int v=me->ready.a[--me->ready.n];
+        topoRun(t,v,0);
+    }
+    poolSync(t->pool,&t->pending);
+}
+static void topoRunBody(void *arg, size_t begin, size_t end){
+    struct TopoSort *t=(struct TopoSort*)arg;
+    for(size_t i=begin;i<end;i++) t->fn(t->arg,t->order[i]);
+}
+static void topoRunLevelsRoot(void *arg){
+    struct TopoSort *t=(struct TopoSort*)arg;
+    for(int l=0;l<t->levels;l++)
+        poolParallelFor(t->pool,t->levelOff[l],t->levelOff[l+1],t->grain,topoRunBody,t);
+}
+// After topoLevels() returned 0: runs fn(arg,v) for the nodes of each level in parallel, one level
+// after the other. grain is how many nodes a task takes (0: TOPO_GRAIN)
+static void topoExecuteLevels(struct TopoSort *t, void (*fn)(void *arg, int v), void *arg, size_t grain){
+    t->fn=fn; t->arg=arg; t->grain=grain ? grain : TOPO_GRAIN;
+    poolRun(t->pool,topoRunLevelsRoot,t);
+}
+// Runs fn(arg,v) for every node, each after all of its predecessors, on the pool.
+// Returns 0, 1 when a cycle kept some nodes from running (t->cycle, t->blocked), -1 when out of memory
+static int topoExecute(struct TopoSort *t, void (*fn)(void *arg, int v), void *arg){
+    const struct CSRGraph *g=t->g;
+    if(t->tasks==NULL && t->threads>1){
+        t->tasks=(struct TopoTask*)malloc((g->n ? g->n : 1)*sizeof(struct TopoTask));
+        if(t->tasks==NULL){ printf("Out of Memory!"); return -1; }
+        for(int v=0;v<g->n;v++){
+            t->tasks[v].task.fn=topoNodeTask; t->tasks[v].task.arg=&t->tasks[v];
+            t->tasks[v].t=t; t->tasks[v].v=v;
+        }
+    }
+    t->fn=fn; t->arg=arg; t->pending=0; t->failed=0; t->ncycle=0; t->blocked=0;
+    for(int i=0;i<t->threads;i++) t->workers[i].ran=0;
+    poolRun(t->pool,topoExecuteRoot,t);
+    if(t->failed){ printf("Out of Memory!"); return -1; }
+    long long ran=0;
+    for(int i=0;i<t->threads;i++) ran+=t->workers[i].ran;
+    if(ran==g->n) return 0;
+    topoFindCycle(t,t->indeg);
+    return 1;
+}
+#endif
@@ -0,0 +1,87 @@
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+// Disjoint sets over 0..n-1 as a forest in one array: parent[v]==v for the root of each set.
+// Finding a root halves the path on the way up (each node passed is pointed at its grandparent),
+// which keeps the trees flat without the recursion of full path compression. A union links the
+// root with the larger id under the one with the smaller id.
+//   ufFind(), ufUnion()                       one thread
+//   ufFindConcurrent(), ufUnionConcurrent()   any number of threads at once, lock-free: a halving
+//                                             step is a CAS that may fail harmlessly, and a link is
+//                                             a CAS on a root that succeeds only while it is one
+//                                             (Anderson and Woll). Linking by id keeps links
+//                                             acyclic whatever the interleaving.
+//
+//   struct UnionFind *uf=newUnionFind(n);
+//   if(ufUnion(uf,a,b)) ...a and b were in different sets
+//   freeUnionFind(uf);
+#include<stdio.h>
+#include<stdlib.h>
+
+struct UnionFind{
+    int n;
+    int *parent;
+};
+
+static inline void freeUnionFind(struct UnionFind *uf){
+    if(uf==NULL) return;
+    free(uf->parent); free(uf);
+}
+// Every element back in a set of its own
+static inline void ufReset(struct UnionFind *uf){
+    for(int v=0;v<uf->n;v++) uf->parent[v]=v;
+}
+static inline struct UnionFind *newUnionFind(int n){
+    struct UnionFind *uf=(struct UnionFind*)calloc(1,sizeof(struct UnionFind));
+    if(uf==NULL || (uf->parent=(int*)malloc((n ? n : 1)*sizeof(int)))==NULL){
+        printf("Out of Memory!");
+        freeUnionFind(uf);
+        return NULL;
+    }
+    uf->n=n;
+    ufReset(uf);
+    return uf;
+}
+
+static inline int ufFind(struct UnionFind *uf, int v){
+    int *p=uf->parent;
+    while(p[v]!=v){ p[v]=p[p[v]]; v=p[v]; }
+    return v;
+}
+// 1 when a and b were in different sets, now joined; 0 when already in the same one
+static inline int ufUnion(struct UnionFind *uf, int a, int b){
+    a=ufFind(uf,a); b=ufFind(uf,b);
+    if(a==b) return 0;
+    if(a<b) uf->parent[b]=a;
+    else uf->parent[a]=b;
+    return 1;
+}
+
+static inline int ufFindConcurrent(struct UnionFind *uf, int v){
+    int *p=uf->parent;
+    for(;;){
+        int up=__atomic_load_n(&p[v],__ATOMIC_ACQUIRE);
+        if(up==v) return v;
+        int grand=__atomic_load_n(&p[up],__ATOMIC_ACQUIRE);
+        if(grand!=up) __atomic_compare_exchange_n(&p[v],&up,grand,1,__ATOMIC_RELEASE,__ATOMIC_RELAXED);
+        v=grand;
+    }
+}
+static inline int ufUnionConcurrent(struct UnionFind *uf, int a, int b){
+    for(;;){
+        a=ufFindConcurrent(uf,a); b=ufFindConcurrent(uf,b);
+        if(a==b) return 0;
+        if(a<b){ int t=a; a=b; b=t; }
+        int expect=a;
+        // fails when another thread linked a first; retry from the new roots
+        if(__atomic_compare_exchange_n(&uf->parent[a],&expect,b,0,__ATOMIC_ACQ_REL,__ATOMIC_ACQUIRE)) return 1;
+    }
+}
+// Same set at the moment of the call; a and b may be joined concurrently right after
+static inline int ufSameConcurrent(struct UnionFind *uf, int a, int b){
+    for(;;){
+        a=ufFindConcurrent(uf,a); b=ufFindConcurrent(uf,b);
+        if(a==b) return 1;
+        if(__atomic_load_n(&uf->parent[a],__ATOMIC_ACQUIRE)==a) return 0;
+    }
+}
+#endif
@@ -1,81 +1,116 @@
+#ifndef CIRCULAR_LINKED_LIST_C
+#define CIRCULAR_LINKED_LIST_C
 #include<stdio.h>
 #include<stdlib.h>
+#include"Node Pool.h"
 struct Node{int info; struct Node *link;};
-struct Node *last=NULL;
-struct Node *newNode(int data){
-    struct Node *node=(struct Node*)malloc(sizeof(struct Node));
+// The list is reached through its last node, whose link is the first: insertFront and append are O(1).
+// The length is counted, and nodes come from a NodePool (see Node Pool.h).
+struct List{struct Node *last; int size; struct NodePool *pool;};
+struct List *newList(struct NodePool *pool){
+    struct List *l=(struct List*)malloc(sizeof(struct List));
+    if(l==NULL){
+        printf("Out of Memory!"); return NULL;
+    }
+    l->last=NULL; l->size=0; l->pool=pool;
+    return l;
+}
+struct Node *newNode(struct NodePool *pool, int data){
+    struct Node *node=(struct Node*)nodePoolAlloc(pool);
+    if(node==NULL) return NULL;
     node->info=data; node->link=NULL;
     return node;
 }
-int size(struct Node *last){
-    struct Node *curr=last; int i=0;
-    if(last!=NULL){
-    do{ curr=curr->link; i++;
-    }while(curr->!=last);
-} return i;
+int size(struct List *l){
+    return l->size;
 }
-void insertFront(struct Node **last, int data){
-    struct Node *node=newNode(data);
-    if(*last==NULL){
-        *last=node; node->link=node;
-        return;
+// 0, or -1 when no node could be allocated (the list is left as it was)
+int insertFront(struct List *l, int data){
+    struct Node *node=newNode(l->pool,data);
+    if(node==NULL) return -1;
+    if(l->last==NULL){
+        l->last=node; node->link=node;
     }
-    node->link=(*last)->link; (*last)->link=node;
-}
-void append(struct Node **last, int data){
-    struct Node *node=newNode(data);
-    if((*last)==NULL){
-        node->link=node; (*last)=node;
-        return;
+    else{
+        node->link=l->last->link; l->last->link=node;
     }
-    node->link=(*last)->link; (*last)->link=node; (*last)=node;
+    l->size++;
+    return 0;
 }
-void insertAtP(struct Node **last, int p, int data){
-    struct Node *curr=*last, *node=newNode(data);
-    if(p>size(*last)+1){
-        printf("Invalid Position!"); return;
-    }
-    if(*last==NULL){
-        last=node; node->link=node;
+int append(struct List *l, int data){
+    if(insertFront(l,data)) return -1;
+    l->last=l->last->link;      // the new first node becomes the last
+    return 0;
+}
+// Inserts data so that it becomes the p-th node (1 <= p <= size+1); -1 for an invalid position or
+// when out of memory
+int insertAtP(struct List *l, int p, int data){
+    if(p<1 || p>l->size+1){
+        printf("Invalid Position!"); return -1;
     }
-    for(int i=1;i<p;i++) curr=curr->link;
+    if(p==l->size+1) return append(l,data);
+    struct Node *curr=l->last, *node=newNode(l->pool,data);
+    if(node==NULL) return -1;
+    for(int i=1;i<p;i++) curr=curr->link;   // node before position p
     node->link=curr->link; curr->link=node;
+    l->size++;
+    return 0;
 }
-int deleteFront(struct Node **last){
-    if(*last==NULL){
-        printf("Underflow!"); return;
+// Unlinks the node after prev and gives it back to the pool
+static int unlinkAfter(struct List *l, struct Node *prev){
+    struct Node *node=prev->link; int data=node->info;
+    if(node==prev) l->last=NULL;            // it was the only node
+    else{
+        prev->link=node->link;
+        if(node==l->last) l->last=prev;
     }
-    int data=(*last)->link->info;
-    *last->next=(*last)->link->link;
+    nodePoolFree(l->pool,node);
+    l->size--;
     return data;
 }
-int pop(struct Node **last){
-    if (*last==NULL){
-        printf("Underflow"); return -1;
-    }
-    if((*last)->link==(*last)){
-        int data = (*last)->info; free(*last); 
-        (*last)=NULL; return data;
+int deleteFront(struct List *l){
+    if(l->last==NULL){
+        printf("Underflow!"); return -1;
     }
-    struct Node *curr=*last;
-    while(curr->link!=(*last)) curr=curr->link;
-    int data=(*last)->info; free(*last);
-    (*last)=curr; return data;
+    return unlinkAfter(l,l->last);
 }
-int deleteAtP(struct Node **last, int p){
-    if(p>size(*last)+1){
-        printf("Invalid Position!"); return -1;
+int pop(struct List *l){
+    if(l->last==NULL){
+        printf("Underflow!"); return -1;
     }
-    if(*last==NULL){
+    struct Node *curr=l->last;
+    while(curr->link!=l->last) curr=curr->link;
+    return unlinkAfter(l,curr);
+}
+// Deletes the p-th node (1 <= p <= size) and returns its data
+int deleteAtP(struct List *l, int p){
+    if(l->last==NULL){
         printf("Underflow!"); return -1;
     }
-    if(size(*last)==1){
-        int data=(*last)->info; free(*last); 
-        *last=NULL; return data;
+    if(p<1 || p>l->size){
+        printf("Invalid Position!"); return -1;
     }
-    struct Node *curr=*last;
+    struct Node *curr=l->last;
     for(int i=1;i<p;i++) curr=curr->link;
-    struct Node *temp=curr->link; int data=temp->info;
-    curr->link=curr->link->link;
-    free(temp); return data;
+    return unlinkAfter(l,curr);
+}
+void display(struct List *l){
+    if(l->last==NULL) return;
+    struct Node *curr=l->last;
+    do{
+        curr=curr->link; printf("%d ",curr->info);
+    }while(curr!=l->last);
+}
+// Returns every node to the pool and empties the list
+void clearList(struct List *l){
+    while(l->last!=NULL) unlinkAfter(l,l->last);
+}
+// Empties the list without touching its nodes: for use after nodePoolReset() released them all
+void resetList(struct List *l){
+    l->last=NULL; l->size=0;
+}
+void freeList(struct List *l){
+    if(l==NULL) return;
+    clearList(l); free(l);
 }
+#endif
@@ -1,147 +1,123 @@
 #include<stdio.h>
 #include<stdlib.h>
+#include"Node Pool.h"
 struct Node{int info; struct Node *prev,*next;};
-struct Node *start=NULL;
+// The list keeps both ends and its length: append, pop and size are O(1).
+// Nodes come from a NodePool (see Node Pool.h), so deletes refill its free list instead of calling free.
+struct List{struct Node *head,*tail; int size; struct NodePool *pool;};
+// create new, empty list whose nodes come from pool
+struct List *newList(struct NodePool *pool){
+    struct List *l=(struct List*)malloc(sizeof(struct List));
+    if(l==NULL){
+        printf("Out of Memory!"); return NULL;
+    }
+    l->head=l->tail=NULL; l->size=0; l->pool=pool;
+    return l;
+}
 // create new node with data
-struct Node *newNode(int data){
-    // allocate memory for node
-    struct Node *node=(struct Node*)malloc(sizeof(struct Node));
+struct Node *newNode(struct NodePool *pool, int data){
+    // take a node from the pool
+    struct Node *node=(struct Node*)nodePoolAlloc(pool);
+    if(node==NULL) return NULL;
     // set data, prev, and next of node
     node->info=data; node->prev=NULL; node->next=NULL;
     // return new node
     return node;
 }
-// create new node with data
-// function to find the size of a linked list
-int size(struct Node *start){
-    // initialize a pointer to the start of the list and a counter to 0
-    struct Node *curr=start; int i=0;
-    // loop through the list
-    while(curr!=NULL){
-        // move the pointer to the next node and increment the counter
-        curr=curr->next; i++;
-    }
-    // return the size of the list (the value of the counter)
-    return i;
+// function to find the size of a linked list, kept up to date by every insert and delete
+int size(struct List *l){
+    return l->size;
 }
-void insertFront(struct Node **start, int data){
+// 0, or -1 when no node could be allocated (the list is left as it was)
+int insertFront(struct List *l, int data){
     // Create new node with given data
-    struct Node *node=newNode(data);
-    
-    // Link new node with current start node
-    node->next=*start; node->prev=NULL; *start=node;
-    
-    // Update previous link of start node if any
-    if(node->next!=NULL) node->next->prev=node;
-    
-    printf('Node Successfully Inserted!');
-}
-void append(struct Node *start, int data){
-    // initialize current and new nodes
-    struct Node *curr=start, *node=newNode(data);
-    
-    // if list is empty, insert new node as start
-    if(start==NULL){
-        start=node; 
-        node->prev=start; 
-        return;
+    struct Node *node=newNode(l->pool,data);
+    if(node==NULL) return -1;
+
+    // Link new node with current head node
+    node->next=l->head;
+
+    // Update previous link of the old head, or the tail if the list was empty
+    if(l->head!=NULL) l->head->prev=node;
+    else l->tail=node;
+    l->head=node; l->size++;
+    return 0;
+}
+int append(struct List *l, int data){
+    struct Node *node=newNode(l->pool,data);
+    if(node==NULL) return -1;
+
+    // if list is empty, insert new node as head
+    if(l->tail==NULL) l->head=node;
+    else{
+        // insert new node after the tail, no traversal needed
+        l->tail->next=node; node->prev=l->tail;
     }
-    
-    // iterate to end of list
-    while(curr->next!=NULL) curr=curr->next;
-    
-    // insert new node at end of list
-    curr->next=node; 
-    node->prev=curr;
-    
-    // display success message
-    printf('Node Successfully Inserted!');
-}
-void insertAtP(struct Node *start, int p, int data){
-    // create new node
-    struct Node *node=newNode(data), *curr=start;
-    if(p>size(start)+1){
+    l->tail=node; l->size++;
+    return 0;
+}
+// Insert data so that it becomes the p-th node (1 <= p <= size+1); -1 for an invalid position or
+// when out of memory
+int insertAtP(struct List *l, int p, int data){
+    if(p<1 || p>l->size+1){
         printf("Invalid Position!"); // handle invalid position
-        free(node); return; // free memory and return
+        return -1;
     }
-    for(int i=1;i<p-1;i++) curr=curr->next; // navigate to desired position
+    if(p==1) return insertFront(l,data);
+    if(p==l->size+1) return append(l,data);
+    struct Node *node=newNode(l->pool,data), *curr=l->head;
+    if(node==NULL) return -1;
+    for(int i=1;i<p-1;i++) curr=curr->next; // navigate to the node before position p
     node->prev=curr; node->next=curr->next; // connect new node
-    if(node->next!=NULL) node->next->prev=node; // adjust pointers if necessary
-    printf('Node Successfully Inserted!'); // indicate successful insertion
+    curr->next->prev=node; curr->next=node; // adjust neighbours' pointers
+    l->size++;
+    return 0;
+}
+// Unlink node from the list and give it back to the pool
+static int unlinkNode(struct List *l, struct Node *node){
+    int data=node->info;
+    if(node->prev!=NULL) node->prev->next=node->next;
+    else l->head=node->next;
+    if(node->next!=NULL) node->next->prev=node->prev;
+    else l->tail=node->prev;
+    nodePoolFree(l->pool,node);
+    l->size--;
+    return data;
 }
 // Delete the front node in the list
-int deleteFront(struct Node **start){
+int deleteFront(struct List *l){
     // If the list is empty, return error message
-    if(*start==NULL){
-        printf("Underflow!"); return;
+    if(l->head==NULL){
+        printf("Underflow!"); return -1;
     }
-    // Get the data of the front node
-    int data=(*start)->info;
-    // Set the front of the list to the next node
-    *start=(*start)->next;
-    // If there are still nodes after the front, free the memory of the previous front node
-    if(*start!=NULL){
-    free((*start)->prev);
-    // Set the previous node of the new front to NULL
-    (*start)->prev=NULL;
+    return unlinkNode(l,l->head);
+}
+// Function to remove and return the last element, in O(1) thanks to the tail pointer
+int pop(struct List *l){
+    if(l->tail==NULL){
+        printf("Underflow!"); return -1;
     }
-    // Print success message
-    printf('Node Successfully Deleted!');
-    // Return the deleted data
-    return data;
+    return unlinkNode(l,l->tail);
 }
-// Function to remove and return top element from stack
-int pop(struct Node **start){
-    // Check if stack is empty
-    if(*start==NULL){
-        printf("Underflow!"); 
-        return -1;
+// Delete node at given position (1 <= p <= size)
+int deleteAtP(struct List *l, int p){
+    if(p<1 || p>l->size){
+        printf("Invalid Position! The size of the list is %d",l->size); return -1;
     }
-    // Check if stack contains only 1 element
-    if((*start)->next==NULL){
-        int data=(*start)->info;
-        free(*start); 
-        *start=NULL;
-        return data;
+    struct Node *curr;
+    // Walk from whichever end is closer
+    if(p<=l->size/2){
+        curr=l->head;
+        for(int i=1;i<p;i++) curr=curr->next;
     }
-    // Initialize pointer to traverse stack
-    struct Node *curr=*start;
-    // Find second last element in stack
-    while(curr->next->next!=NULL) curr=curr->next;
-    // Get data from second last element and remove it
-    int data=curr->next->info;
-    free(curr->next); 
-    curr->next=NULL;
-    printf('Node Successfully Deleted!');
-    return data;
-}
-// Delete node at given position
-int deleteAtP(struct Node *start, int p){
-        if(p>size(*start)){
-        printf("Invalid Position! The size of the list is %d",size(*start)); return;
+    else{
+        curr=l->tail;
+        for(int i=l->size;i>p;i--) curr=curr->prev;
     }
-    if((*start)->next==NULL){
-        int data=(*start)->info; free(*start);
-        *start=NULL; return data; 
-    }  
-    struct Node *curr=start;
-
-    // Loop to the previous node of the node to be deleted
-    for(int i=0;i<p-2;i++) curr=curr->next;
-
-    // Get the value of the node to be deleted
-    int data=curr->next->info;
-
-    // Remove the node by updating the pointers of previous and next nodes
-    curr->next=curr->next->next; curr->next->prev=curr;
-
-    printf('Node Successfully Deleted!');
-    return data;
+    return unlinkNode(l,curr);
 }
-void reverse(struct Node **start){
-    struct Node *curr=*start, *temp=NULL; // set current and temp nodes
-
-    if((*start==NULL)||((*start)->next==NULL)) return; // check if list is empty or has only one node
+void reverse(struct List *l){
+    struct Node *curr=l->head, *temp=NULL; // set current and temp nodes
 
     while(curr!=NULL){
         temp=curr->prev; // save previous node
@@ -149,54 +125,47 @@ void reverse(struct Node **start){
         curr=curr->prev; // move to next node
     }
 
-    (*start)=curr; // update start pointer
-    curr->next=NULL; // set last node's next pointer to NULL
-
-    printf("List Successfully Reversed!");
+    // swap head and tail
+    temp=l->head; l->head=l->tail; l->tail=temp;
 }
-void display(struct Node *start){
-    // initialize current pointer to start
-    struct Node *curr=start;
-    // loop through linked list
-    while(curr->next!=NULL){
-        printf("%d ",curr->info);
-        curr=curr->next; // move to next node
-    }
-    printf("%d",curr->info); // print last node
-}
-void reverseDisplay(struct Node *start){
+void display(struct List *l){
     // Check if the list is empty
-    if(start==NULL){ 
-        printf("The List is Empty!"); 
+    if(l->head==NULL){
+        printf("The List is Empty!");
         return;
     }
-
-    // If there is only one node in the list
-    if(start->next==NULL){ 
-        printf("%d",start->info); 
+    // loop through linked list
+    for(struct Node *curr=l->head;curr!=NULL;curr=curr->next) printf("%d ",curr->info);
+}
+void reverseDisplay(struct List *l){
+    // Check if the list is empty
+    if(l->tail==NULL){
+        printf("The List is Empty!");
         return;
     }
-
-    // Set current node to the start of the list
-    struct Node *curr=start;
-
-    // Traverse the list to the end
-    while(curr->next!=NULL) curr=curr->next;
-
-    // Traverse the list in reverse order and print the data
-    while(curr->prev!=NULL){
-        printf("%d ",curr->info);
-        curr=curr->prev;
-    }
-
-    // Print the last node data
-    printf("%d",curr->info);
+    // Traverse the list in reverse order from the tail and print the data
+    for(struct Node *curr=l->tail;curr!=NULL;curr=curr->prev) printf("%d ",curr->info);
+}
+// Give every node back to the pool and empty the list
+void clearList(struct List *l){
+    while(l->head!=NULL) unlinkNode(l,l->head);
+}
+// Empty the list without touching its nodes: for use after nodePoolReset() released them all
+void resetList(struct List *l){
+    l->head=l->tail=NULL; l->size=0;
+}
+void freeList(struct List *l){
+    if(l==NULL) return;
+    clearList(l); free(l);
 }
 
 //Driver's Code
 int main(){
-    int choice;
-    while(1){ 
+    struct NodePool *pool=newNodePool(sizeof(struct Node),0);
+    struct List *list=newList(pool);
+    if(pool==NULL || list==NULL) return 1;
+    int choice, data, p;
+    while(1){
         printf("\n\t1 The Size of the List\n"); // Get size
         printf("\t2 Insert at the Front\n"); // Insert at front
         printf("\t3 Insert at the End(Push/Append)\n"); // Insert at end
@@ -209,20 +178,30 @@ int main(){
         printf("\t10 Display the List in Reverse Order\n"); // Display the list in reverse order
         printf("\t11 Exit\n"); // Exit the program
         printf("Enter the Choice: ");
-        scanf("%d",&choice);
+        if(scanf("%d",&choice)!=1) break;
+        if(choice>=2 && choice<=4){
+            printf("Enter the Data: ");
+            if(scanf("%d",&data)!=1) break;
+        }
+        if(choice==4 || choice==7){
+            printf("Enter the Position: ");
+            if(scanf("%d",&p)!=1) break;
+        }
     switch(choice){
-        case 1: printf("%d",size(start)); break; // Print size
-        case 2: insertFront(start,data); break; // Insert at front
-        case 3: append(start,data); break; // Insert at end
-        case 4: insertAtP(start,p,data); break; // Insert at specified position
-        case 5: deleteFront(start); break; // Delete from front
-        case 6: pop(start); break; // Delete last node
-        case 7: deleteAtP(start, p); break; // Delete at specified position
-        case 8: reverse(start); break; // Reverse the list
-        case 9: display(start); break; // Display the list
-        case 10: reverseDisplay(start); break; // Display the list in reverse order
-        case 11: exit(1); break; // Exit the program
+        case 1: printf("%d",size(list)); break; // Print size
+        case 2: if(insertFront(list,data)==0) printf("Node Successfully Inserted!"); break; // Insert at front
+        case 3: if(append(list,data)==0) printf("Node Successfully Inserted!"); break; // Insert at end
+        case 4: insertAtP(list,p,data); break; // Insert at specified position
+        case 5: printf("%d",deleteFront(list)); break; // Delete from front
+        case 6: printf("%d",pop(list)); break; // Delete last node
+        case 7: printf("%d",deleteAtP(list,p)); break; // Delete at specified position
+        case 8: reverse(list); printf("List Successfully Reversed!"); break; // Reverse the list
+        case 9: display(list); break; // Display the list
+        case 10: reverseDisplay(list); break; // Display the list in reverse order
+        case 11: freeList(list); freeNodePool(pool); exit(0); break; // Exit the program
         default: printf("Invalid Choice! Try Again: \n"); continue; // Invalid choice, try again
     }
-    } return 0;
-}
\ No newline at end of file
+    }
+    freeList(list); freeNodePool(pool);
+    return 0;
+}
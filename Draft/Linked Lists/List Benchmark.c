@@ -0,0 +1,215 @@
+// Benchmark for the pooled singly linked list of Singly-Linked List.c against the same list with
+// one malloc per node (the old newNode()), and for the unrolled list of Unrolled Linked List.c
+// against the pooled singly linked list.
+// Build: gcc -O2 -o list_bench "List Benchmark.c"
+// Run:   ./list_bench --min 1024 --max 4194304 --json list.json
+// Workloads over a list of n ints (one operation = the whole workload, ns/item = per element):
+//   build     append n elements, sum them, then release every node
+//   churn     n times: delete the front node and append a new one (a FIFO working set), then sum
+//   traverse  sum a list built while the program also made other small allocations, as an
+//             ingestion loop that parses records into lists would
+//   scan      sum a list of n built by append
+//   insertAtP LIST_POS_OPS times: insert at a random position, delete at another random position
+// The pooled list must produce the same checksum as the malloc list, the unrolled list the same
+// as the pooled list.
+#include"Singly-Linked List.c"
+#include"Unrolled Linked List.c"
+#include"../Benchmark/Benchmark.h"
+
+#define LIST_POS_OPS 64 // insert/delete pairs per insertAtP operation
+
+// The baseline: one malloc and one free per node, with a tail pointer so append is O(1) here too
+struct MNode{int info; struct MNode *link;};
+struct MList{struct MNode *head,*tail;};
+static void mAppend(struct MList *l, int data){
+    struct MNode *node=(struct MNode*)malloc(sizeof(struct MNode));
+    node->info=data; node->link=NULL;
+    if(l->tail==NULL) l->head=node;
+    else l->tail->link=node;
+    l->tail=node;
+}
+static int mDeleteFront(struct MList *l){
+    struct MNode *node=l->head; int data=node->info;
+    l->head=node->link;
+    if(l->head==NULL) l->tail=NULL;
+    free(node);
+    return data;
+}
+static void mClear(struct MList *l){
+    while(l->head!=NULL) mDeleteFront(l);
+}
+static long long mSum(const struct MList *l){
+    long long s=0;
+    for(const struct MNode *c=l->head;c!=NULL;c=c->link) s+=c->info;
+    return s;
+}
+static long long poolSum(const struct List *l){
+    long long s=0;
+    for(const struct Node *c=l->head;c!=NULL;c=c->link) s+=c->info;
+    return s;
+}
+
+struct ListCtx{
+    size_t n;
+    struct NodePool *pool; struct List *list;
+    struct MList mlist;
+    struct List *aged; struct MList maged;    // the traverse lists
+    struct List *scan; struct UnrolledList *uscan;  // the scan and insertAtP lists
+};
+static long long poolBuild(void *ctx, size_t begin, size_t end){
+    struct ListCtx *c=(struct ListCtx*)ctx; long long sum=0;
+    for(size_t op=begin;op<end;op++){
+        for(size_t i=0;i<c->n;i++) append(c->list,(int)i);
+        sum+=poolSum(c->list);
+        nodePoolReset(c->pool); resetList(c->list);    // every node released at once
+    }
+    return sum;
+}
+static long long mallocBuild(void *ctx, size_t begin, size_t end){
+    struct ListCtx *c=(struct ListCtx*)ctx; long long sum=0;
+    for(size_t op=begin;op<end;op++){
+        for(size_t i=0;i<c->n;i++) mAppend(&c->mlist,(int)i);
+        sum+=mSum(&c->mlist);
+        mClear(&c->mlist);
+    }
+    return sum;
+}
+static long long poolChurn(void *ctx, size_t begin, size_t end){
+    struct ListCtx *c=(struct ListCtx*)ctx; long long sum=0;
+    for(size_t op=begin;op<end;op++){
+        for(size_t i=0;i<c->n;i++) append(c->list,(int)i);
+        for(size_t i=0;i<c->n;i++) append(c->list,deleteFront(c->list)+1);
+        sum+=poolSum(c->list);
+        clearList(c->list);
+    }
+    return sum;
+}
+static long long mallocChurn(void *ctx, size_t begin, size_t end){
+    struct ListCtx *c=(struct ListCtx*)ctx; long long sum=0;
+    for(size_t op=begin;op<end;op++){
+        for(size_t i=0;i<c->n;i++) mAppend(&c->mlist,(int)i);
+        for(size_t i=0;i<c->n;i++) mAppend(&c->mlist,mDeleteFront(&c->mlist)+1);
+        sum+=mSum(&c->mlist);
+        mClear(&c->mlist);
+    }
+    return sum;
+}
+static long long poolTraverse(void *ctx, size_t begin, size_t end){
+    struct ListCtx *c=(struct ListCtx*)ctx; long long sum=0;
+    for(size_t op=begin;op<end;op++) sum+=poolSum(c->aged);
+    return sum;
+}
+static long long mallocTraverse(void *ctx, size_t begin, size_t end){
+    struct ListCtx *c=(struct ListCtx*)ctx; long long sum=0;
+    for(size_t op=begin;op<end;op++) sum+=mSum(&c->maged);
+    return sum;
+}
+static long long listScan(void *ctx, size_t begin, size_t end){
+    struct ListCtx *c=(struct ListCtx*)ctx; long long sum=0;
+    for(size_t op=begin;op<end;op++) sum+=poolSum(c->scan);
+    return sum;
+}
+static long long unrolledScan(void *ctx, size_t begin, size_t end){
+    struct ListCtx *c=(struct ListCtx*)ctx; long long sum=0;
+    for(size_t op=begin;op<end;op++)
+        for(const struct UNode *node=c->uscan->head;node!=NULL;node=node->next)
+            for(int i=0;i<node->count;i++) sum+=node->items[i];
+    return sum;
+}
+// Every operation makes the same moves (the seed does not depend on op), and both lists start
+// from the same contents, so the two stay identical
+static long long listInsertAtP(void *ctx, size_t begin, size_t end){
+    struct ListCtx *c=(struct ListCtx*)ctx; long long sum=0;
+    for(size_t op=begin;op<end;op++){
+        unsigned long long s=benchSeed(11);
+        for(int k=0;k<LIST_POS_OPS;k++){
+            int n=size(c->scan);
+            insertAtP(c->scan,1+(int)(benchRand(&s)%(unsigned long long)(n+1)),k);
+            sum+=deleteAtP(c->scan,1+(int)(benchRand(&s)%(unsigned long long)(n+1)));
+        }
+    }
+    return sum;
+}
+static long long unrolledInsertAtPOps(void *ctx, size_t begin, size_t end){
+    struct ListCtx *c=(struct ListCtx*)ctx; long long sum=0;
+    for(size_t op=begin;op<end;op++){
+        unsigned long long s=benchSeed(11);
+        for(int k=0;k<LIST_POS_OPS;k++){
+            int n=unrolledSize(c->uscan);
+            unrolledInsertAtP(c->uscan,1+(int)(benchRand(&s)%(unsigned long long)(n+1)),k);
+            sum+=unrolledDeleteAtP(c->uscan,1+(int)(benchRand(&s)%(unsigned long long)(n+1)));
+        }
+    }
+    return sum;
+}
+// Builds both traverse lists, making a 16..256-byte allocation (a parsed record) before each node
+static void buildAged(struct ListCtx *c, void **junk){
+    unsigned long long s=benchSeed(7);
+    for(size_t i=0;i<c->n;i++){
+        junk[2*i]=malloc(16+benchRand(&s)%241);
+        mAppend(&c->maged,(int)i);
+        junk[2*i+1]=malloc(16+benchRand(&s)%241);
+        append(c->aged,(int)i);
+    }
+}
+
+struct ListRoutine{const char *name; long long (*run)(void *ctx, size_t begin, size_t end); size_t items;};
+// Pairs: the first routine's checksum is the reference for the second (items 0 means n)
+static const struct ListRoutine routines[]={
+    {"malloc/build",mallocBuild,0},{"pool/build",poolBuild,0},
+    {"malloc/churn",mallocChurn,0},{"pool/churn",poolChurn,0},
+    {"malloc/traverse",mallocTraverse,0},{"pool/traverse",poolTraverse,0},
+    {"list/scan",listScan,0},{"unrolled/scan",unrolledScan,0},
+    {"list/insertAtP",listInsertAtP,2*LIST_POS_OPS},{"unrolled/insertAtP",unrolledInsertAtPOps,2*LIST_POS_OPS},
+};
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"list");
+    int failed=0;
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        struct ListCtx ctx={n,newNodePool(sizeof(struct Node),0),NULL,{NULL,NULL},NULL,{NULL,NULL},NULL,NULL};
+        struct NodePool *agedPool=newNodePool(sizeof(struct Node),0);
+        struct NodePool *scanPool=newNodePool(sizeof(struct Node),0);
+        struct NodePool *unrolledPool=newNodePool(sizeof(struct UNode),0);
+        void **junk=(void**)malloc(2*n*sizeof(void*));
+        if(ctx.pool==NULL || agedPool==NULL || scanPool==NULL || unrolledPool==NULL || junk==NULL){
+            printf("Out of Memory!"); return 1;
+        }
+        ctx.list=newList(ctx.pool); ctx.aged=newList(agedPool);
+        ctx.scan=newList(scanPool); ctx.uscan=newUnrolledList(unrolledPool);
+        buildAged(&ctx,junk);
+        for(size_t i=0;i<n;i++){
+            append(ctx.scan,(int)i); unrolledAppend(ctx.uscan,(int)i);
+        }
+        size_t reps=cfg.ops*4/n;
+        if(reps<3) reps=3;
+        if(reps>200) reps=200;
+        long long ref=0;
+        for(size_t r=0;r<sizeof(routines)/sizeof(routines[0]);r++){
+            // the reference of a pair always runs
+            if(!benchSelected(&cfg,routines[r].name) && (r&1)) continue;
+            size_t items=routines[r].items ? routines[r].items : n;
+            struct BenchCase bc={routines[r].name,n,reps,1,routines[r].run,NULL,&ctx,items};
+            struct BenchResult res=benchMeasure(&cfg,&bc);
+            if(benchSelected(&cfg,routines[r].name)) benchReportResult(&rep,&res);
+            long long one=res.checksum/(long long)res.ops;
+            if(!(r&1)) ref=one;
+            else if(one!=ref){
+                fprintf(stderr,"%s: wrong result for n=%zu\n",routines[r].name,n); failed=1;
+            }
+        }
+        mClear(&ctx.maged);
+        for(size_t i=0;i<2*n;i++) free(junk[i]);
+        free(junk);
+        freeList(ctx.list); freeNodePool(ctx.pool);
+        freeList(ctx.aged); freeNodePool(agedPool);
+        freeList(ctx.scan); freeNodePool(scanPool);
+        freeUnrolledList(ctx.uscan); freeNodePool(unrolledPool);
+    }
+    benchReportEnd(&rep);
+    return failed;
+}
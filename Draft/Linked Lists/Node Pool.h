@@ -0,0 +1,103 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+// Slab allocator for the fixed-size nodes of the lists in Draft/Linked Lists.
+// - Nodes are carved out of slabs of NODE_SLAB_BYTES, one malloc per slab instead of one per node,
+//   so nodes allocated one after another sit next to each other in memory.
+// - A freed node goes on a free list threaded through the node itself and is handed out again
+//   before the slab is touched, so delete/insert churn never calls malloc or free.
+// - nodePoolReset() releases every node at once in O(1) and keeps the slabs for the next round.
+// - Nodes of a cache line or more (the blocks of Unrolled Linked List.c) are rounded up to whole
+//   lines and start on a line boundary, so reading one node never touches a line of the next.
+// One pool may serve any number of lists whose nodes have the same size.
+//
+//   struct NodePool *pool=newNodePool(sizeof(struct Node),0);
+//   struct Node *n=(struct Node*)nodePoolAlloc(pool);
+//   nodePoolFree(pool,n);
+//   nodePoolReset(pool);                     // every node of every list on the pool is gone
+//   freeNodePool(pool);
+#include<stdio.h>
+#include<stdlib.h>
+#include<stddef.h>
+
+#define NODE_SLAB_BYTES 65536   // default slab size; a multiple of the page size
+#define NODE_ALIGN sizeof(void*) // list nodes hold ints and pointers, so pointer alignment is enough
+#define NODE_LINE 64            // cache line, the alignment of nodes of at least this size
+
+struct NodeSlab{
+    struct NodeSlab *next;      // slabs are kept in allocation order; the nodes follow
+};
+struct NodePool{
+    size_t nodeSize;            // rounded up to NODE_ALIGN, or to NODE_LINE for big nodes
+    size_t offset;              // of the first node in a slab, past the slab header
+    size_t perSlab;             // nodes per slab
+    struct NodeSlab *slabs;     // first slab
+    struct NodeSlab *current;   // slab being carved
+    size_t used;                // nodes carved from current
+    void *freeList;             // freed nodes, linked through their first bytes
+    size_t live;                // nodes handed out and not freed
+    size_t slabCount;
+};
+// nodesPerSlab=0 picks as many as fit in NODE_SLAB_BYTES
+static inline struct NodePool *newNodePool(size_t nodeSize, size_t nodesPerSlab){
+    struct NodePool *p=(struct NodePool*)calloc(1,sizeof(struct NodePool));
+    if(p==NULL){
+        printf("Out of Memory!"); return NULL;
+    }
+    if(nodeSize<sizeof(void*)) nodeSize=sizeof(void*);
+    size_t align=nodeSize>=NODE_LINE ? NODE_LINE : NODE_ALIGN;
+    p->nodeSize=(nodeSize+align-1)/align*align;
+    p->offset=(sizeof(struct NodeSlab)+align-1)/align*align;
+    p->perSlab=nodesPerSlab ? nodesPerSlab : (NODE_SLAB_BYTES-p->offset)/p->nodeSize;
+    if(p->perSlab==0) p->perSlab=1;
+    return p;
+}
+// Moves on to the next kept slab, or allocates one
+static inline int nodePoolNextSlab(struct NodePool *p){
+    struct NodeSlab *s=p->current!=NULL ? p->current->next : p->slabs;
+    if(s==NULL){
+        if(posix_memalign((void**)&s,NODE_LINE,p->offset+p->perSlab*p->nodeSize)) return 0;
+        s->next=NULL;
+        if(p->current!=NULL) p->current->next=s;
+        else p->slabs=s;
+        p->slabCount++;
+    }
+    p->current=s; p->used=0;
+    return 1;
+}
+// Returns an uninitialised node, or NULL when out of memory
+static inline void *nodePoolAlloc(struct NodePool *p){
+    void *node=p->freeList;
+    if(node!=NULL) p->freeList=*(void**)node;          // reuse a freed node first
+    else{
+        if(p->current==NULL || p->used==p->perSlab){
+            if(!nodePoolNextSlab(p)){
+                printf("Out of Memory!"); return NULL;
+            }
+        }
+        node=(char*)p->current+p->offset+p->used*p->nodeSize;  // carve the next node of the slab
+        p->used++;
+    }
+    p->live++;
+    return node;
+}
+static inline void nodePoolFree(struct NodePool *p, void *node){
+    if(node==NULL) return;
+    *(void**)node=p->freeList;
+    p->freeList=node;
+    p->live--;
+}
+// Frees every node at once; the slabs are kept and carved again from the first
+static inline void nodePoolReset(struct NodePool *p){
+    p->current=NULL; p->used=0;
+    p->freeList=NULL; p->live=0;
+}
+static inline void freeNodePool(struct NodePool *p){
+    if(p==NULL) return;
+    while(p->slabs!=NULL){
+        struct NodeSlab *s=p->slabs;
+        p->slabs=s->next;
+        free(s);
+    }
+    free(p);
+}
+#endif
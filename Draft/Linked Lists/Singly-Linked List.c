@@ -1,105 +1,168 @@
+#ifndef SINGLY_LINKED_LIST_C
+#define SINGLY_LINKED_LIST_C
 #include<stdio.h>
 #include<stdlib.h>
+#include"Node Pool.h"
 struct Node{int info; struct Node *link;};
+// The list keeps its tail, so append is O(1), and its length, so size() is O(1).
+// Nodes come from a NodePool, which many lists can share (see Node Pool.h).
+struct List{struct Node *head,*tail; int size; struct NodePool *pool;};
+// Creating new, empty list on a pool made with newNodePool(sizeof(struct Node),0)
+struct List *newList(struct NodePool *pool){
+    struct List *l=(struct List*)malloc(sizeof(struct List));
+    if(l==NULL){
+        printf("Out of Memory!"); return NULL;
+    }
+    l->head=l->tail=NULL; l->size=0; l->pool=pool;
+    return l;
+}
 // Creating new node
-struct Node *newNode(int data){
-    // Allocating memory for the node
-    struct Node *node=(struct Node*)malloc(sizeof(struct Node));
-
-    // Setting the node's data
-    node->info=data;
+struct Node *newNode(struct NodePool *pool, int data){
+    // Taking a node from the pool instead of malloc
+    struct Node *node=(struct Node*)nodePoolAlloc(pool);
+    if(node==NULL) return NULL;
 
-    // Setting the node's link to NULL (initializing it)
-    node->link=NULL;
+    // Setting the node's data and its link to NULL (initializing it)
+    node->info=data; node->link=NULL;
 
     // Returning the newly created node
     return node;
 }
-void insertFront(struct Node **h, int data){
-    // Allocate memory for new node
-    struct Node *node = (struct Node*)malloc(sizeof(struct Node));
-    
-    // Set new node's data and link
-    node->info=data; node->link=*h;
-    
-    // Update head to point to new node
-    *h = node;
-}
-void append(struct Node **h, int data){
-    // Allocate memory for new node
-    struct Node *node = (struct Node*)malloc(sizeof(struct Node));
+int size(struct List *l){
+    return l->size;
+}
+// 0, or -1 when no node could be allocated (the list is left as it was)
+int insertFront(struct List *l, int data){
+    struct Node *node=newNode(l->pool,data);
+    if(node==NULL) return -1;
 
-    // Assign data to new node and set next as NULL
-    node->link=NULL; node->info=data;
+    // Link new node before the current head and make it the head
+    node->link=l->head; l->head=node;
 
-    // If the list is empty, assign new node as head
-    if(*h==NULL){
-        *h=node; return;
-    }
+    // The first node is also the tail
+    if(l->tail==NULL) l->tail=node;
+    l->size++;
+    return 0;
+}
+int append(struct List *l, int data){
+    struct Node *node=newNode(l->pool,data);
+    if(node==NULL) return -1;
 
-    // If list is not empty, traverse to last node
-    struct Node *last = *h;
-    while(last->next!=NULL){
-        last=last->next; last->next=node;
+    // If the list is empty, the new node is the head; otherwise link it after the tail
+    if(l->tail==NULL) l->head=node;
+    else l->tail->link=node;
+    l->tail=node;
+    l->size++;
+    return 0;
+}
+// Inserts data so that it becomes the p-th node (1 <= p <= size+1); -1 for an invalid position or
+// when out of memory
+int insertAtP(struct List *l, int p, int data){
+    if(p<1 || p>l->size+1){
+        printf("Invalid Position!"); return -1;
     }
+    if(p==1) return insertFront(l,data);
+    if(p==l->size+1) return append(l,data);
+    struct Node *node=newNode(l->pool,data);
+    if(node==NULL) return -1;
+
+    // Walk to the (p-1)-th node and link the new node after it
+    struct Node *curr=l->head;
+    for(int i=1;i<p-1;i++) curr=curr->link;
+    node->link=curr->link; curr->link=node;
+    l->size++;
+    return 0;
 }
-// Appends new node recursively
-struct Node* appendRecursive(struct Node **h, int data){
-    if(h==NULL) return newNode(data); // Create new node if head is null
-    h->link=appendRecursive(h->link, data); // Recursive call for the next node
-    return h; // Return updated head
-}
-void display(struct Node *h){
-    // Initialize pointer to first node
-    while(h->link!=NULL){
-        // Print node value
-        printf("%d",h->info);
-        // Move pointer to next node
-        node=h->link;
+int deleteFront(struct List *l){
+    if(l->head==NULL){
+        printf("Underflow!"); return -1;
     }
+    struct Node *node=l->head; int data=node->info;
+    l->head=node->link;
+    if(l->head==NULL) l->tail=NULL;
+    nodePoolFree(l->pool,node);     // back to the pool's free list for the next insert
+    l->size--;
+    return data;
 }
-void displayRecursive(struct Node *h){
-    // Check if head is null
-    if(h==NULL) return;
-
-    // Print node value
-    printf("%d",h->info);
+// Deletes the p-th node (1 <= p <= size) and returns its data
+int deleteAtP(struct List *l, int p){
+    if(p<1 || p>l->size){
+        printf("Invalid Position!"); return -1;
+    }
+    if(p==1) return deleteFront(l);
 
-    // Recursive call for next node
-    displayRecursive(h->link);
+    // Walk to the (p-1)-th node and unlink the node after it
+    struct Node *curr=l->head;
+    for(int i=1;i<p-1;i++) curr=curr->link;
+    struct Node *node=curr->link; int data=node->info;
+    curr->link=node->link;
+    if(node==l->tail) l->tail=curr;
+    nodePoolFree(l->pool,node);
+    l->size--;
+    return data;
+}
+// Deletes the last node; a singly linked list still has to find the node before it
+int pop(struct List *l){
+    if(l->head==NULL){
+        printf("Underflow!"); return -1;
+    }
+    return deleteAtP(l,l->size);
 }
-static void reverse(struct Node **h) {
+void reverse(struct List *l){
     // Initialize previous, current, and next pointers
-    struct Node *prev = NULL, *curr = *h, *next = NULL;
+    struct Node *prev=NULL, *curr=l->head, *next=NULL;
+
+    // The old head becomes the tail
+    l->tail=l->head;
 
     // Iterate through the linked list
-    while (curr != NULL) {
+    while(curr!=NULL){
         // Save the next node in the list
-        next = curr->link;
+        next=curr->link;
         // Reverse the link direction
-        curr->link = prev;
+        curr->link=prev;
         // Move to the next iteration
-        prev = curr;
-        curr = next;
+        prev=curr;
+        curr=next;
     }
 
     // Update the head pointer to the new first node
-    *h = prev;
+    l->head=prev;
 }
-void reverseDisplay(struct Node *h){
-    struct Node *curr=h, *temp=NULL;
+void display(struct List *l){
+    for(struct Node *curr=l->head;curr!=NULL;curr=curr->link) printf("%d ",curr->info);
+}
+void displayRecursive(struct Node *h){
+    // Check if head is null
+    if(h==NULL) return;
 
-    // Iterate through the linked list
-    while(curr!=NULL){
-        struct Node *nextNode=curr->link;
-        curr->link=temp; // Reverse the link direction
-        temp=curr;        // Set the current node as the next temp node
-        curr=nextNode;    // Move to the next node in the original list
-    }
+    // Print node value
+    printf("%d ",h->info);
 
-    // Iterate through the reversed linked list and print the values
-    while(temp!=NULL){
-        printf("%d ->",curr->info);
-        curr=curr->link;
+    // Recursive call for next node
+    displayRecursive(h->link);
+}
+// Prints the list back to front without changing it
+void reverseDisplay(struct Node *h){
+    if(h==NULL) return;
+    reverseDisplay(h->link);
+    printf("%d ",h->info);
+}
+// Returns every node to the pool and empties the list
+void clearList(struct List *l){
+    while(l->head!=NULL){
+        struct Node *node=l->head;
+        l->head=node->link;
+        nodePoolFree(l->pool,node);
     }
-}
\ No newline at end of file
+    l->tail=NULL; l->size=0;
+}
+// Empties the list without touching its nodes: for use after nodePoolReset() released them all
+void resetList(struct List *l){
+    l->head=l->tail=NULL; l->size=0;
+}
+void freeList(struct List *l){
+    if(l==NULL) return;
+    clearList(l); free(l);
+}
+#endif
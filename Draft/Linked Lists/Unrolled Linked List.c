@@ -0,0 +1,164 @@
+#ifndef UNROLLED_LINKED_LIST_C
+#define UNROLLED_LINKED_LIST_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include"Node Pool.h"
+// Unrolled linked list: the same operations as Singly-Linked List.c, but every node is a block of up
+// to UNROLLED_K ints filling two cache lines. A traversal takes one cache miss per block instead of
+// one per element, and walking to position p reads only the link and count of each block it skips.
+// - Inserting into a full block splits it into two half-full blocks.
+// - A block that falls below half full after a delete takes elements from its successor, or merges
+//   with it when both fit in one block, so every block but the last stays at least half full.
+// - The list counts its elements (size() is O(1)) and keeps its tail (append is O(1)).
+// Blocks come from a NodePool made with newNodePool(sizeof(struct UNode),0), which aligns them to lines.
+#define UNROLLED_BYTES 128  // two cache lines per block
+#define UNROLLED_K ((int)((UNROLLED_BYTES-sizeof(void*)-sizeof(int))/sizeof(int)))  // 29 ints
+struct UNode{struct UNode *next; int count; int items[UNROLLED_K];};
+struct UnrolledList{struct UNode *head,*tail; int size; struct NodePool *pool;};
+struct UnrolledList *newUnrolledList(struct NodePool *pool){
+    struct UnrolledList *l=(struct UnrolledList*)malloc(sizeof(struct UnrolledList));
+    if(l==NULL){
+        printf("Out of Memory!"); return NULL;
+    }
+    l->head=l->tail=NULL; l->size=0; l->pool=pool;
+    return l;
+}
+// New empty block linked after prev (or at the front when prev is NULL)
+static struct UNode *unrolledNewNode(struct UnrolledList *l, struct UNode *prev){
+    struct UNode *node=(struct UNode*)nodePoolAlloc(l->pool);
+    if(node==NULL) return NULL;
+    node->count=0;
+    if(prev==NULL){ node->next=l->head; l->head=node; }
+    else{ node->next=prev->next; prev->next=node; }
+    if(node->next==NULL) l->tail=node;
+    return node;
+}
+// Unlinks the block after prev (the head when prev is NULL) and gives it back to the pool
+static void unrolledRemoveNode(struct UnrolledList *l, struct UNode *prev, struct UNode *node){
+    if(prev==NULL) l->head=node->next;
+    else prev->next=node->next;
+    if(l->tail==node) l->tail=prev;
+    nodePoolFree(l->pool,node);
+}
+// Block holding the element at index i (0-based, i < size); its predecessor goes to *prev, the
+// index inside the block to *off
+static struct UNode *unrolledFind(struct UnrolledList *l, int i, struct UNode **prev, int *off){
+    struct UNode *node=l->head, *pr=NULL;
+    while(i>=node->count){ i-=node->count; pr=node; node=node->next; }
+    *prev=pr; *off=i;
+    return node;
+}
+int unrolledSize(struct UnrolledList *l){
+    return l->size;
+}
+void unrolledAppend(struct UnrolledList *l, int data){
+    struct UNode *node=l->tail;
+    // Appends fill the tail block completely before starting a new one
+    if(node==NULL || node->count==UNROLLED_K){
+        node=unrolledNewNode(l,l->tail);
+        if(node==NULL) return;
+    }
+    node->items[node->count++]=data;
+    l->size++;
+}
+// Inserts data so that it becomes the p-th element (1 <= p <= size+1)
+void unrolledInsertAtP(struct UnrolledList *l, int p, int data){
+    if(p<1 || p>l->size+1){
+        printf("Invalid Position!"); return;
+    }
+    if(p==l->size+1){ unrolledAppend(l,data); return; }
+    struct UNode *prev, *node; int off;
+    node=unrolledFind(l,p-1,&prev,&off);
+    if(node->count==UNROLLED_K){
+        // Full: move the upper half to a new block after this one
+        struct UNode *half=unrolledNewNode(l,node);
+        if(half==NULL) return;
+        int keep=UNROLLED_K/2;
+        half->count=UNROLLED_K-keep;
+        memcpy(half->items,node->items+keep,(size_t)half->count*sizeof(int));
+        node->count=keep;
+        if(off>keep){ off-=keep; node=half; }
+    }
+    memmove(node->items+off+1,node->items+off,(size_t)(node->count-off)*sizeof(int));
+    node->items[off]=data; node->count++;
+    l->size++;
+}
+void unrolledInsertFront(struct UnrolledList *l, int data){
+    unrolledInsertAtP(l,1,data);
+}
+// Deletes the p-th element (1 <= p <= size) and returns it
+int unrolledDeleteAtP(struct UnrolledList *l, int p){
+    if(p<1 || p>l->size){
+        printf("Invalid Position!"); return -1;
+    }
+    struct UNode *tail=l->tail;
+    if(p==l->size && tail->count>1){    // the last element, and its block stays non-empty
+        l->size--;
+        return tail->items[--tail->count];
+    }
+    struct UNode *prev, *node; int off;
+    node=unrolledFind(l,p-1,&prev,&off);
+    int data=node->items[off];
+    memmove(node->items+off,node->items+off+1,(size_t)(node->count-off-1)*sizeof(int));
+    node->count--;
+    l->size--;
+    if(node->count<UNROLLED_K/2){
+        struct UNode *next=node->next;
+        if(next!=NULL && node->count+next->count<=UNROLLED_K){
+            // Merge the successor into this block
+            memcpy(node->items+node->count,next->items,(size_t)next->count*sizeof(int));
+            node->count+=next->count;
+            unrolledRemoveNode(l,node,next);
+        }
+        else if(next!=NULL){
+            // Take from the successor until both are about half full
+            int k=(next->count-node->count)/2;
+            memcpy(node->items+node->count,next->items,(size_t)k*sizeof(int));
+            memmove(next->items,next->items+k,(size_t)(next->count-k)*sizeof(int));
+            node->count+=k; next->count-=k;
+        }
+        else if(node->count==0) unrolledRemoveNode(l,prev,node);   // emptied tail block
+    }
+    return data;
+}
+int unrolledDeleteFront(struct UnrolledList *l){
+    if(l->size==0){
+        printf("Underflow!"); return -1;
+    }
+    return unrolledDeleteAtP(l,1);
+}
+int unrolledPop(struct UnrolledList *l){
+    if(l->size==0){
+        printf("Underflow!"); return -1;
+    }
+    return unrolledDeleteAtP(l,l->size);
+}
+// Element at position p (1 <= p <= size)
+int unrolledGet(struct UnrolledList *l, int p){
+    struct UNode *prev; int off;
+    return unrolledFind(l,p-1,&prev,&off)->items[off];
+}
+// Reverses the order of the blocks and the elements inside each block
+void unrolledReverse(struct UnrolledList *l){
+    struct UNode *prev=NULL, *curr=l->head, *next;
+    l->tail=l->head;
+    while(curr!=NULL){
+        for(int i=0,j=curr->count-1;i<j;i++,j--){
+            int t=curr->items[i]; curr->items[i]=curr->items[j]; curr->items[j]=t;
+        }
+        next=curr->next; curr->next=prev;
+        prev=curr; curr=next;
+    }
+    l->head=prev;
+}
+void unrolledDisplay(struct UnrolledList *l){
+    for(struct UNode *node=l->head;node!=NULL;node=node->next)
+        for(int i=0;i<node->count;i++) printf("%d ",node->items[i]);
+}
+void freeUnrolledList(struct UnrolledList *l){
+    if(l==NULL) return;
+    while(l->head!=NULL) unrolledRemoveNode(l,NULL,l->head);
+    free(l);
+}
+#endif
@@ -0,0 +1,213 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+// Fork-join thread pool with one Chase-Lev deque per worker, shared by the parallel programs in Draft/.
+// A worker pushes and pops its own tasks at the bottom of its deque (LIFO, cache-warm) while idle
+// workers steal the oldest, largest tasks from the top of a random victim's deque.
+// Uses GCC/Clang __atomic builtins and pthreads so it compiles as C and as C++.
+//
+//   struct Pool *pool=newPool(0);            // 0 = one worker per online CPU
+//   poolRun(pool,root,arg);                  // the calling thread becomes worker 0 until root returns
+//   ... inside a task:
+//   long pending=0; struct PoolTask t={fn,arg};
+//   poolSpawn(pool,&t,&pending);             // t may run on any worker
+//   ...do the other half yourself...
+//   poolSync(pool,&pending);                 // helps with other work until every spawned task is done
+#include<stdio.h>
+#include<stdlib.h>
+#include<pthread.h>
+#include<sched.h>
+#include<unistd.h>
+
+#define POOL_DEQUE 1024 // tasks per worker; fork-join depth stays far below this, overflow runs inline
+#define POOL_LINE 64
+
+struct PoolTask{
+    void (*fn)(void *arg);
+    void *arg;
+    long *pending;          // set by poolSpawn, decremented when fn returns
+};
+// Chase-Lev deque over a fixed ring (Le, Pop, Cohen, Zappa Nardelli 2013 orderings)
+struct PoolDeque{
+    long top;                                       // stolen from here
+    char pad0[POOL_LINE-sizeof(long)];
+    long bottom;                                    // owner pushes and pops here
+    char pad1[POOL_LINE-sizeof(long)];
+    struct PoolTask *buf[POOL_DEQUE];
+};
+struct Pool{
+    int threads;
+    struct PoolDeque *deques;                       // one per worker, worker 0 is the poolRun caller
+    pthread_t *tids;
+    pthread_mutex_t lock; pthread_cond_t wake;
+    int active, stop;                               // active while a poolRun is in progress
+};
+struct PoolWorkerArg{struct Pool *pool; int id;};
+static __thread struct Pool *poolCurrent=NULL;      // pool the calling thread works for, if any
+static __thread int poolSelf=-1;                    // its worker index
+
+static inline int poolDequePush(struct PoolDeque *d, struct PoolTask *t){
+    long b=__atomic_load_n(&d->bottom,__ATOMIC_RELAXED);
+    long top=__atomic_load_n(&d->top,__ATOMIC_ACQUIRE);
+    if(b-top>=POOL_DEQUE) return 0;                 // full
+    __atomic_store_n(&d->buf[b&(POOL_DEQUE-1)],t,__ATOMIC_RELAXED);
+    __atomic_store_n(&d->bottom,b+1,__ATOMIC_RELEASE); // publishes the task to thieves
+    return 1;
+}
+static inline struct PoolTask *poolDequeTake(struct PoolDeque *d){
+    long b=__atomic_load_n(&d->bottom,__ATOMIC_RELAXED)-1;
+    __atomic_store_n(&d->bottom,b,__ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    long top=__atomic_load_n(&d->top,__ATOMIC_RELAXED);
+    struct PoolTask *t=NULL;
+    if(top<=b){
+        t=__atomic_load_n(&d->buf[b&(POOL_DEQUE-1)],__ATOMIC_RELAXED);
+        if(top==b){
+            // Last task: race a thief for it
+            if(!__atomic_compare_exchange_n(&d->top,&top,top+1,0,__ATOMIC_SEQ_CST,__ATOMIC_RELAXED)) t=NULL;
+            __atomic_store_n(&d->bottom,b+1,__ATOMIC_RELAXED);
+        }
+    }
+    else __atomic_store_n(&d->bottom,b+1,__ATOMIC_RELAXED);
+    return t;
+}
+static inline struct PoolTask *poolDequeSteal(struct PoolDeque *d){
+    long top=__atomic_load_n(&d->top,__ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    long b=__atomic_load_n(&d->bottom,__ATOMIC_ACQUIRE);
+    if(top>=b) return NULL;
+    struct PoolTask *t=__atomic_load_n(&d->buf[top&(POOL_DEQUE-1)],__ATOMIC_RELAXED);
+    if(!__atomic_compare_exchange_n(&d->top,&top,top+1,0,__ATOMIC_SEQ_CST,__ATOMIC_RELAXED)) return NULL;
+    return t;
+}
+static inline void poolExecute(struct PoolTask *t){
+    t->fn(t->arg);
+    __atomic_sub_fetch(t->pending,1,__ATOMIC_RELEASE);
+}
+// Own deque first, then a few random victims
+static inline struct PoolTask *poolFind(struct Pool *p, int self, unsigned *seed){
+    struct PoolTask *t=poolDequeTake(&p->deques[self]);
+    if(t!=NULL || p->threads==1) return t;
+    for(int tries=0;tries<2*p->threads;tries++){
+        *seed=*seed*1103515245u+12345u;
+        int v=(int)((*seed>>16)%(unsigned)p->threads);
+        if(v!=self && (t=poolDequeSteal(&p->deques[v]))!=NULL) return t;
+    }
+    return NULL;
+}
+static void *poolWorker(void *varg){
+    struct PoolWorkerArg *wa=(struct PoolWorkerArg*)varg;
+    struct Pool *p=wa->pool; int self=wa->id; free(wa);
+    poolCurrent=p; poolSelf=self;
+    unsigned seed=2654435761u*(unsigned)(self+1); int idle=0;
+    for(;;){
+        if(!__atomic_load_n(&p->active,__ATOMIC_ACQUIRE)){
+            // Sleep between poolRun calls
+            pthread_mutex_lock(&p->lock);
+            while(!p->active && !p->stop) pthread_cond_wait(&p->wake,&p->lock);
+            int stop=p->stop;
+            pthread_mutex_unlock(&p->lock);
+            if(stop) return NULL;
+        }
+        struct PoolTask *t=poolFind(p,self,&seed);
+        if(t!=NULL){ poolExecute(t); idle=0; }
+        else if(++idle>64){ sched_yield(); idle=0; }
+    }
+}
+// threads<=0 starts one worker per online CPU (the poolRun caller counts as one)
+static inline struct Pool *newPool(int threads){
+    if(threads<=0) threads=(int)sysconf(_SC_NPROCESSORS_ONLN);
+    if(threads<1) threads=1;
+    struct Pool *p=(struct Pool*)calloc(1,sizeof(struct Pool));
+    p->threads=threads;
+    if(posix_memalign((void**)&p->deques,POOL_LINE,(size_t)threads*sizeof(struct PoolDeque))){
+        free(p); return NULL;
+    }
+    for(int i=0;i<threads;i++){ p->deques[i].top=0; p->deques[i].bottom=0; }
+    p->tids=(pthread_t*)calloc((size_t)threads,sizeof(pthread_t));
+    pthread_mutex_init(&p->lock,NULL); pthread_cond_init(&p->wake,NULL);
+    for(int i=1;i<threads;i++){
+        struct PoolWorkerArg *wa=(struct PoolWorkerArg*)malloc(sizeof(struct PoolWorkerArg));
+        wa->pool=p; wa->id=i;
+        pthread_create(&p->tids[i],NULL,poolWorker,wa);
+    }
+    return p;
+}
+static inline void freePool(struct Pool *p){
+    if(p==NULL) return;
+    pthread_mutex_lock(&p->lock); p->stop=1; pthread_cond_broadcast(&p->wake); pthread_mutex_unlock(&p->lock);
+    for(int i=1;i<p->threads;i++) pthread_join(p->tids[i],NULL);
+    pthread_mutex_destroy(&p->lock); pthread_cond_destroy(&p->wake);
+    free(p->tids); free(p->deques); free(p);
+}
+static inline int poolThreads(const struct Pool *p){
+    return p ? p->threads : 1;
+}
+// The calling worker's index in p, in [0,poolThreads(p)): 0 when p is NULL or the caller is not
+// one of p's workers, e.g. a NULL-pool run from inside a task of another pool
+static inline int poolIndex(const struct Pool *p){
+    return p!=NULL && poolCurrent==p ? poolSelf : 0;
+}
+// Makes t available to other workers; outside a pool (or with a full deque) it simply runs now
+static inline void poolSpawn(struct Pool *p, struct PoolTask *t, long *pending){
+    t->pending=pending;
+    __atomic_add_fetch(pending,1,__ATOMIC_RELAXED);
+    if(p==NULL || poolCurrent!=p || !poolDequePush(&p->deques[poolSelf],t)) poolExecute(t);
+}
+// Tasks waiting in the calling worker's deque (0 outside the pool): code that makes work faster
+// than it is stolen can keep the rest to itself while a few are on offer
+static inline long poolQueued(const struct Pool *p){
+    if(p==NULL || poolCurrent!=p) return 0;
+    const struct PoolDeque *d=&p->deques[poolSelf];
+    return __atomic_load_n(&d->bottom,__ATOMIC_RELAXED)-__atomic_load_n(&d->top,__ATOMIC_RELAXED);
+}
+// Waits for every task spawned against `pending`, running queued or stolen tasks meanwhile
+static inline void poolSync(struct Pool *p, long *pending){
+    unsigned seed=(unsigned)(size_t)pending; int idle=0;
+    while(__atomic_load_n(pending,__ATOMIC_ACQUIRE)>0){
+        struct PoolTask *t=poolFind(p,poolSelf,&seed);
+        if(t!=NULL){ poolExecute(t); idle=0; }
+        else if(++idle>64){ sched_yield(); idle=0; }
+    }
+}
+// Runs fn(arg) on the calling thread as worker 0 with the other workers stealing from it.
+// Calls from inside a task of the same pool just run fn. One poolRun per pool at a time.
+static inline void poolRun(struct Pool *p, void (*fn)(void *arg), void *arg){
+    if(p==NULL || poolCurrent==p){ fn(arg); return; }
+    struct Pool *outer=poolCurrent; int outerSelf=poolSelf;
+    poolCurrent=p; poolSelf=0;
+    pthread_mutex_lock(&p->lock); __atomic_store_n(&p->active,1,__ATOMIC_RELEASE); pthread_cond_broadcast(&p->wake); pthread_mutex_unlock(&p->lock);
+    fn(arg);
+    pthread_mutex_lock(&p->lock); __atomic_store_n(&p->active,0,__ATOMIC_RELEASE); pthread_mutex_unlock(&p->lock);
+    poolCurrent=outer; poolSelf=outerSelf;
+}
+
+// Parallel for over [begin,end) in chunks of at most `grain`, split recursively so stealing stays balanced
+struct PoolForArg{
+    struct Pool *pool; size_t begin,end,grain;
+    void (*body)(void *arg, size_t begin, size_t end); void *arg;
+};
+static void poolForTask(void *varg){
+    struct PoolForArg *a=(struct PoolForArg*)varg;
+    long pending=0;
+    struct PoolForArg right[64]; struct PoolTask tasks[64]; int k=0;
+    size_t b=a->begin, e=a->end;
+    // Peel off the right half while the range is large; run the leftmost chunk here
+    while(e-b>a->grain && k<64){
+        size_t m=b+(e-b)/2;
+        right[k]=*a; right[k].begin=m; right[k].end=e;
+        tasks[k].fn=poolForTask; tasks[k].arg=&right[k];
+        poolSpawn(a->pool,&tasks[k],&pending); k++;
+        e=m;
+    }
+    a->body(a->arg,b,e);
+    poolSync(a->pool,&pending);
+}
+static void poolForRoot(void *varg){ poolForTask(varg); }
+static inline void poolParallelFor(struct Pool *p, size_t begin, size_t end, size_t grain,
+                                   void (*body)(void *arg, size_t begin, size_t end), void *arg){
+    if(begin>=end) return;
+    if(grain==0) grain=1;
+    struct PoolForArg a={p,begin,end,grain,body,arg};
+    poolRun(p,poolForRoot,&a);
+}
+#endif
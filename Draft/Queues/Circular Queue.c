@@ -0,0 +1,206 @@
+#ifndef CIRCULAR_QUEUE_C
+#define CIRCULAR_QUEUE_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<sched.h>
+// Bounded ring buffers for passing work between threads, lock-free and allocation-free after creation.
+// The capacity is rounded up to a power of two, so a slot index is pos&mask and the positions
+// only ever grow (no wrap-around bookkeeping; a 64-bit counter does not overflow in practice).
+// Indices written by different threads live on separate cache lines, so a producer and a
+// consumer never invalidate each other's line except to hand over data.
+// Uses GCC/Clang __atomic builtins, like Parallel/Work-Stealing Pool.h, so it compiles as C and C++.
+#define RING_LINE 64
+
+static inline size_t ringCapacity(size_t n){
+    size_t c=2;
+    while(c<n) c<<=1;
+    return c;
+}
+// Tells the CPU we are spinning (frees the pipeline for a sibling hyper-thread); after a while
+// gives up the core, in case the thread we wait for is not running
+static inline void ringPause(int *spins){
+    if(++*spins>64){ sched_yield(); *spins=0; return; }
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+// Single-producer single-consumer ring (Lamport's queue). Wait-free: every call finishes in a
+// bounded number of steps. The producer owns tail and the consumer owns head; each keeps a
+// cached copy of the other's index and only re-reads the shared one when the cache says
+// full or empty, so in steady state a push or pop touches no shared cache line but the slot.
+// DEFINE_SPSC_RING(type,name,T) defines struct type and
+//   struct type *new##type(size_t capacity), void free##type(struct type *q)
+//   int name##Push(q,T v), int name##Pop(q,T *v)             (0 when full / empty)
+//   size_t name##PushBatch(q,const T v[],size_t n), size_t name##PopBatch(q,T out[],size_t n)
+//       (move up to n elements with a single index update; return how many)
+#define DEFINE_SPSC_RING(type, name, T) \
+struct type{ \
+    size_t head, tailCache;                         /* consumer's line */ \
+    char pad0[RING_LINE-2*sizeof(size_t)]; \
+    size_t tail, headCache;                         /* producer's line */ \
+    char pad1[RING_LINE-2*sizeof(size_t)]; \
+    size_t mask; T *slots;                          /* read-only after creation */ \
+    char pad2[RING_LINE-sizeof(size_t)-sizeof(T*)]; \
+}; \
+static struct type *new##type(size_t capacity){ \
+    struct type *q; \
+    if(posix_memalign((void**)&q,RING_LINE,sizeof(struct type))) return NULL; \
+    memset(q,0,sizeof(*q)); \
+    q->mask=ringCapacity(capacity)-1; \
+    if(posix_memalign((void**)&q->slots,RING_LINE,(q->mask+1)*sizeof(T))){ free(q); return NULL; } \
+    return q; \
+} \
+static void free##type(struct type *q){ \
+    if(q==NULL) return; \
+    free(q->slots); free(q); \
+} \
+static inline int name##Push(struct type *q, T v){ \
+    size_t t=q->tail; \
+    if(t-q->headCache>q->mask){ \
+        q->headCache=__atomic_load_n(&q->head,__ATOMIC_ACQUIRE); /* slot freed by the consumer? */ \
+        if(t-q->headCache>q->mask) return 0; \
+    } \
+    q->slots[t&q->mask]=v; \
+    __atomic_store_n(&q->tail,t+1,__ATOMIC_RELEASE);  /* publishes the slot */ \
+    return 1; \
+} \
+static inline int name##Pop(struct type *q, T *v){ \
+    size_t h=q->head; \
+    if(h==q->tailCache){ \
+        q->tailCache=__atomic_load_n(&q->tail,__ATOMIC_ACQUIRE); \
+        if(h==q->tailCache) return 0; \
+    } \
+    *v=q->slots[h&q->mask]; \
+    __atomic_store_n(&q->head,h+1,__ATOMIC_RELEASE);  /* hands the slot back */ \
+    return 1; \
+} \
+static inline size_t name##PushBatch(struct type *q, const T v[], size_t n){ \
+    size_t t=q->tail, cap=q->mask+1; \
+    if(cap-(t-q->headCache)<n) q->headCache=__atomic_load_n(&q->head,__ATOMIC_ACQUIRE); \
+    size_t k=cap-(t-q->headCache); \
+    if(k>n) k=n; \
+    size_t i=t&q->mask, first=cap-i<k ? cap-i : k; /* up to the end of the array, then from 0 */ \
+    memcpy(q->slots+i,v,first*sizeof(T)); \
+    memcpy(q->slots,v+first,(k-first)*sizeof(T)); \
+    __atomic_store_n(&q->tail,t+k,__ATOMIC_RELEASE); \
+    return k; \
+} \
+static inline size_t name##PopBatch(struct type *q, T out[], size_t n){ \
+    size_t h=q->head, cap=q->mask+1; \
+    if(q->tailCache-h<n) q->tailCache=__atomic_load_n(&q->tail,__ATOMIC_ACQUIRE); \
+    size_t k=q->tailCache-h; \
+    if(k>n) k=n; \
+    size_t i=h&q->mask, first=cap-i<k ? cap-i : k; \
+    memcpy(out,q->slots+i,first*sizeof(T)); \
+    memcpy(out+first,q->slots,(k-first)*sizeof(T)); \
+    __atomic_store_n(&q->head,h+k,__ATOMIC_RELEASE); \
+    return k; \
+}
+
+// Bounded multi-producer multi-consumer ring (Vyukov). Every slot carries a sequence number:
+// seq==pos means the slot is free for the producer of position pos, seq==pos+1 means it holds
+// that producer's element. Producers (and consumers) claim a position with one CAS on their
+// shared counter, then fill (or drain) the slot and publish by bumping its seq by one lap,
+// so producers never contend with consumers and no slot is ever locked.
+// DEFINE_MPMC_RING(type,name,T) defines the same functions as DEFINE_SPSC_RING, safe from any number
+// of threads. The batch calls claim a range of positions with a single CAS, up to what the
+// other side's counter shows to be free (or filled), then wait for each slot's seq.
+#define DEFINE_MPMC_RING(type, name, T) \
+struct type##Cell{size_t seq; T data;}; \
+struct type{ \
+    char pad0[RING_LINE]; \
+    size_t enqueuePos; \
+    char pad1[RING_LINE-sizeof(size_t)]; \
+    size_t dequeuePos; \
+    char pad2[RING_LINE-sizeof(size_t)]; \
+    size_t mask; struct type##Cell *cells; \
+    char pad3[RING_LINE-sizeof(size_t)-sizeof(void*)]; \
+}; \
+static struct type *new##type(size_t capacity){ \
+    struct type *q; \
+    if(posix_memalign((void**)&q,RING_LINE,sizeof(struct type))) return NULL; \
+    memset(q,0,sizeof(*q)); \
+    q->mask=ringCapacity(capacity)-1; \
+    if(posix_memalign((void**)&q->cells,RING_LINE,(q->mask+1)*sizeof(struct type##Cell))){ free(q); return NULL; } \
+    for(size_t i=0;i<=q->mask;i++) q->cells[i].seq=i; \
+    return q; \
+} \
+static void free##type(struct type *q){ \
+    if(q==NULL) return; \
+    free(q->cells); free(q); \
+} \
+static inline int name##Push(struct type *q, T v){ \
+    size_t pos=__atomic_load_n(&q->enqueuePos,__ATOMIC_RELAXED); \
+    struct type##Cell *c; \
+    for(;;){ \
+        c=&q->cells[pos&q->mask]; \
+        size_t seq=__atomic_load_n(&c->seq,__ATOMIC_ACQUIRE); \
+        long diff=(long)(seq-pos); \
+        if(diff==0){ \
+            if(__atomic_compare_exchange_n(&q->enqueuePos,&pos,pos+1,1,__ATOMIC_RELAXED,__ATOMIC_RELAXED)) break; \
+        } \
+        else if(diff<0) return 0;                   /* a lap behind: full */ \
+        else pos=__atomic_load_n(&q->enqueuePos,__ATOMIC_RELAXED); \
+    } \
+    c->data=v; \
+    __atomic_store_n(&c->seq,pos+1,__ATOMIC_RELEASE); \
+    return 1; \
+} \
+static inline int name##Pop(struct type *q, T *v){ \
+    size_t pos=__atomic_load_n(&q->dequeuePos,__ATOMIC_RELAXED); \
+    struct type##Cell *c; \
+    for(;;){ \
+        c=&q->cells[pos&q->mask]; \
+        size_t seq=__atomic_load_n(&c->seq,__ATOMIC_ACQUIRE); \
+        long diff=(long)(seq-(pos+1)); \
+        if(diff==0){ \
+            if(__atomic_compare_exchange_n(&q->dequeuePos,&pos,pos+1,1,__ATOMIC_RELAXED,__ATOMIC_RELAXED)) break; \
+        } \
+        else if(diff<0) return 0;                   /* not written yet: empty */ \
+        else pos=__atomic_load_n(&q->dequeuePos,__ATOMIC_RELAXED); \
+    } \
+    *v=c->data; \
+    __atomic_store_n(&c->seq,pos+q->mask+1,__ATOMIC_RELEASE); /* free for the next lap */ \
+    return 1; \
+} \
+static inline size_t name##PushBatch(struct type *q, const T v[], size_t n){ \
+    size_t pos=__atomic_load_n(&q->enqueuePos,__ATOMIC_RELAXED), k; \
+    for(;;){ \
+        /* Positions below dequeuePos+capacity have been claimed by a consumer on the last lap */ \
+        size_t limit=__atomic_load_n(&q->dequeuePos,__ATOMIC_ACQUIRE)+q->mask+1; \
+        k=limit>pos ? limit-pos : 0; \
+        if(k>n) k=n; \
+        if(k==0) return 0; \
+        if(__atomic_compare_exchange_n(&q->enqueuePos,&pos,pos+k,1,__ATOMIC_RELAXED,__ATOMIC_RELAXED)) break; \
+    } \
+    for(size_t i=0;i<k;i++){ \
+        struct type##Cell *c=&q->cells[(pos+i)&q->mask]; int spins=0; \
+        while(__atomic_load_n(&c->seq,__ATOMIC_ACQUIRE)!=pos+i) ringPause(&spins); /* consumer still copying out */ \
+        c->data=v[i]; \
+        __atomic_store_n(&c->seq,pos+i+1,__ATOMIC_RELEASE); \
+    } \
+    return k; \
+} \
+static inline size_t name##PopBatch(struct type *q, T out[], size_t n){ \
+    size_t pos=__atomic_load_n(&q->dequeuePos,__ATOMIC_RELAXED), k; \
+    for(;;){ \
+        size_t limit=__atomic_load_n(&q->enqueuePos,__ATOMIC_ACQUIRE); \
+        k=limit>pos ? limit-pos : 0; \
+        if(k>n) k=n; \
+        if(k==0) return 0; \
+        if(__atomic_compare_exchange_n(&q->dequeuePos,&pos,pos+k,1,__ATOMIC_RELAXED,__ATOMIC_RELAXED)) break; \
+    } \
+    for(size_t i=0;i<k;i++){ \
+        struct type##Cell *c=&q->cells[(pos+i)&q->mask]; int spins=0; \
+        while(__atomic_load_n(&c->seq,__ATOMIC_ACQUIRE)!=pos+i+1) ringPause(&spins); /* producer still copying in */ \
+        out[i]=c->data; \
+        __atomic_store_n(&c->seq,pos+i+q->mask+1,__ATOMIC_RELEASE); \
+    } \
+    return k; \
+}
+
+DEFINE_SPSC_RING(SpscRingInt,spscRingInt,int)
+DEFINE_MPMC_RING(MpmcRingInt,mpmcRingInt,int)
+#endif
@@ -0,0 +1,151 @@
+// Benchmark for the block deque in Double-Ended Queue(Deque).c against the linked-list queue of
+// Dynamic Linear Queue.c and std::deque. Built as C++ only for std::deque; the queues are C.
+// Build: g++ -O2 -o deque_bench "Deque Benchmark.cpp"
+// Run:   ./deque_bench --min 1024 --max 16777216 --json deque.json
+// Workloads over n elements (one operation = the whole workload, ns/item = per element):
+//   fifo      push n at the back, pop them all from the front
+//   frontier  BFS over the implicit binary tree 1..n: pop a node, push its children
+//   window    slide a 1024-wide window over n values, reading its middle element by index
+//   random    fill n, then n reads at random indices
+//   lifo      push n at the front, pop them all from the back
+// Every container must produce the same checksum as std::deque.
+#include<deque>
+#include"Double-Ended Queue(Deque).c"
+#include"Dynamic Linear Queue.c"
+#include"../Benchmark/Benchmark.h"
+
+#define WINDOW 1024
+
+struct DequeCtx{size_t n; const unsigned *idx;};    // idx: n random indices below n
+// Workloads written once against push/pop/at expressions on a container q
+#define DEQUE_WORKLOADS(prefix, DECL, PUSH_BACK, PUSH_FRONT, POP_FRONT, POP_BACK, AT, SIZE, DONE) \
+static long long prefix##Fifo(void *ctx, size_t begin, size_t end){ \
+    struct DequeCtx *c=(struct DequeCtx*)ctx; long long sum=0; (void)begin; (void)end; \
+    DECL; int v=0; \
+    for(size_t i=0;i<c->n;i++) PUSH_BACK((int)i); \
+    for(size_t i=0;i<c->n;i++){ POP_FRONT(v); sum+=v; } \
+    DONE; return sum; \
+} \
+static long long prefix##Frontier(void *ctx, size_t begin, size_t end){ \
+    struct DequeCtx *c=(struct DequeCtx*)ctx; long long sum=0; (void)begin; (void)end; \
+    DECL; int v=0; int n=(int)c->n; \
+    PUSH_BACK(1); \
+    while(SIZE>0){ \
+        POP_FRONT(v); sum+=v; \
+        if(2*v<=n) PUSH_BACK(2*v); \
+        if(2*v+1<=n) PUSH_BACK(2*v+1); \
+    } \
+    DONE; return sum; \
+} \
+static long long prefix##Window(void *ctx, size_t begin, size_t end){ \
+    struct DequeCtx *c=(struct DequeCtx*)ctx; long long sum=0; (void)begin; (void)end; \
+    DECL; int v=0; \
+    for(size_t i=0;i<c->n;i++){ \
+        PUSH_BACK((int)i); \
+        if(SIZE>WINDOW){ POP_FRONT(v); sum-=v; } \
+        sum+=AT(SIZE/2); \
+    } \
+    DONE; return sum; \
+} \
+static long long prefix##Random(void *ctx, size_t begin, size_t end){ \
+    struct DequeCtx *c=(struct DequeCtx*)ctx; long long sum=0; (void)begin; (void)end; \
+    DECL; \
+    for(size_t i=0;i<c->n;i++) PUSH_BACK((int)i); \
+    for(size_t i=0;i<c->n;i++) sum+=AT(c->idx[i]); \
+    DONE; return sum; \
+} \
+static long long prefix##Lifo(void *ctx, size_t begin, size_t end){ \
+    struct DequeCtx *c=(struct DequeCtx*)ctx; long long sum=0; (void)begin; (void)end; \
+    DECL; int v=0; \
+    for(size_t i=0;i<c->n;i++) PUSH_FRONT((int)i); \
+    for(size_t i=0;i<c->n;i++){ POP_BACK(v); sum+=v*(long long)(i&7); } \
+    DONE; return sum; \
+}
+
+// Block deque; the same deque is reused across operations, as a long-lived frontier would be
+static struct Deque *benchDeque;
+#define BD_PUSH_BACK(x) dequePushBack(benchDeque,(x))
+#define BD_PUSH_FRONT(x) dequePushFront(benchDeque,(x))
+#define BD_POP_FRONT(x) dequePopFront(benchDeque,&(x))
+#define BD_POP_BACK(x) dequePopBack(benchDeque,&(x))
+#define BD_AT(i) (*dequeAt(benchDeque,(size_t)(i)))
+DEQUE_WORKLOADS(blockDeque,dequeClear(benchDeque),BD_PUSH_BACK,BD_PUSH_FRONT,BD_POP_FRONT,BD_POP_BACK,BD_AT,dequeSize(benchDeque),(void)0)
+
+#define SD_PUSH_BACK(x) q.push_back(x)
+#define SD_PUSH_FRONT(x) q.push_front(x)
+#define SD_POP_FRONT(x) do{ (x)=q.front(); q.pop_front(); }while(0)
+#define SD_POP_BACK(x) do{ (x)=q.back(); q.pop_back(); }while(0)
+#define SD_AT(i) q[(size_t)(i)]
+DEQUE_WORKLOADS(stdDeque,std::deque<int> q,SD_PUSH_BACK,SD_PUSH_FRONT,SD_POP_FRONT,SD_POP_BACK,SD_AT,q.size(),(void)0)
+
+// The linked-list queue only has the FIFO end; a malloc and a free per element
+static long long linkedFifo(void *ctx, size_t begin, size_t end){
+    struct DequeCtx *c=(struct DequeCtx*)ctx; long long sum=0; (void)begin; (void)end;
+    struct LinkedQueue *q=newLinkedQueue();
+    for(size_t i=0;i<c->n;i++) linkedEnqueue(q,(int)i);
+    for(size_t i=0;i<c->n;i++) sum+=linkedDequeue(q);
+    freeLinkedQueue(q);
+    return sum;
+}
+static long long linkedFrontier(void *ctx, size_t begin, size_t end){
+    struct DequeCtx *c=(struct DequeCtx*)ctx; long long sum=0; (void)begin; (void)end;
+    struct LinkedQueue *q=newLinkedQueue(); int n=(int)c->n;
+    linkedEnqueue(q,1);
+    while(!linkedIsEmpty(q)){
+        int v=linkedDequeue(q); sum+=v;
+        if(2*v<=n) linkedEnqueue(q,2*v);
+        if(2*v+1<=n) linkedEnqueue(q,2*v+1);
+    }
+    freeLinkedQueue(q);
+    return sum;
+}
+
+struct DequeRoutine{const char *container, *workload; long long (*run)(void *ctx, size_t begin, size_t end);};
+// std::deque first: its checksums are the reference
+static const struct DequeRoutine routines[]={
+    {"std::deque","fifo",stdDequeFifo},{"std::deque","frontier",stdDequeFrontier},{"std::deque","window",stdDequeWindow},
+    {"std::deque","random",stdDequeRandom},{"std::deque","lifo",stdDequeLifo},
+    {"blockDeque","fifo",blockDequeFifo},{"blockDeque","frontier",blockDequeFrontier},{"blockDeque","window",blockDequeWindow},
+    {"blockDeque","random",blockDequeRandom},{"blockDeque","lifo",blockDequeLifo},
+    {"linkedQueue","fifo",linkedFifo},{"linkedQueue","frontier",linkedFrontier},
+};
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"deque");
+    benchDeque=newDeque();
+    unsigned *idx=(unsigned*)malloc(cfg.maxN*sizeof(unsigned));
+    if(benchDeque==NULL || idx==NULL){
+        printf("Out of Memory!"); return 1;
+    }
+    int failed=0;
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        unsigned long long s=benchSeed(cfg.seed);
+        for(size_t i=0;i<n;i++) idx[i]=(unsigned)(benchRand(&s)%n);
+        struct DequeCtx ctx={n,idx};
+        size_t reps=cfg.ops*4/n;
+        if(reps<3) reps=3;
+        if(reps>200) reps=200;
+        long long ref[5]={0};
+        for(size_t r=0;r<sizeof(routines)/sizeof(routines[0]);r++){
+            char name[64];
+            snprintf(name,sizeof(name),"%s/%s",routines[r].container,routines[r].workload);
+            int w=(int)(r%5);
+            if(!benchSelected(&cfg,name) && r>=5) continue;   // the reference always runs
+            struct BenchCase bc={name,n,reps,1,routines[r].run,NULL,&ctx,n};
+            struct BenchResult res=benchMeasure(&cfg,&bc);
+            if(benchSelected(&cfg,name)) benchReportResult(&rep,&res);
+            long long one=res.checksum/(long long)res.ops;
+            if(r<5) ref[w]=one;
+            else if(one!=ref[w]){
+                fprintf(stderr,"%s: wrong result for n=%zu\n",name,n); failed=1;
+            }
+        }
+    }
+    benchReportEnd(&rep);
+    freeDeque(benchDeque); free(idx);
+    return failed;
+}
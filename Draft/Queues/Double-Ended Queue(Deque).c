@@ -0,0 +1,126 @@
+#ifndef DEQUE_C
+#define DEQUE_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+// Double-ended queue in fixed-size blocks (the layout of std::deque).
+// - Elements live in blocks of DEQUE_BLOCK_BYTES; a circular map of block pointers says which
+//   block holds which part of the sequence. Element i is in block (begin+i)/B at (begin+i)%B.
+// - push/pop at either end touch one block; a new block is needed once every B pushes, and
+//   the map doubles when it runs out of slots, so both are O(1) amortised.
+// - Random access is two loads (map slot, then element), with no pointer chasing.
+// - Emptied blocks go to a free list and are reused before anything is allocated again, so a
+//   deque that stays around the same size (a BFS frontier, a sliding window) stops calling malloc.
+// DEFINE_DEQUE(type,name,T) defines struct type and
+//   struct type *new##type(void), void free##type(struct type *q)
+//   int name##PushBack(q,T v), int name##PushFront(q,T v)     (0 when out of memory)
+//   int name##PopFront(q,T *v), int name##PopBack(q,T *v)      (0 when empty)
+//   T *name##At(q,i) (0 <= i < size), size_t name##Size(q), void name##Clear(q) (keeps the blocks)
+#define DEQUE_BLOCK_BYTES 4096   // one page per block
+
+#define DEFINE_DEQUE(type, name, T) \
+enum{type##Block=DEQUE_BLOCK_BYTES/sizeof(T)>=16 ? DEQUE_BLOCK_BYTES/sizeof(T) : 16}; \
+struct type{ \
+    T **map;                /* circular array of block pointers */ \
+    size_t mapCap;          /* slots in map, a power of two */ \
+    size_t first;           /* map slot of the block holding element 0 */ \
+    size_t blocks;          /* blocks in use, starting at slot first */ \
+    size_t begin;           /* offset of element 0 inside its block */ \
+    size_t size; \
+    void *spare;            /* free list of emptied blocks, linked through their first bytes */ \
+}; \
+static struct type *new##type(void){ \
+    struct type *q=(struct type*)calloc(1,sizeof(struct type)); \
+    if(q==NULL) return NULL; \
+    q->mapCap=8; \
+    q->map=(T**)malloc(q->mapCap*sizeof(T*)); \
+    if(q->map==NULL){ free(q); return NULL; } \
+    return q; \
+} \
+static inline T *name##NewBlock(struct type *q){ \
+    if(q->spare!=NULL){ \
+        T *b=(T*)q->spare; \
+        memcpy(&q->spare,b,sizeof(void*)); \
+        return b; \
+    } \
+    return (T*)malloc(type##Block*sizeof(T)); \
+} \
+static inline void name##FreeBlock(struct type *q, T *b){ \
+    memcpy(b,&q->spare,sizeof(void*)); \
+    q->spare=b; \
+} \
+/* Doubles the map, laying the blocks in use out from slot 0 */ \
+static int name##GrowMap(struct type *q){ \
+    T **m=(T**)malloc(2*q->mapCap*sizeof(T*)); \
+    if(m==NULL) return 0; \
+    for(size_t i=0;i<q->blocks;i++) m[i]=q->map[(q->first+i)&(q->mapCap-1)]; \
+    free(q->map); \
+    q->map=m; q->mapCap*=2; q->first=0; \
+    return 1; \
+} \
+static inline T *name##At(struct type *q, size_t i){ \
+    size_t off=q->begin+i; \
+    return q->map[(q->first+off/type##Block)&(q->mapCap-1)]+off%type##Block; \
+} \
+static inline size_t name##Size(const struct type *q){ return q->size; } \
+static inline int name##PushBack(struct type *q, T v){ \
+    if(q->begin+q->size==q->blocks*type##Block){  /* last block full: add one after it */ \
+        if(q->blocks==q->mapCap && !name##GrowMap(q)) return 0; \
+        T *b=name##NewBlock(q); \
+        if(b==NULL) return 0; \
+        q->map[(q->first+q->blocks)&(q->mapCap-1)]=b; q->blocks++; \
+    } \
+    *name##At(q,q->size)=v; q->size++; \
+    return 1; \
+} \
+static inline int name##PushFront(struct type *q, T v){ \
+    if(q->begin==0){                               /* first block full: add one before it */ \
+        if(q->blocks==q->mapCap && !name##GrowMap(q)) return 0; \
+        T *b=name##NewBlock(q); \
+        if(b==NULL) return 0; \
+        q->first=(q->first-1)&(q->mapCap-1); q->map[q->first]=b; q->blocks++; \
+        q->begin=type##Block; \
+    } \
+    q->begin--; q->size++; \
+    *name##At(q,0)=v; \
+    return 1; \
+} \
+static inline int name##PopFront(struct type *q, T *v){ \
+    if(q->size==0) return 0; \
+    *v=*name##At(q,0); \
+    q->begin++; q->size--; \
+    if(q->begin==type##Block || q->size==0){       /* first block emptied */ \
+        name##FreeBlock(q,q->map[q->first]); \
+        q->first=(q->first+1)&(q->mapCap-1); q->blocks--; \
+        q->begin=0; \
+    } \
+    return 1; \
+} \
+static inline int name##PopBack(struct type *q, T *v){ \
+    if(q->size==0) return 0; \
+    q->size--; \
+    *v=*name##At(q,q->size); \
+    if(q->begin+q->size<=(q->blocks-1)*type##Block){ /* last block emptied */ \
+        name##FreeBlock(q,q->map[(q->first+q->blocks-1)&(q->mapCap-1)]); q->blocks--; \
+        if(q->blocks==0) q->begin=0; \
+    } \
+    return 1; \
+} \
+/* Removes every element; the blocks stay in the free list for reuse */ \
+static void name##Clear(struct type *q){ \
+    for(size_t i=0;i<q->blocks;i++) name##FreeBlock(q,q->map[(q->first+i)&(q->mapCap-1)]); \
+    q->blocks=0; q->begin=0; q->size=0; q->first=0; \
+} \
+static void free##type(struct type *q){ \
+    if(q==NULL) return; \
+    name##Clear(q); \
+    while(q->spare!=NULL){ \
+        void *b=q->spare; \
+        memcpy(&q->spare,b,sizeof(void*)); \
+        free(b); \
+    } \
+    free(q->map); free(q); \
+}
+
+DEFINE_DEQUE(Deque,deque,int)
+#endif
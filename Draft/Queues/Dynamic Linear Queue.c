@@ -0,0 +1,51 @@
+#ifndef DYNAMIC_LINEAR_QUEUE_C
+#define DYNAMIC_LINEAR_QUEUE_C
+#include<stdio.h>
+#include<stdlib.h>
+// Queue as a singly linked list: dequeue at the front, enqueue after the rear node
+struct QNode{int info; struct QNode *link;};
+struct LinkedQueue{struct QNode *front,*rear; int size;};
+// create new, empty queue
+struct LinkedQueue *newLinkedQueue(void){
+    struct LinkedQueue *q=(struct LinkedQueue*)malloc(sizeof(struct LinkedQueue));
+    if(q==NULL) return NULL;
+    q->front=q->rear=NULL; // no nodes yet
+    q->size=0;
+    return q;
+}
+int linkedIsEmpty(struct LinkedQueue *q){
+    return q->front==NULL;
+}
+void linkedEnqueue(struct LinkedQueue *q, int data){
+    struct QNode *node=(struct QNode*)malloc(sizeof(struct QNode)); // one allocation per element
+    if(node==NULL){
+        printf("Out of Memory!"); return;
+    }
+    node->info=data; node->link=NULL;
+    if(q->rear==NULL) q->front=node;    // first node is both front and rear
+    else q->rear->link=node;            // link after the current rear
+    q->rear=node;
+    q->size++;
+}
+int linkedDequeue(struct LinkedQueue *q){
+    if(linkedIsEmpty(q)){
+        printf("Underflow!"); return -1;
+    }
+    struct QNode *node=q->front;
+    int data=node->info;
+    q->front=node->link;                // next node becomes the front
+    if(q->front==NULL) q->rear=NULL;    // queue is now empty
+    free(node);
+    q->size--;
+    return data;
+}
+void freeLinkedQueue(struct LinkedQueue *q){
+    if(q==NULL) return;
+    while(q->front!=NULL){
+        struct QNode *node=q->front;
+        q->front=node->link;
+        free(node);
+    }
+    free(q);
+}
+#endif
@@ -0,0 +1,314 @@
+// Benchmark for the indexed D-ary heap of Priority Queue.c as the frontier of Dijkstra's and Prim's
+// algorithms, against lazy insertion: push a duplicate whenever a key improves and skip stale
+// entries when they are popped, as dijkstra() in daily/day_001 does with std::priority_queue.
+// Built as C++ only for std::priority_queue; the heaps are C.
+// Build: g++ -O2 -o pq_bench "Priority Queue Benchmark.cpp"
+// Run:   ./pq_bench --min 1024 --max 4194304 --json pq.json
+// Graphs over n vertices, undirected, weights in [1,2^20), stored as adjacency arrays (CSR):
+//   random  every vertex joined to a random earlier one, plus random edges up to average degree 8
+//   grid    a sqrt(n) x sqrt(n) grid, 4 neighbours per vertex, like a road network
+// Routines, one operation = a whole run from vertex 0 (ns/item = per vertex):
+//   dijkstra/<graph>/lazyStd     std::priority_queue of (distance,vertex) with duplicates
+//   dijkstra/<graph>/lazyHeap4   the same on the 4-ary heap of Heap Tree.c
+//   dijkstra/<graph>/indexed2|4|8  DEFINE_INDEXED_HEAP with D=2,4,8 and decrease-key
+//   prim/<graph>/lazyStd, prim/<graph>/indexed4|8   minimum spanning tree
+// The checksum is the sum of all distances, or the weight of the spanning tree; every routine
+// must match the lazyStd row of its algorithm and graph.
+// Untimed, checkDaryHeap() and checkIndexed*() run the operations the searches do not use
+// (Heapify, Build and Merge of both heaps, the indexed heap's Remove) on up to PQ_CHECK_MAX
+// entries and pop everything against a std::priority_queue.
+#include<queue>
+#include<vector>
+#include<functional>
+#include"Priority Queue.c"
+#include"../Trees/Heap Tree.c"
+#include"../Benchmark/Benchmark.h"
+
+DEFINE_INDEXED_HEAP(IndexedHeap2,long long,2)
+DEFINE_INDEXED_HEAP(IndexedHeap8,long long,8)
+struct PQPair{long long key; int v;};
+#define PQ_PAIR_LESS(x,y) ((x).key<(y).key)
+DEFINE_DARY_HEAP(PairHeap4,struct PQPair,4,PQ_PAIR_LESS)
+
+#define PQ_INF (1LL<<62)
+#define PQ_CHECK_MAX 65536
+typedef std::pair<long long,int> pli;
+
+struct Graph{int n; int *off, *to, *w;};   // the edges of v are to/w[off[v]..off[v+1])
+struct PQCtx{const struct Graph *g; long long *dist; char *done;};
+
+// Adjacency arrays of the undirected graph with m edges (eu[i],ev[i],ew[i])
+static int buildGraph(struct Graph *g, int n, const int *eu, const int *ev, const int *ew, size_t m){
+    g->n=n;
+    g->off=(int*)calloc((size_t)n+1,sizeof(int));
+    g->to=(int*)malloc(2*m*sizeof(int)); g->w=(int*)malloc(2*m*sizeof(int));
+    if(g->off==NULL || g->to==NULL || g->w==NULL) return 0;
+    for(size_t i=0;i<m;i++){ g->off[eu[i]+1]++; g->off[ev[i]+1]++; }
+    for(int v=0;v<n;v++) g->off[v+1]+=g->off[v];
+    int *fill=(int*)malloc((size_t)n*sizeof(int));
+    if(fill==NULL) return 0;
+    memcpy(fill,g->off,(size_t)n*sizeof(int));
+    for(size_t i=0;i<m;i++){
+        int a=fill[eu[i]]++, b=fill[ev[i]]++;
+        g->to[a]=ev[i]; g->w[a]=ew[i];
+        g->to[b]=eu[i]; g->w[b]=ew[i];
+    }
+    free(fill);
+    return 1;
+}
+static int makeGraph(struct Graph *g, int grid, int n, unsigned long long *s){
+    size_t m=0, cap=grid ? 2*(size_t)n : 4*(size_t)n;
+    int *eu=(int*)malloc(cap*sizeof(int)), *ev=(int*)malloc(cap*sizeof(int)), *ew=(int*)malloc(cap*sizeof(int));
+    if(eu==NULL || ev==NULL || ew==NULL) return 0;
+    if(grid){
+        int side=1;
+        while((side+1)*(side+1)<=n) side++;
+        for(int r=0;r<side;r++)
+            for(int c=0;c<side;c++){
+                int v=r*side+c;
+                if(c+1<side){ eu[m]=v; ev[m]=v+1; ew[m++]=1+(int)(benchRand(s)&0xfffff); }
+                if(r+1<side){ eu[m]=v; ev[m]=v+side; ew[m++]=1+(int)(benchRand(s)&0xfffff); }
+            }
+        n=side*side;
+    }
+    else{
+        for(int v=1;v<n;v++){ eu[m]=v; ev[m]=(int)(benchRand(s)%(unsigned)v); ew[m++]=1+(int)(benchRand(s)&0xfffff); }
+        while(m<cap){ eu[m]=(int)(benchRand(s)%(unsigned)n); ev[m]=(int)(benchRand(s)%(unsigned)n); ew[m++]=1+(int)(benchRand(s)&0xfffff); }
+    }
+    int ok=buildGraph(g,n,eu,ev,ew,m);
+    free(eu); free(ev); free(ew);
+    return ok;
+}
+static void freeGraph(struct Graph *g){
+    free(g->off); free(g->to); free(g->w);
+}
+static long long sumDist(const struct PQCtx *c){
+    long long sum=0;
+    for(int v=0;v<c->g->n;v++) sum+=c->dist[v];
+    return sum;
+}
+
+// Dijkstra with lazy insertion, as in dijkstra_s_algorithm.md
+static long long dijkstraLazyStd(void *vctx, size_t begin, size_t end){
+    struct PQCtx *c=(struct PQCtx*)vctx; const struct Graph *g=c->g; (void)begin; (void)end;
+    for(int v=0;v<g->n;v++) c->dist[v]=PQ_INF;
+    std::priority_queue<pli,std::vector<pli>,std::greater<pli> > pq;
+    c->dist[0]=0; pq.push(pli(0,0));
+    while(!pq.empty()){
+        long long d=pq.top().first; int u=pq.top().second; pq.pop();
+        if(d>c->dist[u]) continue;
+        for(int e=g->off[u];e<g->off[u+1];e++){
+            long long nd=d+g->w[e];
+            if(nd<c->dist[g->to[e]]){ c->dist[g->to[e]]=nd; pq.push(pli(nd,g->to[e])); }
+        }
+    }
+    return sumDist(c);
+}
+static long long dijkstraLazyHeap4(void *vctx, size_t begin, size_t end){
+    struct PQCtx *c=(struct PQCtx*)vctx; const struct Graph *g=c->g; (void)begin; (void)end;
+    for(int v=0;v<g->n;v++) c->dist[v]=PQ_INF;
+    struct PairHeap4 *pq=newPairHeap4(1024);
+    struct PQPair x={0,0};
+    c->dist[0]=0; PairHeap4Push(pq,x);
+    while(PairHeap4Pop(pq,&x)){
+        if(x.key>c->dist[x.v]) continue;
+        for(int e=g->off[x.v];e<g->off[x.v+1];e++){
+            struct PQPair y={x.key+g->w[e],g->to[e]};
+            if(y.key<c->dist[y.v]){ c->dist[y.v]=y.key; PairHeap4Push(pq,y); }
+        }
+    }
+    freePairHeap4(pq);
+    return sumDist(c);
+}
+// Dijkstra with decrease-key: at most one entry per vertex, nothing stale to skip
+#define PQ_DIJKSTRA_INDEXED(fn, H) \
+static long long fn(void *vctx, size_t begin, size_t end){ \
+    struct PQCtx *c=(struct PQCtx*)vctx; const struct Graph *g=c->g; (void)begin; (void)end; \
+    for(int v=0;v<g->n;v++) c->dist[v]=PQ_INF; \
+    struct H *pq=new##H(g->n); \
+    int u; long long d; \
+    c->dist[0]=0; H##Push(pq,0,0); \
+    while(H##Pop(pq,&u,&d)) \
+        for(int e=g->off[u];e<g->off[u+1];e++){ \
+            long long nd=d+g->w[e]; \
+            if(nd<c->dist[g->to[e]]){ c->dist[g->to[e]]=nd; H##Update(pq,g->to[e],nd); } \
+        } \
+    free##H(pq); \
+    return sumDist(c); \
+}
+PQ_DIJKSTRA_INDEXED(dijkstraIndexed2,IndexedHeap2)
+PQ_DIJKSTRA_INDEXED(dijkstraIndexed4,IndexedHeap4)
+PQ_DIJKSTRA_INDEXED(dijkstraIndexed8,IndexedHeap8)
+
+// Prim: grow the tree from vertex 0, always taking the lightest edge leaving it
+static long long primLazyStd(void *vctx, size_t begin, size_t end){
+    struct PQCtx *c=(struct PQCtx*)vctx; const struct Graph *g=c->g; (void)begin; (void)end;
+    memset(c->done,0,(size_t)g->n);
+    std::priority_queue<pli,std::vector<pli>,std::greater<pli> > pq;
+    long long total=0;
+    pq.push(pli(0,0));
+    while(!pq.empty()){
+        long long w=pq.top().first; int u=pq.top().second; pq.pop();
+        if(c->done[u]) continue;
+        c->done[u]=1; total+=w;
+        for(int e=g->off[u];e<g->off[u+1];e++)
+            if(!c->done[g->to[e]]) pq.push(pli(g->w[e],g->to[e]));
+    }
+    return total;
+}
+#define PQ_PRIM_INDEXED(fn, H) \
+static long long fn(void *vctx, size_t begin, size_t end){ \
+    struct PQCtx *c=(struct PQCtx*)vctx; const struct Graph *g=c->g; (void)begin; (void)end; \
+    memset(c->done,0,(size_t)g->n); \
+    struct H *pq=new##H(g->n); \
+    long long total=0, w; int u; \
+    H##Push(pq,0,0); \
+    while(H##Pop(pq,&u,&w)){ \
+        c->done[u]=1; total+=w; \
+        for(int e=g->off[u];e<g->off[u+1];e++) \
+            if(!c->done[g->to[e]]) H##Update(pq,g->to[e],g->w[e]); \
+    } \
+    free##H(pq); \
+    return total; \
+}
+PQ_PRIM_INDEXED(primIndexed4,IndexedHeap4)
+PQ_PRIM_INDEXED(primIndexed8,IndexedHeap8)
+
+typedef std::priority_queue<long long,std::vector<long long>,std::greater<long long> > MinQueue;
+// Heap4Int: Heapify of a plain array, Build, then a Merge of a few elements (sifted up one by one)
+// and one of many (appended and rebuilt), each followed by a check of the heap order; popping
+// must give what std::priority_queue gives
+static int checkDaryHeap(int n, unsigned long long *s){
+    std::vector<int> v(n), w(n);
+    for(int i=0;i<n;i++){ v[i]=(int)(benchRand(s)&0x7fffffff); w[i]=(int)(benchRand(s)&0x7fffffff); }
+    std::vector<int> a(v);
+    Heap4IntHeapify(a.data(),(size_t)n);
+    for(int i=1;i<n;i++) if(a[i]<a[(i-1)/4]) return 0;
+    struct Heap4Int *h=newHeap4Int(0), *o=newHeap4Int(0);
+    MinQueue ref;
+    int ok=h!=NULL && o!=NULL && Heap4IntBuild(h,v.data(),(size_t)n);
+    for(int i=0;i<n;i++) ref.push(v[i]);
+    for(int round=0;round<2 && ok;round++){
+        int m=round ? n : n/16;
+        ok=Heap4IntBuild(o,w.data(),(size_t)m) && Heap4IntMerge(h,o) && o->n==0;
+        for(size_t i=1;i<h->n && ok;i++) ok=h->a[i]>=h->a[(i-1)/4];
+        for(int i=0;i<m;i++) ref.push(w[i]);
+    }
+    int x;
+    for(;ok && !ref.empty();ref.pop()) ok=Heap4IntTop(h)==ref.top() && Heap4IntPop(h,&x) && x==ref.top();
+    ok=ok && !Heap4IntPop(h,&x);
+    freeHeap4Int(h); freeHeap4Int(o);
+    return ok;
+}
+// An indexed heap through Heapify (with repeated items), Remove, Update and two Merges, each
+// checked for heap order and positions, then popped empty. The reference is key[item] (-1 when
+// not queued) and a std::priority_queue of keys with stale entries skipped; the low
+// PQ_CHECK_BITS of a key are its item, so keys are distinct and every pop has one right answer.
+#define PQ_CHECK_BITS 17
+#define PQ_CHECK_INDEXED(fn, H, D) \
+static int fn(int n, unsigned long long *s){ \
+    struct H *q=new##H(n), *o=new##H(n); \
+    std::vector<long long> key(n,-1); std::vector<int> items(n); std::vector<long long> keys(n); \
+    MinQueue ref; \
+    int ok=q!=NULL && o!=NULL; \
+    for(int i=0;i<n;i++){ \
+        items[i]=(int)(benchRand(s)%(unsigned)n); \
+        keys[i]=(long long)(benchRand(s)&0xffffff)<<PQ_CHECK_BITS|items[i]; \
+        key[items[i]]=keys[i]; \
+    } \
+    ok=ok && H##Heapify(q,items.data(),keys.data(),n); \
+    for(int v=0;v<n;v++) if(key[v]>=0) ref.push(key[v]); \
+    for(int i=0;i<n/4 && ok;i++){ \
+        int v=(int)(benchRand(s)%(unsigned)n); \
+        ok=H##Remove(q,v)==(key[v]>=0); key[v]=-1; \
+    } \
+    for(int i=0;i<n/4 && ok;i++){ \
+        int v=(int)(benchRand(s)%(unsigned)n); \
+        long long k=(long long)(benchRand(s)&0xffffff)<<PQ_CHECK_BITS|v; \
+        int changes=key[v]<0 || k<key[v]; \
+        ok=H##Update(q,v,k)==changes; \
+        if(changes){ key[v]=k; ref.push(k); } \
+    } \
+    /* a few new entries are sifted up, many make Merge rebuild; shared items keep the smaller key */ \
+    for(int round=0;round<2 && ok;round++){ \
+        for(int i=0;i<(round ? n/2 : n/64);i++){ \
+            int v=(int)(benchRand(s)%(unsigned)n); \
+            long long k=(long long)(benchRand(s)&0xffffff)<<PQ_CHECK_BITS|v; \
+            if(!H##Push(o,v,k)) continue; \
+            if(key[v]<0 || k<key[v]){ key[v]=k; ref.push(k); } \
+        } \
+        ok=H##Merge(q,o) && H##Size(o)==0; \
+        for(int i=0;i<q->n && ok;i++) ok=q->pos[q->a[i].item]==i && (i==0 || q->a[i].key>=q->a[(i-1)/D].key); \
+        for(int v=0;v<n && ok;v++) ok=!H##Contains(o,v) && H##Contains(q,v)==(key[v]>=0) && \
+            (key[v]<0 || H##Key(q,v)==key[v]); \
+    } \
+    int v; long long k; \
+    while(ok && H##Pop(q,&v,&k)){ \
+        while(!ref.empty() && key[ref.top()&((1<<PQ_CHECK_BITS)-1)]!=ref.top()) ref.pop(); \
+        ok=!ref.empty() && ref.top()==k && key[v]==k; \
+        ref.pop(); key[v]=-1; \
+    } \
+    while(ok && !ref.empty()){ ok=key[ref.top()&((1<<PQ_CHECK_BITS)-1)]!=ref.top(); ref.pop(); } \
+    ok=ok && H##Size(q)==0; \
+    free##H(q); free##H(o); \
+    return ok; \
+}
+PQ_CHECK_INDEXED(checkIndexed2,IndexedHeap2,2)
+PQ_CHECK_INDEXED(checkIndexed4,IndexedHeap4,4)
+PQ_CHECK_INDEXED(checkIndexed8,IndexedHeap8,8)
+
+struct PQRoutine{const char *algo, *queue; long long (*run)(void *ctx, size_t begin, size_t end);};
+// lazyStd first in each algorithm: its checksum is the reference
+static const struct PQRoutine routines[]={
+    {"dijkstra","lazyStd",dijkstraLazyStd},{"dijkstra","lazyHeap4",dijkstraLazyHeap4},
+    {"dijkstra","indexed2",dijkstraIndexed2},{"dijkstra","indexed4",dijkstraIndexed4},{"dijkstra","indexed8",dijkstraIndexed8},
+    {"prim","lazyStd",primLazyStd},{"prim","indexed4",primIndexed4},{"prim","indexed8",primIndexed8},
+};
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    cfg.maxN=1<<22;
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"priority_queue");
+    int failed=0;
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        unsigned long long cs=benchSeed(cfg.seed);
+        int cn=(int)(n<PQ_CHECK_MAX ? n : PQ_CHECK_MAX);
+        if(!checkDaryHeap(cn,&cs) || !checkIndexed2(cn,&cs) || !checkIndexed4(cn,&cs) || !checkIndexed8(cn,&cs)){
+            fprintf(stderr,"heap operations disagree with std::priority_queue for n=%d\n",cn); failed=1;
+        }
+        for(int grid=0;grid<2;grid++){
+            unsigned long long s=benchSeed(cfg.seed);
+            struct Graph g;
+            long long *dist=(long long*)malloc(n*sizeof(long long));
+            char *done=(char*)malloc(n);
+            if(!makeGraph(&g,grid,(int)n,&s) || dist==NULL || done==NULL){
+                printf("Out of Memory!"); return 1;
+            }
+            struct PQCtx ctx={&g,dist,done};
+            size_t reps=cfg.ops*4/n;
+            if(reps<3) reps=3;
+            if(reps>200) reps=200;
+            long long ref=0;
+            for(size_t r=0;r<sizeof(routines)/sizeof(routines[0]);r++){
+                char name[64];
+                int isRef=strcmp(routines[r].queue,"lazyStd")==0;
+                snprintf(name,sizeof(name),"%s/%s/%s",routines[r].algo,grid ? "grid" : "random",routines[r].queue);
+                if(!benchSelected(&cfg,name) && !isRef) continue;   // the reference always runs
+                struct BenchCase bc={name,(size_t)g.n,reps,1,routines[r].run,NULL,&ctx,(size_t)g.n};
+                struct BenchResult res=benchMeasure(&cfg,&bc);
+                if(benchSelected(&cfg,name)) benchReportResult(&rep,&res);
+                long long one=res.checksum/(long long)res.ops;
+                if(isRef) ref=one;
+                else if(one!=ref){
+                    fprintf(stderr,"%s: wrong result for n=%zu\n",name,n); failed=1;
+                }
+            }
+            freeGraph(&g); free(dist); free(done);
+        }
+    }
+    benchReportEnd(&rep);
+    return failed;
+}
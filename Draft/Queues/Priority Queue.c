@@ -0,0 +1,146 @@
+#ifndef PRIORITY_QUEUE_C
+#define PRIORITY_QUEUE_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+// Indexed priority queue: a D-ary min-heap of (key,item) entries where item is a handle in
+// [0,items), plus pos[item], the entry's slot in the heap (-1 when absent). Every move in the heap
+// updates pos, so an item can be found, re-keyed or removed in O(D log_D n) without a search.
+// This is what Dijkstra's and Prim's algorithms need: when a shorter edge to a vertex turns up,
+// its key is lowered in place instead of pushing a duplicate that is skipped when popped later,
+// so the heap never holds more than one entry per vertex.
+// Layout as in Heap Tree.c: the heap starts D-1 entries before a 64-byte boundary, so the D
+// children of a node share one line (D=4 with 16-byte entries) or two (D=8).
+// DEFINE_INDEXED_HEAP(name,K,D) defines struct name and
+//   new##name(items), free##name(q), name##Size(q), name##Contains(q,item), name##Key(q,item)
+//   name##Push(q,item,key)         1, or 0 when item is already queued
+//   name##DecreaseKey(q,item,key)  1 when key is below the item's key
+//   name##Update(q,item,key)       push, or decrease-key when queued; 1 when the queue changed
+//   name##Pop(q,&item,&key)        0 when empty
+//   name##Remove(q,item)           1 when item was queued
+//   name##Heapify(q,items[],keys[],n)  replaces the contents in O(n)
+//   name##Merge(q,other)           moves every entry of other (same handle range) into q
+#define PQ_LINE 64
+
+#define DEFINE_INDEXED_HEAP(name, K, D) \
+struct name##Entry{K key; int item;}; \
+struct name{struct name##Entry *a; int *pos; int n, items; void *base;}; \
+static inline struct name *new##name(int items){ \
+    struct name *q=(struct name*)calloc(1,sizeof(struct name)); \
+    if(q==NULL || items<0) goto fail; \
+    q->items=items; \
+    q->pos=(int*)malloc((items ? items : 1)*sizeof(int)); \
+    if(q->pos==NULL || posix_memalign(&q->base,PQ_LINE,(items+(D))*sizeof(struct name##Entry))) goto fail; \
+    q->a=(struct name##Entry*)q->base+((D)-1); \
+    memset(q->pos,-1,items*sizeof(int)); \
+    return q; \
+fail: \
+    printf("Out of Memory!"); \
+    if(q!=NULL){ free(q->pos); free(q); } \
+    return NULL; \
+} \
+static inline void free##name(struct name *q){ \
+    if(q==NULL) return; \
+    free(q->base); free(q->pos); free(q); \
+} \
+static inline int name##Size(const struct name *q){ return q->n; } \
+static inline int name##Contains(const struct name *q, int item){ \
+    return item>=0 && item<q->items && q->pos[item]>=0; \
+} \
+static inline K name##Key(const struct name *q, int item){ return q->a[q->pos[item]].key; } \
+/* Moves the entry at slot i up or down to its place, keeping pos in step */ \
+static inline void name##SiftUp(struct name *q, int i){ \
+    struct name##Entry x=q->a[i], *a=q->a; \
+    while(i>0){ \
+        int p=(i-1)/(D); \
+        if(!(x.key<a[p].key)) break; \
+        a[i]=a[p]; q->pos[a[i].item]=i; i=p; \
+    } \
+    a[i]=x; q->pos[x.item]=i; \
+} \
+static inline void name##SiftDown(struct name *q, int i){ \
+    struct name##Entry x=q->a[i], *a=q->a; \
+    int n=q->n; \
+    for(;;){ \
+        int c=(D)*i+1, e, m=c; \
+        if(c>=n) break; \
+        e=c+(D)<n ? c+(D) : n; \
+        for(int k=c+1;k<e;k++) if(a[k].key<a[m].key) m=k;   /* smallest child */ \
+        if(!(a[m].key<x.key)) break; \
+        a[i]=a[m]; q->pos[a[i].item]=i; i=m; \
+    } \
+    a[i]=x; q->pos[x.item]=i; \
+} \
+static inline int name##Push(struct name *q, int item, K key){ \
+    if(item<0 || item>=q->items || q->pos[item]>=0) return 0; \
+    q->a[q->n].key=key; q->a[q->n].item=item; \
+    name##SiftUp(q,q->n++); \
+    return 1; \
+} \
+static inline int name##DecreaseKey(struct name *q, int item, K key){ \
+    if(!name##Contains(q,item)) return 0; \
+    int i=q->pos[item]; \
+    if(!(key<q->a[i].key)) return 0; \
+    q->a[i].key=key; \
+    name##SiftUp(q,i); \
+    return 1; \
+} \
+static inline int name##Update(struct name *q, int item, K key){ \
+    if(item<0 || item>=q->items) return 0; \
+    if(q->pos[item]<0) return name##Push(q,item,key); \
+    return name##DecreaseKey(q,item,key); \
+} \
+static inline int name##Pop(struct name *q, int *item, K *key){ \
+    if(q->n==0) return 0; \
+    *item=q->a[0].item; *key=q->a[0].key; \
+    q->pos[*item]=-1; \
+    if(--q->n>0){ q->a[0]=q->a[q->n]; name##SiftDown(q,0); } \
+    return 1; \
+} \
+/* The last entry fills the hole; it may belong above or below it */ \
+static inline int name##Remove(struct name *q, int item){ \
+    if(!name##Contains(q,item)) return 0; \
+    int i=q->pos[item]; \
+    q->pos[item]=-1; \
+    if(i==--q->n) return 1; \
+    K old=q->a[i].key; \
+    q->a[i]=q->a[q->n]; \
+    if(q->a[i].key<old) name##SiftUp(q,i); \
+    else name##SiftDown(q,i); \
+    return 1; \
+} \
+/* Floyd's bottom-up build; a repeated item keeps its last key. 0 for a handle out of range */ \
+static inline int name##Heapify(struct name *q, const int items[], const K keys[], int n){ \
+    for(int i=0;i<n;i++) if(items[i]<0 || items[i]>=q->items) return 0; \
+    for(int i=0;i<q->n;i++) q->pos[q->a[i].item]=-1; \
+    q->n=0; \
+    for(int i=0;i<n;i++){ \
+        if(q->pos[items[i]]>=0){ q->a[q->pos[items[i]]].key=keys[i]; continue; } \
+        q->a[q->n].key=keys[i]; q->a[q->n].item=items[i]; \
+        q->pos[items[i]]=q->n++; \
+    } \
+    if(q->n>1) for(int i=(q->n-2)/(D)+1;i-->0;) name##SiftDown(q,i); \
+    return 1; \
+} \
+/* An item queued in both keeps the smaller key. Few new entries are sifted up one by one; when \
+   m*D >= n they are appended and the whole heap rebuilt in O(n+m). other ends up empty. */ \
+static inline int name##Merge(struct name *q, struct name *other){ \
+    if(other->items>q->items) return 0; \
+    int n=q->n, m=0; \
+    for(int i=0;i<other->n;i++) if(q->pos[other->a[i].item]<0) m++; \
+    int rebuild=m*(D)>=n; \
+    for(int i=0;i<other->n;i++){ \
+        struct name##Entry x=other->a[i]; \
+        other->pos[x.item]=-1; \
+        if(q->pos[x.item]>=0){ name##DecreaseKey(q,x.item,x.key); continue; } \
+        q->a[q->n]=x; q->pos[x.item]=q->n; \
+        if(rebuild) q->n++; \
+        else name##SiftUp(q,q->n++); \
+    } \
+    other->n=0; \
+    if(rebuild && q->n>1) for(int i=(q->n-2)/(D)+1;i-->0;) name##SiftDown(q,i); \
+    return 1; \
+}
+
+DEFINE_INDEXED_HEAP(IndexedHeap4,long long,4)
+#endif
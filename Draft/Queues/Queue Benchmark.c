@@ -0,0 +1,163 @@
+// Throughput benchmark for the thread-safe queues in Draft/Queues.
+// Build: gcc -O2 -pthread -o queue_bench "Queue Benchmark.c"
+// Run:   ./queue_bench --threads 8 --min 1024 --max 65536 --ops 4194304 --json queue.json
+// n is the ring capacity. Every operation moves --ops integers from P producer threads to
+// C consumer threads, for P and C in 1,2,4,... up to --threads (SPSC only runs 1/1), and
+// ns/item is the wall time per integer. Every run checks that each integer arrived exactly once.
+#include<pthread.h>
+#include<unistd.h>
+#include"Circular Queue.c"
+#include"Static Linear Queue.c"
+#include"../Benchmark/Benchmark.h"
+
+#define QUEUE_BATCH 32  // elements per call for the batch variants
+
+// The mutex-guarded array queue from Static Linear Queue.c, as the baseline
+struct LockedQueue{pthread_mutex_t lock; struct Queue *q;};
+static void *newLocked(size_t capacity){
+    struct LockedQueue *l=(struct LockedQueue*)malloc(sizeof(struct LockedQueue));
+    pthread_mutex_init(&l->lock,NULL);
+    l->q=newQueue((unsigned)capacity);
+    return l;
+}
+static void freeLocked(void *q){
+    struct LockedQueue *l=(struct LockedQueue*)q;
+    pthread_mutex_destroy(&l->lock); freeQueue(l->q); free(l);
+}
+static size_t lockedPush(void *q, const int v[], size_t n){
+    struct LockedQueue *l=(struct LockedQueue*)q; size_t k=0;
+    pthread_mutex_lock(&l->lock);
+    while(k<n && !isFull(l->q)) enqueue(l->q,v[k++]);
+    pthread_mutex_unlock(&l->lock);
+    return k;
+}
+static size_t lockedPop(void *q, int out[], size_t n){
+    struct LockedQueue *l=(struct LockedQueue*)q; size_t k=0;
+    pthread_mutex_lock(&l->lock);
+    while(k<n && !isEmpty(l->q)) out[k++]=dequeue(l->q);
+    pthread_mutex_unlock(&l->lock);
+    return k;
+}
+// Uniform entry points: move up to n elements, return how many moved
+static void *newSpsc(size_t capacity){ return newSpscRingInt(capacity); }
+static void freeSpsc(void *q){ freeSpscRingInt((struct SpscRingInt*)q); }
+static size_t spscPush(void *q, const int v[], size_t n){ (void)n; return (size_t)spscRingIntPush((struct SpscRingInt*)q,v[0]); }
+static size_t spscPop(void *q, int out[], size_t n){ (void)n; return (size_t)spscRingIntPop((struct SpscRingInt*)q,out); }
+static size_t spscPushBatch(void *q, const int v[], size_t n){ return spscRingIntPushBatch((struct SpscRingInt*)q,v,n); }
+static size_t spscPopBatch(void *q, int out[], size_t n){ return spscRingIntPopBatch((struct SpscRingInt*)q,out,n); }
+static void *newMpmc(size_t capacity){ return newMpmcRingInt(capacity); }
+static void freeMpmc(void *q){ freeMpmcRingInt((struct MpmcRingInt*)q); }
+static size_t mpmcPush(void *q, const int v[], size_t n){ (void)n; return (size_t)mpmcRingIntPush((struct MpmcRingInt*)q,v[0]); }
+static size_t mpmcPop(void *q, int out[], size_t n){ (void)n; return (size_t)mpmcRingIntPop((struct MpmcRingInt*)q,out); }
+static size_t mpmcPushBatch(void *q, const int v[], size_t n){ return mpmcRingIntPushBatch((struct MpmcRingInt*)q,v,n); }
+static size_t mpmcPopBatch(void *q, int out[], size_t n){ return mpmcRingIntPopBatch((struct MpmcRingInt*)q,out,n); }
+
+struct QueueKind{
+    const char *name;
+    void *(*make)(size_t capacity); void (*destroy)(void *q);
+    size_t (*push)(void *q, const int v[], size_t n);
+    size_t (*pop)(void *q, int out[], size_t n);
+    size_t batch;           // elements offered per call
+    int single;             // one producer and one consumer only
+};
+// Register new queues here
+static const struct QueueKind kinds[]={
+    {"spsc",newSpsc,freeSpsc,spscPush,spscPop,1,1},
+    {"spscBatch",newSpsc,freeSpsc,spscPushBatch,spscPopBatch,QUEUE_BATCH,1},
+    {"mpmc",newMpmc,freeMpmc,mpmcPush,mpmcPop,1,0},
+    {"mpmcBatch",newMpmc,freeMpmc,mpmcPushBatch,mpmcPopBatch,QUEUE_BATCH,0},
+    {"mutex",newLocked,freeLocked,lockedPush,lockedPop,1,0},
+    {"mutexBatch",newLocked,freeLocked,lockedPush,lockedPop,QUEUE_BATCH,0},
+};
+
+struct QueueCtx{
+    const struct QueueKind *kind; void *q;
+    int producers, consumers;
+    size_t items;               // integers moved per operation
+    long remaining;             // integers not yet consumed in the current operation
+    long long sum;              // of everything consumed, for the exactly-once check
+};
+struct QueueWorker{struct QueueCtx *c; int id;};
+static void *producer(void *varg){
+    struct QueueWorker *w=(struct QueueWorker*)varg; struct QueueCtx *c=w->c;
+    size_t b=c->items*(size_t)w->id/(size_t)c->producers, e=c->items*(size_t)(w->id+1)/(size_t)c->producers;
+    int v[QUEUE_BATCH]; int spins=0;
+    while(b<e){
+        size_t n=e-b<c->kind->batch ? e-b : c->kind->batch;
+        for(size_t i=0;i<n;i++) v[i]=(int)(b+i+1);
+        size_t k=0;
+        while(k<n){
+            size_t m=c->kind->push(c->q,v+k,n-k);
+            if(m==0) ringPause(&spins);
+            k+=m;
+        }
+        b+=n;
+    }
+    return NULL;
+}
+static void *consumer(void *varg){
+    struct QueueWorker *w=(struct QueueWorker*)varg; struct QueueCtx *c=w->c;
+    int v[QUEUE_BATCH]; int spins=0; long long sum=0;
+    while(__atomic_load_n(&c->remaining,__ATOMIC_RELAXED)>0){
+        size_t m=c->kind->pop(c->q,v,c->kind->batch);
+        if(m==0){ ringPause(&spins); continue; }
+        for(size_t i=0;i<m;i++) sum+=v[i];
+        __atomic_sub_fetch(&c->remaining,(long)m,__ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&c->sum,sum,__ATOMIC_RELAXED);
+    return NULL;
+}
+// One operation: start every thread, move c->items integers, join
+static long long runTransfer(void *ctx, size_t begin, size_t end){
+    struct QueueCtx *c=(struct QueueCtx*)ctx;
+    long long total=0;
+    for(size_t op=begin;op<end;op++){
+        int t=c->producers+c->consumers;
+        pthread_t *tid=(pthread_t*)malloc((size_t)t*sizeof(pthread_t));
+        struct QueueWorker *w=(struct QueueWorker*)malloc((size_t)t*sizeof(struct QueueWorker));
+        c->remaining=(long)c->items; c->sum=0;
+        for(int i=0;i<t;i++){
+            w[i].c=c; w[i].id=i<c->producers ? i : i-c->producers;
+            pthread_create(&tid[i],NULL,i<c->producers ? producer : consumer,&w[i]);
+        }
+        for(int i=0;i<t;i++) pthread_join(tid[i],NULL);
+        free(tid); free(w);
+        total+=c->sum;
+    }
+    return total;
+}
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    cfg.minN=1<<10; cfg.maxN=1<<16; cfg.factor=8; cfg.ops=1<<22;
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    int maxThreads=cfg.threads>0 ? cfg.threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if(maxThreads<1) maxThreads=1;
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"queue");
+    long long expect=(long long)cfg.ops*((long long)cfg.ops+1)/2;
+    int failed=0;
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n))
+        for(size_t k=0;k<sizeof(kinds)/sizeof(kinds[0]);k++)
+            for(int p=1;p<=maxThreads;p*=2)
+                for(int cs=1;cs<=maxThreads;cs*=2){
+                    if(kinds[k].single && (p>1 || cs>1)) continue;
+                    char name[64];
+                    snprintf(name,sizeof(name),"%s/%dp%dc",kinds[k].name,p,cs);
+                    if(!benchSelected(&cfg,name)) continue;
+                    struct QueueCtx ctx={&kinds[k],kinds[k].make(n),p,cs,cfg.ops,0,0};
+                    if(ctx.q==NULL){
+                        printf("Out of Memory!"); return 1;
+                    }
+                    struct BenchCase bc={name,n,3,1,runTransfer,NULL,&ctx,cfg.ops};
+                    struct BenchResult res=benchMeasure(&cfg,&bc);
+                    benchReportResult(&rep,&res);
+                    if(res.checksum!=3*expect){
+                        fprintf(stderr,"%s: lost or duplicated items for n=%zu\n",name,n); failed=1;
+                    }
+                    kinds[k].destroy(ctx.q);
+                }
+    benchReportEnd(&rep);
+    return failed;
+}
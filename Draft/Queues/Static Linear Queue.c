@@ -1,18 +1,26 @@
+#ifndef STATIC_LINEAR_QUEUE_C
+#define STATIC_LINEAR_QUEUE_C
 #include<stdio.h>
 #include<stdlib.h>
 struct Queue{int front,rear,size;unsigned capacity;int *a;};
 // create new queue
 struct Queue *newQueue(unsigned capacity){
     struct Queue *q=(struct Queue*)malloc(sizeof(struct Queue)); // allocate memory for queue structure
-    q->front==0;q->rear==capacity-1;    // initialize front and rear indices
+    if(q==NULL) return NULL;
+    q->front=0;q->rear=(int)capacity-1;    // initialize front and rear indices
     q->size=0;q->capacity=capacity;    // set initial size and capacity
-    q->a=(int *)malloc(q->size*sizeof(int));    // allocate memory for queue array
+    q->a=(int *)malloc(capacity*sizeof(int));    // allocate memory for queue array
+    if(q->a==NULL){ free(q); return NULL; }
     return q;
 }
+void freeQueue(struct Queue *q){
+    if(q==NULL) return;
+    free(q->a); free(q);
+}
 // Function to check if the queue is full
 int isFull(struct Queue *q){
     // Check if size equals capacity
-    return q->size==q->capacity;
+    return q->size==(int)q->capacity;
 }
 // function to check if the queue is empty
 int isEmpty(struct Queue *q){
@@ -21,14 +29,20 @@ int isEmpty(struct Queue *q){
 }
 void enqueue(struct Queue *q,int data){
     if(isFull(q)){ // check if queue is full
-        printf("Overflow"); 
+        printf("Overflow");
         return; // return if overflow
     }
-    q->a[++q->rear]=data; // insert data at rear+1 and increment rear
+    q->rear=(q->rear+1)%(int)q->capacity; // advance rear, wrapping around to the start
+    q->a[q->rear]=data; // insert data at the new rear
+    q->size++;
 }
 int dequeue(struct Queue *q){
     if(isEmpty(q)){
         printf("Underflow!"); return -1;
     }
-    q->
-}
\ No newline at end of file
+    int data=q->a[q->front]; // take the element at front
+    q->front=(q->front+1)%(int)q->capacity; // advance front, wrapping around to the start
+    q->size--;
+    return data;
+}
+#endif
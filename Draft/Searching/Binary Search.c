@@ -1,14 +1,14 @@
 #include<stdio.h>
 #include<stdlib.h>
 int binary(int a[], int n, int data){
-    int l=0,r=n;
+    int l=0,r=n-1;
     while(l<=r){
         int m=l+(r-l)/2; // Find middle index
         if(a[m]==data) return m; // Element found
         if(a[m]<data) l=m+1; // Search right half
         else r=m-1; // Search left half
     }
-    printf("Element Doesn't Exist in The Array!"); return -1; // Not found
+    return -1; // Not found
 }
 int binaryRecursive(int a[], int l, int r, int data){
     // If array is not empty
@@ -18,7 +18,16 @@ int binaryRecursive(int a[], int l, int r, int data){
         if(a[m]<data) return binaryRecursive(a, m+1, r, data); // Search right
         else return binaryRecursive(a, l, m-1, data); // Search left
     }
-    printf("Element Doesn't Exist in The Array!"); return -1; // Element not found
+    return -1; // Element not found
+}
+#ifndef NO_MAIN
+#include"../Benchmark/Benchmark.h"
+struct BinaryQuery{int *a; int n; int data;};
+// Benchmark callback: one binary search per operation
+static long long runBinary(void *ctx, size_t begin, size_t end){
+    struct BinaryQuery *q=(struct BinaryQuery*)ctx; long long s=0;
+    for(size_t i=begin;i<end;i++) s+=binary(q->a,q->n,q->data);
+    return s;
 }
 int main(){
     // Input Size of Array
@@ -34,14 +43,19 @@ int main(){
     printf("Enter the Element to be Searched: ");
     int data; scanf("%d",&data);
     
-    // Start Clock
-    clock_t t = clock();
-    
-    // Call Binary Search Function 100,000 Times
-    for(int j=0;j<100000;j++) binary(a,n,data);
+    // Search once and report the index
+    int idx=binary(a,n,data);
+    if(idx<0){
+        printf("Element Doesn't Exist in The Array!"); return 0;
+    }
+    printf("Element Found at Index %d\n",idx);
     
-    // Calculate and Print Time Taken
-    t = clock() - t; 
-    double time_taken = ((double)t); // in seconds 
-    printf("Took %lf seconds to execute \n", time_taken); 
-}
\ No newline at end of file
+    // Time 100,000 searches with the shared harness (see Search Benchmark.c for the full suite)
+    struct BenchConfig cfg; benchDefaults(&cfg); cfg.ops=100000;
+    struct BinaryQuery q={a,n,data};
+    struct BenchCase bc={"binary",(size_t)n,0,0,runBinary,NULL,&q,0};
+    struct BenchResult r=benchMeasure(&cfg,&bc);
+    printf("Took %.2lf ns per search (p50 %.2lf ns, p99 %.2lf ns)\n",r.nsPerOp,r.p50,r.p99);
+    return 0;
+}
+#endif
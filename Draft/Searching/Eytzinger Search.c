@@ -0,0 +1,108 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+// Eytzinger (BFS) layout: node k has children 2k and 2k+1, so the first levels of every
+// search share a few cache lines and the next levels can be prefetched before they are needed.
+// b[] is 1-indexed and 64-byte aligned, so b[16k..16k+15] (the descendants of k four levels down) is one cache line.
+struct Eytzinger{int n; int *b; int *rank;};
+#define EYTZ_LINE 16 // ints per 64-byte cache line
+
+// In-order walk of the implicit tree, copying the sorted array into BFS order
+static int eytzingerFill(const int a[], struct Eytzinger *e, int i, int k){
+    if(k<=e->n){
+        i=eytzingerFill(a,e,i,2*k);        // left subtree holds the smaller keys
+        e->b[k]=a[i]; e->rank[k]=i++;      // this node, remembering its sorted position
+        i=eytzingerFill(a,e,i,2*k+1);      // right subtree holds the larger keys
+    }
+    return i;
+}
+// Builds the layout from a sorted array of n keys; returns NULL when out of memory
+struct Eytzinger *newEytzinger(const int a[], int n){
+    struct Eytzinger *e=(struct Eytzinger*)malloc(sizeof(struct Eytzinger));
+    if(e==NULL){
+        printf("Out of Memory!"); return NULL;
+    }
+    // Round up to whole cache lines so aligned_alloc accepts the size
+    size_t bytes=(((size_t)n+1)*sizeof(int)+63)&~(size_t)63;
+    e->n=n;
+    e->b=(int*)aligned_alloc(64,bytes);
+    e->rank=(int*)malloc(((size_t)n+1)*sizeof(int));
+    if(e->b==NULL || e->rank==NULL){
+        printf("Out of Memory!");
+        free(e->b); free(e->rank); free(e); return NULL;
+    }
+    e->b[0]=0; e->rank[0]=n; // k==0 means "past the end"
+    eytzingerFill(a,e,0,1);
+    return e;
+}
+void freeEytzinger(struct Eytzinger *e){
+    if(e==NULL) return;
+    free(e->b); free(e->rank); free(e);
+}
+// Descends branch-free: every level appends one bit (1 = went right). The answer is the last
+// node where we went left, i.e. k with its trailing 1s and the 0 before them shifted out.
+static inline int eytzingerDescend(const int *b, int n, int data){
+    int k=1;
+    while(k<=n){
+        __builtin_prefetch(b+(size_t)k*EYTZ_LINE); // descendants four levels ahead
+        k=2*k+(b[k]<data);
+    }
+    return k>>__builtin_ffs(~k);
+}
+// Index (in the original sorted array) of the first key >= data, or n when every key is smaller
+int eytzingerLowerBound(const struct Eytzinger *e, int data){
+    return e->rank[eytzingerDescend(e->b,e->n,data)];
+}
+// Same contract as binary(): index of data in the sorted array, or -1 when absent
+int eytzinger(const struct Eytzinger *e, int data){
+    int k=eytzingerDescend(e->b,e->n,data);
+    return (k!=0 && e->b[k]==data) ? e->rank[k] : -1;
+}
+// Answers m lower_bound queries. Keys are walked in groups of EYTZ_GROUP in lock-step so
+// their cache misses overlap instead of being paid one after another.
+#define EYTZ_GROUP 16
+void eytzingerBatch(const struct Eytzinger *e, const int keys[], int m, int out[]){
+    const int *b=e->b; int n=e->n;
+    // Levels every key can take without bounds checks: after d steps k<2^(d+1)-1<=n
+    int full=0; while((2<<full)-1<=n) full++;
+    for(int g=0;g<m;g+=EYTZ_GROUP){
+        int cnt=m-g<EYTZ_GROUP ? m-g : EYTZ_GROUP;
+        int k[EYTZ_GROUP];
+        for(int j=0;j<cnt;j++) k[j]=1;
+        for(int d=0;d<full;d++)
+            for(int j=0;j<cnt;j++){
+                __builtin_prefetch(b+(size_t)k[j]*EYTZ_LINE);
+                k[j]=2*k[j]+(b[k[j]]<keys[g+j]);
+            }
+        // At most one partial level is left for the deepest keys
+        for(int j=0;j<cnt;j++){
+            int x=k[j];
+            while(x<=n) x=2*x+(b[x]<keys[g+j]);
+            out[g+j]=e->rank[x>>__builtin_ffs(~x)];
+        }
+    }
+}
+#ifndef NO_MAIN
+int main(){
+    // Input Size of Array
+    printf("Enter the Size of The Array: ");
+    int n; scanf("%d",&n);
+
+    // Declare and Input Sorted Array
+    int *a=(int*)malloc(((size_t)n+1)*sizeof(int));
+    printf("Enter the Elements in Ascending Order: \n");
+    for(int i=0;i<n;i++) scanf("%d",&a[i]);
+
+    // Input Element to Search
+    printf("Enter the Element to be Searched: ");
+    int data; scanf("%d",&data);
+
+    struct Eytzinger *e=newEytzinger(a,n);
+    if(e==NULL) return 1;
+    int idx=eytzinger(e,data);
+    if(idx<0) printf("Element Doesn't Exist in The Array! It would be Inserted at Index %d\n",eytzingerLowerBound(e,data));
+    else printf("Element Found at Index %d\n",idx);
+    freeEytzinger(e); free(a);
+    return 0;
+}
+#endif
@@ -1,27 +1,137 @@
 #include<stdio.h>
 #include<stdlib.h>
 // Function to search for data in array a
-int linear(int a[], n, int data) {
+int linear(int a[], int n, int data) {
    for(int i=0; i<n; i++) { // Iterate over each element in the array
        if(a[i] == data) { // Check if current element equals data
            return i; // If so, return the index
        }
    }
-   // If data is not found, print error message and return -1
-   printf("Element Doesn't Exist in The Array!");
+   // If data is not found, return -1 (the caller decides whether to report it)
    return -1;
 }
 // Function: linearRecursive
 // Input: int array a[], size n, target data
 // Output: of data in a[], or -1 if not found
-int linearRecursive( a[], int n, int data) {
-   // Base case: if n is 0, return -1 if data not found
-   if(n==0) {
-       printf("Element Doesn't Exist in The Array!");
-       return -1;
-   }
-   // If data is found, return its index
-   if(a[n]==data) return n;
+int linearRecursive(int a[], int n, int data) {
+   // Base case: if n is 0, data was not found
+   if(n==0) return -1;
+   // If data is found at the last position, return its index
+   if(a[n-1]==data) return n-1;
    // Recursive case: search in the rest of the array
    return linearRecursive(a, n-1, data); // recursive call
-}
\ No newline at end of file
+}
+
+// Vectorised kernels. Each ISA gets its own copy compiled with a target attribute, and the
+// best one is picked at runtime, so one binary runs on every x86-64 host (and elsewhere via the scalar path).
+struct LinearKernels{
+    const char *isa;
+    int (*find)(const int a[], int n, int data);      // first index of data, or -1
+    int (*countLess)(const int a[], int n, int data); // number of keys < data
+};
+static int findScalar(const int a[], int n, int data){
+    for(int i=0;i<n;i++) if(a[i]==data) return i;
+    return -1;
+}
+static int countLessScalar(const int a[], int n, int data){
+    int c=0;
+    for(int i=0;i<n;i++) c+=a[i]<data; // branch-free: sorted or not, just count
+    return c;
+}
+#if defined(__x86_64__) || defined(__i386__)
+#include<immintrin.h>
+// 16 keys per iteration: two 8-lane compares OR-ed, movemask locates the first hit
+__attribute__((target("avx2")))
+static int findAvx2(const int a[], int n, int data){
+    __m256i k=_mm256_set1_epi32(data);
+    int i=0;
+    for(;i+16<=n;i+=16){
+        __m256i e0=_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(a+i)),k);
+        __m256i e1=_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(a+i+8)),k);
+        if(_mm256_testz_si256(_mm256_or_si256(e0,e1),_mm256_or_si256(e0,e1))) continue;
+        unsigned m=(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(e0))
+                  |(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(e1))<<8;
+        return i+__builtin_ctz(m);
+    }
+    for(;i<n;i++) if(a[i]==data) return i;
+    return -1;
+}
+__attribute__((target("avx2,popcnt")))
+static int countLessAvx2(const int a[], int n, int data){
+    __m256i k=_mm256_set1_epi32(data);
+    int i=0,c=0;
+    for(;i+8<=n;i+=8){
+        __m256i lt=_mm256_cmpgt_epi32(k,_mm256_loadu_si256((const __m256i*)(a+i)));
+        c+=__builtin_popcount((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(lt)));
+    }
+    for(;i<n;i++) c+=a[i]<data;
+    return c;
+}
+// 16 keys per iteration as four 4-lane compares
+__attribute__((target("sse4.2")))
+static int findSse42(const int a[], int n, int data){
+    __m128i k=_mm_set1_epi32(data);
+    int i=0;
+    for(;i+16<=n;i+=16){
+        __m128i e0=_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a+i)),k);
+        __m128i e1=_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a+i+4)),k);
+        __m128i e2=_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a+i+8)),k);
+        __m128i e3=_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a+i+12)),k);
+        __m128i any=_mm_or_si128(_mm_or_si128(e0,e1),_mm_or_si128(e2,e3));
+        if(_mm_testz_si128(any,any)) continue;
+        unsigned m=(unsigned)_mm_movemask_ps(_mm_castsi128_ps(e0))
+                  |(unsigned)_mm_movemask_ps(_mm_castsi128_ps(e1))<<4
+                  |(unsigned)_mm_movemask_ps(_mm_castsi128_ps(e2))<<8
+                  |(unsigned)_mm_movemask_ps(_mm_castsi128_ps(e3))<<12;
+        return i+__builtin_ctz(m);
+    }
+    for(;i<n;i++) if(a[i]==data) return i;
+    return -1;
+}
+__attribute__((target("sse4.2,popcnt")))
+static int countLessSse42(const int a[], int n, int data){
+    __m128i k=_mm_set1_epi32(data);
+    int i=0,c=0;
+    for(;i+4<=n;i+=4){
+        __m128i lt=_mm_cmpgt_epi32(k,_mm_loadu_si128((const __m128i*)(a+i)));
+        c+=__builtin_popcount((unsigned)_mm_movemask_ps(_mm_castsi128_ps(lt)));
+    }
+    for(;i<n;i++) c+=a[i]<data;
+    return c;
+}
+#endif
+// Picks the widest kernel the CPU supports; resolved once, on first use
+static const struct LinearKernels *linearKernels(void){
+    static const struct LinearKernels scalar={"scalar",findScalar,countLessScalar};
+    static const struct LinearKernels *chosen=NULL;
+    if(chosen!=NULL) return chosen;
+#if defined(__x86_64__) || defined(__i386__)
+    static const struct LinearKernels avx2={"avx2",findAvx2,countLessAvx2};
+    static const struct LinearKernels sse42={"sse4.2",findSse42,countLessSse42};
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) return chosen=&avx2;
+    if(__builtin_cpu_supports("sse4.2")) return chosen=&sse42;
+#endif
+    return chosen=&scalar;
+}
+// Same contract as linear(), on unsorted or sorted input
+int linearSimd(const int a[], int n, int data){
+    return linearKernels()->find(a,n,data);
+}
+// Sorted input: narrow with branch-free binary search until the range fits in
+// LINEAR_WINDOW keys (four cache lines), then count the smaller keys with SIMD.
+#define LINEAR_WINDOW 64
+int lowerBoundHybrid(const int a[], int n, int data){
+    int base=0, len=n;
+    while(len>LINEAR_WINDOW){
+        int half=len/2;
+        base=a[base+half-1]<data ? base+half : base; // compiles to a conditional move
+        len-=half;
+    }
+    return base+linearKernels()->countLess(a+base,len,data);
+}
+// Same contract as binary(): index of data in the sorted array, or -1 when absent
+int binaryLinear(const int a[], int n, int data){
+    int i=lowerBoundHybrid(a,n,data);
+    return (i<n && a[i]==data) ? i : -1;
+}
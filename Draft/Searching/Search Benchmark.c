@@ -0,0 +1,107 @@
+// Benchmark suite for every search routine in Draft/Searching.
+// Build: gcc -O2 -o search_bench "Search Benchmark.c"
+// Run:   ./search_bench --min 1024 --max 67108864 --miss 0.5 --json search.json
+// Sizes sweep geometrically from L1-resident to far past the last-level cache.
+#define NO_MAIN
+#include"Binary Search.c"
+#include"Linear Search.c"
+#include"Eytzinger Search.c"
+#include"../Benchmark/Benchmark.h"
+
+// Sorted input of odd keys (a[i]=2i+1) plus a stream of query keys; even keys always miss
+struct SearchCtx{int *a; int n; int *q; size_t mask; struct Eytzinger *e;};
+
+// One benchmark callback per routine so every call site is direct
+#define SEARCH_RUNNER(name, call) \
+static long long name(void *ctx, size_t begin, size_t end){ \
+    struct SearchCtx *c=(struct SearchCtx*)ctx; long long s=0; \
+    for(size_t i=begin;i<end;i++){ int data=c->q[i&c->mask]; s+=call; } \
+    return s; \
+}
+SEARCH_RUNNER(runBinary,binary(c->a,c->n,data))
+SEARCH_RUNNER(runBinaryRecursive,binaryRecursive(c->a,0,c->n-1,data))
+SEARCH_RUNNER(runLinear,linear(c->a,c->n,data))
+SEARCH_RUNNER(runLinearRecursive,linearRecursive(c->a,c->n,data))
+SEARCH_RUNNER(runLinearSimd,linearSimd(c->a,c->n,data))
+SEARCH_RUNNER(runBinaryLinear,binaryLinear(c->a,c->n,data))
+SEARCH_RUNNER(runEytzinger,eytzinger(c->e,data))
+// Batch API: the whole sample is answered by one call (query slices never wrap, see qn)
+static long long runEytzingerBatch(void *ctx, size_t begin, size_t end){
+    struct SearchCtx *c=(struct SearchCtx*)ctx; long long s=0;
+    int out[256];
+    for(size_t i=begin;i<end;i+=256){
+        int m=end-i<256 ? (int)(end-i) : 256;
+        eytzingerBatch(c->e,c->q+(i&c->mask),m,out);
+        for(int j=0;j<m;j++) s+=out[j];
+    }
+    return s;
+}
+
+struct SearchRoutine{
+    const char *name;
+    long long (*run)(void *ctx, size_t begin, size_t end);
+    size_t maxN;            // skip sizes where the routine is hopeless (O(n) scans, recursion depth)
+    unsigned batch;         // operations per sample, 0 for the command-line default
+};
+// Register new searches here once their files have bodies
+static const struct SearchRoutine routines[]={
+    {"binary",runBinary,(size_t)-1,0},
+    {"binaryRecursive",runBinaryRecursive,(size_t)-1,0},
+    {"linear",runLinear,1<<16,0},
+    {"linearRecursive",runLinearRecursive,1<<12,0},
+    {"linearSimd",runLinearSimd,1<<16,0},
+    {"binaryLinear",runBinaryLinear,(size_t)-1,0},
+    {"eytzinger",runEytzinger,(size_t)-1,0},
+    {"eytzingerBatch",runEytzingerBatch,(size_t)-1,256},
+};
+
+int main(int argc, char **argv){
+    // Suite-specific flag, stripped before the common ones are parsed
+    double miss=0; int m=1;
+    for(int i=1;i<argc;i++){
+        if(!strcmp(argv[i],"--miss") && i+1<argc) miss=atof(argv[++i]);
+        else argv[m++]=argv[i];
+    }
+    argc=m;
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); fprintf(stderr,"       [--miss FRACTION]\n"); return 1;
+    }
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"search");
+
+    // Query stream is shared by every size so each routine sees the same pattern
+    // A power of two of at least 256 keys, so batched slices [i&mask, +256) stay in bounds
+    size_t qn=256; while(qn<cfg.ops && qn<(1u<<20)) qn<<=1;
+    int *q=(int*)malloc(qn*sizeof(int));
+    int *a=(int*)malloc(cfg.maxN*sizeof(int));
+    if(q==NULL || a==NULL){
+        printf("Out of Memory!"); return 1;
+    }
+    for(size_t i=0;i<cfg.maxN;i++) a[i]=(int)(2*i+1);
+
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        // Uniformly random keys; a `miss` fraction of them fall between present keys
+        unsigned long long s=benchSeed(cfg.seed);
+        for(size_t i=0;i<qn;i++){
+            int hit=(double)(benchRand(&s)>>11)*(1.0/9007199254740992.0)>=miss;
+            q[i]=(int)(2*(benchRand(&s)%n)+hit);
+        }
+        struct SearchCtx ctx={a,(int)n,q,qn-1,newEytzinger(a,(int)n)};
+        if(ctx.e==NULL) return 1;
+
+        for(size_t r=0;r<sizeof(routines)/sizeof(routines[0]);r++){
+            if(n>routines[r].maxN || !benchSelected(&cfg,routines[r].name)) continue;
+            // Keep O(n) routines to a bounded amount of work per size
+            size_t ops=cfg.ops;
+            if(routines[r].maxN!=(size_t)-1 && ops*n>((size_t)1<<30)) ops=((size_t)1<<30)/n;
+            struct BenchCase bc={routines[r].name,n,ops,routines[r].batch,routines[r].run,NULL,&ctx,0};
+            struct BenchResult res=benchMeasure(&cfg,&bc);
+            benchReportResult(&rep,&res);
+        }
+        freeEytzinger(ctx.e);
+    }
+    benchReportEnd(&rep);
+    fprintf(stderr,"linearSimd kernels: %s\n",linearKernels()->isa);
+    free(a); free(q);
+    return 0;
+}
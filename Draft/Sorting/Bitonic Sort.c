@@ -0,0 +1,201 @@
+#ifndef BITONIC_SORT_C
+#define BITONIC_SORT_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<limits.h>
+#include"Quick Sort.c"
+#include"Merge Sort.c"
+// Sorting networks: a fixed sequence of compare-exchanges that does not depend on the data,
+// so it runs without a single mispredicted branch. For small arrays that beats insertion
+// and selection sort, which mispredict about once per element.
+
+// DEFINE_SORTING_NETWORK(name,T,LESS) defines void name(T a[], size_t n) for any n. It uses
+// Batcher's merge exchange (Knuth 5.2.2, Algorithm M), which has the optimal number of comparators
+// for n<=8 and stays within 3% of the best known networks up to 32 (191 against 185).
+// - name##Fixed(a,N) with a constant N is unrolled by the compiler into straight-line code,
+//   one min/max pair per comparator; name() dispatches to those copies up to SORTNET_UNROLLED.
+// - Larger n run the same network from loops (O(n log^2 n) comparators).
+// Not stable.
+#define SORTNET_UNROLLED 32  // sizes up to this get their own straight-line network
+
+#define SORTNET_CASE(name, k) case k: name##Fixed(a,k); return;
+#define DEFINE_SORTING_NETWORK(name, T, LESS) \
+/* Compare-exchange written as selects, which compile to cmov or min/max, not to branches */ \
+static inline void name##CX(T *x, T *y){ \
+    T a=*x, b=*y; int s=LESS(b,a); \
+    *x=s ? b : a; *y=s ? a : b; \
+} \
+/* Counted loops over the exponents of p and q, so every bound is a constant when n is */ \
+static inline __attribute__((always_inline)) void name##Fixed(T a[], size_t n){ \
+    int t=0; \
+    while(((size_t)1<<t)<n) t++; \
+    _Pragma("GCC unroll 8") \
+    for(int tp=t-1;tp>=0;tp--){ \
+        size_t p=(size_t)1<<tp; \
+        _Pragma("GCC unroll 8") \
+        for(int tq=t-1;tq>=tp;tq--){ \
+            size_t q=(size_t)1<<tq, r=tq==t-1 ? 0 : p, d=tq==t-1 ? p : 2*q-p; \
+            _Pragma("GCC unroll 32") \
+            for(size_t i=0;i+d<n;i++) if((i&p)==r) name##CX(&a[i],&a[i+d]); \
+        } \
+    } \
+} \
+static void name##Loop(T a[], size_t n){ \
+    int t=0; \
+    while(((size_t)1<<t)<n) t++; \
+    for(int tp=t-1;tp>=0;tp--){ \
+        size_t p=(size_t)1<<tp; \
+        for(int tq=t-1;tq>=tp;tq--){ \
+            size_t q=(size_t)1<<tq, r=tq==t-1 ? 0 : p, d=tq==t-1 ? p : 2*q-p; \
+            /* comparators (i,i+d) for the i whose p bit equals r: blocks of p indices */ \
+            for(size_t b=r;b+d<n;b+=2*p) \
+                for(size_t i=b;i<b+p && i+d<n;i++) name##CX(&a[i],&a[i+d]); \
+        } \
+    } \
+} \
+static void name(T a[], size_t n){ \
+    switch(n){ \
+    case 0: case 1: return; \
+    SORTNET_CASE(name,2) SORTNET_CASE(name,3) SORTNET_CASE(name,4) SORTNET_CASE(name,5) \
+    SORTNET_CASE(name,6) SORTNET_CASE(name,7) SORTNET_CASE(name,8) SORTNET_CASE(name,9) \
+    SORTNET_CASE(name,10) SORTNET_CASE(name,11) SORTNET_CASE(name,12) SORTNET_CASE(name,13) \
+    SORTNET_CASE(name,14) SORTNET_CASE(name,15) SORTNET_CASE(name,16) SORTNET_CASE(name,17) \
+    SORTNET_CASE(name,18) SORTNET_CASE(name,19) SORTNET_CASE(name,20) SORTNET_CASE(name,21) \
+    SORTNET_CASE(name,22) SORTNET_CASE(name,23) SORTNET_CASE(name,24) SORTNET_CASE(name,25) \
+    SORTNET_CASE(name,26) SORTNET_CASE(name,27) SORTNET_CASE(name,28) SORTNET_CASE(name,29) \
+    SORTNET_CASE(name,30) SORTNET_CASE(name,31) SORTNET_CASE(name,32) \
+    default: name##Loop(a,n); \
+    } \
+}
+
+#define SORTNET_INT_LESS(x,y) ((x)<(y))
+DEFINE_SORTING_NETWORK(sortNetworkInt,int,SORTNET_INT_LESS)
+
+// AVX2 bitonic kernel: up to 64 ints held in eight 8-lane registers. Each register is sorted
+// by an in-register network (permute, min, max, blend per layer), then sorted registers are
+// merged pairwise with bitonic merges: reverse one run, take lane-wise min and max, and
+// clean both halves, which never moves a key between lanes with a branch.
+#define BITONIC_AVX2_MAX 64
+#define BITONIC_AVX2_MIN 16  // smallSort() leaves up to this many keys to the unrolled networks
+#if defined(__x86_64__) || defined(__i386__)
+#include<immintrin.h>
+// One layer of an 8-lane network: lane i meets lane perm[i], lanes set in imm keep the larger key
+#define BITONIC_LAYER(v, perm, imm) do{ \
+    __m256i p_=_mm256_permutevar8x32_epi32(v,perm); \
+    v=_mm256_blend_epi32(_mm256_min_epi32(v,p_),_mm256_max_epi32(v,p_),imm); \
+}while(0)
+// The optimal 19-comparator network for 8 keys in its 6 parallel layers
+__attribute__((target("avx2")))
+static inline __m256i bitonicSort8Avx2(__m256i v){
+    BITONIC_LAYER(v,_mm256_setr_epi32(2,3,0,1,6,7,4,5),0xCC);   // (0,2)(1,3)(4,6)(5,7)
+    BITONIC_LAYER(v,_mm256_setr_epi32(4,5,6,7,0,1,2,3),0xF0);   // (0,4)(1,5)(2,6)(3,7)
+    BITONIC_LAYER(v,_mm256_setr_epi32(1,0,3,2,5,4,7,6),0xAA);   // (0,1)(2,3)(4,5)(6,7)
+    BITONIC_LAYER(v,_mm256_setr_epi32(0,1,4,5,2,3,6,7),0x30);   // (2,4)(3,5)
+    BITONIC_LAYER(v,_mm256_setr_epi32(0,4,2,6,1,5,3,7),0x50);   // (1,4)(3,6)
+    BITONIC_LAYER(v,_mm256_setr_epi32(0,2,1,4,3,6,5,7),0x54);   // (1,2)(3,4)(5,6)
+    return v;
+}
+// Sorts a bitonic register with half-cleaners at distance 4, 2 and 1
+__attribute__((target("avx2")))
+static inline __m256i bitonicClean8Avx2(__m256i v){
+    BITONIC_LAYER(v,_mm256_setr_epi32(4,5,6,7,0,1,2,3),0xF0);
+    BITONIC_LAYER(v,_mm256_setr_epi32(2,3,0,1,6,7,4,5),0xCC);
+    BITONIC_LAYER(v,_mm256_setr_epi32(1,0,3,2,5,4,7,6),0xAA);
+    return v;
+}
+// Merges the sorted runs r[0..k) and r[k..2k) (k registers each) into one sorted run r[0..2k)
+__attribute__((target("avx2")))
+static inline void bitonicMergeAvx2(__m256i r[], size_t k){
+    // Reversing the second run makes the whole sequence bitonic
+    const __m256i rev=_mm256_setr_epi32(7,6,5,4,3,2,1,0);
+    for(size_t i=0;i<k/2;i++){ __m256i t=r[k+i]; r[k+i]=r[2*k-1-i]; r[2*k-1-i]=t; }
+    for(size_t i=k;i<2*k;i++) r[i]=_mm256_permutevar8x32_epi32(r[i],rev);
+    // Half-cleaners across registers, then inside each register
+    for(size_t d=k;d>0;d/=2)
+        for(size_t i=0;i<2*k;i++) if(!(i&d)){
+            __m256i lo=_mm256_min_epi32(r[i],r[i+d]), hi=_mm256_max_epi32(r[i],r[i+d]);
+            r[i]=lo; r[i+d]=hi;
+        }
+    for(size_t i=0;i<2*k;i++) r[i]=bitonicClean8Avx2(r[i]);
+}
+// Sorts a[0..n), n<=BITONIC_AVX2_MAX. The partial last register is read and written with
+// masked loads and stores, its empty lanes padded with INT_MAX, so no key is copied twice.
+__attribute__((target("avx2")))
+static void bitonicSortInt32Avx2(int a[], size_t n){
+    if(n<2) return;
+    size_t regs=1, full=n/8;
+    while(regs*8<n) regs*=2;
+    __m256i r[BITONIC_AVX2_MAX/8];
+    const __m256i lane=_mm256_setr_epi32(0,1,2,3,4,5,6,7), inf=_mm256_set1_epi32(INT_MAX);
+    __m256i tail=_mm256_cmpgt_epi32(_mm256_set1_epi32((int)(n%8)),lane); // lanes holding keys
+    for(size_t i=0;i<full;i++) r[i]=_mm256_loadu_si256((const __m256i*)(a+8*i));
+    if(full<regs) r[full]=_mm256_blendv_epi8(inf,_mm256_maskload_epi32(a+8*full,tail),tail);
+    for(size_t i=full+1;i<regs;i++) r[i]=inf;
+    for(size_t i=0;i<regs;i++) r[i]=bitonicSort8Avx2(r[i]);
+    for(size_t k=1;k<regs;k*=2)
+        for(size_t i=0;i<regs;i+=2*k) bitonicMergeAvx2(r+i,k);
+    for(size_t i=0;i<full;i++) _mm256_storeu_si256((__m256i*)(a+8*i),r[i]);
+    if(full<regs) _mm256_maskstore_epi32(a+8*full,tail,r[full]);
+}
+#endif
+// Small-sort plug-in for int keys: the unrolled scalar networks up to BITONIC_AVX2_MIN keys
+// (as fast as the vector kernel there, with no setup), the AVX2 kernel up to 64 keys when the
+// CPU has it, beyond about 20 keys faster than the unrolled networks. Without AVX2 the unrolled
+// networks run up to SORTNET_UNROLLED keys and the loops after that. Resolved once, on first use.
+static void smallSortScalar(int a[], size_t n){ sortNetworkInt(a,n); }
+#if defined(__x86_64__) || defined(__i386__)
+static void smallSortAvx2(int a[], size_t n){
+    if(n>BITONIC_AVX2_MIN && n<=BITONIC_AVX2_MAX) bitonicSortInt32Avx2(a,n);
+    else sortNetworkInt(a,n);
+}
+#endif
+static void (*smallSortKernel(void))(int a[], size_t n){
+    static void (*chosen)(int a[], size_t n)=NULL;
+    if(chosen!=NULL) return chosen;
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) return chosen=smallSortAvx2;
+#endif
+    return chosen=smallSortScalar;
+}
+static inline void smallSortInt(int a[], size_t n){
+    smallSortKernel()(a,n);
+}
+
+// The larger sorts with the network as their base case
+#define SMALL_SORT_CUTOFF 32
+DEFINE_INTROSORT_WITH(introSortNetworkInt,int,INTRO_INT_LESS,smallSortInt,SMALL_SORT_CUTOFF)
+DEFINE_PARALLEL_MERGE_SORT_WITH(parallelMergeSortNetworkInt,int,MERGE_INT_LESS,smallSortInt,SMALL_SORT_CUTOFF)
+
+// Bitonic sort for any n: sort the halves in opposite directions, which makes the whole
+// range bitonic, then merge it. O(n log^2 n) compare-exchanges, every one data-independent.
+static void bitonicCompare(int a[], int i, int j, int up){
+    int x=a[i], y=a[j], s=up ? y<x : x<y;
+    a[i]=s ? y : x; a[j]=s ? x : y;
+}
+static void bitonicMerge(int a[], int lo, int n, int up){
+    if(n<2) return;
+    int m=1;
+    while(m*2<n) m*=2; // largest power of two below n
+    for(int i=lo;i<lo+n-m;i++) bitonicCompare(a,i,i+m,up);
+    bitonicMerge(a,lo,m,up);
+    bitonicMerge(a,lo+m,n-m,up);
+}
+static void bitonicSortRange(int a[], int lo, int n, int up){
+    if(n<2) return;
+    int m=n/2;
+    bitonicSortRange(a,lo,m,!up);
+    bitonicSortRange(a,lo+m,n-m,up);
+    bitonicMerge(a,lo,n,up);
+}
+// Sorts a[0..n-1] in ascending order
+void bitonicSort(int a[], int n){
+    bitonicSortRange(a,0,n,1);
+}
+// Sorts a short array a[0..n-1] (best up to 64 elements) with the fastest branch-free kernel
+void smallSort(int a[], int n){
+    if(n>1) smallSortInt(a,(size_t)n);
+}
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef RADIX_SORT_C
+#define RADIX_SORT_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<stdint.h>
+#include"Insertion Sort.c"
+#include"../Parallel/Work-Stealing Pool.h"
+#define COUNT_MAX_RANGE(n) (4*(size_t)(n)+65536) // wider key ranges go to radixSort()
+void radixSort(int a[], int n);
+// Counting sort for small key ranges: count every value between min and max, then rewrite the array.
+// A range too wide for its n would cost more counters than keys, so those arrays are radix sorted.
+void countSort(int a[], int n){
+    if(n<2) return;
+    int mn=a[0], mx=a[0];
+    for(int i=1;i<n;i++){ if(a[i]<mn) mn=a[i]; if(a[i]>mx) mx=a[i]; } // find the key range
+    size_t range=(size_t)((long long)mx-mn+1);
+    if(range>COUNT_MAX_RANGE(n)){
+        radixSort(a,n); return;
+    }
+    int *count=(int*)calloc(range,sizeof(int));
+    if(count==NULL){
+        printf("Out of Memory!"); return;
+    }
+    for(int i=0;i<n;i++) count[a[i]-mn]++;                       // histogram of the keys
+    for(size_t v=0,k=0;v<range;v++)
+        for(int c=count[v];c>0;c--) a[k++]=(int)(mn+(long long)v); // write each value count times
+    free(count);
+}
+
+// Radix sorts work on unsigned key bits. These transforms map signed and floating-point keys
+// to unsigned integers with the same order: flip the sign bit of two's complement values;
+// for IEEE floats flip only the sign bit of positives and every bit of negatives. That is a total
+// order on the bits: -NaN < -inf < negatives < -0.0 < +0.0 < positives < +inf < +NaN.
+static inline uint32_t radixKeyInt32(int32_t x){ return (uint32_t)x^0x80000000u; }
+static inline uint64_t radixKeyInt64(int64_t x){ return (uint64_t)x^0x8000000000000000ull; }
+static inline uint32_t radixKeyFloat(float f){
+    uint32_t u; memcpy(&u,&f,sizeof(u));
+    return u^(-(u>>31)|0x80000000u);
+}
+static inline uint64_t radixKeyDouble(double d){
+    uint64_t u; memcpy(&u,&d,sizeof(u));
+    return u^(-(u>>63)|0x8000000000000000ull);
+}
+
+// LSD radix sort. DEFINE_LSD_RADIX_SORT(name,T,K,KEY,BITS) sorts elements of type T by the
+// unsigned key KEY(x) of type K, BITS bits per digit (8: 256 buckets that stay in L1;
+// 11: 3 passes instead of 4 for 32-bit keys). Stable, so records with payloads keep their order.
+// - The histograms of every pass are counted in a single read of the input.
+// - A pass where every key has the same digit (e.g. the high bytes of small keys) is skipped.
+// Defines int name(T a[], size_t n) (-1 when out of memory) and, for callers that keep their own
+// scratch space, void name##With(T a[], T buf[], size_t n, size_t hist[]) with hist sized passes*2^BITS.
+#define DEFINE_LSD_RADIX_SORT(name, T, K, KEY, BITS) \
+static void name##With(T a[], T buf[], size_t n, size_t *hist){ \
+    enum{R=1<<(BITS), P=(int)((sizeof(K)*8+(BITS)-1)/(BITS))}; \
+    memset(hist,0,sizeof(size_t)*R*P); \
+    for(size_t i=0;i<n;i++){ \
+        K k=KEY(a[i]); \
+        for(int p=0;p<P;p++) hist[p*R+(size_t)((k>>(p*(BITS)))&(R-1))]++; \
+    } \
+    T *src=a, *dst=buf; \
+    for(int p=0;p<P;p++){ \
+        size_t *c=hist+p*R; int shift=p*(BITS); \
+        if(c[(size_t)((KEY(src[0])>>shift)&(R-1))]==n) continue; /* trivial pass */ \
+        for(size_t d=0,sum=0;d<R;d++){ size_t t=c[d]; c[d]=sum; sum+=t; } /* bucket starts */ \
+        for(size_t i=0;i<n;i++) dst[c[(size_t)((KEY(src[i])>>shift)&(R-1))]++]=src[i]; \
+        T *t=src; src=dst; dst=t; \
+    } \
+    if(src!=a) memcpy(a,src,n*sizeof(T)); \
+} \
+static int name(T a[], size_t n){ \
+    enum{R=1<<(BITS), P=(int)((sizeof(K)*8+(BITS)-1)/(BITS))}; \
+    if(n<2) return 0; \
+    T *buf=(T*)malloc(n*sizeof(T)); \
+    size_t *hist=(size_t*)malloc(sizeof(size_t)*R*P); \
+    if(buf==NULL || hist==NULL){ free(buf); free(hist); return -1; } \
+    name##With(a,buf,n,hist); \
+    free(buf); free(hist); \
+    return 0; \
+}
+
+// In-place MSD radix sort (American flag sort) with 8-bit digits, for jobs that cannot afford
+// a second array. Each level counts its bucket sizes, then cycles every element directly into
+// its bucket by swapping, and recurses per bucket on the next digit. Short buckets fall back to
+// insertion sort. Not stable. DEFINE_AMERICAN_FLAG_SORT(name,T,K,KEY) defines void name(T a[], size_t n).
+#define FLAG_SMALL 48
+#define DEFINE_AMERICAN_FLAG_SORT(name, T, K, KEY) \
+static inline int name##Less(T x, T y){ return KEY(x)<KEY(y); } \
+DEFINE_INSERTION_SORT(name##Insertion,T,name##Less) \
+static void name##Level(T a[], size_t n, int shift){ \
+    if(n<=FLAG_SMALL){ name##Insertion(a,n); return; } \
+    size_t count[256]={0}, next[256], end[256]; \
+    for(size_t i=0;i<n;i++) count[(KEY(a[i])>>shift)&255]++; \
+    if(count[(KEY(a[0])>>shift)&255]==n){   /* one bucket: go straight to the next digit */ \
+        if(shift>0) name##Level(a,n,shift-8); \
+        return; \
+    } \
+    for(size_t d=0,sum=0;d<256;d++){ next[d]=sum; sum+=count[d]; end[d]=sum; } \
+    for(size_t d=0;d<256;d++) \
+        while(next[d]<end[d]){ \
+            T x=a[next[d]]; size_t dx=(KEY(x)>>shift)&255; \
+            while(dx!=d){ /* swap x into its bucket, pick up whatever was there */ \
+                T t=a[next[dx]]; a[next[dx]++]=x; x=t; dx=(KEY(x)>>shift)&255; \
+            } \
+            a[next[d]++]=x; \
+        } \
+    if(shift==0) return; \
+    for(size_t d=0,b=0;d<256;b+=count[d],d++) \
+        if(count[d]>1) name##Level(a+b,count[d],shift-8); \
+} \
+static void name(T a[], size_t n){ \
+    if(n>1) name##Level(a,n,(int)sizeof(K)*8-8); \
+}
+
+// Multi-threaded LSD radix sort on the work-stealing pool. The input is cut into chunks
+// (four per thread); every chunk counts its own histogram, a prefix sum over (digit, chunk)
+// gives each chunk a private output range per bucket, and chunks scatter in parallel with no
+// atomics. Chunk order is preserved, so the sort stays stable.
+// DEFINE_PARALLEL_RADIX_SORT(name,T,K,KEY,BITS) defines int name(T a[], size_t n, struct Pool *pool).
+#define RADIX_PARALLEL_MIN 65536 // below this the sequential sort wins
+#define DEFINE_PARALLEL_RADIX_SORT(name, T, K, KEY, BITS) \
+DEFINE_LSD_RADIX_SORT(name##Seq,T,K,KEY,BITS) \
+struct name##Job{T *src; T *dst; size_t n, chunks; size_t *hist; int pass, all;}; \
+static void name##Count(void *varg, size_t cb, size_t ce){ \
+    enum{R=1<<(BITS), P=(int)((sizeof(K)*8+(BITS)-1)/(BITS))}; \
+    struct name##Job *j=(struct name##Job*)varg; \
+    for(size_t c=cb;c<ce;c++){ \
+        size_t b=j->n*c/j->chunks, e=j->n*(c+1)/j->chunks; \
+        size_t *h=j->hist+c*P*R; \
+        if(j->all){ /* every pass at once, from the untouched input */ \
+            memset(h,0,sizeof(size_t)*R*P); \
+            for(size_t i=b;i<e;i++){ \
+                K k=KEY(j->src[i]); \
+                for(int p=0;p<P;p++) h[p*R+(size_t)((k>>(p*(BITS)))&(R-1))]++; \
+            } \
+        } \
+        else{ \
+            int shift=j->pass*(BITS); h+=j->pass*R; \
+            memset(h,0,sizeof(size_t)*R); \
+            for(size_t i=b;i<e;i++) h[(size_t)((KEY(j->src[i])>>shift)&(R-1))]++; \
+        } \
+    } \
+} \
+static void name##Scatter(void *varg, size_t cb, size_t ce){ \
+    enum{R=1<<(BITS), P=(int)((sizeof(K)*8+(BITS)-1)/(BITS))}; \
+    struct name##Job *j=(struct name##Job*)varg; \
+    int shift=j->pass*(BITS); \
+    for(size_t c=cb;c<ce;c++){ \
+        size_t b=j->n*c/j->chunks, e=j->n*(c+1)/j->chunks; \
+        size_t *off=j->hist+c*P*R+j->pass*R; /* this chunk's write cursors */ \
+        for(size_t i=b;i<e;i++) j->dst[off[(size_t)((KEY(j->src[i])>>shift)&(R-1))]++]=j->src[i]; \
+    } \
+} \
+static int name(T a[], size_t n, struct Pool *pool){ \
+    enum{R=1<<(BITS), P=(int)((sizeof(K)*8+(BITS)-1)/(BITS))}; \
+    if(n<RADIX_PARALLEL_MIN || poolThreads(pool)==1) return name##Seq(a,n); \
+    size_t chunks=(size_t)poolThreads(pool)*4; \
+    T *buf=(T*)malloc(n*sizeof(T)); \
+    /* Per-chunk histograms of every pass, plus the global totals in the last slot */ \
+    size_t *hist=(size_t*)malloc(sizeof(size_t)*R*P*(chunks+1)); \
+    if(buf==NULL || hist==NULL){ free(buf); free(hist); return -1; } \
+    struct name##Job j={a,buf,n,chunks,hist,0,1}; \
+    poolParallelFor(pool,0,chunks,1,name##Count,&j); \
+    size_t *total=hist+chunks*P*R; /* digit counts do not depend on order: valid for every pass */ \
+    memset(total,0,sizeof(size_t)*R*P); \
+    for(size_t c=0;c<chunks;c++) for(size_t i=0;i<(size_t)R*P;i++) total[i]+=hist[c*P*R+i]; \
+    j.all=0; \
+    int fresh=1; /* per-chunk counts still match the chunk contents */ \
+    for(int p=0;p<P;p++){ \
+        j.pass=p; \
+        if(total[p*R+(size_t)((KEY(j.src[0])>>(p*(BITS)))&(R-1))]==n) continue; /* trivial pass */ \
+        if(!fresh) poolParallelFor(pool,0,chunks,1,name##Count,&j); \
+        /* Bucket-major, chunk-minor prefix sum: output ranges in stable order */ \
+        for(size_t d=0,sum=0;d<R;d++) \
+            for(size_t c=0;c<chunks;c++){ size_t t=hist[c*P*R+p*R+d]; hist[c*P*R+p*R+d]=sum; sum+=t; } \
+        poolParallelFor(pool,0,chunks,1,name##Scatter,&j); \
+        T *t=j.src; j.src=j.dst; j.dst=t; fresh=0; \
+    } \
+    if(j.src!=a) memcpy(a,j.src,n*sizeof(T)); \
+    free(buf); free(hist); \
+    return 0; \
+}
+
+#define RADIX_KEY_INT(x) radixKeyInt32(x)
+#define RADIX_KEY_FLOAT(x) radixKeyFloat(x)
+#define RADIX_KEY_INT64(x) radixKeyInt64(x)
+#define RADIX_KEY_DOUBLE(x) radixKeyDouble(x)
+DEFINE_LSD_RADIX_SORT(radixSortInt8,int,uint32_t,RADIX_KEY_INT,8)
+DEFINE_LSD_RADIX_SORT(radixSortInt11,int,uint32_t,RADIX_KEY_INT,11)
+DEFINE_LSD_RADIX_SORT(radixSortFloat11,float,uint32_t,RADIX_KEY_FLOAT,11)
+DEFINE_LSD_RADIX_SORT(radixSortInt64x11,int64_t,uint64_t,RADIX_KEY_INT64,11)
+DEFINE_LSD_RADIX_SORT(radixSortDouble11,double,uint64_t,RADIX_KEY_DOUBLE,11)
+DEFINE_AMERICAN_FLAG_SORT(americanFlagSortInt,int,uint32_t,RADIX_KEY_INT)
+DEFINE_PARALLEL_RADIX_SORT(parallelRadixSortInt,int,uint32_t,RADIX_KEY_INT,8)
+// Sorts a[0..n-1] ascending with three 11-bit passes
+void radixSort(int a[], int n){
+    if(n>1 && radixSortInt11(a,(size_t)n)) printf("Out of Memory!");
+}
+// In the order of radixKeyFloat()/radixKeyDouble(), NaNs at the ends by sign
+void radixSortFloat(float a[], int n){
+    if(n>1 && radixSortFloat11(a,(size_t)n)) printf("Out of Memory!");
+}
+void radixSortDouble(double a[], int n){
+    if(n>1 && radixSortDouble11(a,(size_t)n)) printf("Out of Memory!");
+}
+void radixSortInt64(int64_t a[], int n){
+    if(n>1 && radixSortInt64x11(a,(size_t)n)) printf("Out of Memory!");
+}
+// In place, no extra array
+void americanFlagSort(int a[], int n){
+    if(n>1) americanFlagSortInt(a,(size_t)n);
+}
+// On the workers of pool (NULL: on the calling thread); 0, or -1 when out of memory
+int parallelRadixSort(int a[], int n, struct Pool *pool){
+    if(parallelRadixSortInt(a,(size_t)(n>0 ? n : 0),pool)){
+        printf("Out of Memory!"); return -1;
+    }
+    return 0;
+}
+#endif
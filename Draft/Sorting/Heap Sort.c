@@ -0,0 +1,33 @@
+#ifndef HEAP_SORT_C
+#define HEAP_SORT_C
+#include<stdio.h>
+#include<stdlib.h>
+// Generic heap sort: DEFINE_HEAP_SORT(name,T,LESS) defines void name(T a[], size_t n).
+// In-place and O(n log n) in the worst case, which is why introsort falls back to it.
+#define DEFINE_HEAP_SORT(name, T, LESS) \
+static void name##SiftDown(T a[], size_t i, size_t n){ \
+    T x=a[i]; \
+    for(;;){ \
+        size_t c=2*i+1; \
+        if(c>=n) break; \
+        if(c+1<n && LESS(a[c],a[c+1])) c++;   /* pick the larger child */ \
+        if(!LESS(x,a[c])) break;              /* heap property restored */ \
+        a[i]=a[c]; i=c;                       /* move the child up, continue below */ \
+    } \
+    a[i]=x; \
+} \
+static void name(T a[], size_t n){ \
+    if(n<2) return; \
+    for(size_t i=n/2;i-->0;) name##SiftDown(a,i,n);   /* build a max-heap bottom-up */ \
+    for(size_t e=n-1;e>0;e--){ \
+        T t=a[0]; a[0]=a[e]; a[e]=t;                 /* move the maximum to the end */ \
+        name##SiftDown(a,0,e); \
+    } \
+}
+#define HEAP_INT_LESS(x,y) ((x)<(y))
+DEFINE_HEAP_SORT(heapSortInt,int,HEAP_INT_LESS)
+// Sorts a[0..n-1] in ascending order
+void heapSort(int a[], int n){
+    if(n>1) heapSortInt(a,(size_t)n);
+}
+#endif
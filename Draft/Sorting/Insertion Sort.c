@@ -1,6 +1,8 @@
+#ifndef INSERTION_SORT_C
+#define INSERTION_SORT_C
 #include<stdio.h>
 #include<stdlib.h>
-void insertionSort( a[], int n) {
+void insertionSort(int a[], int n) {
     // Iterate through elements in the array, starting from the second element
     for (int i = 1; i < n; i++) {
  int key = a[i], j = i - 1;  // Store the current element and its previous index
@@ -14,4 +16,16 @@ void insertionSort( a[], int n) {
         // Insert the key at its correct position
         a[j + 1] = key;
     }
-}
\ No newline at end of file
+}
+// Generic version for other element types and orderings, used as the small-range base case
+// of the larger sorts. DEFINE_INSERTION_SORT(name,T,LESS) defines void name(T a[], size_t n),
+// where LESS(x,y) is true when x must come before y. Equal keys keep their order (stable).
+#define DEFINE_INSERTION_SORT(name, T, LESS) \
+static void name(T a[], size_t n){ \
+    for(size_t i=1;i<n;i++){ \
+        T key=a[i]; size_t j=i; \
+        while(j>0 && LESS(key,a[j-1])){ a[j]=a[j-1]; j--; } /* shift larger elements right */ \
+        a[j]=key; \
+    } \
+}
+#endif
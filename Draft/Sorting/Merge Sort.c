@@ -0,0 +1,148 @@
+#ifndef MERGE_SORT_C
+#define MERGE_SORT_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include"Insertion Sort.c"
+#include"../Parallel/Work-Stealing Pool.h"
+// Merges the sorted runs a[l..m] and a[m+1..r] through buf (at least r-l+1 ints).
+// Takes from the left run on ties, so the sort is stable.
+void merge(int a[], int buf[], int l, int m, int r){
+    int i=l, j=m+1, k=0;
+    while(i<=m && j<=r) buf[k++]=(a[j]<a[i]) ? a[j++] : a[i++]; // smaller head first
+    while(i<=m) buf[k++]=a[i++];    // rest of the left run
+    while(j<=r) buf[k++]=a[j++];    // rest of the right run
+    memcpy(a+l,buf,(size_t)k*sizeof(int));
+}
+static void mergeSortRange(int a[], int buf[], int l, int r){
+    if(l>=r) return; // Base case: single element or empty range
+    int m=l+(r-l)/2;
+    mergeSortRange(a,buf,l,m);
+    mergeSortRange(a,buf,m+1,r);
+    merge(a,buf,l,m,r);
+}
+// Sorts a[l..r] top-down; one scratch buffer for the whole sort instead of two per merge
+void mergeSortRecursive(int a[], int l, int r){
+    if(l>=r) return;
+    int *buf=(int*)malloc((size_t)(r-l+1)*sizeof(int));
+    if(buf==NULL){
+        printf("Out of Memory!"); return;
+    }
+    mergeSortRange(a+l,buf,0,r-l);
+    free(buf);
+}
+// Sorts a[0..n-1] bottom-up, doubling the run width each pass
+void mergeSortIterative(int a[], int n){
+    int *buf=(int*)malloc((size_t)(n>0 ? n : 1)*sizeof(int));
+    if(buf==NULL){
+        printf("Out of Memory!"); return;
+    }
+    for(int w=1;w<n;w*=2)
+        for(int l=0;l<n-w;l+=2*w){
+            int m=l+w-1, r=l+2*w-1<n-1 ? l+2*w-1 : n-1;
+            merge(a,buf,l,m,r);
+        }
+    free(buf);
+}
+
+// Parallel stable merge sort on the work-stealing pool.
+// - One scratch buffer of n elements; every level sorts its halves into the other buffer
+//   and merges back, so data ping-pongs between the two instead of being copied.
+// - Halves above MERGE_SPAWN elements are sorted as separate tasks.
+// - Merges above MERGE_SPAWN outputs are split by co-ranking: the output position k is
+//   mapped to the (i,j) with i+j=k that a sequential merge would have reached, so both
+//   halves of the output can be produced in parallel, down to the final merge.
+// DEFINE_PARALLEL_MERGE_SORT(name,T,LESS) defines
+//   int name(T a[], size_t n, struct Pool *pool)    (0 on success, -1 out of memory)
+//   void name##With(T a[], T buf[], size_t n, struct Pool *pool)   (caller-provided buffer)
+// DEFINE_PARALLEL_MERGE_SORT_WITH(name,T,LESS,SMALL,CUTOFF) sorts runs of at most CUTOFF
+// elements with SMALL(a,n) instead of insertion sort; the result is only stable if SMALL is.
+#define MERGE_SMALL 32       // insertion sort below this
+#define MERGE_SPAWN 8192     // no tasks below this: the split costs more than it saves
+
+#define DEFINE_PARALLEL_MERGE_SORT(name, T, LESS) \
+DEFINE_INSERTION_SORT(name##Insertion,T,LESS) \
+DEFINE_PARALLEL_MERGE_SORT_WITH(name,T,LESS,name##Insertion,MERGE_SMALL)
+
+#define DEFINE_PARALLEL_MERGE_SORT_WITH(name, T, LESS, SMALL, CUTOFF) \
+static void name##MergeSeq(const T x[], size_t nx, const T y[], size_t ny, T out[]){ \
+    size_t i=0, j=0, k=0; \
+    while(i<nx && j<ny){ \
+        int takeY=LESS(y[j],x[i]);               /* ties go to x: stable */ \
+        out[k++]=takeY ? y[j] : x[i]; \
+        j+=takeY; i+=!takeY; \
+    } \
+    while(i<nx) out[k++]=x[i++]; \
+    while(j<ny) out[k++]=y[j++]; \
+} \
+/* Number of x elements among the first k outputs of a stable merge of x and y */ \
+static size_t name##CoRank(size_t k, const T x[], size_t nx, const T y[], size_t ny){ \
+    size_t lo=k>ny ? k-ny : 0, hi=k<nx ? k : nx; \
+    while(lo<hi){ \
+        size_t i=lo+(hi-lo)/2, j=k-i; \
+        if(j>0 && i<nx && !LESS(y[j-1],x[i])) lo=i+1;  /* x[i] precedes y[j-1]: take more x */ \
+        else hi=i; \
+    } \
+    return lo; \
+} \
+struct name##MergeArg{struct Pool *pool; const T *x; size_t nx; const T *y; size_t ny; T *out;}; \
+static void name##MergeTask(void *varg){ \
+    struct name##MergeArg *a=(struct name##MergeArg*)varg; \
+    size_t n=a->nx+a->ny; \
+    if(n<=MERGE_SPAWN){ name##MergeSeq(a->x,a->nx,a->y,a->ny,a->out); return; } \
+    size_t k=n/2, i=name##CoRank(k,a->x,a->nx,a->y,a->ny), j=k-i; \
+    struct name##MergeArg left={a->pool,a->x,i,a->y,j,a->out}; \
+    struct name##MergeArg right={a->pool,a->x+i,a->nx-i,a->y+j,a->ny-j,a->out+k}; \
+    long pending=0; struct PoolTask t={name##MergeTask,&left,NULL}; \
+    poolSpawn(a->pool,&t,&pending); \
+    name##MergeTask(&right); \
+    poolSync(a->pool,&pending); \
+} \
+/* Sorts a[0..n) leaving the result in b when toB, otherwise in a; the other array is scratch */ \
+struct name##SortArg{struct Pool *pool; T *a; T *b; size_t n; int toB;}; \
+static void name##SortTask(void *varg){ \
+    struct name##SortArg *s=(struct name##SortArg*)varg; \
+    T *a=s->a, *b=s->b; size_t n=s->n; \
+    if(n<=(CUTOFF)){ \
+        SMALL(a,n); \
+        if(s->toB) memcpy(b,a,n*sizeof(T)); \
+        return; \
+    } \
+    size_t m=n/2; \
+    /* Halves go to the buffer we are not merging into */ \
+    struct name##SortArg left={s->pool,a,b,m,!s->toB}, right={s->pool,a+m,b+m,n-m,!s->toB}; \
+    if(n>MERGE_SPAWN){ \
+        long pending=0; struct PoolTask t={name##SortTask,&left,NULL}; \
+        poolSpawn(s->pool,&t,&pending); \
+        name##SortTask(&right); \
+        poolSync(s->pool,&pending); \
+    } \
+    else{ name##SortTask(&left); name##SortTask(&right); } \
+    T *from=s->toB ? a : b, *to=s->toB ? b : a; \
+    struct name##MergeArg mg={s->pool,from,m,from+m,n-m,to}; \
+    name##MergeTask(&mg); \
+} \
+static void name##Root(void *varg){ name##SortTask(varg); } \
+static void name##With(T a[], T buf[], size_t n, struct Pool *pool){ \
+    struct name##SortArg s={pool,a,buf,n,0}; \
+    if(n>1) poolRun(pool,name##Root,&s); \
+} \
+static int name(T a[], size_t n, struct Pool *pool){ \
+    if(n<2) return 0; \
+    T *buf=(T*)malloc(n*sizeof(T)); \
+    if(buf==NULL) return -1; \
+    name##With(a,buf,n,pool); \
+    free(buf); \
+    return 0; \
+}
+
+#define MERGE_INT_LESS(x,y) ((x)<(y))
+DEFINE_PARALLEL_MERGE_SORT(parallelMergeSortInt,int,MERGE_INT_LESS)
+// Sorts a[0..n-1] stably on the workers of pool (NULL: on the calling thread); 0, or -1 when out of memory
+int parallelMergeSort(int a[], int n, struct Pool *pool){
+    if(parallelMergeSortInt(a,(size_t)(n>0 ? n : 0),pool)){
+        printf("Out of Memory!"); return -1;
+    }
+    return 0;
+}
+#endif
@@ -1,13 +1,22 @@
+#ifndef QUICK_SORT_C
+#define QUICK_SORT_C
 #include<stdio.h>
 #include<stdlib.h>
+#include"Insertion Sort.c"
+#include"Heap Sort.c"
 // Function to swap two integers
-void swap(int *, int *y) {    
+void swap(int *x, int *y) {
     int t = *x; // Temporary variable to hold x's value
     *x = *y; // Set x to y's value
     *y = t; // Set y to temporary variable's value
 }
-int partition(int a[], low, int high) {
-    // choose pivot as last element
+int partition(int a[], int low, int high) {
+    // choose pivot as the median of first, middle and last, moved to the end
+    // (the last element alone degrades to O(n^2) on sorted input)
+    int mid = low + (high - low) / 2;
+    if (a[mid] < a[low]) swap(&a[mid], &a[low]);
+    if (a[high] < a[low]) swap(&a[high], &a[low]);
+    if (a[mid] < a[high]) swap(&a[mid], &a[high]);
     int pivot = a[high];
     int i = low - 1;  // index for smaller elements
 
@@ -19,8 +28,6 @@ int partition(int a[], low, int high) {
             i++;
             // swap current element with element at i
             swap(&a[j], &a[i]);
-            // move to next element
-            j -= 1;
         }
     }
     // swap pivot element with element at i+1
@@ -28,14 +35,119 @@ int partition(int a[], low, int high) {
     // return index of pivot element
     return i + 1;
 }
-// recursive quicksort function
-void quickSort(int a[], int low, int high) {
-    // partition the array and get pivot index
-    int p = part(a, low, high);
 
-    // recursively sort elements on left side of pivot
-    quickSort(a, low, p - 1);
+// Introsort: quicksort with a ninther pivot and a branch-free block partition, insertion
+// sort for short ranges and heap sort once the recursion gets too deep, so the worst case
+// stays O(n log n). DEFINE_INTROSORT(name,T,LESS) defines void name(T a[], size_t n)
+// for any element type T and strict ordering LESS(x,y). Not stable.
+// DEFINE_INTROSORT_WITH(name,T,LESS,SMALL,CUTOFF) plugs in another base case: ranges of at
+// most CUTOFF elements go to SMALL(a,n), e.g. a sorting network from Bitonic Sort.c.
+#define INTRO_CUTOFF 24     // ranges this short go to insertion sort
+#define INTRO_NINTHER 128   // ranges longer than this use Tukey's ninther
+#define INTRO_BLOCK 64      // elements classified per block in the partition
+
+#define DEFINE_INTROSORT(name, T, LESS) \
+DEFINE_INSERTION_SORT(name##Insertion,T,LESS) \
+DEFINE_INTROSORT_WITH(name,T,LESS,name##Insertion,INTRO_CUTOFF)
+
+#define DEFINE_INTROSORT_WITH(name, T, LESS, SMALL, CUTOFF) \
+DEFINE_HEAP_SORT(name##Heap,T,LESS) \
+static inline void name##Swap(T *x, T *y){ T t=*x; *x=*y; *y=t; } \
+/* Orders a[i]<=a[j]<=a[k] */ \
+static inline void name##Sort3(T a[], size_t i, size_t j, size_t k){ \
+    if(LESS(a[j],a[i])) name##Swap(&a[i],&a[j]); \
+    if(LESS(a[k],a[j])) name##Swap(&a[j],&a[k]); \
+    if(LESS(a[j],a[i])) name##Swap(&a[i],&a[j]); \
+} \
+/* Leaves the median of 3 (or of 3 medians of 3) in a[0] */ \
+static inline void name##Pivot(T a[], size_t n){ \
+    size_t m=n/2; \
+    if(n>INTRO_NINTHER){ \
+        name##Sort3(a,0,m,n-1); name##Sort3(a,1,m-1,n-2); name##Sort3(a,2,m+1,n-3); \
+        name##Sort3(a,m-1,m,m+1); name##Swap(&a[0],&a[m]); \
+    } \
+    else name##Sort3(a,m,0,n-1); \
+} \
+/* Pivot in a[0]; keys < pivot end up left of it, keys >= pivot right. Misplaced keys of a \
+   left and a right block are found with branch-free counting into offset buffers, then \
+   swapped pairwise, so no branch depends on the data (BlockQuicksort). Returns the pivot index. */ \
+static size_t name##Partition(T a[], size_t n){ \
+    T pivot=a[0]; \
+    size_t l=1, r=n-1; /* [l,r] is still unclassified */ \
+    unsigned char offL[INTRO_BLOCK], offR[INTRO_BLOCK]; \
+    size_t numL=0, numR=0, startL=0, startR=0; \
+    while(r+1-l>=2*INTRO_BLOCK){ \
+        if(numL==0){ \
+            startL=0; \
+            for(size_t i=0;i<INTRO_BLOCK;i++){ offL[numL]=(unsigned char)i; numL+=!LESS(a[l+i],pivot); } \
+        } \
+        if(numR==0){ \
+            startR=0; \
+            for(size_t i=0;i<INTRO_BLOCK;i++){ offR[numR]=(unsigned char)i; numR+=LESS(a[r-i],pivot); } \
+        } \
+        size_t num=numL<numR ? numL : numR; \
+        for(size_t j=0;j<num;j++) name##Swap(&a[l+offL[startL+j]],&a[r-offR[startR+j]]); \
+        numL-=num; numR-=num; startL+=num; startR+=num; \
+        if(numL==0) l+=INTRO_BLOCK;  /* block fully classified */ \
+        if(numR==0) r-=INTRO_BLOCK; \
+    } \
+    /* Under two blocks left (possibly half-done): finish with a plain Hoare pass */ \
+    size_t i=l, j=r; \
+    for(;;){ \
+        while(i<=j && LESS(a[i],pivot)) i++; \
+        while(i<=j && !LESS(a[j],pivot)) j--; \
+        if(i>=j) break; \
+        name##Swap(&a[i],&a[j]); i++; j--; \
+    } \
+    name##Swap(&a[0],&a[i-1]); \
+    return i-1; \
+} \
+/* Keys <= pivot go left. Used when the pivot equals the key just before the range, \
+   so everything left of it equals the pivot and is already in place. */ \
+static size_t name##PartitionLeft(T a[], size_t n){ \
+    T pivot=a[0]; \
+    size_t i=1, j=n-1; \
+    for(;;){ \
+        while(i<=j && !LESS(pivot,a[i])) i++; \
+        while(i<=j && LESS(pivot,a[j])) j--; \
+        if(i>=j) break; \
+        name##Swap(&a[i],&a[j]); i++; j--; \
+    } \
+    name##Swap(&a[0],&a[i-1]); \
+    return i-1; \
+} \
+static void name##Loop(T a[], size_t n, int depth, int leftmost){ \
+    while(n>(CUTOFF)){ \
+        if(depth--==0){ name##Heap(a,n); return; } /* too many bad pivots */ \
+        name##Pivot(a,n); \
+        /* a[-1] is a lower bound for this range; equal to the pivot means a run of duplicates */ \
+        if(!leftmost && !LESS(a[-1],a[0])){ \
+            size_t p=name##PartitionLeft(a,n); \
+            a+=p+1; n-=p+1; continue; \
+        } \
+        size_t p=name##Partition(a,n); \
+        /* Recurse into the smaller side and loop on the larger: O(log n) stack */ \
+        if(p<n-p-1){ name##Loop(a,p,depth,leftmost); a+=p+1; n-=p+1; leftmost=0; } \
+        else{ name##Loop(a+p+1,n-p-1,depth,0); n=p; } \
+    } \
+    SMALL(a,n); \
+} \
+static void name(T a[], size_t n){ \
+    int depth=0; \
+    for(size_t m=n;m>1;m>>=1) depth++; \
+    name##Loop(a,n,2*depth,1); \
+}
 
-    // recursively sort elements on right side of pivot
-    quickSort(a, p + 1, high);
-}
\ No newline at end of file
+#define INTRO_INT_LESS(x,y) ((x)<(y))
+DEFINE_INTROSORT(introSortInt,int,INTRO_INT_LESS)
+// Sorts a[0..n-1] in ascending order in O(n log n) worst case
+void introSort(int a[], int n){
+    if(n>1) introSortInt(a,(size_t)n);
+}
+// Sorts a[low..high]; kept for existing callers, now backed by introsort
+void quickSort(int a[], int low, int high) {
+    // nothing to do for empty or single-element ranges
+    if (low >= high) return;
+    introSort(a + low, high - low + 1);
+}
+#endif
@@ -0,0 +1,306 @@
+// Benchmark suite for the comparison and radix sorts in Draft/Sorting against std::sort and qsort.
+// Built as C++ only so std::sort can sit in the same table; the sorts themselves are C.
+// Build: g++ -O2 -pthread -o sort_bench "Sort Benchmark.cpp"
+// Run:   ./sort_bench --min 1024 --max 16777216 --threads 8 --json sort.json
+// Every routine sorts the same random, sorted, reversed, few-unique, nearly-sorted (1% of keys
+// displaced, like an append-mostly log) and 16-shard (concatenated sorted runs) inputs; each result
+// is checked against std::sort before it is reported. Untimed, the stable sorts also sort records of
+// 16 distinct keys with their input position as payload, which must stay ascending within a key.
+// The key rows sort floats and doubles (negatives, both zeros, infinities, NaNs of either sign) and
+// full-range int64s, checked bit for bit against std::sort in the order of the radix key transforms.
+// The small-batch rows ("/g8" .. "/g64")
+// cut the random input into independent groups of 8 to 64 keys and sort every group.
+#include<algorithm>
+#include<limits>
+#define NO_MAIN
+#include"Quick Sort.c"
+#include"Merge Sort.c"
+#include"Count Sort, Radix Sort.c"
+#include"Bitonic Sort.c"
+#include"Tim Sort.c"
+#include"../Benchmark/Benchmark.h"
+
+struct SortCtx{const int *src; int *dst; size_t n; size_t group;};
+// Untimed: every operation sorts a fresh copy of the input
+static void copyInput(void *ctx, size_t begin, size_t end){
+    struct SortCtx *c=(struct SortCtx*)ctx; (void)begin; (void)end;
+    memcpy(c->dst,c->src,c->n*sizeof(int));
+}
+#define SORT_RUNNER(name, call) \
+static long long name(void *ctx, size_t begin, size_t end){ \
+    struct SortCtx *c=(struct SortCtx*)ctx; int *a=c->dst; size_t n=c->n; (void)begin; (void)end; \
+    call; \
+    return n ? (long long)a[0]+a[n-1] : 0; \
+}
+static int compareInt(const void *x, const void *y){
+    int a=*(const int*)x, b=*(const int*)y;
+    return (a>b)-(a<b);
+}
+SORT_RUNNER(runIntroSort,introSort(a,(int)n))
+SORT_RUNNER(runHeapSort,heapSort(a,(int)n))
+SORT_RUNNER(runInsertionSort,insertionSort(a,(int)n))
+SORT_RUNNER(runStdSort,std::sort(a,a+n))
+SORT_RUNNER(runQsort,qsort(a,n,sizeof(int),compareInt))
+SORT_RUNNER(runStdStableSort,std::stable_sort(a,a+n))
+// Parallel routines share one pool sized by --threads
+static struct Pool *benchPool;
+SORT_RUNNER(runMergeSortRecursive,mergeSortRecursive(a,0,(int)n-1))
+SORT_RUNNER(runMergeSortIterative,mergeSortIterative(a,(int)n))
+SORT_RUNNER(runParallelMergeSort,parallelMergeSort(a,(int)n,benchPool))
+SORT_RUNNER(runCountSort,countSort(a,(int)n))
+SORT_RUNNER(runRadixSort8,radixSortInt8(a,n))
+SORT_RUNNER(runRadixSort11,radixSortInt11(a,n))
+SORT_RUNNER(runAmericanFlagSort,americanFlagSortInt(a,n))
+SORT_RUNNER(runParallelRadixSort,parallelRadixSort(a,(int)n,benchPool))
+SORT_RUNNER(runIntroSortNetwork,introSortNetworkInt(a,n))
+SORT_RUNNER(runParallelMergeSortNetwork,parallelMergeSortNetworkInt(a,n,benchPool))
+SORT_RUNNER(runBitonicSort,bitonicSort(a,(int)n))
+SORT_RUNNER(runTimSort,timSortInt(a,n))
+// Small-batch runners sort c->n/c->group independent groups per operation
+#define GROUP_RUNNER(name, call) \
+static long long name(void *ctx, size_t begin, size_t end){ \
+    struct SortCtx *c=(struct SortCtx*)ctx; size_t n=c->group; (void)begin; (void)end; \
+    for(size_t i=0;i+n<=c->n;i+=n){ int *a=c->dst+i; call; } \
+    return c->n ? (long long)c->dst[0]+c->dst[c->n-1] : 0; \
+}
+GROUP_RUNNER(runGroupInsertionSort,insertionSort(a,(int)n))
+GROUP_RUNNER(runGroupStdSort,std::sort(a,a+n))
+GROUP_RUNNER(runGroupSortNetwork,sortNetworkInt(a,n))
+GROUP_RUNNER(runGroupSmallSort,smallSortInt(a,n))
+
+// Floating-point and 64-bit keys. The std::sort rows compare through the same key transforms,
+// which order -0.0 before +0.0 and put NaNs at the ends by sign.
+struct KeyCtx{const void *src; void *dst; size_t n, size;};
+static void copyKeys(void *ctx, size_t begin, size_t end){
+    struct KeyCtx *c=(struct KeyCtx*)ctx; (void)begin; (void)end;
+    memcpy(c->dst,c->src,c->n*c->size);
+}
+static bool floatLess(float x, float y){ return radixKeyFloat(x)<radixKeyFloat(y); }
+static bool doubleLess(double x, double y){ return radixKeyDouble(x)<radixKeyDouble(y); }
+#define KEY_RUNNER(name, T, call) \
+static long long name(void *ctx, size_t begin, size_t end){ \
+    struct KeyCtx *c=(struct KeyCtx*)ctx; T *a=(T*)c->dst; size_t n=c->n; (void)begin; (void)end; \
+    call; \
+    return (long long)n; \
+}
+KEY_RUNNER(runRadixSortFloat,float,radixSortFloat(a,(int)n))
+KEY_RUNNER(runStdSortFloat,float,std::sort(a,a+n,floatLess))
+KEY_RUNNER(runRadixSortDouble,double,radixSortDouble(a,(int)n))
+KEY_RUNNER(runStdSortDouble,double,std::sort(a,a+n,doubleLess))
+KEY_RUNNER(runRadixSortInt64,int64_t,radixSortInt64(a,(int)n))
+KEY_RUNNER(runStdSortInt64,int64_t,std::sort(a,a+n))
+// One value in 8 is special: -0.0, +0.0, -inf, +inf, or a NaN of either sign with a random payload
+template<class T, class U> static T specialKey(unsigned long long r){
+    T v;
+    switch(r%6){
+    case 0: return (T)-0.0;
+    case 1: return (T)0.0;
+    case 2: return -std::numeric_limits<T>::infinity();
+    case 3: return std::numeric_limits<T>::infinity();
+    default:{
+        U u; v=std::numeric_limits<T>::quiet_NaN(); memcpy(&u,&v,sizeof(u));
+        u|=(U)(r>>8)&(((U)1<<(sizeof(U)*8-12))-1);              // payload bits below the quiet bit
+        if(r%6==5) u|=(U)1<<(sizeof(U)*8-1);                    // negative NaN
+        memcpy(&v,&u,sizeof(v)); return v;
+    }
+    }
+}
+static void fillFloats(float a[], size_t n, unsigned long long *s){
+    for(size_t i=0;i<n;i++){
+        unsigned long long r=benchRand(s);
+        a[i]=r%8==0 ? specialKey<float,uint32_t>(r>>3) : (float)((double)(long long)(r>>8)/(1LL<<40)-(1<<15));
+    }
+}
+static void fillDoubles(double a[], size_t n, unsigned long long *s){
+    for(size_t i=0;i<n;i++){
+        unsigned long long r=benchRand(s);
+        a[i]=r%8==0 ? specialKey<double,uint64_t>(r>>3) : (double)(long long)(r>>8)/(1LL<<30)-(1<<25);
+    }
+}
+static void fillInt64s(int64_t a[], size_t n, unsigned long long *s){
+    for(size_t i=0;i<n;i++) a[i]=(int64_t)benchRand(s);
+}
+struct KeyRoutine{const char *name; long long (*run)(void *ctx, size_t begin, size_t end); int type;};
+static const struct KeyRoutine keyRoutines[]={
+    {"radixSortFloat/mixed",runRadixSortFloat,0},{"std::sort/float",runStdSortFloat,0},
+    {"radixSortDouble/mixed",runRadixSortDouble,1},{"std::sort/double",runStdSortDouble,1},
+    {"radixSortInt64/random",runRadixSortInt64,2},{"std::sort/int64",runStdSortInt64,2},
+};
+
+// Key/payload records for the stability checks
+struct SortRecord{int key, index;};
+#define RECORD_LESS(x,y) ((x).key<(y).key)
+#define RECORD_KEY(x) radixKeyInt32((x).key)
+DEFINE_PARALLEL_MERGE_SORT(parallelMergeSortRecord,struct SortRecord,RECORD_LESS)
+DEFINE_TIM_SORT(timSortRecord,struct SortRecord,RECORD_LESS)
+DEFINE_LSD_RADIX_SORT(radixSortRecord,struct SortRecord,uint32_t,RECORD_KEY,8)
+static int sortRecordsMerge(struct SortRecord r[], size_t n){ return parallelMergeSortRecord(r,n,benchPool); }
+static int sortRecordsTim(struct SortRecord r[], size_t n){ return timSortRecord(r,n); }
+static int sortRecordsRadix(struct SortRecord r[], size_t n){ return radixSortRecord(r,n); }
+static const struct{const char *name; int (*sort)(struct SortRecord r[], size_t n);} stableRoutines[]={
+    {"parallelMergeSort",sortRecordsMerge},{"timSort",sortRecordsTim},{"radixSort8",sortRecordsRadix},
+};
+// Keys ascending, and positions ascending among equal keys
+static int checkStable(const struct SortRecord r[], size_t n){
+    for(size_t i=1;i<n;i++)
+        if(r[i].key<r[i-1].key || (r[i].key==r[i-1].key && r[i].index<r[i-1].index)) return 0;
+    return 1;
+}
+
+struct SortRoutine{
+    const char *name;
+    long long (*run)(void *ctx, size_t begin, size_t end);
+    size_t maxN;            // skip sizes where the routine is quadratic
+};
+// Register new sorts here
+static const struct SortRoutine routines[]={
+    {"introSort",runIntroSort,(size_t)-1},
+    {"heapSort",runHeapSort,(size_t)-1},
+    {"insertionSort",runInsertionSort,1<<12},
+    {"std::sort",runStdSort,(size_t)-1},
+    {"qsort",runQsort,(size_t)-1},
+    {"std::stable_sort",runStdStableSort,(size_t)-1},
+    {"mergeSortRecursive",runMergeSortRecursive,(size_t)-1},
+    {"mergeSortIterative",runMergeSortIterative,(size_t)-1},
+    {"parallelMergeSort",runParallelMergeSort,(size_t)-1},
+    {"countSort",runCountSort,(size_t)-1},
+    {"radixSort8",runRadixSort8,(size_t)-1},
+    {"radixSort11",runRadixSort11,(size_t)-1},
+    {"americanFlagSort",runAmericanFlagSort,(size_t)-1},
+    {"parallelRadixSort",runParallelRadixSort,(size_t)-1},
+    {"introSortNetwork",runIntroSortNetwork,(size_t)-1},
+    {"parallelMergeSortNetwork",runParallelMergeSortNetwork,(size_t)-1},
+    {"bitonicSort",runBitonicSort,(size_t)-1},
+    {"timSort",runTimSort,(size_t)-1},
+};
+static const struct SortRoutine groupRoutines[]={
+    {"insertionSort",runGroupInsertionSort,(size_t)-1},
+    {"std::sort",runGroupStdSort,(size_t)-1},
+    {"sortNetwork",runGroupSortNetwork,(size_t)-1},
+    {"smallSort",runGroupSmallSort,(size_t)-1},
+};
+static const size_t groups[]={8,16,32,64};
+
+// Input distributions
+static void fillRandom(int a[], size_t n, unsigned long long *s){
+    for(size_t i=0;i<n;i++) a[i]=(int)benchRand(s);
+}
+static void fillSorted(int a[], size_t n, unsigned long long *s){
+    fillRandom(a,n,s); std::sort(a,a+n);
+}
+static void fillReversed(int a[], size_t n, unsigned long long *s){
+    fillSorted(a,n,s); std::reverse(a,a+n);
+}
+static void fillFewUnique(int a[], size_t n, unsigned long long *s){
+    for(size_t i=0;i<n;i++) a[i]=(int)(benchRand(s)%16);
+}
+static void fillNearlySorted(int a[], size_t n, unsigned long long *s){
+    fillSorted(a,n,s);
+    for(size_t i=0;i<n/100;i++){
+        size_t x=benchRand(s)%n, y=benchRand(s)%n;
+        int t=a[x]; a[x]=a[y]; a[y]=t;
+    }
+}
+static void fillShards(int a[], size_t n, unsigned long long *s){
+    fillRandom(a,n,s);
+    for(size_t k=0;k<16;k++) std::sort(a+n*k/16,a+n*(k+1)/16);
+}
+struct SortInput{const char *name; void (*fill)(int a[], size_t n, unsigned long long *s);};
+static const struct SortInput inputs[]={
+    {"random",fillRandom},{"sorted",fillSorted},{"reversed",fillReversed},{"fewUnique",fillFewUnique},
+    {"nearlySorted",fillNearlySorted},{"shards",fillShards},
+};
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    cfg.maxN=1<<22; // sorting is O(n log n) per operation, keep the default sweep short
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"sort");
+    benchPool=newPool(cfg.threads);
+    int *src=(int*)malloc(cfg.maxN*sizeof(int));
+    int *dst=(int*)malloc(cfg.maxN*sizeof(int));
+    int *ref=(int*)malloc(cfg.maxN*sizeof(int));
+    struct SortRecord *rec=(struct SortRecord*)malloc(cfg.maxN*sizeof(struct SortRecord));
+    void *keySrc=malloc(cfg.maxN*8), *keyDst=malloc(cfg.maxN*8), *keyRef=malloc(cfg.maxN*8);
+    if(src==NULL || dst==NULL || ref==NULL || rec==NULL || keySrc==NULL || keyDst==NULL || keyRef==NULL){
+        printf("Out of Memory!"); return 1;
+    }
+    int failed=0;
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        // Enough repetitions for stable numbers, at least 3 even for the largest inputs
+        size_t reps=cfg.ops*4/n;
+        if(reps<3) reps=3;
+        if(reps>200) reps=200;
+        for(size_t d=0;d<sizeof(inputs)/sizeof(inputs[0]);d++){
+            unsigned long long s=benchSeed(cfg.seed);
+            inputs[d].fill(src,n,&s);
+            memcpy(ref,src,n*sizeof(int)); std::sort(ref,ref+n);
+            struct SortCtx ctx={src,dst,n,n};
+            for(size_t r=0;r<sizeof(routines)/sizeof(routines[0]);r++){
+                char name[64];
+                snprintf(name,sizeof(name),"%s/%s",routines[r].name,inputs[d].name);
+                if(n>routines[r].maxN || !benchSelected(&cfg,name)) continue;
+                struct BenchCase bc={name,n,reps,1,routines[r].run,copyInput,&ctx,n};
+                struct BenchResult res=benchMeasure(&cfg,&bc);
+                benchReportResult(&rep,&res);
+                if(memcmp(dst,ref,n*sizeof(int))){
+                    fprintf(stderr,"%s: wrong result for n=%zu\n",name,n); failed=1;
+                }
+            }
+        }
+        // Floating-point and 64-bit keys, each type's input sorted by std::sort as the reference
+        for(int type=0;type<3;type++){
+            size_t size=type==0 ? sizeof(float) : 8;
+            unsigned long long s=benchSeed(cfg.seed);
+            if(type==0){ fillFloats((float*)keySrc,n,&s); memcpy(keyRef,keySrc,n*size); std::sort((float*)keyRef,(float*)keyRef+n,floatLess); }
+            else if(type==1){ fillDoubles((double*)keySrc,n,&s); memcpy(keyRef,keySrc,n*size); std::sort((double*)keyRef,(double*)keyRef+n,doubleLess); }
+            else{ fillInt64s((int64_t*)keySrc,n,&s); memcpy(keyRef,keySrc,n*size); std::sort((int64_t*)keyRef,(int64_t*)keyRef+n); }
+            struct KeyCtx ctx={keySrc,keyDst,n,size};
+            for(size_t r=0;r<sizeof(keyRoutines)/sizeof(keyRoutines[0]);r++){
+                if(keyRoutines[r].type!=type || !benchSelected(&cfg,keyRoutines[r].name)) continue;
+                struct BenchCase bc={keyRoutines[r].name,n,reps,1,keyRoutines[r].run,copyKeys,&ctx,n};
+                struct BenchResult res=benchMeasure(&cfg,&bc);
+                benchReportResult(&rep,&res);
+                if(memcmp(keyDst,keyRef,n*size)){
+                    fprintf(stderr,"%s: wrong result for n=%zu\n",keyRoutines[r].name,n); failed=1;
+                }
+            }
+        }
+        // Stability: few distinct keys (some negative), input positions as payload
+        for(size_t r=0;r<sizeof(stableRoutines)/sizeof(stableRoutines[0]);r++){
+            if(!benchSelected(&cfg,stableRoutines[r].name)) continue;
+            unsigned long long s=benchSeed(cfg.seed);
+            for(size_t i=0;i<n;i++){ rec[i].key=(int)(benchRand(&s)%16)-8; rec[i].index=(int)i; }
+            if(stableRoutines[r].sort(rec,n) || !checkStable(rec,n)){
+                fprintf(stderr,"%s: not stable for n=%zu\n",stableRoutines[r].name,n); failed=1;
+            }
+        }
+        // Small batches: whole groups only, each checked against std::sort of that group
+        for(size_t g=0;g<sizeof(groups)/sizeof(groups[0]);g++){
+            size_t m=n-n%groups[g];
+            if(m==0) continue;
+            unsigned long long s=benchSeed(cfg.seed);
+            fillRandom(src,m,&s);
+            memcpy(ref,src,m*sizeof(int));
+            for(size_t i=0;i<m;i+=groups[g]) std::sort(ref+i,ref+i+groups[g]);
+            struct SortCtx ctx={src,dst,m,groups[g]};
+            for(size_t r=0;r<sizeof(groupRoutines)/sizeof(groupRoutines[0]);r++){
+                char name[64];
+                snprintf(name,sizeof(name),"%s/g%zu",groupRoutines[r].name,groups[g]);
+                if(!benchSelected(&cfg,name)) continue;
+                struct BenchCase bc={name,m,reps,1,groupRoutines[r].run,copyInput,&ctx,m};
+                struct BenchResult res=benchMeasure(&cfg,&bc);
+                benchReportResult(&rep,&res);
+                if(memcmp(dst,ref,m*sizeof(int))){
+                    fprintf(stderr,"%s: wrong result for n=%zu\n",name,m); failed=1;
+                }
+            }
+        }
+    }
+    benchReportEnd(&rep);
+    free(src); free(dst); free(ref); free(rec); free(keySrc); free(keyDst); free(keyRef);
+    freePool(benchPool);
+    return failed;
+}
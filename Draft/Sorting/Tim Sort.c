@@ -0,0 +1,240 @@
+#ifndef TIM_SORT_C
+#define TIM_SORT_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+// TimSort (Peters 2002, as in CPython and Java): a stable, adaptive merge sort.
+// - The input is scanned for natural runs; strictly descending runs are reversed in place.
+// - Runs shorter than minrun (32..64, chosen so n/minrun is close to a power of two) are
+//   extended with binary insertion sort.
+// - Runs are pushed on a stack whose lengths must keep decreasing like Fibonacci numbers
+//   (len[i-2] > len[i-1] + len[i] and len[i-1] > len[i]), so merges stay balanced and the
+//   stack stays O(log n). This is the corrected check of de Gouw et al. (2015).
+// - A merge copies only the shorter run into the buffer. When one run keeps winning, the merge
+//   switches to galloping: exponential search for how many keys it wins in a row, then one
+//   block copy. minGallop adapts to how well galloping has been paying off.
+// On sorted or reversed input that is a single O(n) scan; on k runs it is O(n log k).
+// DEFINE_TIM_SORT(name,T,LESS) defines
+//   int name(T a[], size_t n)                 (0 on success, -1 out of memory)
+//   void name##With(T a[], size_t n, T buf[]) (buf holds at least n/2 elements, reusable across calls)
+#define TIM_MIN_MERGE 64     // arrays shorter than this are one binary insertion sort
+#define TIM_MIN_GALLOP 7     // wins in a row before a merge starts galloping
+#define TIM_STACK 85         // enough runs for any 64-bit n under the stack invariants
+
+#define DEFINE_TIM_SORT(name, T, LESS) \
+struct name##State{ \
+    T *a, *tmp; \
+    long minGallop; \
+    int runs; \
+    size_t base[TIM_STACK], len[TIM_STACK]; \
+}; \
+/* n/minrun is a power of two or just below one: the top 6 bits of n, plus 1 if any lower bit is set */ \
+static size_t name##MinRun(size_t n){ \
+    size_t r=0; \
+    while(n>=TIM_MIN_MERGE){ r|=n&1; n>>=1; } \
+    return n+r; \
+} \
+/* Sorts a[0..n) given that a[0..start) is sorted; binary search keeps comparisons at O(n log n) */ \
+static void name##BinaryInsertion(T a[], size_t n, size_t start){ \
+    for(size_t i=start;i<n;i++){ \
+        T key=a[i]; size_t lo=0, hi=i; \
+        while(lo<hi){ \
+            size_t m=lo+(hi-lo)/2; \
+            if(LESS(key,a[m])) hi=m; else lo=m+1; /* after equal keys: stable */ \
+        } \
+        memmove(a+lo+1,a+lo,(i-lo)*sizeof(T)); \
+        a[lo]=key; \
+    } \
+} \
+/* Length of the run at a[0]; a strictly descending run is reversed (strictly, to stay stable) */ \
+static size_t name##CountRun(T a[], size_t n){ \
+    size_t hi=1; \
+    if(n<2) return n; \
+    if(LESS(a[1],a[0])){ \
+        while(hi<n && LESS(a[hi],a[hi-1])) hi++; \
+        for(size_t i=0,j=hi-1;i<j;i++,j--){ T t=a[i]; a[i]=a[j]; a[j]=t; } \
+    } \
+    else while(hi<n && !LESS(a[hi],a[hi-1])) hi++; \
+    return hi; \
+} \
+/* Leftmost k with a[k-1] < key <= a[k], searched outward from a[hint] in steps 1,3,7,... */ \
+static long name##GallopLeft(T key, const T a[], long n, long hint){ \
+    long last=0, ofs=1; \
+    if(LESS(a[hint],key)){ \
+        long maxOfs=n-hint; \
+        while(ofs<maxOfs && LESS(a[hint+ofs],key)){ last=ofs; ofs=2*ofs+1; } \
+        if(ofs>maxOfs) ofs=maxOfs; \
+        last+=hint; ofs+=hint; \
+    } \
+    else{ \
+        long maxOfs=hint+1; \
+        while(ofs<maxOfs && !LESS(a[hint-ofs],key)){ last=ofs; ofs=2*ofs+1; } \
+        if(ofs>maxOfs) ofs=maxOfs; \
+        long t=last; last=hint-ofs; ofs=hint-t; \
+    } \
+    /* a[last] < key <= a[ofs]: binary search in between */ \
+    last++; \
+    while(last<ofs){ \
+        long m=last+(ofs-last)/2; \
+        if(LESS(a[m],key)) last=m+1; else ofs=m; \
+    } \
+    return ofs; \
+} \
+/* Rightmost k with a[k-1] <= key < a[k] */ \
+static long name##GallopRight(T key, const T a[], long n, long hint){ \
+    long last=0, ofs=1; \
+    if(LESS(key,a[hint])){ \
+        long maxOfs=hint+1; \
+        while(ofs<maxOfs && LESS(key,a[hint-ofs])){ last=ofs; ofs=2*ofs+1; } \
+        if(ofs>maxOfs) ofs=maxOfs; \
+        long t=last; last=hint-ofs; ofs=hint-t; \
+    } \
+    else{ \
+        long maxOfs=n-hint; \
+        while(ofs<maxOfs && !LESS(key,a[hint+ofs])){ last=ofs; ofs=2*ofs+1; } \
+        if(ofs>maxOfs) ofs=maxOfs; \
+        last+=hint; ofs+=hint; \
+    } \
+    last++; \
+    while(last<ofs){ \
+        long m=last+(ofs-last)/2; \
+        if(LESS(key,a[m])) ofs=m; else last=m+1; \
+    } \
+    return ofs; \
+} \
+/* Merges a[b1..b1+n1) with the adjacent a[b2..b2+n2), n1<=n2, front to back. \
+   Preconditions from mergeAt: a[b2] goes first and a[b1+n1-1] goes last. */ \
+static void name##MergeLo(struct name##State *s, long b1, long n1, long b2, long n2){ \
+    T *a=s->a, *tmp=s->tmp; \
+    memcpy(tmp,a+b1,(size_t)n1*sizeof(T)); \
+    long c1=0, c2=b2, d=b1, minGallop=s->minGallop; \
+    a[d++]=a[c2++]; \
+    if(--n2==0) goto done; \
+    if(n1==1) goto done; \
+    for(;;){ \
+        long w1=0, w2=0; /* wins in a row of each run */ \
+        do{ \
+            if(LESS(a[c2],tmp[c1])){ a[d++]=a[c2++]; w2++; w1=0; if(--n2==0) goto done; } \
+            else{ a[d++]=tmp[c1++]; w1++; w2=0; if(--n1==1) goto done; } \
+        }while((w1|w2)<minGallop); \
+        /* One run is winning consistently: gallop until neither wins TIM_MIN_GALLOP in a row */ \
+        do{ \
+            w1=name##GallopRight(a[c2],tmp+c1,n1,0); \
+            if(w1){ memcpy(a+d,tmp+c1,(size_t)w1*sizeof(T)); d+=w1; c1+=w1; n1-=w1; if(n1<=1) goto done; } \
+            a[d++]=a[c2++]; \
+            if(--n2==0) goto done; \
+            w2=name##GallopLeft(tmp[c1],a+c2,n2,0); \
+            if(w2){ memmove(a+d,a+c2,(size_t)w2*sizeof(T)); d+=w2; c2+=w2; n2-=w2; if(n2==0) goto done; } \
+            a[d++]=tmp[c1++]; \
+            if(--n1==1) goto done; \
+            minGallop--; \
+        }while(w1>=TIM_MIN_GALLOP || w2>=TIM_MIN_GALLOP); \
+        if(minGallop<0) minGallop=0; \
+        minGallop+=2; /* penalty for leaving gallop mode */ \
+    } \
+done: \
+    s->minGallop=minGallop<1 ? 1 : minGallop; \
+    if(n1==1){ memmove(a+d,a+c2,(size_t)n2*sizeof(T)); a[d+n2]=tmp[c1]; } /* last of run 1 goes last */ \
+    else if(n1>0) memcpy(a+d,tmp+c1,(size_t)n1*sizeof(T)); \
+} \
+/* Same, n1>n2, back to front with run 2 in the buffer */ \
+static void name##MergeHi(struct name##State *s, long b1, long n1, long b2, long n2){ \
+    T *a=s->a, *tmp=s->tmp; \
+    memcpy(tmp,a+b2,(size_t)n2*sizeof(T)); \
+    long c1=b1+n1-1, c2=n2-1, d=b2+n2-1, minGallop=s->minGallop; \
+    a[d--]=a[c1--]; \
+    if(--n1==0) goto done; \
+    if(n2==1) goto done; \
+    for(;;){ \
+        long w1=0, w2=0; \
+        do{ \
+            if(LESS(tmp[c2],a[c1])){ a[d--]=a[c1--]; w1++; w2=0; if(--n1==0) goto done; } \
+            else{ a[d--]=tmp[c2--]; w2++; w1=0; if(--n2==1) goto done; } \
+        }while((w1|w2)<minGallop); \
+        do{ \
+            w1=n1-name##GallopRight(tmp[c2],a+b1,n1,n1-1); \
+            if(w1){ d-=w1; c1-=w1; n1-=w1; memmove(a+d+1,a+c1+1,(size_t)w1*sizeof(T)); if(n1==0) goto done; } \
+            a[d--]=tmp[c2--]; \
+            if(--n2==1) goto done; \
+            w2=n2-name##GallopLeft(a[c1],tmp,n2,n2-1); \
+            if(w2){ d-=w2; c2-=w2; n2-=w2; memcpy(a+d+1,tmp+c2+1,(size_t)w2*sizeof(T)); if(n2<=1) goto done; } \
+            a[d--]=a[c1--]; \
+            if(--n1==0) goto done; \
+            minGallop--; \
+        }while(w1>=TIM_MIN_GALLOP || w2>=TIM_MIN_GALLOP); \
+        if(minGallop<0) minGallop=0; \
+        minGallop+=2; \
+    } \
+done: \
+    s->minGallop=minGallop<1 ? 1 : minGallop; \
+    if(n2==1){ d-=n1; c1-=n1; memmove(a+d+1,a+c1+1,(size_t)n1*sizeof(T)); a[d]=tmp[c2]; } /* first of run 2 goes first */ \
+    else if(n2>0) memcpy(a+d-(n2-1),tmp,(size_t)n2*sizeof(T)); \
+} \
+/* Merges stack runs i and i+1 (i is the second or third from the top) */ \
+static void name##MergeAt(struct name##State *s, int i){ \
+    T *a=s->a; \
+    long b1=(long)s->base[i], n1=(long)s->len[i], b2=(long)s->base[i+1], n2=(long)s->len[i+1]; \
+    s->len[i]=(size_t)(n1+n2); \
+    if(i==s->runs-3){ s->base[i+1]=s->base[i+2]; s->len[i+1]=s->len[i+2]; } \
+    s->runs--; \
+    /* Keys of run 1 below a[b2] and keys of run 2 above its last key are already in place */ \
+    long k=name##GallopRight(a[b2],a+b1,n1,0); \
+    b1+=k; n1-=k; \
+    if(n1==0) return; \
+    n2=name##GallopLeft(a[b1+n1-1],a+b2,n2,n2-1); \
+    if(n2==0) return; \
+    if(n1<=n2) name##MergeLo(s,b1,n1,b2,n2); \
+    else name##MergeHi(s,b1,n1,b2,n2); \
+} \
+/* Restores the stack invariants after a push */ \
+static void name##Collapse(struct name##State *s){ \
+    size_t *len=s->len; \
+    while(s->runs>1){ \
+        int i=s->runs-2; \
+        if((i>0 && len[i-1]<=len[i]+len[i+1]) || (i>1 && len[i-2]<=len[i-1]+len[i])){ \
+            if(len[i-1]<len[i+1]) i--; \
+        } \
+        else if(len[i]>len[i+1]) break; \
+        name##MergeAt(s,i); \
+    } \
+} \
+static void name##With(T a[], size_t n, T buf[]){ \
+    if(n<2) return; \
+    if(n<TIM_MIN_MERGE){ name##BinaryInsertion(a,n,name##CountRun(a,n)); return; } \
+    struct name##State s; \
+    s.a=a; s.tmp=buf; s.minGallop=TIM_MIN_GALLOP; s.runs=0; \
+    size_t minRun=name##MinRun(n), lo=0; \
+    while(lo<n){ \
+        size_t run=name##CountRun(a+lo,n-lo); \
+        if(run<minRun){ \
+            size_t force=n-lo<minRun ? n-lo : minRun; \
+            name##BinaryInsertion(a+lo,force,run); \
+            run=force; \
+        } \
+        s.base[s.runs]=lo; s.len[s.runs]=run; s.runs++; \
+        name##Collapse(&s); \
+        lo+=run; \
+    } \
+    /* Merge what is left, smaller neighbour first */ \
+    while(s.runs>1){ \
+        int i=s.runs-2; \
+        if(i>0 && s.len[i-1]<s.len[i+1]) i--; \
+        name##MergeAt(&s,i); \
+    } \
+} \
+static int name(T a[], size_t n){ \
+    if(n<2) return 0; \
+    T *buf=(T*)malloc((n/2+1)*sizeof(T)); /* a merge buffers its shorter run only */ \
+    if(buf==NULL) return -1; \
+    name##With(a,n,buf); \
+    free(buf); \
+    return 0; \
+}
+
+#define TIM_INT_LESS(x,y) ((x)<(y))
+DEFINE_TIM_SORT(timSortInt,int,TIM_INT_LESS)
+// Sorts a[0..n-1] stably; close to linear on input that is already mostly in order
+void timSort(int a[], int n){
+    if(n>1 && timSortInt(a,(size_t)n)) printf("Out of Memory!");
+}
+#endif
@@ -0,0 +1,224 @@
+#ifndef CONCURRENT_STACK_C
+#define CONCURRENT_STACK_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<sched.h>
+// Lock-free stack for sharing free lists and DFS work between threads (Treiber 1986).
+// - The top of the stack is a 64-bit word: the index of the top node in the low 32 bits and a tag
+//   in the high 32. Every successful CAS bumps the tag, so a pop that read top=A, next=B and was
+//   delayed while A was popped, reused and pushed back fails its CAS instead of installing a stale
+//   B (the ABA problem). A tag wraps after 2^32 changes, far longer than any thread stalls.
+// - Nodes are addressed by index and live in chunks that are only freed with the whole stack, so
+//   reading the next field of a node another thread just popped is always safe. Popped nodes go on
+//   a second tagged stack, the free list, and are reused by later pushes without calling malloc.
+// - Elimination backoff (Hendler, Shavit, Yerushalmi 2004): a push whose CAS fails offers its node
+//   in a random slot of a small array for a while, and a pop whose CAS fails looks for an offer
+//   there. A push and a pop that meet cancel out without touching the top word, so under heavy
+//   contention pairs of operations complete in parallel instead of queueing on one cache line.
+// - The batch calls move a whole chain of nodes with a single CAS on the top word, so a thread
+//   that buffers its pushes or pops locally pays for the shared cache line once per batch.
+// Uses GCC/Clang __atomic builtins, like Parallel/Work-Stealing Pool.h, so it compiles as C and C++.
+// DEFINE_TREIBER_STACK(type,name,T) defines struct type and
+//   struct type *new##type(void), void free##type(struct type *s)
+//   int name##Push(s,T v), int name##Pop(s,T *v)                  (0 when out of memory / empty)
+//   int name##PushElim(s,T v), int name##PopElim(s,T *v)          (the same, with elimination)
+//   size_t name##PushBatch(s,const T v[],size_t n), size_t name##PopBatch(s,T out[],size_t n)
+//   int name##IsEmpty(s)
+#define STACK_LINE 64
+#define STACK_CHUNK_BITS 12         // 4096 nodes per chunk
+#define STACK_MAX_CHUNKS 65536      // so at most 2^28 nodes
+#define STACK_ELIM_SLOTS 8          // elimination array
+#define STACK_ELIM_SPINS 128        // how long a push waits in a slot for a pop
+
+static inline void stackPause(void){
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+static __thread unsigned stackSeed=0;  // per-thread random slot choice
+static inline unsigned stackRand(void){
+    if(stackSeed==0) stackSeed=(unsigned)(size_t)&stackSeed|1;
+    stackSeed^=stackSeed<<13; stackSeed^=stackSeed>>17; stackSeed^=stackSeed<<5;
+    return stackSeed;
+}
+// A new top word: node index first (0 = empty), one more change than old
+static inline unsigned long long stackWord(unsigned long long old, unsigned first){
+    return ((old>>32)+1)<<32 | first;
+}
+
+#define DEFINE_TREIBER_STACK(type, name, T) \
+struct type##Node{T value; unsigned next;}; \
+struct type##Slot{unsigned long long word; char pad[STACK_LINE-sizeof(unsigned long long)];}; \
+struct type{ \
+    unsigned long long head;                        /* top node of the stack */ \
+    char pad0[STACK_LINE-sizeof(unsigned long long)]; \
+    unsigned long long freeHead;                    /* top node of the free list */ \
+    char pad1[STACK_LINE-sizeof(unsigned long long)]; \
+    /* 0 empty, 1 taken by a pop, 2*index a push's offer */ \
+    struct type##Slot elim[STACK_ELIM_SLOTS]; \
+    unsigned used;                                  /* nodes handed out of the chunks so far */ \
+    char pad2[STACK_LINE-sizeof(unsigned)]; \
+    struct type##Node **chunks; \
+}; \
+static struct type *new##type(void){ \
+    struct type *s; \
+    if(posix_memalign((void**)&s,STACK_LINE,sizeof(struct type))) return NULL; \
+    memset(s,0,sizeof(*s)); \
+    s->chunks=(struct type##Node**)calloc(STACK_MAX_CHUNKS,sizeof(struct type##Node*)); \
+    if(s->chunks==NULL){ free(s); return NULL; } \
+    return s; \
+} \
+static void free##type(struct type *s){ \
+    if(s==NULL) return; \
+    for(size_t c=0;c<STACK_MAX_CHUNKS;c++) if(s->chunks[c]!=NULL) free(s->chunks[c]); \
+    free(s->chunks); free(s); \
+} \
+/* Node with index i (1-based) */ \
+static inline struct type##Node *name##At(struct type *s, unsigned i){ \
+    struct type##Node *chunk=__atomic_load_n(&s->chunks[(i-1)>>STACK_CHUNK_BITS],__ATOMIC_ACQUIRE); \
+    return chunk+((i-1)&((1u<<STACK_CHUNK_BITS)-1)); \
+} \
+/* Links the private chain first..last on top of the stack at *head */ \
+static inline void name##PushChain(struct type *s, unsigned long long *head, unsigned first, unsigned last){ \
+    unsigned long long old=__atomic_load_n(head,__ATOMIC_RELAXED); \
+    do __atomic_store_n(&name##At(s,last)->next,(unsigned)old,__ATOMIC_RELAXED); \
+    while(!__atomic_compare_exchange_n(head,&old,stackWord(old,first),1,__ATOMIC_RELEASE,__ATOMIC_RELAXED)); \
+} \
+/* Unlinks up to max nodes from the top of *head with one CAS; returns how many, chained first..last */ \
+static inline size_t name##PopChain(struct type *s, unsigned long long *head, size_t max, unsigned *first, unsigned *last){ \
+    unsigned long long old=__atomic_load_n(head,__ATOMIC_ACQUIRE); \
+    for(;;){ \
+        unsigned f=(unsigned)old, l=f; size_t k=1; \
+        if(f==0) return 0; \
+        /* These reads may race with pops that reuse the nodes; the tag makes the CAS fail then */ \
+        unsigned next=__atomic_load_n(&name##At(s,f)->next,__ATOMIC_RELAXED); \
+        while(k<max && next!=0){ \
+            l=next; k++; \
+            next=__atomic_load_n(&name##At(s,l)->next,__ATOMIC_RELAXED); \
+        } \
+        if(__atomic_compare_exchange_n(head,&old,stackWord(old,next),1,__ATOMIC_ACQUIRE,__ATOMIC_ACQUIRE)){ \
+            *first=f; *last=l; \
+            return k; \
+        } \
+    } \
+} \
+/* A node never used before; chunks are allocated on demand by whichever thread needs them first */ \
+static unsigned name##FreshNode(struct type *s){ \
+    unsigned i=__atomic_fetch_add(&s->used,1,__ATOMIC_RELAXED); \
+    if(i>=(unsigned)STACK_MAX_CHUNKS<<STACK_CHUNK_BITS) return 0; \
+    struct type##Node **slot=&s->chunks[i>>STACK_CHUNK_BITS]; \
+    if(__atomic_load_n(slot,__ATOMIC_ACQUIRE)==NULL){ \
+        struct type##Node *chunk=(struct type##Node*)malloc(sizeof(struct type##Node)<<STACK_CHUNK_BITS), *expect=NULL; \
+        if(chunk==NULL) return 0; \
+        if(!__atomic_compare_exchange_n(slot,&expect,chunk,0,__ATOMIC_ACQ_REL,__ATOMIC_ACQUIRE)) free(chunk); \
+    } \
+    return i+1; \
+} \
+static inline unsigned name##NewNode(struct type *s){ \
+    unsigned first, last; \
+    if(name##PopChain(s,&s->freeHead,1,&first,&last)) return first; \
+    return name##FreshNode(s); \
+} \
+static inline int name##IsEmpty(struct type *s){ \
+    return (unsigned)__atomic_load_n(&s->head,__ATOMIC_ACQUIRE)==0; \
+} \
+static inline int name##Push(struct type *s, T v){ \
+    unsigned i=name##NewNode(s); \
+    if(i==0) return 0; \
+    name##At(s,i)->value=v; \
+    name##PushChain(s,&s->head,i,i); \
+    return 1; \
+} \
+static inline int name##Pop(struct type *s, T *v){ \
+    unsigned i, last; \
+    if(!name##PopChain(s,&s->head,1,&i,&last)) return 0; \
+    *v=name##At(s,i)->value; \
+    name##PushChain(s,&s->freeHead,i,i); \
+    return 1; \
+} \
+/* Offers node i in a random slot; 1 when a pop took it */ \
+static inline int name##ElimOffer(struct type *s, unsigned i){ \
+    unsigned long long *slot=&s->elim[stackRand()%STACK_ELIM_SLOTS].word, offer=2ull*i, empty=0; \
+    if(!__atomic_compare_exchange_n(slot,&empty,offer,0,__ATOMIC_RELEASE,__ATOMIC_RELAXED)) return 0; \
+    for(int spin=0;spin<STACK_ELIM_SPINS;spin++){ \
+        if(__atomic_load_n(slot,__ATOMIC_ACQUIRE)==1) break; \
+        stackPause(); \
+    } \
+    if(__atomic_compare_exchange_n(slot,&offer,0,0,__ATOMIC_RELAXED,__ATOMIC_RELAXED)) return 0; /* withdrawn */ \
+    __atomic_store_n(slot,0,__ATOMIC_RELEASE);      /* taken: free the slot for the next offer */ \
+    return 1; \
+} \
+/* Takes an offered node from the elimination array, or returns 0 */ \
+static inline unsigned name##ElimTake(struct type *s){ \
+    unsigned start=stackRand(); \
+    for(unsigned k=0;k<STACK_ELIM_SLOTS;k++){ \
+        unsigned long long *slot=&s->elim[(start+k)%STACK_ELIM_SLOTS].word; \
+        unsigned long long w=__atomic_load_n(slot,__ATOMIC_RELAXED); \
+        if(w>=2 && __atomic_compare_exchange_n(slot,&w,1,0,__ATOMIC_ACQUIRE,__ATOMIC_RELAXED)) return (unsigned)(w/2); \
+    } \
+    return 0; \
+} \
+static inline int name##PushElim(struct type *s, T v){ \
+    unsigned i=name##NewNode(s); \
+    if(i==0) return 0; \
+    name##At(s,i)->value=v; \
+    unsigned long long old=__atomic_load_n(&s->head,__ATOMIC_RELAXED); \
+    for(;;){ \
+        __atomic_store_n(&name##At(s,i)->next,(unsigned)old,__ATOMIC_RELAXED); \
+        if(__atomic_compare_exchange_n(&s->head,&old,stackWord(old,i),0,__ATOMIC_RELEASE,__ATOMIC_RELAXED)) return 1; \
+        if(name##ElimOffer(s,i)) return 1;          /* contended: try to meet a pop instead */ \
+        old=__atomic_load_n(&s->head,__ATOMIC_RELAXED); \
+    } \
+} \
+static inline int name##PopElim(struct type *s, T *v){ \
+    unsigned long long old=__atomic_load_n(&s->head,__ATOMIC_ACQUIRE); \
+    unsigned i; \
+    for(;;){ \
+        i=(unsigned)old; \
+        if(i==0) return 0; \
+        unsigned next=__atomic_load_n(&name##At(s,i)->next,__ATOMIC_RELAXED); \
+        if(__atomic_compare_exchange_n(&s->head,&old,stackWord(old,next),0,__ATOMIC_ACQUIRE,__ATOMIC_ACQUIRE)) break; \
+        if((i=name##ElimTake(s))!=0) break;         /* contended: take a waiting push's node */ \
+        old=__atomic_load_n(&s->head,__ATOMIC_ACQUIRE); \
+    } \
+    *v=name##At(s,i)->value; \
+    name##PushChain(s,&s->freeHead,i,i); \
+    return 1; \
+} \
+static size_t name##PushBatch(struct type *s, const T v[], size_t n){ \
+    unsigned first=0, last=0; \
+    if(n==0) return 0; \
+    size_t k=name##PopChain(s,&s->freeHead,n,&first,&last);   /* recycled nodes, one CAS */ \
+    for(;k<n;k++){                                  /* fresh nodes for the rest */ \
+        unsigned i=name##FreshNode(s); \
+        if(i==0) break; \
+        if(k==0) first=i; \
+        else __atomic_store_n(&name##At(s,last)->next,i,__ATOMIC_RELAXED); \
+        last=i; \
+    } \
+    if(k==0) return 0; \
+    /* Fill the chain so that v[n-1] ends on top, as n single pushes would leave it */ \
+    unsigned i=first; \
+    for(size_t j=k;j-->0;){ \
+        name##At(s,i)->value=v[j]; \
+        i=__atomic_load_n(&name##At(s,i)->next,__ATOMIC_RELAXED); \
+    } \
+    name##PushChain(s,&s->head,first,last); \
+    return k; \
+} \
+static size_t name##PopBatch(struct type *s, T out[], size_t n){ \
+    unsigned first, last; \
+    size_t k=name##PopChain(s,&s->head,n,&first,&last); \
+    if(k==0) return 0; \
+    unsigned i=first; \
+    for(size_t j=0;j<k;j++){ \
+        out[j]=name##At(s,i)->value; \
+        i=__atomic_load_n(&name##At(s,i)->next,__ATOMIC_RELAXED); \
+    } \
+    name##PushChain(s,&s->freeHead,first,last); \
+    return k; \
+}
+
+DEFINE_TREIBER_STACK(TreiberStackInt,treiberStackInt,int)
+#endif
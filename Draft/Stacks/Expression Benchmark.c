@@ -0,0 +1,198 @@
+// Benchmark for the compiled expressions of Infix to PostFix.c against parsing the text again for
+// every evaluation.
+// Build: gcc -O2 -o expr_bench "Expression Benchmark.c" -lm
+// Run:   ./expr_bench --min 1024 --max 1048576 --json expr.json
+// Every routine evaluates each of the rule expressions below on n rows of random variables
+// a..e (one operation = all of them on all rows, ns/item = per evaluation; 1e9/ns is
+// evaluations/sec):
+//   reparse   a recursive descent evaluator that reads the text on every evaluation
+//   compiled  exprEval() of an expression compiled once, one row at a time
+//   batch     exprEvalBatch() of an expression compiled once, over the columns
+// The three must produce the same checksum. Before timing, each malformed expression of
+// badRules must fail to compile with its error at the expected offset.
+#include"Infix to PostFix.c"
+#include"../Benchmark/Benchmark.h"
+
+#define EXPR_COLUMNS 5  // variables a..e
+static const char *rules[]={
+    "a+b",
+    "a*b-c/d",
+    "(a+b)*(c-d)+e*2.5",
+    "-a*b+c*c-4*a*e",
+    "(a*0.3+b*0.7)/(c+1)-d%1.5",
+    "a^2+b^2-2*a*b*e",
+    "((a-b)*(a-b)+(c-d)*(c-d))/(e+0.5)",
+    "a*(b+c*(d+e*(a+b*(c+d))))",
+};
+#define EXPR_RULES (sizeof(rules)/sizeof(rules[0]))
+// Syntax errors and the offset exprCompile() must report for each
+static const struct{const char *text; int error;} badRules[]={
+    {"(a+b",4},         // unmatched '(' is found at the end
+    {"a+b)*c",3},       // unmatched ')'
+    {"()",1},           // empty parentheses
+    {"a*",2},           // operator missing its right operand
+    {"a+*b",2},         // operator missing its left operand
+    {"*a",0},
+    {"a b",2},          // two operands in a row
+    {"",0},             // no expression at all
+    {"a+B",2},          // unknown tokens
+    {"a#b",1},
+    {"2$",1},
+};
+
+// The baseline: evaluates the text directly, the way a rule engine without a compile step would
+struct Parser{const char *p; const double *vars;};
+static double parseSum(struct Parser *ps);
+static void parseSpace(struct Parser *ps){
+    while(*ps->p==' ') ps->p++;
+}
+static double parseAtom(struct Parser *ps){
+    parseSpace(ps);
+    char c=*ps->p;
+    if(c=='('){
+        ps->p++;
+        double v=parseSum(ps);
+        parseSpace(ps); ps->p++;    // ')'
+        return v;
+    }
+    if(c>='a' && c<='z'){ ps->p++; return ps->vars[c-'a']; }
+    char *end; double v=strtod(ps->p,&end);
+    ps->p=end;
+    return v;
+}
+// '^' binds tighter than unary minus and is right associative, as in exprCompile()
+static double parsePower(struct Parser *ps){
+    double v=parseAtom(ps);
+    parseSpace(ps);
+    if(*ps->p=='^'){ ps->p++; parseSpace(ps); return pow(v,*ps->p=='-' ? (ps->p++,-parsePower(ps)) : parsePower(ps)); }
+    return v;
+}
+static double parseUnary(struct Parser *ps){
+    parseSpace(ps);
+    if(*ps->p=='-'){ ps->p++; return -parseUnary(ps); }
+    return parsePower(ps);
+}
+static double parseProduct(struct Parser *ps){
+    double v=parseUnary(ps);
+    for(;;){
+        parseSpace(ps);
+        char c=*ps->p;
+        if(c!='*' && c!='/' && c!='%') return v;
+        ps->p++;
+        double w=parseUnary(ps);
+        v=c=='*' ? v*w : c=='/' ? v/w : fmod(v,w);
+    }
+}
+static double parseSum(struct Parser *ps){
+    double v=parseProduct(ps);
+    for(;;){
+        parseSpace(ps);
+        char c=*ps->p;
+        if(c!='+' && c!='-') return v;
+        ps->p++;
+        double w=parseProduct(ps);
+        v=c=='+' ? v+w : v-w;
+    }
+}
+
+struct ExprCtx{
+    size_t n;
+    double *cols[EXPR_COLUMNS];     // column v holds variable 'a'+v
+    double *rows;                   // the same values row by row, for the one-row routines
+    double *out;
+    struct Expr compiled[EXPR_RULES];
+};
+// Results are rounded so the checksum survives the conversion to an integer
+static long long exprChecksum(double v){
+    return (long long)llround(v*1e6);
+}
+static long long runReparse(void *vctx, size_t begin, size_t end){
+    struct ExprCtx *c=(struct ExprCtx*)vctx; long long sum=0;
+    for(size_t op=begin;op<end;op++)
+        for(size_t k=0;k<EXPR_RULES;k++)
+            for(size_t r=0;r<c->n;r++){
+                struct Parser ps={rules[k],c->rows+r*EXPR_COLUMNS};
+                sum+=exprChecksum(parseSum(&ps));
+            }
+    return sum;
+}
+static long long runCompiled(void *vctx, size_t begin, size_t end){
+    struct ExprCtx *c=(struct ExprCtx*)vctx; long long sum=0;
+    for(size_t op=begin;op<end;op++)
+        for(size_t k=0;k<EXPR_RULES;k++)
+            for(size_t r=0;r<c->n;r++) sum+=exprChecksum(exprEval(&c->compiled[k],c->rows+r*EXPR_COLUMNS));
+    return sum;
+}
+static long long runBatch(void *vctx, size_t begin, size_t end){
+    struct ExprCtx *c=(struct ExprCtx*)vctx; long long sum=0;
+    for(size_t op=begin;op<end;op++)
+        for(size_t k=0;k<EXPR_RULES;k++){
+            exprEvalBatch(&c->compiled[k],(const double *const *)c->cols,c->n,c->out);
+            for(size_t r=0;r<c->n;r++) sum+=exprChecksum(c->out[r]);
+        }
+    return sum;
+}
+struct ExprRoutine{const char *name; long long (*run)(void *ctx, size_t begin, size_t end);};
+// The first routine's checksum is the reference for the others
+static const struct ExprRoutine routines[]={
+    {"reparse",runReparse},{"compiled",runCompiled},{"batch",runBatch},
+};
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    cfg.maxN=1<<20;
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"expression");
+    struct ExprCtx ctx;
+    for(size_t k=0;k<EXPR_RULES;k++)
+        if(!exprCompile(&ctx.compiled[k],rules[k])){
+            fprintf(stderr,"%s: syntax error at %d\n",rules[k],ctx.compiled[k].error); return 1;
+        }
+    int failed=0;
+    for(size_t k=0;k<sizeof(badRules)/sizeof(badRules[0]);k++){
+        struct Expr bad;
+        if(exprCompile(&bad,badRules[k].text) || bad.error!=badRules[k].error){
+            fprintf(stderr,"\"%s\": expected a syntax error at %d, got %d\n",badRules[k].text,badRules[k].error,bad.error);
+            failed=1;
+        }
+    }
+    unsigned long long s=benchSeed(cfg.seed);
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        ctx.n=n;
+        ctx.rows=(double*)malloc(n*EXPR_COLUMNS*sizeof(double));
+        ctx.out=(double*)malloc(n*sizeof(double));
+        int missing=ctx.rows==NULL || ctx.out==NULL;
+        for(int v=0;v<EXPR_COLUMNS;v++){
+            ctx.cols[v]=(double*)malloc(n*sizeof(double));
+            if(ctx.cols[v]==NULL) missing=1;
+        }
+        if(missing){
+            printf("Out of Memory!"); return 1;
+        }
+        for(size_t r=0;r<n;r++)
+            for(int v=0;v<EXPR_COLUMNS;v++)
+                ctx.cols[v][r]=ctx.rows[r*EXPR_COLUMNS+v]=1+(double)(benchRand(&s)>>11)/9007199254740992.0;
+        size_t reps=cfg.ops*4/(n*EXPR_RULES);
+        if(reps<3) reps=3;
+        if(reps>200) reps=200;
+        long long ref=0;
+        for(size_t r=0;r<sizeof(routines)/sizeof(routines[0]);r++){
+            // the reference always runs
+            if(!benchSelected(&cfg,routines[r].name) && r>0) continue;
+            struct BenchCase bc={routines[r].name,n,reps,1,routines[r].run,NULL,&ctx,n*EXPR_RULES};
+            struct BenchResult res=benchMeasure(&cfg,&bc);
+            if(benchSelected(&cfg,routines[r].name)) benchReportResult(&rep,&res);
+            long long one=res.checksum/(long long)res.ops;
+            if(r==0) ref=one;
+            else if(one!=ref){
+                fprintf(stderr,"%s: wrong result for n=%zu\n",routines[r].name,n); failed=1;
+            }
+        }
+        free(ctx.rows); free(ctx.out);
+        for(int v=0;v<EXPR_COLUMNS;v++) free(ctx.cols[v]);
+    }
+    benchReportEnd(&rep);
+    return failed;
+}
@@ -0,0 +1,184 @@
+#ifndef INFIX_TO_POSTFIX_C
+#define INFIX_TO_POSTFIX_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<math.h>
+// Infix to postfix with the shunting-yard algorithm, compiled once to a compact bytecode that a
+// stack machine evaluates many times.
+// - Expressions use numbers, the variables a..z, + - * / % ^ (right associative), unary minus
+//   and parentheses, e.g. "-(a+2.5)*b^2".
+// - exprCompile() turns the infix text into postfix instructions, one byte of opcode and one
+//   byte of operand each, with the constants in a side table. It uses only the struct Expr it is
+//   given and records the deepest the value stack can get, so evaluation can never overflow it.
+// - exprEval() runs the bytecode over a fixed-size value stack in local storage: no heap
+//   allocation per evaluation.
+// - exprEvalBatch() runs one expression over columns of inputs (column v holds variable 'a'+v).
+//   Each instruction is applied to EXPR_TILE rows at a time, so dispatch is paid once per tile
+//   and the inner loops over rows vectorize.
+#define EXPR_MAX_CODE 256   // instructions per expression
+#define EXPR_MAX_CONST 255  // constants per expression
+#define EXPR_STACK 32       // value stack depth, and operator stack depth while compiling
+#define EXPR_VARS 26        // variables a..z
+#define EXPR_TILE 64        // rows per instruction in batch mode
+
+enum ExprOp{EXPR_CONST,EXPR_VAR,EXPR_ADD,EXPR_SUB,EXPR_MUL,EXPR_DIV,EXPR_MOD,EXPR_POW,EXPR_NEG};
+struct Expr{
+    unsigned char op[EXPR_MAX_CODE], arg[EXPR_MAX_CODE];
+    double consts[EXPR_MAX_CONST];
+    int len, nconst;
+    int depth;              // deepest the value stack gets
+    int error;              // offset in the text of the first syntax error, -1 when none
+};
+
+static int exprPrecedence(char c){
+    switch(c){
+        case '+': case '-': return 1;
+        case '*': case '/': case '%': return 2;
+        case '~': return 3;     // unary minus
+        case '^': return 4;
+    }
+    return 0;
+}
+// Appends one instruction and tracks the stack depth; 0 when the expression is too long
+static int exprEmit(struct Expr *e, int op, int arg, int *depth){
+    if(e->len==EXPR_MAX_CODE) return 0;
+    e->op[e->len]=(unsigned char)op; e->arg[e->len]=(unsigned char)arg; e->len++;
+    if(op==EXPR_CONST || op==EXPR_VAR) ++*depth;
+    else if(op!=EXPR_NEG) --*depth;
+    if(*depth>e->depth) e->depth=*depth;
+    return *depth<=EXPR_STACK;
+}
+static int exprEmitOperator(struct Expr *e, char c, int *depth){
+    switch(c){
+        case '+': return exprEmit(e,EXPR_ADD,0,depth);
+        case '-': return exprEmit(e,EXPR_SUB,0,depth);
+        case '*': return exprEmit(e,EXPR_MUL,0,depth);
+        case '/': return exprEmit(e,EXPR_DIV,0,depth);
+        case '%': return exprEmit(e,EXPR_MOD,0,depth);
+        case '^': return exprEmit(e,EXPR_POW,0,depth);
+        default:  return exprEmit(e,EXPR_NEG,0,depth);
+    }
+}
+// Compiles infix text into e; returns 1, or 0 with e->error set to where it went wrong
+int exprCompile(struct Expr *e, const char *s){
+    char ops[EXPR_STACK];   // operator stack: operators and '('
+    int top=-1, depth=0, operand=0;  // operand: the last token was a value or ')'
+    const char *p=s;
+    e->len=e->nconst=e->depth=0; e->error=-1;
+    while(*p){
+        char c=*p;
+        if(c==' ' || c=='\t'){ p++; continue; }
+        if(!operand && ((c>='0' && c<='9') || c=='.')){
+            char *end; double v=strtod(p,&end);
+            if(end==p || e->nconst==EXPR_MAX_CONST) break;
+            e->consts[e->nconst]=v;
+            if(!exprEmit(e,EXPR_CONST,e->nconst++,&depth)) break;
+            p=end; operand=1; continue;
+        }
+        if(!operand && c>='a' && c<='z'){
+            if(!exprEmit(e,EXPR_VAR,c-'a',&depth)) break;
+            p++; operand=1; continue;
+        }
+        if(!operand && (c=='(' || c=='-')){
+            // '(' or a unary minus; both wait on the stack for their operand
+            if(top==EXPR_STACK-1) break;
+            ops[++top]=c=='(' ? '(' : '~';
+            p++; continue;
+        }
+        if(operand && c==')'){
+            int ok=1;
+            while(ok && top>=0 && ops[top]!='(') ok=exprEmitOperator(e,ops[top--],&depth);
+            if(!ok || top<0) break;  // too long, or an unmatched ')'
+            top--; p++; continue;
+        }
+        if(operand && exprPrecedence(c)){
+            // Pop operators that bind at least as tightly; '^' is right associative
+            int prec=exprPrecedence(c), ok=1;
+            while(ok && top>=0 && ops[top]!='(' && (exprPrecedence(ops[top])>prec ||
+                    (exprPrecedence(ops[top])==prec && c!='^')))
+                ok=exprEmitOperator(e,ops[top--],&depth);
+            if(!ok || top==EXPR_STACK-1) break;
+            ops[++top]=c;
+            p++; operand=0; continue;
+        }
+        break;
+    }
+    if(*p==0 && operand){
+        int ok=1;
+        while(ok && top>=0 && ops[top]!='(') ok=exprEmitOperator(e,ops[top--],&depth);
+        if(ok && top<0) return 1;   // otherwise too long, or an unmatched '('
+    }
+    e->error=(int)(p-s);
+    return 0;
+}
+// Evaluates e with vars[v] as the value of variable 'a'+v
+double exprEval(const struct Expr *e, const double *vars){
+    double st[EXPR_STACK];
+    int top=-1;
+    for(int i=0;i<e->len;i++){
+        switch(e->op[i]){
+            case EXPR_CONST: st[++top]=e->consts[e->arg[i]]; break;
+            case EXPR_VAR: st[++top]=vars[e->arg[i]]; break;
+            case EXPR_ADD: top--; st[top]+=st[top+1]; break;
+            case EXPR_SUB: top--; st[top]-=st[top+1]; break;
+            case EXPR_MUL: top--; st[top]*=st[top+1]; break;
+            case EXPR_DIV: top--; st[top]/=st[top+1]; break;
+            case EXPR_MOD: top--; st[top]=fmod(st[top],st[top+1]); break;
+            case EXPR_POW: top--; st[top]=pow(st[top],st[top+1]); break;
+            case EXPR_NEG: st[top]=-st[top]; break;
+        }
+    }
+    return st[0];
+}
+// out[r] = e evaluated on row r, where cols[v][r] is variable 'a'+v; only the columns of the
+// variables e uses are read
+void exprEvalBatch(const struct Expr *e, const double *const cols[], size_t n, double out[]){
+    double st[EXPR_STACK][EXPR_TILE];
+    for(size_t r0=0;r0<n;r0+=EXPR_TILE){
+        size_t m=n-r0<EXPR_TILE ? n-r0 : EXPR_TILE;
+        int top=-1;
+        for(int i=0;i<e->len;i++){
+            int op=e->op[i];
+            if(op==EXPR_CONST){
+                double v=e->consts[e->arg[i]], *x=st[++top];
+                for(size_t r=0;r<m;r++) x[r]=v;
+                continue;
+            }
+            if(op==EXPR_VAR){
+                const double *c=cols[e->arg[i]]+r0; double *x=st[++top];
+                for(size_t r=0;r<m;r++) x[r]=c[r];
+                continue;
+            }
+            double *x=st[top];
+            if(op==EXPR_NEG){
+                for(size_t r=0;r<m;r++) x[r]=-x[r];
+                continue;
+            }
+            double *y=st[--top];
+            switch(op){
+                case EXPR_ADD: for(size_t r=0;r<m;r++) y[r]+=x[r]; break;
+                case EXPR_SUB: for(size_t r=0;r<m;r++) y[r]-=x[r]; break;
+                case EXPR_MUL: for(size_t r=0;r<m;r++) y[r]*=x[r]; break;
+                case EXPR_DIV: for(size_t r=0;r<m;r++) y[r]/=x[r]; break;
+                case EXPR_MOD: for(size_t r=0;r<m;r++) y[r]=fmod(y[r],x[r]); break;
+                case EXPR_POW: for(size_t r=0;r<m;r++) y[r]=pow(y[r],x[r]); break;
+            }
+        }
+        for(size_t r=0;r<m;r++) out[r0+r]=st[0][r];
+    }
+}
+// Writes the postfix form of e into out (at most size bytes), e.g. "a 2.5 + ~ b 2 ^ *"
+void exprPostfix(const struct Expr *e, char *out, size_t size){
+    static const char sym[]="  +-*/%^~";
+    size_t k=0;
+    if(size==0) return;
+    out[0]=0;
+    for(int i=0;i<e->len && k<size;i++){
+        int w;
+        if(e->op[i]==EXPR_CONST) w=snprintf(out+k,size-k,"%s%g",i ? " " : "",e->consts[e->arg[i]]);
+        else if(e->op[i]==EXPR_VAR) w=snprintf(out+k,size-k,"%s%c",i ? " " : "",'a'+e->arg[i]);
+        else w=snprintf(out+k,size-k,"%s%c",i ? " " : "",sym[e->op[i]]);
+        k+=(size_t)w;
+    }
+}
+#endif
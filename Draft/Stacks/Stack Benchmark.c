@@ -0,0 +1,155 @@
+// Throughput benchmark for the stacks in Draft/Stacks shared between threads.
+// Build: gcc -O2 -pthread -o stack_bench "Stack Benchmark.c"
+// Run:   ./stack_bench --threads 8 --ops 4194304 --json stack.json
+// Every operation runs T threads (1,2,4,... up to --threads) over one shared stack. Each thread
+// repeatedly pushes STACK_BURST integers and then pops STACK_BURST, the pattern of a shared free
+// list or a DFS work pool, until --ops integers have been pushed in all. ns/item is the wall time
+// per integer pushed and popped. Every run checks that each integer was popped exactly once.
+// (--min/--max are not used: the stack size is set by the burst and the thread count.)
+#include<pthread.h>
+#include<unistd.h>
+#include"Stack.c"
+#include"Concurrent Stack.c"
+#include"../Benchmark/Benchmark.h"
+
+#define STACK_BURST 32  // pushes, then pops, per round; also the size of a batch
+
+// The growable array stack of Stack.c behind a mutex, as the baseline
+struct LockedStack{pthread_mutex_t lock; struct Stack *s;};
+static void *newLocked(void){
+    struct LockedStack *l=(struct LockedStack*)malloc(sizeof(struct LockedStack));
+    pthread_mutex_init(&l->lock,NULL);
+    l->s=newStack(1024);
+    return l;
+}
+static void freeLocked(void *s){
+    struct LockedStack *l=(struct LockedStack*)s;
+    pthread_mutex_destroy(&l->lock); freeStack(l->s); free(l);
+}
+static size_t lockedPush(void *s, const int v[], size_t n){
+    struct LockedStack *l=(struct LockedStack*)s;
+    pthread_mutex_lock(&l->lock);
+    for(size_t i=0;i<n;i++) push(l->s,v[i]);
+    pthread_mutex_unlock(&l->lock);
+    return n;
+}
+static size_t lockedPop(void *s, int out[], size_t n){
+    struct LockedStack *l=(struct LockedStack*)s; size_t k=0;
+    pthread_mutex_lock(&l->lock);
+    while(k<n && !isEmpty(l->s)) out[k++]=pop(l->s);
+    pthread_mutex_unlock(&l->lock);
+    return k;
+}
+// Uniform entry points: move up to n elements, return how many moved
+static void *newTreiber(void){ return newTreiberStackInt(); }
+static void freeTreiber(void *s){ freeTreiberStackInt((struct TreiberStackInt*)s); }
+static size_t treiberPush(void *s, const int v[], size_t n){ (void)n; return (size_t)treiberStackIntPush((struct TreiberStackInt*)s,v[0]); }
+static size_t treiberPop(void *s, int out[], size_t n){ (void)n; return (size_t)treiberStackIntPop((struct TreiberStackInt*)s,out); }
+static size_t elimPush(void *s, const int v[], size_t n){ (void)n; return (size_t)treiberStackIntPushElim((struct TreiberStackInt*)s,v[0]); }
+static size_t elimPop(void *s, int out[], size_t n){ (void)n; return (size_t)treiberStackIntPopElim((struct TreiberStackInt*)s,out); }
+static size_t batchPush(void *s, const int v[], size_t n){ return treiberStackIntPushBatch((struct TreiberStackInt*)s,v,n); }
+static size_t batchPop(void *s, int out[], size_t n){ return treiberStackIntPopBatch((struct TreiberStackInt*)s,out,n); }
+
+struct StackKind{
+    const char *name;
+    void *(*make)(void); void (*destroy)(void *s);
+    size_t (*push)(void *s, const int v[], size_t n);
+    size_t (*pop)(void *s, int out[], size_t n);
+    size_t batch;           // elements offered per call
+};
+// Register new stacks here
+static const struct StackKind kinds[]={
+    {"mutex",newLocked,freeLocked,lockedPush,lockedPop,1},
+    {"mutexBatch",newLocked,freeLocked,lockedPush,lockedPop,STACK_BURST},
+    {"treiber",newTreiber,freeTreiber,treiberPush,treiberPop,1},
+    {"elimination",newTreiber,freeTreiber,elimPush,elimPop,1},
+    {"treiberBatch",newTreiber,freeTreiber,batchPush,batchPop,STACK_BURST},
+};
+
+struct StackCtx{
+    const struct StackKind *kind; void *s;
+    int threads;
+    size_t items;               // integers pushed per operation
+    long long sum;              // of everything popped, for the exactly-once check
+};
+struct StackWorker{struct StackCtx *c; int id;};
+static void *worker(void *varg){
+    struct StackWorker *w=(struct StackWorker*)varg; struct StackCtx *c=w->c;
+    size_t b=c->items*(size_t)w->id/(size_t)c->threads, e=c->items*(size_t)(w->id+1)/(size_t)c->threads;
+    size_t batch=c->kind->batch;
+    int v[STACK_BURST]; long long sum=0;
+    while(b<e){
+        size_t n=e-b<STACK_BURST ? e-b : STACK_BURST;
+        for(size_t i=0;i<n;i++) v[i]=(int)(b+i+1);
+        for(size_t k=0;k<n;){
+            size_t m=c->kind->push(c->s,v+k,n-k<batch ? n-k : batch);
+            if(m==0){
+                printf("Out of Memory!"); exit(1);
+            }
+            k+=m;
+        }
+        // Pop as many as were pushed; other threads may have taken ours, then we take theirs
+        for(size_t k=0;k<n;){
+            size_t m=c->kind->pop(c->s,v,n-k<batch ? n-k : batch);
+            if(m==0) break;     // empty: the rest are left for the final drain
+            for(size_t i=0;i<m;i++) sum+=v[i];
+            k+=m;
+        }
+        b+=n;
+    }
+    __atomic_add_fetch(&c->sum,sum,__ATOMIC_RELAXED);
+    return NULL;
+}
+// One operation: start every thread, push and pop c->items integers, join, drain what is left
+static long long runStack(void *ctx, size_t begin, size_t end){
+    struct StackCtx *c=(struct StackCtx*)ctx;
+    long long total=0;
+    for(size_t op=begin;op<end;op++){
+        pthread_t *tid=(pthread_t*)malloc((size_t)c->threads*sizeof(pthread_t));
+        struct StackWorker *w=(struct StackWorker*)malloc((size_t)c->threads*sizeof(struct StackWorker));
+        c->sum=0;
+        for(int i=0;i<c->threads;i++){
+            w[i].c=c; w[i].id=i;
+            pthread_create(&tid[i],NULL,worker,&w[i]);
+        }
+        for(int i=0;i<c->threads;i++) pthread_join(tid[i],NULL);
+        free(tid); free(w);
+        int v[STACK_BURST]; size_t m;
+        while((m=c->kind->pop(c->s,v,c->kind->batch))>0)
+            for(size_t i=0;i<m;i++) c->sum+=v[i];
+        total+=c->sum;
+    }
+    return total;
+}
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    cfg.ops=1<<22;
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    int maxThreads=cfg.threads>0 ? cfg.threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if(maxThreads<1) maxThreads=1;
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"stack");
+    long long expect=(long long)cfg.ops*((long long)cfg.ops+1)/2;
+    int failed=0;
+    for(size_t k=0;k<sizeof(kinds)/sizeof(kinds[0]);k++)
+        for(int t=1;t<=maxThreads;t*=2){
+            char name[64];
+            snprintf(name,sizeof(name),"%s/%dt",kinds[k].name,t);
+            if(!benchSelected(&cfg,name)) continue;
+            struct StackCtx ctx={&kinds[k],kinds[k].make(),t,cfg.ops,0};
+            if(ctx.s==NULL){
+                printf("Out of Memory!"); return 1;
+            }
+            struct BenchCase bc={name,(size_t)t,3,1,runStack,NULL,&ctx,cfg.ops};
+            struct BenchResult res=benchMeasure(&cfg,&bc);
+            benchReportResult(&rep,&res);
+            if(res.checksum!=3*expect){
+                fprintf(stderr,"%s: lost or duplicated items\n",name); failed=1;
+            }
+            kinds[k].destroy(ctx.s);
+        }
+    benchReportEnd(&rep);
+    return failed;
+}
@@ -1,30 +1,47 @@
+#ifndef STACK_C
+#define STACK_C
 #include<stdio.h>
+#include<stdlib.h>
+// Array stack that grows: a push onto a full stack doubles the array, so n pushes cost O(n) in all
 struct Stack{int top;unsigned size;int *a;};
-// Creating new stack with size
+// Creating new stack with room for size elements to start with
 struct Stack *newStack(unsigned size){
     // Allocating memory for stack structure
     struct Stack *stack=(struct Stack*)malloc(sizeof(struct Stack));
+    if(stack==NULL){
+        printf("Out of Memory!"); return NULL;
+    }
     // Setting stack size and initializing top index
-    stack->size=size; stack->top=-1;
+    stack->size=size ? size : 1; stack->top=-1;
     // Allocating memory for stack elements array
     stack->a=(int *)malloc(stack->size*sizeof(int));
+    if(stack->a==NULL){
+        printf("Out of Memory!"); free(stack); return NULL;
+    }
     // Returning created stack
     return stack;
 }
 // Function to check if stack is full
 int isFull(struct Stack *stack){
     // If top index is at the last position of stack
-    // then it indicates stack is full
-    return stack->top==stack->size-1; 
+    // then the next push has to grow it
+    return stack->top==(int)stack->size-1;
 }
 // check if stack is empty
 int isEmpty(struct Stack *stack){
     // return 1 if top index is -1 (empty stack)
     return stack->top==-1;
 }
+// Doubles the capacity, keeping the elements
+static int growStack(struct Stack *stack){
+    int *a=(int*)realloc(stack->a,2*(size_t)stack->size*sizeof(int));
+    if(a==NULL) return 0;
+    stack->a=a; stack->size*=2;
+    return 1;
+}
 void push(struct Stack *stack, int data) {
-    if (isFull(stack)) {
-        printf("Overflow!"); return; // Check if stack is full before pushing
+    if (isFull(stack) && !growStack(stack)) {
+        printf("Overflow!"); return; // Only when the array cannot grow any more
     }
     stack->a[++(stack->top)] = data; // Increment top and assign data to new top element
 }
@@ -40,9 +57,14 @@ int pop(struct Stack *stack){
 int peek(struct Stack *stack){
     // Check if stack is empty
     if(isEmpty(stack)) {
-        printf("Underflow!"); 
+        printf("Underflow!");
         return -1; // Return -1 if underflow occurs
     }
     // Return top element without removing it
     return stack->a[stack->top];
 }
+void freeStack(struct Stack *stack){
+    if(stack==NULL) return;
+    free(stack->a); free(stack);
+}
+#endif
@@ -1,6 +1,6 @@
 #include<stdio.h>
 #include<stdlib.h>
-struct Node{int key,height; struct Node *left,*right}
+struct Node{int key,height; struct Node *left,*right;};
 // Function to create a new node with given data
 struct Node *newNode(int data) {
     // Allocate memory for new node
@@ -35,16 +35,16 @@ int bal(struct Node *root) {
    return height(root->left) - height(root->right); // Subtract right subtree height from left subtree height
 }
 // Function to perform right rotation of the tree
-struct Node *RRot(struct Node **root) {
+struct Node *RRot(struct Node *root) {
     // Save the right child of the left child of root
-    struct Node *x = (*root)->left, *T = (*root)->left->right;
+    struct Node *x = root->left, *T = root->left->right;
     
     // Perform rotation
-    x->right = *root;    // Make x the new root
-    (*root)->left = T;     // Make T the left child of root
+    x->right = root;    // Make x the new root
+    root->left = T;     // Make T the left child of root
     
     // Update heights
-    (*root)->height = max(height((*root)->left), height((*root)->right)) + 1;
+    root->height = max(height(root->left), height(root->right)) + 1;
     x->height = max(height(x->left), height(x->right)) + 1;
     
     // Return the new root
@@ -84,6 +84,9 @@ struct Node *insert(struct Node *root, int data) {
     else if(data>root->key) root->right=insert(root->right,data);
     else return root;
 
+    // update the height of the root after the insertion below it
+    root->height=max(height(root->left),height(root->right))+1;
+
     // get balance factor of the tree
     int b=bal(root);
 
@@ -105,4 +108,4 @@ struct Node *insert(struct Node *root, int data) {
 
     // return the unchanged root if tree is balanced
     return root;
-}
\ No newline at end of file
+}
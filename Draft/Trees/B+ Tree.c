@@ -0,0 +1,283 @@
+#ifndef BPLUS_TREE_C
+#define BPLUS_TREE_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<limits.h>
+#include"../Linked Lists/Node Pool.h"
+#include"../Searching/Linear Search.c"
+// In-memory B+ tree mapping int keys to int values, laid out for the cache.
+// - Every node is BPTREE_NODE_BYTES (four cache lines) and starts on a line boundary. A leaf holds
+//   BP_LEAF_KEYS=30 keys and their values, an inner node BP_INNER_KEYS=20 separators and 21
+//   children, so 16M keys sit under five levels and a lookup touches five nodes.
+// - Inside a node the keys are contiguous, and the slot is found by counting the keys smaller than
+//   the target with the SIMD kernels of Linear Search.c (AVX2/SSE4.2, picked at runtime): no
+//   branches on the key comparisons.
+// - Leaves are linked left to right, so a range scan seeks once and then walks the leaves.
+// - bpBulkLoad() builds the tree bottom-up from sorted keys with packed nodes, in O(n).
+// - bpFindBatch() descends for BPTREE_BATCH keys in lockstep and prefetches every next node, so
+//   the cache misses of the batch overlap. bpInsertBatch() skips the descent while consecutive
+//   keys land in the same leaf.
+// Nodes come from a NodePool owned by the tree; there is no delete.
+#define BPTREE_NODE_BYTES 256
+#define BPTREE_MAX_HEIGHT 16    // inner levels; fanout >= 11 makes 10 enough for 2^31 keys
+#define BPTREE_BATCH 16         // keys in flight in bpFindBatch()
+#define BP_LEAF_KEYS ((int)((BPTREE_NODE_BYTES-2*sizeof(void*))/(2*sizeof(int))))          // 30
+#define BP_INNER_KEYS ((int)((BPTREE_NODE_BYTES-2*sizeof(void*))/(sizeof(int)+sizeof(void*))))  // 20
+struct BPLeaf{struct BPLeaf *next; int count; int keys[BP_LEAF_KEYS]; int values[BP_LEAF_KEYS];};
+struct BPInner{int count; int keys[BP_INNER_KEYS]; void *child[BP_INNER_KEYS+1];};
+struct BPTree{
+    void *root;                 // a struct BPLeaf when height is 0, else a struct BPInner
+    int height;                 // inner levels above the leaves
+    size_t size;                // keys stored
+    struct NodePool *pool;
+    int (*countLess)(const int a[], int n, int data);
+};
+struct BPCursor{const struct BPLeaf *leaf; int i;};
+
+struct BPTree *newBPTree(void){
+    struct BPTree *t=(struct BPTree*)malloc(sizeof(struct BPTree));
+    if(t==NULL){
+        printf("Out of Memory!"); return NULL;
+    }
+    t->pool=newNodePool(BPTREE_NODE_BYTES,0);
+    if(t->pool==NULL){ free(t); return NULL; }
+    t->root=NULL; t->height=0; t->size=0;
+    t->countLess=linearKernels()->countLess;
+    return t;
+}
+void freeBPTree(struct BPTree *t){
+    if(t==NULL) return;
+    freeNodePool(t->pool); free(t);
+}
+static inline void bpPrefetch(const void *node){
+    for(int off=0;off<BPTREE_NODE_BYTES;off+=NODE_LINE) __builtin_prefetch((const char*)node+off);
+}
+// Child of node that covers key: separators <= key go left of it
+static inline int bpSlot(const struct BPTree *t, const struct BPInner *node, int key){
+    int i=t->countLess(node->keys,node->count,key);
+    return i+(i<node->count && node->keys[i]==key);
+}
+// Leaf that covers key. When path is given it receives the inner nodes and child slots on the
+// way down, and [*lo,*hi) the range of keys that belong in the leaf.
+static struct BPLeaf *bpDescend(const struct BPTree *t, int key, struct BPInner **path, int *slot,
+        long long *lo, long long *hi){
+    void *node=t->root;
+    if(lo!=NULL){ *lo=(long long)INT_MIN; *hi=(long long)INT_MAX+1; }
+    for(int level=0;level<t->height;level++){
+        struct BPInner *in=(struct BPInner*)node;
+        int i=bpSlot(t,in,key);
+        if(path!=NULL){ path[level]=in; slot[level]=i; }
+        if(lo!=NULL){
+            if(i>0) *lo=in->keys[i-1];
+            if(i<in->count) *hi=in->keys[i];
+        }
+        node=in->child[i];
+    }
+    return (struct BPLeaf*)node;
+}
+// 1 and the value in *value when key is present
+int bpFind(const struct BPTree *t, int key, int *value){
+    if(t->root==NULL) return 0;
+    const struct BPLeaf *leaf=bpDescend(t,key,NULL,NULL,NULL,NULL);
+    int i=t->countLess(leaf->keys,leaf->count,key);
+    if(i==leaf->count || leaf->keys[i]!=key) return 0;
+    *value=leaf->values[i];
+    return 1;
+}
+// Looks up n keys; values[i] and found[i] (1 or 0) for keys[i]. Returns how many were found.
+size_t bpFindBatch(const struct BPTree *t, const int keys[], int values[], int found[], size_t n){
+    const void *node[BPTREE_BATCH];
+    size_t hits=0;
+    for(size_t b=0;b<n;b+=BPTREE_BATCH){
+        int m=n-b<BPTREE_BATCH ? (int)(n-b) : BPTREE_BATCH;
+        if(t->root==NULL){
+            for(int j=0;j<m;j++) found[b+j]=0;
+            continue;
+        }
+        for(int j=0;j<m;j++) node[j]=t->root;
+        // One level for every key of the batch, then the next: each node is prefetched a whole
+        // round of m searches before it is read
+        for(int level=0;level<t->height;level++)
+            for(int j=0;j<m;j++){
+                const struct BPInner *in=(const struct BPInner*)node[j];
+                node[j]=in->child[bpSlot(t,in,keys[b+j])];
+                bpPrefetch(node[j]);
+            }
+        for(int j=0;j<m;j++){
+            const struct BPLeaf *leaf=(const struct BPLeaf*)node[j];
+            int i=t->countLess(leaf->keys,leaf->count,keys[b+j]);
+            found[b+j]=i<leaf->count && leaf->keys[i]==keys[b+j];
+            if(found[b+j]){ values[b+j]=leaf->values[i]; hits++; }
+        }
+    }
+    return hits;
+}
+// Puts sep and its right child into level of the path, splitting inner nodes up to the root. The
+// new nodes come from spare, reserved by the caller: one per full node on the path, and the root.
+static void bpInsertInner(struct BPTree *t, struct BPInner **path, int *slot, int level, int sep, void *right, void **spare){
+    for(;level>=0;level--){
+        struct BPInner *in=path[level]; int i=slot[level];
+        if(in->count<BP_INNER_KEYS){
+            for(int j=in->count;j>i;j--){ in->keys[j]=in->keys[j-1]; in->child[j+1]=in->child[j]; }
+            in->keys[i]=sep; in->child[i+1]=right; in->count++;
+            return;
+        }
+        // Split: the first half stays, the middle separator moves up, the rest goes right
+        struct BPInner *r=(struct BPInner*)*spare++;
+        int keys[BP_INNER_KEYS+1]; void *child[BP_INNER_KEYS+2];
+        for(int j=0,k=0;j<=BP_INNER_KEYS;j++) keys[j]=j==i ? sep : in->keys[k++];
+        for(int j=0,k=0;j<=BP_INNER_KEYS+1;j++) child[j]=j==i+1 ? right : in->child[k++];
+        int half=(BP_INNER_KEYS+1)/2;
+        in->count=half; r->count=BP_INNER_KEYS-half;
+        for(int j=0;j<half;j++){ in->keys[j]=keys[j]; in->child[j]=child[j]; }
+        in->child[half]=child[half];
+        for(int j=0;j<r->count;j++){ r->keys[j]=keys[half+1+j]; r->child[j]=child[half+1+j]; }
+        r->child[r->count]=child[BP_INNER_KEYS+1];
+        sep=keys[half]; right=r;
+    }
+    // The root split: grow a level
+    struct BPInner *root=(struct BPInner*)*spare;
+    root->count=1; root->keys[0]=sep; root->child[0]=t->root; root->child[1]=right;
+    t->root=root; t->height++;
+}
+// Inserts key at position i of a leaf that has room
+static inline void bpLeafPut(struct BPLeaf *leaf, int i, int key, int value){
+    for(int j=leaf->count;j>i;j--){ leaf->keys[j]=leaf->keys[j-1]; leaf->values[j]=leaf->values[j-1]; }
+    leaf->keys[i]=key; leaf->values[i]=value; leaf->count++;
+}
+// Inserts into the leaf reached through path; 1 new key, 0 updated, -1 out of memory
+static int bpInsertAt(struct BPTree *t, struct BPLeaf *leaf, struct BPInner **path, int *slot, int key, int value){
+    int i=t->countLess(leaf->keys,leaf->count,key);
+    if(i<leaf->count && leaf->keys[i]==key){ leaf->values[i]=value; return 0; }
+    if(leaf->count<BP_LEAF_KEYS){ bpLeafPut(leaf,i,key,value); t->size++; return 1; }
+    // Reserve every node the split needs before touching the tree, so running out of memory
+    // leaves it as it was: the new leaf, one per full inner node above it, and a new root when
+    // they are full all the way up
+    void *spare[BPTREE_MAX_HEIGHT+2];
+    int need=1, level=t->height-1;
+    while(level>=0 && path[level]->count==BP_INNER_KEYS){ need++; level--; }
+    if(level<0) need++;
+    for(int j=0;j<need;j++)
+        if((spare[j]=nodePoolAlloc(t->pool))==NULL){
+            while(j>0) nodePoolFree(t->pool,spare[--j]);
+            return -1;
+        }
+    // Split the full leaf in half and put the key in the half it belongs to
+    struct BPLeaf *r=(struct BPLeaf*)spare[0];
+    int half=(BP_LEAF_KEYS+1)/2;
+    r->count=BP_LEAF_KEYS-half;
+    for(int j=0;j<r->count;j++){ r->keys[j]=leaf->keys[half+j]; r->values[j]=leaf->values[half+j]; }
+    leaf->count=half;
+    r->next=leaf->next; leaf->next=r;
+    if(i<=half) bpLeafPut(leaf,i,key,value);
+    else bpLeafPut(r,i-half,key,value);
+    bpInsertInner(t,path,slot,t->height-1,r->keys[0],r,spare+1);
+    t->size++;
+    return 1;
+}
+// 1 when key is new, 0 when its value was replaced, -1 when out of memory
+int bpInsert(struct BPTree *t, int key, int value){
+    struct BPInner *path[BPTREE_MAX_HEIGHT]; int slot[BPTREE_MAX_HEIGHT];
+    if(t->root==NULL){
+        struct BPLeaf *leaf=(struct BPLeaf*)nodePoolAlloc(t->pool);
+        if(leaf==NULL) return -1;
+        leaf->next=NULL; leaf->count=0;
+        t->root=leaf;
+    }
+    struct BPLeaf *leaf=bpDescend(t,key,path,slot,NULL,NULL);
+    return bpInsertAt(t,leaf,path,slot,key,value);
+}
+// Inserts n keys in the given order and returns how many were new. While the next key belongs to
+// the same leaf as the last one it goes straight in without a new descent, so sorted or clustered
+// batches pay for one descent per leaf (and one more after each split).
+size_t bpInsertBatch(struct BPTree *t, const int keys[], const int values[], size_t n){
+    struct BPInner *path[BPTREE_MAX_HEIGHT]; int slot[BPTREE_MAX_HEIGHT];
+    struct BPLeaf *leaf=NULL; long long lo=0, hi=0;
+    size_t added=0;
+    for(size_t k=0;k<n;k++){
+        int key=keys[k];
+        if(leaf==NULL || key<lo || key>=hi){
+            if(t->root==NULL){
+                int r=bpInsert(t,key,values[k]);
+                if(r<0) break;
+                added+=(size_t)r; continue;
+            }
+            leaf=bpDescend(t,key,path,slot,&lo,&hi);
+        }
+        int full=leaf->count==BP_LEAF_KEYS;
+        int r=bpInsertAt(t,leaf,path,slot,key,values[k]);
+        if(r<0) break;
+        added+=(size_t)r;
+        if(full && r==1) leaf=NULL;     // it split: the leaf, its bounds and the path changed
+    }
+    return added;
+}
+// Builds the tree from n strictly increasing keys, packing every node. The tree must be empty.
+// Returns 0 (leaving it empty) when it is not, the keys are not sorted, or memory runs out.
+int bpBulkLoad(struct BPTree *t, const int keys[], const int values[], size_t n){
+    if(t->root!=NULL) return 0;
+    for(size_t i=1;i<n;i++) if(keys[i-1]>=keys[i]) return 0;
+    if(n==0) return 1;
+    // Leaves first: n keys spread evenly over ceil(n/K) leaves
+    size_t count=(n+BP_LEAF_KEYS-1)/BP_LEAF_KEYS;
+    void **node=(void**)malloc(count*sizeof(void*));
+    int *low=(int*)malloc(count*sizeof(int));       // smallest key under each node
+    if(node==NULL || low==NULL){
+        printf("Out of Memory!"); free(node); free(low); return 0;
+    }
+    struct BPLeaf *prev=NULL;
+    int height=0;
+    for(size_t j=0,k=0;j<count;j++){
+        struct BPLeaf *leaf=(struct BPLeaf*)nodePoolAlloc(t->pool);
+        if(leaf==NULL) goto fail;
+        leaf->count=(int)(n*(j+1)/count-n*j/count); leaf->next=NULL;
+        for(int i=0;i<leaf->count;i++,k++){ leaf->keys[i]=keys[k]; leaf->values[i]=values[k]; }
+        if(prev!=NULL) prev->next=leaf;
+        prev=leaf; node[j]=leaf; low[j]=leaf->keys[0];
+    }
+    // Then each inner level over the one below, until a single node is left
+    while(count>1){
+        size_t parents=(count+BP_INNER_KEYS)/(BP_INNER_KEYS+1);
+        for(size_t p=0,c=0;p<parents;p++){
+            struct BPInner *in=(struct BPInner*)nodePoolAlloc(t->pool);
+            if(in==NULL) goto fail;
+            size_t end=count*(p+1)/parents;
+            int lowest=low[c];
+            in->count=(int)(end-c)-1;
+            in->child[0]=node[c++];
+            for(int i=0;c<end;i++,c++){ in->keys[i]=low[c]; in->child[i+1]=node[c]; }
+            node[p]=in; low[p]=lowest;  // p < c, so the level below is not overwritten yet
+        }
+        count=parents; height++;
+    }
+    t->root=node[0]; t->height=height; t->size=n;
+    free(node); free(low);
+    return 1;
+fail:
+    nodePoolReset(t->pool);
+    free(node); free(low);
+    return 0;
+}
+// Positions c at the first key >= key
+void bpSeek(const struct BPTree *t, int key, struct BPCursor *c){
+    c->leaf=NULL; c->i=0;
+    if(t->root==NULL) return;
+    c->leaf=bpDescend(t,key,NULL,NULL,NULL,NULL);
+    c->i=t->countLess(c->leaf->keys,c->leaf->count,key);
+    if(c->i==c->leaf->count){ c->leaf=c->leaf->next; c->i=0; }
+}
+// The key and value under c, then steps to the next key; 0 past the last key
+int bpNext(struct BPCursor *c, int *key, int *value){
+    if(c->leaf==NULL) return 0;
+    *key=c->leaf->keys[c->i]; *value=c->leaf->values[c->i];
+    if(++c->i==c->leaf->count){ c->leaf=c->leaf->next; c->i=0; }
+    return 1;
+}
+// Copies up to max keys in [lo,hi] and their values, in order; returns how many
+size_t bpRange(const struct BPTree *t, int lo, int hi, int keys[], int values[], size_t max){
+    struct BPCursor c; int key, value; size_t k=0;
+    bpSeek(t,lo,&c);
+    while(k<max && bpNext(&c,&key,&value) && key<=hi){ keys[k]=key; values[k]=value; k++; }
+    return k;
+}
+#endif
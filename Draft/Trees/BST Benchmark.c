@@ -0,0 +1,254 @@
+// Benchmark for the traversals and the balanced build of Binary Search Tree.c.
+// Build: gcc -O2 -pthread -o bst_bench "BST Benchmark.c"
+// Run:   ./bst_bench --min 1024 --max 4194304 --threads 8 --json bst.json
+// For every n, over a tree built by inserting n random keys (height about 2.5 log2 n) and, for
+// the build rows, from n sorted keys (ns/item = per node):
+//   levelorder/perLevel  the old levelorder(): one printGivenLevel() walk from the root per level,
+//                        O(n*h) (only up to BST_PER_LEVEL_MAX nodes)
+//   levelorder/queue     levelorderVisit()
+//   inorder/recursive    the old recursive inorder(), pre- and postorder likewise
+//   inorder/morris       inorderVisit(), O(1) extra space
+//   preorder/stack, postorder/stack  preorderVisit(), postorderVisit()
+//   build/sequential     buildBalanced() of the sorted keys, then the tree is freed
+//   build/parallel       parallelBuildBalanced() on --threads workers
+// Every traversal folds the keys into an order-sensitive hash, checked against the recursive
+// version of the same order; the builds are checked by an in-order hash of the tree.
+// Untimed, the same keys are inserted into the trees of Singly-Threaded Binary Tree.c and
+// Doubly-Threaded Binary Tree.c, whose forward and backward thread walks must give the sorted
+// keys; see checkThreaded().
+#include"Binary Search Tree.c"
+#include"../Benchmark/Benchmark.h"
+// The threaded trees use the same names as Binary Search Tree.c, so each gets its own prefix
+#define Node STNode
+#define newNode stNewNode
+#define minNode stMinNode
+#define successor stSuccessor
+#define insert stInsert
+#define inorderVisit stInorderVisit
+#define printKey stPrintKey
+#define inorder stInorder
+#define freeTree stFreeTree
+#include"Singly-Threaded Binary Tree.c"
+#undef Node
+#undef newNode
+#undef minNode
+#undef successor
+#undef insert
+#undef inorderVisit
+#undef printKey
+#undef inorder
+#undef freeTree
+#define Node DTNode
+#define newNode dtNewNode
+#define minNode dtMinNode
+#define maxNode dtMaxNode
+#define successor dtSuccessor
+#define predecessor dtPredecessor
+#define insert dtInsert
+#define inorderVisit dtInorderVisit
+#define reverseInorderVisit dtReverseInorderVisit
+#define printKey dtPrintKey
+#define inorder dtInorder
+#define reverseInorder dtReverseInorder
+#define freeTree dtFreeTree
+#include"Doubly-Threaded Binary Tree.c"
+#undef Node
+#undef newNode
+#undef minNode
+#undef maxNode
+#undef successor
+#undef predecessor
+#undef insert
+#undef inorderVisit
+#undef reverseInorderVisit
+#undef printKey
+#undef inorder
+#undef reverseInorder
+#undef freeTree
+
+#define BST_PER_LEVEL_MAX 65536
+
+static void hashVisit(void *arg, int key){
+    unsigned long long *h=(unsigned long long*)arg;
+    *h=*h*1000003+(unsigned)key;
+}
+// The baselines, as the traversals were written before
+static void perLevel(struct Node *root, int l, unsigned long long *h){
+    if(root==NULL) return;
+    if(l==1) hashVisit(h,root->key);
+    else{ perLevel(root->left,l-1,h); perLevel(root->right,l-1,h); }
+}
+static void recursive(struct Node *root, int order, unsigned long long *h){
+    if(root==NULL) return;
+    if(order==0) hashVisit(h,root->key);
+    recursive(root->left,order,h);
+    if(order==1) hashVisit(h,root->key);
+    recursive(root->right,order,h);
+    if(order==2) hashVisit(h,root->key);
+}
+static void freeNodes(struct Node *root){
+    struct NodeList st={NULL,0,0};
+    if(root!=NULL) nodeListPush(&st,root);
+    while(st.n>0){
+        struct Node *node=st.a[--st.n];
+        if(node->left!=NULL) nodeListPush(&st,node->left);
+        if(node->right!=NULL) nodeListPush(&st,node->right);
+        free(node);
+    }
+    free(st.a);
+}
+
+struct BstCtx{struct Node *tree; int height; const int *sorted; size_t n; struct Pool *pool; struct Node *built;};
+static long long runPerLevel(void *vctx, size_t begin, size_t end){
+    struct BstCtx *c=(struct BstCtx*)vctx; unsigned long long h=0;
+    for(size_t op=begin;op<end;op++)
+        for(int l=1;l<=c->height;l++) perLevel(c->tree,l,&h);
+    return (long long)h;
+}
+static long long runQueue(void *vctx, size_t begin, size_t end){
+    struct BstCtx *c=(struct BstCtx*)vctx; unsigned long long h=0;
+    for(size_t op=begin;op<end;op++) levelorderVisit(c->tree,hashVisit,NULL,&h);
+    return (long long)h;
+}
+#define BST_RECURSIVE(name, order) \
+static long long name(void *vctx, size_t begin, size_t end){ \
+    struct BstCtx *c=(struct BstCtx*)vctx; unsigned long long h=0; \
+    for(size_t op=begin;op<end;op++) recursive(c->tree,order,&h); \
+    return (long long)h; \
+}
+BST_RECURSIVE(runPreRecursive,0)
+BST_RECURSIVE(runInRecursive,1)
+BST_RECURSIVE(runPostRecursive,2)
+static long long runMorris(void *vctx, size_t begin, size_t end){
+    struct BstCtx *c=(struct BstCtx*)vctx; unsigned long long h=0;
+    for(size_t op=begin;op<end;op++) inorderVisit(c->tree,hashVisit,&h);
+    return (long long)h;
+}
+static long long runPreStack(void *vctx, size_t begin, size_t end){
+    struct BstCtx *c=(struct BstCtx*)vctx; unsigned long long h=0;
+    for(size_t op=begin;op<end;op++) preorderVisit(c->tree,hashVisit,&h);
+    return (long long)h;
+}
+static long long runPostStack(void *vctx, size_t begin, size_t end){
+    struct BstCtx *c=(struct BstCtx*)vctx; unsigned long long h=0;
+    for(size_t op=begin;op<end;op++) postorderVisit(c->tree,hashVisit,&h);
+    return (long long)h;
+}
+// Builds: setup frees the tree of the previous sample; the checksum is the in-order hash
+static void dropBuilt(void *vctx, size_t begin, size_t end){
+    struct BstCtx *c=(struct BstCtx*)vctx; (void)begin; (void)end;
+    freeNodes(c->built); c->built=NULL;
+}
+static long long runBuild(void *vctx, size_t begin, size_t end){
+    struct BstCtx *c=(struct BstCtx*)vctx; (void)begin; (void)end;
+    c->built=buildBalanced(c->sorted,c->n);
+    unsigned long long h=0; inorderVisit(c->built,hashVisit,&h);
+    return (long long)h;
+}
+static long long runParallelBuild(void *vctx, size_t begin, size_t end){
+    struct BstCtx *c=(struct BstCtx*)vctx; (void)begin; (void)end;
+    c->built=parallelBuildBalanced(c->sorted,c->n,c->pool);
+    unsigned long long h=0; inorderVisit(c->built,hashVisit,&h);
+    return (long long)h;
+}
+// The i-th key inserted: i -> (i^x)*odd mod 2^31 is a bijection, so the keys are distinct and
+// look random
+static inline int bstKey(size_t i, unsigned x){
+    return (int)((((unsigned)i^x)*2654435761u)&0x7fffffff);
+}
+// Inserts the n keys into both threaded trees and walks them: forwards they must give sorted[],
+// backwards (doubly threaded) its reverse, and each inserted node must sit between its neighbours
+static int checkThreaded(unsigned x, const int sorted[], size_t n){
+    struct STNode *st=NULL; struct DTNode *dt=NULL;
+    int ok=1;
+    for(size_t i=0;i<n && ok;i++){
+        int key=bstKey(i,x);
+        struct STNode *s=stInsert(&st,key);
+        struct DTNode *d=dtInsert(&dt,key);
+        if(s==NULL || d==NULL){ ok=0; break; }
+        struct DTNode *p=dtPredecessor(d), *q=dtSuccessor(d); struct STNode *next=stSuccessor(s);
+        ok=(p==NULL || p->key<key) && (q==NULL || q->key>key) &&
+            (q==NULL ? next==NULL : next!=NULL && next->key==q->key);
+    }
+    struct KeyBuffer kb={NULL,0,n};
+    int *walk=(int*)malloc((n ? n : 1)*sizeof(int));
+    if(walk==NULL) ok=0;
+    if(ok){
+        kb.a=walk; kb.n=0; stInorderVisit(st,keyBufferVisit,&kb);
+        ok=kb.n==n && memcmp(walk,sorted,n*sizeof(int))==0;
+    }
+    if(ok){
+        kb.n=0; dtInorderVisit(dt,keyBufferVisit,&kb);
+        ok=kb.n==n && memcmp(walk,sorted,n*sizeof(int))==0;
+    }
+    if(ok){
+        kb.n=0; dtReverseInorderVisit(dt,keyBufferVisit,&kb);
+        for(size_t i=0;i<n && ok;i++) ok=kb.n==n && walk[i]==sorted[n-1-i];
+    }
+    free(walk); stFreeTree(st); dtFreeTree(dt);
+    return ok;
+}
+
+struct BstRoutine{const char *name; long long (*run)(void *ctx, size_t begin, size_t end); void (*setup)(void *ctx, size_t begin, size_t end);};
+// Pairs: the first routine's checksum is the reference for the second
+static const struct BstRoutine routines[]={
+    {"levelorder/perLevel",runPerLevel,NULL},{"levelorder/queue",runQueue,NULL},
+    {"inorder/recursive",runInRecursive,NULL},{"inorder/morris",runMorris,NULL},
+    {"preorder/recursive",runPreRecursive,NULL},{"preorder/stack",runPreStack,NULL},
+    {"postorder/recursive",runPostRecursive,NULL},{"postorder/stack",runPostStack,NULL},
+    {"build/sequential",runBuild,dropBuilt},{"build/parallel",runParallelBuild,dropBuilt},
+};
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    cfg.maxN=1<<22;
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    struct Pool *pool=newPool(cfg.threads);
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"bst");
+    int failed=0;
+    unsigned long long s=benchSeed(cfg.seed);
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        int *sorted=(int*)malloc(n*sizeof(int));
+        if(pool==NULL || sorted==NULL){
+            printf("Out of Memory!"); return 1;
+        }
+        unsigned x=(unsigned)benchRand(&s)&0x7fffffff;
+        struct Node *tree=NULL;
+        for(size_t i=0;i<n;i++){
+            int key=bstKey(i,x);
+            insert(&tree,key);
+            sorted[i]=key;
+        }
+        // sort the keys with the tree itself
+        struct KeyBuffer kb={sorted,0,n}; inorderVisit(tree,keyBufferVisit,&kb);
+        if(!checkThreaded(x,sorted,n)){
+            fprintf(stderr,"threaded trees: wrong walk for n=%zu\n",n); failed=1;
+        }
+        struct BstCtx ctx={tree,height(tree),sorted,n,pool,NULL};
+        size_t reps=cfg.ops*4/n;
+        if(reps<3) reps=3;
+        if(reps>200) reps=200;
+        long long ref=0;
+        for(size_t r=0;r<sizeof(routines)/sizeof(routines[0]);r++){
+            if(r<2 && n>BST_PER_LEVEL_MAX) continue;
+            // the reference of a pair always runs
+            if(!benchSelected(&cfg,routines[r].name) && (r&1)) continue;
+            int build=routines[r].setup!=NULL;
+            struct BenchCase bc={routines[r].name,n,build ? 1 : reps,1,routines[r].run,routines[r].setup,&ctx,n};
+            struct BenchResult res=benchMeasure(&cfg,&bc);
+            if(benchSelected(&cfg,routines[r].name)) benchReportResult(&rep,&res);
+            long long one=res.checksum;  // both routines of a pair run the same passes
+            if(!(r&1)) ref=one;
+            else if(one!=ref){
+                fprintf(stderr,"%s: wrong result for n=%zu\n",routines[r].name,n); failed=1;
+            }
+            if(build){ freeNodes(ctx.built); ctx.built=NULL; }
+        }
+        freeNodes(tree); free(sorted);
+    }
+    benchReportEnd(&rep);
+    freePool(pool);
+    return failed;
+}
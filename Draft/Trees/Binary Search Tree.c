@@ -1,5 +1,9 @@
+#ifndef BINARY_SEARCH_TREE_C
+#define BINARY_SEARCH_TREE_C
 #include<stdio.h>
 #include<stdlib.h>
+#include<limits.h>
+#include"../Parallel/Work-Stealing Pool.h"
 struct Node{int key; struct Node *left, *right;};
 struct Node *root=NULL;
 // function to find height of the tree
@@ -17,6 +21,9 @@ int height(struct Node *root){
 struct Node *newNode(int data) {
    // Allocate memory and store data
    struct Node *node = (struct Node*)malloc(sizeof(struct Node));
+   if(node == NULL) {
+       printf("Out of Memory!"); return NULL;
+   }
    node->key = data;  // Set key value
    node->left = NULL;  // Initialize left child as null
    node->right = NULL;  // Initialize right child as null
@@ -24,13 +31,13 @@ struct Node *newNode(int data) {
 }
 struct Node *minNode(struct Node *root){
     struct Node *curr=root;
-    while((curr && curr->left)!=NULL) curr=curr->left;
+    while(curr && curr->left!=NULL) curr=curr->left;
     return curr;
 }
 // Find the maximum node in a BST
 struct Node *maxNode(struct Node *root){
     struct Node *curr=root; // Initialize current node as root
-    while((curr && curr->right)!=NULL) curr=curr->right; // Move right until reaching maximum node
+    while(curr && curr->right!=NULL) curr=curr->right; // Move right until reaching maximum node
     return curr; // Return the maximum node
 }
 // insert node with value data
@@ -46,74 +53,198 @@ struct Node *insert(struct Node **root, int data){
     return (*root);
 }
 struct Node *delete(struct Node **root, int data){
-    if(root==NULL) return root; // Tree is empty
+    if(*root==NULL) return NULL; // Tree is empty
     if(data<(*root)->key) (*root)->left=delete(&((*root)->left),data); // Go left
     else if(data>(*root)->key) (*root)->right=delete(&((*root)->right),data); // Go right
     else{
         if((*root)->left==NULL){
             struct Node *temp=(*root)->right;
-            free(root); return temp; // No left child, return right child
+            free(*root); return temp; // No left child, return right child
         }
         if((*root)->right==NULL){
             struct Node *temp=(*root)->left;
-            free(root); return temp; // No right child, return left child
+            free(*root); return temp; // No right child, return left child
         }
         struct Node *temp=minNode((*root)->right); // Both children exist, replace root with min in right subtree
         (*root)->key=temp->key;
         (*root)->right=delete(&((*root)->right),temp->key); // Delete the replaced node in right subtree
     }
-    return root;
+    return *root;
 }
-void printGivenLevel(struct Node *root, int l){
-    // base case: empty tree
-    if(root==NULL) return;
-
-    // base case: current level is 1
-    if(l==1) printf("%d",root->key);
-
-    // recursive case: current level is greater than 1
-    else{
-        printGivenLevel(root->left,l-1); // recursively print left subtree
-        printGivenLevel(root->right,l-1); // recursively print right subtree
+// Traversals that hand every key to visit(arg,key) instead of printing it, so callers can fill a
+// buffer, sum, or print. None of them recurses, so a degenerate tree of n nodes costs O(n) time
+// and no call stack. The ones that need a stack or queue return -1 when it cannot grow.
+// Growable array of node pointers, the stack or queue of the traversals below
+struct NodeList{struct Node **a; size_t n,cap;};
+static int nodeListPush(struct NodeList *l, struct Node *node){
+    if(l->n==l->cap){
+        size_t cap=l->cap ? 2*l->cap : 64;
+        struct Node **a=(struct Node**)realloc(l->a,cap*sizeof(struct Node*));
+        if(a==NULL){
+            printf("Out of Memory!"); return 0;
+        }
+        l->a=a; l->cap=cap;
     }
+    l->a[l->n++]=node;
+    return 1;
 }
-void levelorder(struct Node *root){
-    int i; // Iterate over levels
-
-    for(i=1;i<=height(root);i++){
-        printGivenLevel(root,i); printf("\n"); // Print current level and newline
+// Morris in-order: O(1) extra space. The rightmost node of each left subtree is pointed back at
+// its in-order successor while that subtree is walked, and restored on the second visit, so the
+// tree is unchanged afterwards (but must not be read by another thread meanwhile).
+void inorderVisit(struct Node *root, void (*visit)(void *arg, int key), void *arg){
+    struct Node *curr=root;
+    while(curr!=NULL){
+        if(curr->left==NULL){
+            visit(arg,curr->key);
+            curr=curr->right;           // the right child, or a thread to the successor
+            continue;
+        }
+        struct Node *pre=curr->left;    // in-order predecessor of curr
+        while(pre->right!=NULL && pre->right!=curr) pre=pre->right;
+        if(pre->right==NULL){
+            pre->right=curr;            // first visit: thread back, then walk the left subtree
+            curr=curr->left;
+        }
+        else{
+            pre->right=NULL;            // second visit: the left subtree is done
+            visit(arg,curr->key);
+            curr=curr->right;
+        }
     }
 }
-void preorder(struct Node *root){
-    // Base case: check if root exists
-    if(root!=NULL){
-        // Print the root node's key
-        printf("%d",root->key);
-        // Recursively traverse the left subtree
-        preorder(root->left);
-        // Recursively traverse the right subtree
-        preorder(root->right);
+// Pre-order with an explicit stack; the right child is pushed first so the left is visited first
+int preorderVisit(struct Node *root, void (*visit)(void *arg, int key), void *arg){
+    struct NodeList st={NULL,0,0};
+    int ok=root==NULL || nodeListPush(&st,root);
+    while(ok && st.n>0){
+        struct Node *node=st.a[--st.n];
+        visit(arg,node->key);
+        if(node->right!=NULL) ok=nodeListPush(&st,node->right);
+        if(ok && node->left!=NULL) ok=nodeListPush(&st,node->left);
     }
+    free(st.a);
+    return ok ? 0 : -1;
 }
-void inorder(struct Node *root){
-    if(root!=NULL){ // If the node exists
-        inorder(root->left); // Traverse left subtree
-        printf("%d",root->key); // Print the key
-        inorder(root->right); // Traverse right subtree
+// Post-order with one stack: go left as far as possible, then right; a node is visited when its
+// right subtree is empty or was the last subtree visited
+int postorderVisit(struct Node *root, void (*visit)(void *arg, int key), void *arg){
+    struct NodeList st={NULL,0,0};
+    struct Node *curr=root, *last=NULL;
+    int ok=1;
+    while(ok && (curr!=NULL || st.n>0)){
+        if(curr!=NULL){
+            ok=nodeListPush(&st,curr);
+            curr=curr->left;
+            continue;
+        }
+        struct Node *top=st.a[st.n-1];
+        if(top->right!=NULL && top->right!=last) curr=top->right;
+        else{
+            visit(arg,top->key);
+            last=top; st.n--;
+        }
+    }
+    free(st.a);
+    return ok ? 0 : -1;
+}
+// Level order with a queue: every node is enqueued once, so O(n) whatever the shape of the tree.
+// endLevel(arg), when given, is called after the last key of each level.
+int levelorderVisit(struct Node *root, void (*visit)(void *arg, int key), void (*endLevel)(void *arg), void *arg){
+    struct NodeList q={NULL,0,0};
+    size_t head=0;
+    int ok=root==NULL || nodeListPush(&q,root);
+    while(ok && head<q.n){
+        size_t end=q.n;                 // the nodes of the current level are [head,end)
+        for(;ok && head<end;head++){
+            struct Node *node=q.a[head];
+            visit(arg,node->key);
+            if(node->left!=NULL) ok=nodeListPush(&q,node->left);
+            if(ok && node->right!=NULL) ok=nodeListPush(&q,node->right);
+        }
+        if(endLevel!=NULL) endLevel(arg);
     }
+    free(q.a);
+    return ok ? 0 : -1;
+}
+// Visitor that copies keys into a buffer: struct KeyBuffer b={out,0,max};
+struct KeyBuffer{int *a; size_t n,max;};
+void keyBufferVisit(void *arg, int key){
+    struct KeyBuffer *b=(struct KeyBuffer*)arg;
+    if(b->n<b->max) b->a[b->n]=key;
+    b->n++;                             // counts every key, so n > max tells the buffer was short
+}
+static void printKey(void *arg, int key){
+    (void)arg; printf("%d",key);
+}
+static void printNewline(void *arg){
+    (void)arg; printf("\n");
+}
+void levelorder(struct Node *root){
+    // Print every level on its own line
+    levelorderVisit(root,printKey,printNewline,NULL);
+}
+void preorder(struct Node *root){
+    preorderVisit(root,printKey,NULL);
+}
+void inorder(struct Node *root){
+    inorderVisit(root,printKey,NULL);
 }
 void postorder(struct Node *root){
-    if(root!=NULL){ // If node exists
-        postorder(root->left); // Traverse left subtree
-        postorder(root->right); // Traverse right subtree
-        printf("%d",root->key); // Print the node's key
+    postorderVisit(root,printKey,NULL);
+}
+// Frees a tree made by buildBalanced(); its height is logarithmic, so recursion is safe
+static void freeBalanced(struct Node *root){
+    if(root==NULL) return;
+    freeBalanced(root->left); freeBalanced(root->right); free(root);
+}
+// Balanced tree from n sorted keys in O(n): the middle key is the root, and each half builds a
+// subtree the same way, so the height is ceil(log2(n+1)). NULL, with nothing left allocated,
+// when memory runs out.
+struct Node *buildBalanced(const int a[], size_t n){
+    if(n==0) return NULL;
+    size_t m=n/2;
+    struct Node *root=newNode(a[m]);
+    if(root==NULL) return NULL;
+    root->left=buildBalanced(a,m);
+    root->right=buildBalanced(a+m+1,n-m-1);
+    if((m>0 && root->left==NULL) || (n-m-1>0 && root->right==NULL)){
+        freeBalanced(root->left); freeBalanced(root->right); free(root);
+        return NULL;
     }
+    return root;
+}
+// The same tree with the two halves built in parallel on pool; below BST_SPAWN keys a subtree is
+// built on the worker that reached it
+#define BST_SPAWN 16384
+struct BuildArg{struct Pool *pool; const int *a; size_t n; struct Node *root;};
+static void buildTask(void *varg){
+    struct BuildArg *b=(struct BuildArg*)varg;
+    if(b->n<=BST_SPAWN){ b->root=buildBalanced(b->a,b->n); return; }
+    size_t m=b->n/2;
+    struct BuildArg left={b->pool,b->a,m,NULL}, right={b->pool,b->a+m+1,b->n-m-1,NULL};
+    long pending=0; struct PoolTask t={buildTask,&left,NULL};
+    poolSpawn(b->pool,&t,&pending);
+    buildTask(&right);
+    b->root=newNode(b->a[m]);
+    poolSync(b->pool,&pending);
+    // Both halves are non-empty here, so NULL means a failed allocation somewhere below
+    if(b->root==NULL || left.root==NULL || right.root==NULL){
+        freeBalanced(left.root); freeBalanced(right.root); free(b->root);
+        b->root=NULL; return;
+    }
+    b->root->left=left.root; b->root->right=right.root;
+}
+// NULL, with nothing left allocated, when memory runs out
+struct Node *parallelBuildBalanced(const int a[], size_t n, struct Pool *pool){
+    struct BuildArg b={pool,a,n,NULL};
+    poolRun(pool,buildTask,&b);
+    return b.root;
 }
 // Function to construct a tree from a postorder traversal
-struct Node *constructTreeUtil(int[],int *pi,int key,int min,int max, size)
+struct Node *constructTreeUtil(int post[],int *pi,int key,int min,int max, int size)
 {
     // Return NULL if the index is out of bounds
-    if(*pi<0) return;
+    if(*pi<0) return NULL;
 
     // Initialize the root node and decrement the index
     struct Node *root=NULL;
@@ -138,4 +269,5 @@ struct Node *constructTree(int post[], int size) {
 
     // Call the helper function with the postorder array and its size
     return constructTreeUtil(post, &pi, post[pi], INT_MIN, INT_MAX, size);
-}
\ No newline at end of file
+}
+#endif
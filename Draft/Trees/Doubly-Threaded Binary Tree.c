@@ -0,0 +1,100 @@
+#ifndef DOUBLY_THREADED_BINARY_TREE_C
+#define DOUBLY_THREADED_BINARY_TREE_C
+#include<stdio.h>
+#include<stdlib.h>
+// Binary search tree whose empty child pointers are threads: a missing left child is replaced by
+// a pointer to the in-order predecessor, a missing right child by one to the successor (NULL at
+// the two ends), and the flags l and r tell threads from children. The tree can be walked in
+// order forwards and backwards, and every node finds its neighbours, without recursion or a stack.
+struct Node{int key; struct Node *left, *right; int l, r;};  // l/r: left/right is a thread
+struct Node *newNode(int data) {
+   // Allocate memory and store data
+   struct Node *node = (struct Node*)malloc(sizeof(struct Node));
+   if(node == NULL) {
+       printf("Out of Memory!"); return NULL;
+   }
+   node->key = data;  // Set key value
+   node->left = node->right = NULL;  // No neighbours yet
+   node->l = node->r = 1;  // A new node is a leaf, so both pointers are threads
+   return node;  // Return the created node
+}
+// Smallest key of the subtree: follow left children, not threads
+struct Node *minNode(struct Node *root) {
+    struct Node *curr = root;
+    while (curr && !curr->l) curr = curr->left;
+    return curr;
+}
+// Largest key of the subtree: follow right children, not threads
+struct Node *maxNode(struct Node *root) {
+    struct Node *curr = root;
+    while (curr && !curr->r) curr = curr->right;
+    return curr;
+}
+// In-order successor of node, or NULL for the largest key
+struct Node *successor(struct Node *node) {
+    if (node->r) return node->right;
+    return minNode(node->right);
+}
+// In-order predecessor of node, or NULL for the smallest key
+struct Node *predecessor(struct Node *node) {
+    if (node->l) return node->left;
+    return maxNode(node->left);
+}
+// Inserts data without recursion; returns its node (the existing one for a duplicate)
+struct Node *insert(struct Node **root, int data) {
+    // create new node if root is null
+    if (*root == NULL) return *root = newNode(data);
+
+    struct Node *curr = *root;
+    for (;;) {
+        if (data < curr->key) {
+            if (!curr->l) { curr = curr->left; continue; }
+            // New left leaf: it sits between curr's predecessor and curr
+            struct Node *node = newNode(data);
+            if (node == NULL) return NULL;
+            node->left = curr->left; node->right = curr;
+            curr->left = node; curr->l = 0;
+            return node;
+        }
+        if (data > curr->key) {
+            if (!curr->r) { curr = curr->right; continue; }
+            // New right leaf: it sits between curr and curr's successor
+            struct Node *node = newNode(data);
+            if (node == NULL) return NULL;
+            node->left = curr; node->right = curr->right;
+            curr->right = node; curr->r = 0;
+            return node;
+        }
+        printf("Duplicate Node!");
+        return curr;
+    }
+}
+// Hands every key to visit(arg,key) in increasing order, in O(n) time and O(1) space
+void inorderVisit(struct Node *root, void (*visit)(void *arg, int key), void *arg) {
+    for (struct Node *curr = minNode(root); curr != NULL; curr = successor(curr))
+        visit(arg, curr->key);
+}
+// The same in decreasing order, following the left threads
+void reverseInorderVisit(struct Node *root, void (*visit)(void *arg, int key), void *arg) {
+    for (struct Node *curr = maxNode(root); curr != NULL; curr = predecessor(curr))
+        visit(arg, curr->key);
+}
+static void printKey(void *arg, int key) {
+    (void)arg; printf("%d ", key);
+}
+void inorder(struct Node *root) {
+    inorderVisit(root, printKey, NULL);
+}
+void reverseInorder(struct Node *root) {
+    reverseInorderVisit(root, printKey, NULL);
+}
+// Frees every node in order; every node the walk reads later comes after the freed one
+void freeTree(struct Node *root) {
+    struct Node *curr = minNode(root);
+    while (curr != NULL) {
+        struct Node *next = successor(curr);
+        free(curr);
+        curr = next;
+    }
+}
+#endif
@@ -0,0 +1,106 @@
+#ifndef HEAP_TREE_C
+#define HEAP_TREE_C
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+// D-ary min-heap in an array: the children of a[i] are a[D*i+1..D*i+D], so the tree is log_D n
+// levels deep instead of log_2 n. Sifting down compares D children per level, but they sit side by
+// side: the array starts D-1 elements before a cache line boundary, so with D*sizeof(T) equal to a
+// line (4 x 16-byte or 16 x 4-byte elements) every group of siblings fills exactly one line.
+// DEFINE_DARY_HEAP(name,T,D,LESS) defines
+//   name##SiftUp(T a[],i), name##SiftDown(T a[],n,i), name##Heapify(T a[],n)   (on any array)
+//   struct name with new##name(cap), free##name(h), name##Push(h,x) (0 out of memory),
+//   name##Pop(h,T *x) (0 when empty), name##Top(h), name##Build(h,const T v[],n) and
+//   name##Merge(h,other), which moves every element of other into h
+#define HEAP_LINE 64
+
+#define DEFINE_DARY_HEAP(name, T, D, LESS) \
+static inline void name##SiftUp(T a[], size_t i){ \
+    T x=a[i]; \
+    while(i>0){ \
+        size_t p=(i-1)/(D); \
+        if(!LESS(x,a[p])) break; \
+        a[i]=a[p]; i=p; \
+    } \
+    a[i]=x; \
+} \
+static inline void name##SiftDown(T a[], size_t n, size_t i){ \
+    T x=a[i]; \
+    for(;;){ \
+        size_t c=(D)*i+1, e, m=c; \
+        if(c>=n) break; \
+        e=c+(D)<n ? c+(D) : n; \
+        for(size_t k=c+1;k<e;k++) if(LESS(a[k],a[m])) m=k;   /* smallest child */ \
+        if(!LESS(a[m],x)) break; \
+        a[i]=a[m]; i=m; \
+    } \
+    a[i]=x; \
+} \
+/* Floyd's bottom-up build: sift down every inner node, last first, in O(n) */ \
+static inline void name##Heapify(T a[], size_t n){ \
+    if(n<2) return; \
+    for(size_t i=(n-2)/(D)+1;i-->0;) name##SiftDown(a,n,i); \
+} \
+struct name{T *a; size_t n,cap; void *base;}; \
+/* Storage for cap elements with the sibling groups on line boundaries */ \
+static inline int name##Grow(struct name *h, size_t cap){ \
+    void *base; \
+    if(posix_memalign(&base,HEAP_LINE,(cap+(D))*sizeof(T))) return 0; \
+    T *a=(T*)base+((D)-1); \
+    if(h->n) memcpy(a,h->a,h->n*sizeof(T)); \
+    free(h->base); \
+    h->base=base; h->a=a; h->cap=cap; \
+    return 1; \
+} \
+static inline struct name *new##name(size_t cap){ \
+    struct name *h=(struct name*)calloc(1,sizeof(struct name)); \
+    if(h==NULL || !name##Grow(h,cap ? cap : 16)){ \
+        printf("Out of Memory!"); free(h); return NULL; \
+    } \
+    return h; \
+} \
+static inline void free##name(struct name *h){ \
+    if(h==NULL) return; \
+    free(h->base); free(h); \
+} \
+static inline int name##Push(struct name *h, T x){ \
+    if(h->n==h->cap && !name##Grow(h,2*h->cap)) return 0; \
+    h->a[h->n]=x; \
+    name##SiftUp(h->a,h->n++); \
+    return 1; \
+} \
+static inline int name##Pop(struct name *h, T *x){ \
+    if(h->n==0) return 0; \
+    *x=h->a[0]; \
+    h->a[0]=h->a[--h->n]; \
+    if(h->n>1) name##SiftDown(h->a,h->n,0); \
+    return 1; \
+} \
+static inline T name##Top(const struct name *h){ \
+    return h->a[0]; \
+} \
+/* Replaces the contents of h with v[0..n) in O(n) */ \
+static inline int name##Build(struct name *h, const T v[], size_t n){ \
+    h->n=0; \
+    if(n>h->cap && !name##Grow(h,n)) return 0; \
+    memcpy(h->a,v,n*sizeof(T)); h->n=n; \
+    name##Heapify(h->a,n); \
+    return 1; \
+} \
+/* Moves the m elements of other into h and empties other. A few are pushed one by one; when  \
+   m*D >= n it is cheaper to append them all and heapify, O(n+m). */ \
+static inline int name##Merge(struct name *h, struct name *other){ \
+    size_t m=other->n; \
+    if(h->n+m>h->cap && !name##Grow(h,2*(h->n+m))) return 0; \
+    if(m*(D)<h->n) for(size_t i=0;i<m;i++){ h->a[h->n]=other->a[i]; name##SiftUp(h->a,h->n++); } \
+    else{ \
+        memcpy(h->a+h->n,other->a,m*sizeof(T)); h->n+=m; \
+        name##Heapify(h->a,h->n); \
+    } \
+    other->n=0; \
+    return 1; \
+}
+
+#define HEAP_INT_LESS(x,y) ((x)<(y))
+DEFINE_DARY_HEAP(Heap4Int,int,4,HEAP_INT_LESS)
+#endif
@@ -0,0 +1,185 @@
+#ifndef ORDER_STATISTIC_AVL_TREE_C
+#define ORDER_STATISTIC_AVL_TREE_C
+#include<stdio.h>
+#include<stdlib.h>
+// AVL tree of distinct int keys with the size of every subtree, for rank and select on a live
+// ordered set.
+// - Nodes live in one growable array (the arena) and point at each other by index, 0 meaning
+//   none. Node 0 is a sentinel with height and size 0, so the code never tests for a missing
+//   child. Deleted nodes go on a free list threaded through their left index and are reused.
+//   The arena doubles when it is full, so n inserts cost O(n) allocation in all.
+// - Insert and delete are iterative: the way down is kept on an explicit stack of at most
+//   OST_MAX_HEIGHT nodes (an AVL tree of 2^32 nodes is under 46 levels), and the way back up
+//   updates heights and sizes and rotates, so deep trees cannot overflow the call stack.
+// - ostRank() counts the keys smaller than a key and ostSelect() finds the k-th smallest, both in
+//   O(log n) from the subtree sizes.
+#define OST_MAX_HEIGHT 64
+struct OSNode{int key; unsigned left,right,size; int height;};
+struct OSTree{
+    struct OSNode *a;       // the arena; a[0] is the sentinel
+    unsigned root;
+    unsigned capacity;      // nodes in the arena, the sentinel included
+    unsigned used;          // nodes handed out so far, the sentinel included
+    unsigned freeList;      // deleted nodes
+};
+struct OSTree *newOSTree(unsigned capacity){
+    struct OSTree *t=(struct OSTree*)malloc(sizeof(struct OSTree));
+    if(t==NULL){
+        printf("Out of Memory!"); return NULL;
+    }
+    t->capacity=capacity<2 ? 2 : capacity+1;
+    t->a=(struct OSNode*)malloc(t->capacity*sizeof(struct OSNode));
+    if(t->a==NULL){
+        printf("Out of Memory!"); free(t); return NULL;
+    }
+    t->a[0].key=0; t->a[0].left=t->a[0].right=0; t->a[0].size=0; t->a[0].height=0;
+    t->root=0; t->used=1; t->freeList=0;
+    return t;
+}
+void freeOSTree(struct OSTree *t){
+    if(t==NULL) return;
+    free(t->a); free(t);
+}
+unsigned ostSize(const struct OSTree *t){
+    return t->a[t->root].size;
+}
+// A fresh leaf holding key, or 0 when out of memory
+static unsigned ostNewNode(struct OSTree *t, int key){
+    unsigned i=t->freeList;
+    if(i!=0) t->freeList=t->a[i].left;
+    else{
+        if(t->used==t->capacity){
+            struct OSNode *a=(struct OSNode*)realloc(t->a,2*(size_t)t->capacity*sizeof(struct OSNode));
+            if(a==NULL){
+                printf("Out of Memory!"); return 0;
+            }
+            t->a=a; t->capacity*=2;
+        }
+        i=t->used++;
+    }
+    struct OSNode *n=&t->a[i];
+    n->key=key; n->left=n->right=0; n->size=1; n->height=1;
+    return i;
+}
+static inline void ostUpdate(struct OSNode *a, unsigned i){
+    int l=a[a[i].left].height, r=a[a[i].right].height;
+    a[i].height=(l>r ? l : r)+1;
+    a[i].size=a[a[i].left].size+a[a[i].right].size+1;
+}
+static unsigned ostRotateRight(struct OSNode *a, unsigned i){
+    unsigned x=a[i].left;
+    a[i].left=a[x].right; a[x].right=i;
+    ostUpdate(a,i); ostUpdate(a,x);
+    return x;
+}
+static unsigned ostRotateLeft(struct OSNode *a, unsigned i){
+    unsigned x=a[i].right;
+    a[i].right=a[x].left; a[x].left=i;
+    ostUpdate(a,i); ostUpdate(a,x);
+    return x;
+}
+// Updates node i after a change below it and rotates if it is out of balance; returns the new
+// root of its subtree
+static unsigned ostBalance(struct OSNode *a, unsigned i){
+    ostUpdate(a,i);
+    int b=a[a[i].left].height-a[a[i].right].height;
+    if(b>1){
+        unsigned l=a[i].left;
+        if(a[a[l].left].height<a[a[l].right].height) a[i].left=ostRotateLeft(a,l);   // left-right
+        return ostRotateRight(a,i);
+    }
+    if(b<-1){
+        unsigned r=a[i].right;
+        if(a[a[r].right].height<a[a[r].left].height) a[i].right=ostRotateRight(a,r); // right-left
+        return ostRotateLeft(a,i);
+    }
+    return i;
+}
+// Rebalances the nodes of path[0..depth) from the bottom up, relinking each to its parent
+static void ostFixPath(struct OSTree *t, const unsigned *path, const unsigned char *right, int depth){
+    struct OSNode *a=t->a;
+    for(int k=depth-1;k>=0;k--){
+        unsigned i=ostBalance(a,path[k]);
+        if(k==0) t->root=i;
+        else if(right[k-1]) a[path[k-1]].right=i;
+        else a[path[k-1]].left=i;
+    }
+}
+// 1 when key was added, 0 when it was already there, -1 when out of memory
+int ostInsert(struct OSTree *t, int key){
+    unsigned path[OST_MAX_HEIGHT]; unsigned char right[OST_MAX_HEIGHT];
+    int depth=0;
+    for(unsigned i=t->root;i!=0;){
+        if(key==t->a[i].key) return 0;
+        path[depth]=i; right[depth]=key>t->a[i].key;
+        i=right[depth] ? t->a[i].right : t->a[i].left;
+        depth++;
+    }
+    unsigned n=ostNewNode(t,key);      // may move the arena
+    if(n==0) return -1;
+    if(depth==0) t->root=n;
+    else if(right[depth-1]) t->a[path[depth-1]].right=n;
+    else t->a[path[depth-1]].left=n;
+    ostFixPath(t,path,right,depth);
+    return 1;
+}
+// 1 when key was removed, 0 when it was not there
+int ostDelete(struct OSTree *t, int key){
+    unsigned path[OST_MAX_HEIGHT]; unsigned char right[OST_MAX_HEIGHT];
+    struct OSNode *a=t->a;
+    int depth=0;
+    unsigned i=t->root;
+    while(i!=0 && a[i].key!=key){
+        path[depth]=i; right[depth]=key>a[i].key;
+        i=right[depth] ? a[i].right : a[i].left;
+        depth++;
+    }
+    if(i==0) return 0;
+    if(a[i].left!=0 && a[i].right!=0){
+        // Two children: take the key of the successor, then unlink the successor instead
+        int at=depth;
+        path[depth]=i; right[depth]=1; depth++;
+        unsigned s=a[i].right;
+        while(a[s].left!=0){
+            path[depth]=s; right[depth]=0; depth++;
+            s=a[s].left;
+        }
+        a[path[at]].key=a[s].key;
+        i=s;
+    }
+    unsigned child=a[i].left!=0 ? a[i].left : a[i].right;
+    if(depth==0) t->root=child;
+    else if(right[depth-1]) a[path[depth-1]].right=child;
+    else a[path[depth-1]].left=child;
+    a[i].left=t->freeList; t->freeList=i;
+    ostFixPath(t,path,right,depth);
+    return 1;
+}
+int ostFind(const struct OSTree *t, int key){
+    unsigned i=t->root;
+    while(i!=0 && t->a[i].key!=key) i=key<t->a[i].key ? t->a[i].left : t->a[i].right;
+    return i!=0;
+}
+// Number of keys smaller than key
+unsigned ostRank(const struct OSTree *t, int key){
+    const struct OSNode *a=t->a;
+    unsigned rank=0;
+    for(unsigned i=t->root;i!=0;){
+        if(key<=a[i].key) i=a[i].left;
+        else{ rank+=a[a[i].left].size+1; i=a[i].right; }
+    }
+    return rank;
+}
+// The k-th smallest key (k from 0) in *key; 0 when k >= ostSize()
+int ostSelect(const struct OSTree *t, unsigned k, int *key){
+    const struct OSNode *a=t->a;
+    unsigned i=t->root;
+    if(k>=a[i].size) return 0;
+    for(;;){
+        unsigned l=a[a[i].left].size;
+        if(k==l){ *key=a[i].key; return 1; }
+        if(k<l) i=a[i].left;
+        else{ k-=l+1; i=a[i].right; }
+    }
+}
+#endif
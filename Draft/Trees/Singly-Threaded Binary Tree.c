@@ -1,13 +1,21 @@
-#include<stdio.H>
+#ifndef SINGLY_THREADED_BINARY_TREE_C
+#define SINGLY_THREADED_BINARY_TREE_C
+#include<stdio.h>
 #include<stdlib.h>
-struct Node{int key; struct Node *left, *right; bool r;};
+// Binary search tree whose empty right pointers are threads: a node with no right child points
+// at its in-order successor instead (NULL for the largest key), and r tells the two apart.
+// An in-order walk follows the threads upward, so it needs neither recursion nor a stack.
+struct Node{int key; struct Node *left, *right; int r;};   // r: right is a thread
 struct Node *newNode(int data) {
    // Allocate memory and store data
    struct Node *node = (struct Node*)malloc(sizeof(struct Node));
+   if(node == NULL) {
+       printf("Out of Memory!"); return NULL;
+   }
    node->key = data;  // Set key value
    node->left = NULL;  // Initialize left child as null
-   node->right = NULL;  // Initialize right child as null
-   node->r = 0;
+   node->right = NULL;  // No successor yet
+   node->r = 1;  // A new node is a leaf, so its right pointer is a thread
    return node;  // Return the created node
 }
 // Function to find the minimum node in a binary search tree
@@ -17,7 +25,7 @@ struct Node *minNode(struct Node *root)
     struct Node *curr = root;
 
     // Loop until current node is null or has no left child
-    while ((curr && curr->left) != NULL)
+    while (curr && curr->left != NULL)
     {
         // Move to the left child
         curr = curr->left;
@@ -26,24 +34,60 @@ struct Node *minNode(struct Node *root)
     // Return the minimum node
     return curr;
 }
+// In-order successor of node, or NULL for the largest key
+struct Node *successor(struct Node *node) {
+    // A thread points straight at it; otherwise it is the minimum of the right subtree
+    if (node->r) return node->right;
+    return minNode(node->right);
+}
+// Inserts data without recursion; returns its node (the existing one for a duplicate)
 struct Node *insert(struct Node **root, int data) {
     // create new node if root is null
-    if (*root == NULL) *root = newNode(data);
+    if (*root == NULL) return *root = newNode(data);
 
-    // go to left subtree if data is less than root's key
-    if (data < (*root)->key) {
-        struct Node *lc = insert((*root)->left, data);
-        (*root)->left = lc;  // assign left child
-        lc->right = (*root); // make new node as right child of left child
-        lc->r = 1;           // set right child count of new node
-    } else {
-        // go to right subtree if data is greater than or equal to root's key
-        struct Node *rc = insert((*root)->right, data);
-        (*root)->right = rc; // assign right child
-        rc->right = (*root)->right; // make root's right child as right child of new node
-        rc->r = (*root)->r; (*root)->r = 0; // update right child count
+    struct Node *curr = *root;
+    for (;;) {
+        if (data < curr->key) {
+            // go to left subtree, or hang the new node there: its successor is curr
+            if (curr->left != NULL) { curr = curr->left; continue; }
+            struct Node *node = newNode(data);
+            if (node == NULL) return NULL;
+            node->right = curr;
+            curr->left = node;
+            return node;
+        }
+        if (data > curr->key) {
+            // go to right subtree, or take over curr's thread: the new node inherits its successor
+            if (!curr->r) { curr = curr->right; continue; }
+            struct Node *node = newNode(data);
+            if (node == NULL) return NULL;
+            node->right = curr->right;
+            curr->right = node; curr->r = 0;
+            return node;
+        }
+        printf("Duplicate Node!");
+        return curr;
     }
-
-    // return root node
-    return (*root);
-}
\ No newline at end of file
+}
+// Hands every key to visit(arg,key) in order, in O(n) time and O(1) space
+void inorderVisit(struct Node *root, void (*visit)(void *arg, int key), void *arg) {
+    for (struct Node *curr = minNode(root); curr != NULL; curr = successor(curr))
+        visit(arg, curr->key);
+}
+static void printKey(void *arg, int key) {
+    (void)arg; printf("%d ", key);
+}
+void inorder(struct Node *root) {
+    inorderVisit(root, printKey, NULL);
+}
+// Frees every node, walking the threads so no stack is needed either
+void freeTree(struct Node *root) {
+    struct Node *curr = minNode(root);
+    while (curr != NULL) {
+        // read before curr is freed; every node the walk reads later comes after curr in order
+        struct Node *next = successor(curr);
+        free(curr);
+        curr = next;
+    }
+}
+#endif
@@ -0,0 +1,398 @@
+// Benchmark for the B+ tree of B+ Tree.c against the AVL tree of AVL Search(Height Balanced) Tree.c
+// and std::map, as an ordered index of distinct int keys.
+// Built as C++ only so std::map can sit in the same table; the trees themselves are C.
+// Build: g++ -O2 -o tree_bench "Tree Benchmark.cpp"
+// Run:   ./tree_bench --min 65536 --max 16777216 --json tree.json
+// For every n (ns/item = per key for the builds, per lookup or scan otherwise):
+//   */insert        insert n random keys one by one (the AVL tree through its insert())
+//   bptree/insertBatch  the same keys in batches of TREE_CHUNK, each batch sorted, through
+//                   bpInsertBatch(), as an ingest buffer that is sorted before it is flushed
+//   bptree/bulk     bpBulkLoad() of the n keys in order
+//   */find          point lookups, half of them hits
+//   bptree/findBatch, bulk/findBatch  the same lookups through bpFindBatch()
+//   */range         sum the values of the keys in a random interval holding TREE_RANGE keys
+//                   on average
+//   */rank          number of keys below each lookup key
+//   */select        the (key mod n)-th smallest key for each lookup key
+// The order statistic tree of Order Statistic AVL Tree.c runs insert, find, range (as two ranks),
+// rank and select; its rank and select are checked against binary search in the sorted keys.
+// Every lookup and range checksum is checked against std::map. Untimed, checkOst() runs
+// inserts and deletes on an order statistic tree of up to TREE_OST_CHECK keys and compares every
+// rank and select with a std::set after each round.
+#include<map>
+#include<set>
+#include<vector>
+#include<algorithm>
+#include"AVL Search(Height Balanced) Tree.c"
+#include"B+ Tree.c"
+#include"Order Statistic AVL Tree.c"
+#include"../Benchmark/Benchmark.h"
+
+#define TREE_CHUNK 4096     // keys per bpInsertBatch() call
+#define TREE_RANGE 100      // keys per range scan, on average
+#define TREE_FIND_BATCH 64  // keys per bpFindBatch() call
+#define TREE_OST_CHECK 65536    // keys in checkOst()
+
+// The value stored with a key; the AVL tree keeps only keys, so its lookups recompute it
+static inline int treeValue(int key){
+    return key^0x5bd1e995;
+}
+struct TreeCtx{
+    size_t n;
+    int *keys;              // distinct, in insertion order
+    int *chunked;           // the same keys, sorted in chunks of TREE_CHUNK
+    int *sorted, *sortedValues, *values, *chunkedValues;
+    int *queries; size_t nq;
+    int *lo; long long span; size_t nr;
+    struct Node *avl;
+    std::map<int,int> *map;
+    struct BPTree *bp, *batch, *bulk;
+    struct OSTree *ost;
+};
+
+static void avlFree(struct Node *root){
+    if(root==NULL) return;
+    avlFree(root->left); avlFree(root->right); free(root);
+}
+static int avlFind(const struct Node *root, int key){
+    while(root!=NULL && root->key!=key) root=key<root->key ? root->left : root->right;
+    return root!=NULL;
+}
+// Sum of the values of the keys in [lo,hi)
+static long long avlRange(const struct Node *root, long long lo, long long hi){
+    if(root==NULL) return 0;
+    long long s=0;
+    if(root->key>lo) s+=avlRange(root->left,lo,hi);
+    if(root->key>=lo && root->key<hi) s+=treeValue(root->key);
+    if(root->key<hi-1) s+=avlRange(root->right,lo,hi);
+    return s;
+}
+
+// Builds: setup drops the structure of the previous sample
+static void dropAvl(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; (void)begin; (void)end;
+    avlFree(c->avl); c->avl=NULL;
+}
+static void dropMap(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; (void)begin; (void)end;
+    delete c->map; c->map=new std::map<int,int>();
+}
+static void dropOst(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; (void)begin; (void)end;
+    freeOSTree(c->ost); c->ost=newOSTree(0);
+}
+static void dropBp(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; (void)begin; (void)end;
+    freeBPTree(c->bp); c->bp=newBPTree();
+}
+static void dropBatch(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; (void)begin; (void)end;
+    freeBPTree(c->batch); c->batch=newBPTree();
+}
+static void dropBulk(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; (void)begin; (void)end;
+    freeBPTree(c->bulk); c->bulk=newBPTree();
+}
+static long long avlInsert(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; (void)begin; (void)end;
+    for(size_t i=0;i<c->n;i++) c->avl=insert(c->avl,c->keys[i]);
+    return height(c->avl);
+}
+static long long mapInsert(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; (void)begin; (void)end;
+    for(size_t i=0;i<c->n;i++) c->map->insert(std::make_pair(c->keys[i],c->values[i]));
+    return (long long)c->map->size();
+}
+static long long ostInsertAll(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; (void)begin; (void)end;
+    for(size_t i=0;i<c->n;i++) ostInsert(c->ost,c->keys[i]);
+    return ostSize(c->ost);
+}
+static long long bpInsertAll(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; (void)begin; (void)end;
+    for(size_t i=0;i<c->n;i++) bpInsert(c->bp,c->keys[i],c->values[i]);
+    return (long long)c->bp->size;
+}
+static long long bpInsertChunks(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; (void)begin; (void)end;
+    for(size_t i=0;i<c->n;i+=TREE_CHUNK){
+        size_t m=c->n-i<TREE_CHUNK ? c->n-i : TREE_CHUNK;
+        bpInsertBatch(c->batch,c->chunked+i,c->chunkedValues+i,m);
+    }
+    return (long long)c->batch->size;
+}
+static long long bpBulk(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; (void)begin; (void)end;
+    bpBulkLoad(c->bulk,c->sorted,c->sortedValues,c->n);
+    return (long long)c->bulk->size;
+}
+
+// Lookups: operation i looks up queries[i % nq]
+static long long avlLookup(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; long long sum=0;
+    for(size_t i=begin;i<end;i++){
+        int key=c->queries[i%c->nq];
+        if(avlFind(c->avl,key)) sum+=treeValue(key);
+    }
+    return sum;
+}
+static long long mapLookup(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; long long sum=0;
+    for(size_t i=begin;i<end;i++){
+        std::map<int,int>::const_iterator it=c->map->find(c->queries[i%c->nq]);
+        if(it!=c->map->end()) sum+=it->second;
+    }
+    return sum;
+}
+static long long ostLookup(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; long long sum=0;
+    for(size_t i=begin;i<end;i++){
+        int key=c->queries[i%c->nq];
+        if(ostFind(c->ost,key)) sum+=treeValue(key);
+    }
+    return sum;
+}
+static long long bpLookup(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; long long sum=0; int v;
+    for(size_t i=begin;i<end;i++)
+        if(bpFind(c->bp,c->queries[i%c->nq],&v)) sum+=v;
+    return sum;
+}
+static long long lookupBatch(const struct BPTree *t, const struct TreeCtx *c, size_t begin, size_t end){
+    int keys[TREE_FIND_BATCH], values[TREE_FIND_BATCH], found[TREE_FIND_BATCH];
+    long long sum=0;
+    for(size_t i=begin;i<end;i+=TREE_FIND_BATCH){
+        size_t m=end-i<TREE_FIND_BATCH ? end-i : TREE_FIND_BATCH;
+        for(size_t j=0;j<m;j++) keys[j]=c->queries[(i+j)%c->nq];
+        bpFindBatch(t,keys,values,found,m);
+        for(size_t j=0;j<m;j++) if(found[j]) sum+=values[j];
+    }
+    return sum;
+}
+static long long bpLookupBatch(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx;
+    return lookupBatch(c->bp,c,begin,end);
+}
+static long long bulkLookupBatch(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx;
+    return lookupBatch(c->bulk,c,begin,end);
+}
+
+// Range scans: operation i sums [lo[i % nr], lo+span)
+static long long avlScan(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; long long sum=0;
+    for(size_t i=begin;i<end;i++){
+        long long lo=c->lo[i%c->nr];
+        sum+=avlRange(c->avl,lo,lo+c->span);
+    }
+    return sum;
+}
+static long long mapScan(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; long long sum=0;
+    for(size_t i=begin;i<end;i++){
+        long long lo=c->lo[i%c->nr];
+        for(std::map<int,int>::const_iterator it=c->map->lower_bound((int)lo);it!=c->map->end() && it->first<lo+c->span;++it)
+            sum+=it->second;
+    }
+    return sum;
+}
+static long long bpScan(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; long long sum=0;
+    for(size_t i=begin;i<end;i++){
+        long long lo=c->lo[i%c->nr];
+        struct BPCursor cur; int key, value;
+        bpSeek(c->bp,(int)lo,&cur);
+        while(bpNext(&cur,&key,&value) && key<lo+c->span) sum+=value;
+    }
+    return sum;
+}
+
+// Only counts: the order statistic tree holds keys, and a range is rank(hi)-rank(lo)
+static long long mapCount(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; long long sum=0;
+    for(size_t i=begin;i<end;i++){
+        long long lo=c->lo[i%c->nr];
+        for(std::map<int,int>::const_iterator it=c->map->lower_bound((int)lo);it!=c->map->end() && it->first<lo+c->span;++it)
+            sum++;
+    }
+    return sum;
+}
+static long long ostCount(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; long long sum=0;
+    for(size_t i=begin;i<end;i++){
+        long long lo=c->lo[i%c->nr], hi=lo+c->span;
+        unsigned above=hi>INT_MAX ? ostSize(c->ost) : ostRank(c->ost,(int)hi);
+        sum+=above-ostRank(c->ost,(int)lo);
+    }
+    return sum;
+}
+
+// Rank and select: the sorted keys give the reference
+static long long sortedRank(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; long long sum=0;
+    for(size_t i=begin;i<end;i++) sum+=std::lower_bound(c->sorted,c->sorted+c->n,c->queries[i%c->nq])-c->sorted;
+    return sum;
+}
+static long long ostRankAll(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; long long sum=0;
+    for(size_t i=begin;i<end;i++) sum+=ostRank(c->ost,c->queries[i%c->nq]);
+    return sum;
+}
+static long long sortedSelect(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; long long sum=0;
+    for(size_t i=begin;i<end;i++) sum+=c->sorted[(unsigned)c->queries[i%c->nq]%c->n];
+    return sum;
+}
+static long long ostSelectAll(void *vctx, size_t begin, size_t end){
+    struct TreeCtx *c=(struct TreeCtx*)vctx; long long sum=0; int key;
+    for(size_t i=begin;i<end;i++)
+        if(ostSelect(c->ost,(unsigned)c->queries[i%c->nq]%c->n,&key)) sum+=key;
+    return sum;
+}
+
+// Height of the subtree at i, or -1 when a height, a size, the key order or the AVL balance is off
+static int ostValid(const struct OSTree *t, unsigned i, long long lo, long long hi){
+    const struct OSNode *a=t->a;
+    if(i==0) return 0;
+    int l=ostValid(t,a[i].left,lo,a[i].key), r=ostValid(t,a[i].right,a[i].key,hi);
+    if(l<0 || r<0 || a[i].key<=lo || a[i].key>=hi || l-r>1 || r-l>1) return -1;
+    if(a[i].height!=1+std::max(l,r) || a[i].size!=a[a[i].left].size+a[a[i].right].size+1) return -1;
+    return a[i].height;
+}
+// Rounds of deletes (of present and absent keys) and reinserts on an order statistic tree, each
+// checked against a std::set: return values, then the shape and every rank and select
+static int checkOst(const int keys[], size_t n, unsigned long long *s){
+    size_t m=std::min(n,(size_t)TREE_OST_CHECK);
+    struct OSTree *t=newOSTree(0);
+    std::set<int> ref;
+    if(t==NULL) return 0;
+    int ok=1;
+    for(size_t i=0;i<m;i++){ ostInsert(t,keys[i]); ref.insert(keys[i]); }
+    for(int round=0;round<8 && ok;round++){
+        for(size_t i=0;i<m/2 && ok;i++){
+            int key=keys[benchRand(s)%m];
+            if(round&1) ok=ostInsert(t,key)==(int)ref.insert(key).second;
+            else{
+                ok=ostDelete(t,key)==(int)ref.erase(key);
+                if(i&1) key=(int)(benchRand(s)&0x7fffffff);
+                ok=ok && ostDelete(t,key)==(int)ref.erase(key);
+            }
+        }
+        std::vector<int> v(ref.begin(),ref.end());
+        ok=ok && ostSize(t)==v.size() && ostValid(t,t->root,(long long)INT_MIN-1,(long long)INT_MAX+1)>=0;
+        for(size_t k=0;k<v.size() && ok;k++){
+            int key;
+            ok=ostSelect(t,(unsigned)k,&key) && key==v[k] && ostRank(t,v[k])==k &&
+                (v[k]==INT_MAX || ostRank(t,v[k]+1)==k+1) && ostFind(t,v[k]);
+        }
+        int past;
+        ok=ok && !ostSelect(t,(unsigned)v.size(),&past);
+    }
+    for(size_t i=0;i<m && ok;i++) ostDelete(t,keys[i]);
+    ok=ok && ostSize(t)==0;
+    freeOSTree(t);
+    return ok;
+}
+
+struct TreeRoutine{
+    const char *name;
+    long long (*run)(void *ctx, size_t begin, size_t end);
+    void (*setup)(void *ctx, size_t begin, size_t end);
+    int kind;               // 0 build (always runs: the other rows need it), 1 lookup, 2 range,
+                            // 3 range count, 4 rank, 5 select
+    int reference;          // checksum the later rows of the kind are checked against
+};
+static const struct TreeRoutine routines[]={
+    {"map/insert",mapInsert,dropMap,0,0},
+    {"avl/insert",avlInsert,dropAvl,0,0},
+    {"bptree/insert",bpInsertAll,dropBp,0,0},
+    {"bptree/insertBatch",bpInsertChunks,dropBatch,0,0},
+    {"bptree/bulk",bpBulk,dropBulk,0,0},
+    {"ost/insert",ostInsertAll,dropOst,0,0},
+    {"map/find",mapLookup,NULL,1,1},
+    {"avl/find",avlLookup,NULL,1,0},
+    {"bptree/find",bpLookup,NULL,1,0},
+    {"bptree/findBatch",bpLookupBatch,NULL,1,0},
+    {"bulk/findBatch",bulkLookupBatch,NULL,1,0},
+    {"ost/find",ostLookup,NULL,1,0},
+    {"map/range",mapScan,NULL,2,1},
+    {"avl/range",avlScan,NULL,2,0},
+    {"bptree/range",bpScan,NULL,2,0},
+    {"map/count",mapCount,NULL,3,1},
+    {"ost/count",ostCount,NULL,3,0},
+    {"sorted/rank",sortedRank,NULL,4,1},
+    {"ost/rank",ostRankAll,NULL,4,0},
+    {"sorted/select",sortedSelect,NULL,5,1},
+    {"ost/select",ostSelectAll,NULL,5,0},
+};
+
+int main(int argc, char **argv){
+    struct BenchConfig cfg; benchDefaults(&cfg);
+    cfg.minN=1<<16;
+    if(benchParseArgs(&cfg,argc,argv)!=argc){
+        benchUsage(argv[0]); return 1;
+    }
+    struct BenchReport rep; benchReportBegin(&rep,&cfg,"tree");
+    int failed=0;
+    unsigned long long s=benchSeed(cfg.seed);
+    for(size_t n=benchNextSize(&cfg,0);n;n=benchNextSize(&cfg,n)){
+        if(n>=(size_t)1<<31) break;
+        struct TreeCtx c;
+        c.n=n; c.nq=cfg.ops; c.nr=cfg.ops/16 ? cfg.ops/16 : 1;
+        c.keys=(int*)malloc(n*sizeof(int)); c.values=(int*)malloc(n*sizeof(int));
+        c.chunked=(int*)malloc(n*sizeof(int)); c.chunkedValues=(int*)malloc(n*sizeof(int));
+        c.sorted=(int*)malloc(n*sizeof(int)); c.sortedValues=(int*)malloc(n*sizeof(int));
+        c.queries=(int*)malloc(c.nq*sizeof(int)); c.lo=(int*)malloc(c.nr*sizeof(int));
+        if(c.keys==NULL || c.values==NULL || c.chunked==NULL || c.chunkedValues==NULL ||
+                c.sorted==NULL || c.sortedValues==NULL || c.queries==NULL || c.lo==NULL){
+            printf("Out of Memory!"); return 1;
+        }
+        // i -> (i^x)*odd mod 2^31 is a bijection, so the keys are distinct and look random
+        unsigned x=(unsigned)benchRand(&s)&0x7fffffff;
+        for(size_t i=0;i<n;i++){
+            c.keys[i]=(int)((((unsigned)i^x)*2654435761u)&0x7fffffff);
+            c.values[i]=treeValue(c.keys[i]);
+        }
+        memcpy(c.chunked,c.keys,n*sizeof(int));
+        for(size_t i=0;i<n;i+=TREE_CHUNK) std::sort(c.chunked+i,c.chunked+std::min(n,i+TREE_CHUNK));
+        memcpy(c.sorted,c.keys,n*sizeof(int));
+        std::sort(c.sorted,c.sorted+n);
+        for(size_t i=0;i<n;i++){
+            c.chunkedValues[i]=treeValue(c.chunked[i]); c.sortedValues[i]=treeValue(c.sorted[i]);
+        }
+        for(size_t i=0;i<c.nq;i++)
+            c.queries[i]=(i&1) ? (int)(benchRand(&s)&0x7fffffff) : c.keys[benchRand(&s)%n];
+        c.span=((long long)TREE_RANGE<<31)/(long long)n;
+        for(size_t i=0;i<c.nr;i++) c.lo[i]=(int)(benchRand(&s)&0x7fffffff);
+        c.avl=NULL; c.map=NULL; c.bp=c.batch=c.bulk=NULL; c.ost=NULL;
+        if(!checkOst(c.keys,n,&s)){
+            fprintf(stderr,"ost: delete, rank or select disagrees with std::set for n=%zu\n",n); failed=1;
+        }
+
+        long long ref[6]={0,0,0,0,0,0};
+        for(size_t r=0;r<sizeof(routines)/sizeof(routines[0]);r++){
+            const struct TreeRoutine *rt=&routines[r];
+            if(!benchSelected(&cfg,rt->name) && rt->kind!=0 && !rt->reference) continue;
+            size_t ops=rt->kind==0 ? 1 : rt->kind==2 || rt->kind==3 ? c.nr : c.nq;
+            unsigned batch=rt->kind==0 ? 1 : rt->kind==2 || rt->kind==3 ? 0 : TREE_FIND_BATCH;
+            struct BenchCase bc={rt->name,n,ops,batch,rt->run,rt->setup,&c,rt->kind==0 ? n : 0};
+            struct BenchResult res=benchMeasure(&cfg,&bc);
+            if(benchSelected(&cfg,rt->name)) benchReportResult(&rep,&res);
+            if(rt->kind==0) continue;
+            long long one=res.checksum;
+            if(rt->reference) ref[rt->kind]=one;
+            else if(one!=ref[rt->kind]){
+                fprintf(stderr,"%s: wrong result for n=%zu\n",rt->name,n); failed=1;
+            }
+        }
+        if(c.bp->size!=n || c.batch->size!=n || c.bulk->size!=n || c.map->size()!=n || ostSize(c.ost)!=n){
+            fprintf(stderr,"wrong number of keys for n=%zu\n",n); failed=1;
+        }
+        avlFree(c.avl); delete c.map;
+        freeBPTree(c.bp); freeBPTree(c.batch); freeBPTree(c.bulk); freeOSTree(c.ost);
+        free(c.keys); free(c.values); free(c.chunked); free(c.chunkedValues);
+        free(c.sorted); free(c.sortedValues); free(c.queries); free(c.lo);
+    }
+    benchReportEnd(&rep);
+    return failed;
+}